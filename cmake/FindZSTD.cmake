@@ -0,0 +1,25 @@
+find_path(ZSTD_ROOT_DIR
+    NAMES include/zstd.h
+)
+
+find_library(ZSTD_LIBRARIES
+    NAMES zstd
+    HINTS ${ZSTD_ROOT_DIR}/lib
+)
+
+find_path(ZSTD_INCLUDE_DIR
+    NAMES zstd.h
+    HINTS ${ZSTD_ROOT_DIR}/include
+)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(zstd DEFAULT_MSG
+    ZSTD_LIBRARIES
+    ZSTD_INCLUDE_DIR
+)
+
+mark_as_advanced(
+    ZSTD_ROOT_DIR
+    ZSTD_LIBRARIES
+    ZSTD_INCLUDE_DIR
+)
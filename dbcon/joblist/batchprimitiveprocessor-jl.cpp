@@ -79,6 +79,7 @@ BatchPrimitiveProcessorJL::BatchPrimitiveProcessorJL(ResourceManager* rm)
  , threadCount(1)
  , fJoinerChunkSize(rm->getJlJoinerChunkSize())
  , hasSmallOuterJoin(false)
+ , columnarRowGroupData(rm->getJlColumnarRowGroupTransfer())
  , _priority(1)
  , rm_(rm)
 {
@@ -1060,6 +1061,9 @@ void BatchPrimitiveProcessorJL::createBPP(ByteStream& bs) const
   if (wideColumnsWidths)
     flags |= HAS_WIDE_COLUMNS;
 
+  if (columnarRowGroupData)
+    flags |= COLUMNAR_ROWGROUP_DATA;
+
   bs << flags;
 
   if (wideColumnsWidths)
@@ -1192,6 +1196,18 @@ void BatchPrimitiveProcessorJL::createBPP(ByteStream& bs) const
     {
       bs << (uint8_t)0;
     }
+
+    bs << topNLimit;
+
+    if (topNLimit > 0)
+    {
+      bs << (uint32_t)topNSpec.size();
+
+      for (const auto& spec : topNSpec)
+        bs << (int32_t)spec.fIndex << (int8_t)spec.fAsc << (int8_t)spec.fNf;
+    }
+
+    bs << limit;
   }
 
   // decide which rowgroup is received by PrimProc
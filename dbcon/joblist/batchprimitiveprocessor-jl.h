@@ -43,6 +43,7 @@
 #include "brm.h"
 #include "command-jl.h"
 #include "resourcemanager.h"
+#include "../../utils/windowfunction/idborderby.h"
 //#include "tableband.h"
 
 namespace joblist
@@ -227,6 +228,19 @@ class BatchPrimitiveProcessorJL
   void setFEGroup2(boost::shared_ptr<funcexp::FuncExpWrapper>, const rowgroup::RowGroup& output);
   void setJoinFERG(const rowgroup::RowGroup& rg);
 
+  /* Top-N of ORDER BY ... LIMIT, PM keeps the first limit rows of every job */
+  void setTopN(const std::vector<ordering::IdbSortSpec>& spec, uint32_t limit)
+  {
+    topNSpec = spec;
+    topNLimit = limit;
+  }
+
+  /* LIMIT without ORDER BY, PM stops reading the blocks of a job that has sent limit rows */
+  void setLimit(uint64_t l)
+  {
+    limit = l;
+  }
+
   /* This fcn determines whether or not the containing TBPS obj will process results
   from a join or put the RG data right in the output datalist. */
   bool pmSendsFinalResult() const
@@ -350,6 +364,13 @@ class BatchPrimitiveProcessorJL
   rowgroup::SP_ROWAGG_PM_t aggregatorPM;
   rowgroup::RowGroup aggregateRGPM;
 
+  /* for PM Top-N */
+  std::vector<ordering::IdbSortSpec> topNSpec;
+  uint32_t topNLimit = 0;
+
+  /* for PM LIMIT */
+  uint64_t limit = 0;
+
   /* UM portion of the PM join alg */
   std::vector<std::shared_ptr<joiner::TupleJoiner> > tJoiners;
   std::vector<rowgroup::RowGroup> smallSideRGs;
@@ -378,6 +399,8 @@ class BatchPrimitiveProcessorJL
   unsigned fJoinerChunkSize;
   uint32_t dbRoot;
   bool hasSmallOuterJoin;
+  // Ask PrimProc to send the result RowGroups column-wise encoded.
+  bool columnarRowGroupData;
   uint32_t maxPmJoinResultCount = 1048576;
 
   uint32_t _priority;
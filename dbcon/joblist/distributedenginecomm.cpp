@@ -257,8 +257,10 @@ int32_t DistributedEngineComm::Setup()
   tbpsThreadCount = fRm->getJlNumScanReceiveThreads();
   fDECConnectionsPerQuery = fRm->getDECConnectionsPerQuery();
   unsigned numConnections = getNumConnections();
-  flowControlEnableBytesThresh = fRm->getDECEnableBytesThresh();
-  flowControlDisableBytesThresh = fRm->getDECDisableBytesThresh();
+  flowControlByteCredits = fRm->getDECFlowControlByteCredits();
+  flowControlMaxByteCredits = fRm->getDECFlowControlMaxByteCredits();
+  flowControlMsgCredits = fRm->getDECFlowControlMsgCredits();
+  flowControlMaxMsgCredits = fRm->getDECFlowControlMaxMsgCredits();
   oam::Oam oam;
   ModuleTypeConfig moduletypeconfig;
 
@@ -432,7 +434,6 @@ Error:
   for (map_tok = fSessionMessages.begin(); map_tok != fSessionMessages.end(); ++map_tok)
   {
     map_tok->second->queue.clear();
-    (void)atomicops::atomicInc(&map_tok->second->unackedWork[0]);
     map_tok->second->queue.push(sbs);
   }
   lk.unlock();
@@ -461,11 +462,12 @@ void DistributedEngineComm::addQueue(uint32_t key, bool sendACKs)
   condition* cond = new condition();
   uint32_t firstPMInterleavedConnectionId =
       key % (fPmConnections.size() / pmCount) * fDECConnectionsPerQuery * pmCount % fPmConnections.size();
-  boost::shared_ptr<MQE> mqe(new MQE(pmCount, firstPMInterleavedConnectionId, flowControlEnableBytesThresh));
+  FlowControlCredits credits(pmCount, flowControlByteCredits, flowControlMaxByteCredits,
+                             flowControlMsgCredits, flowControlMaxMsgCredits);
+  boost::shared_ptr<MQE> mqe(new MQE(pmCount, firstPMInterleavedConnectionId, credits));
 
   mqe->queue = StepMsgQueue(lock, cond);
   mqe->sendACKs = sendACKs;
-  mqe->throttled = false;
 
   std::lock_guard lk(fMlock);
   b = fSessionMessages.insert(pair<uint32_t, boost::shared_ptr<MQE> >(key, mqe)).second;
@@ -528,13 +530,9 @@ void DistributedEngineComm::read(uint32_t key, SBS& bs)
   if (bs && mqe->sendACKs)
   {
     std::unique_lock lk(ackLock);
-
-    if (mqe->throttled && !mqe->hasBigMsgs && queueSize.size <= flowControlDisableBytesThresh)
-      setFlowControl(false, key, mqe);
-
     vector<SBS> v;
     v.push_back(bs);
-    sendAcks(key, v, mqe, queueSize.size);
+    returnCredits(key, v, mqe, queueSize.size);
   }
 
   if (!bs)
@@ -566,13 +564,9 @@ const ByteStream DistributedEngineComm::read(uint32_t key)
   if (sbs && mqe->sendACKs)
   {
     std::unique_lock lk(ackLock);
-
-    if (mqe->throttled && !mqe->hasBigMsgs && queueSize.size <= flowControlDisableBytesThresh)
-      setFlowControl(false, key, mqe);
-
     vector<SBS> v;
     v.push_back(sbs);
-    sendAcks(key, v, mqe, queueSize.size);
+    returnCredits(key, v, mqe, queueSize.size);
   }
 
   if (!sbs)
@@ -615,7 +609,7 @@ void DistributedEngineComm::read_all(uint32_t key, vector<SBS>& v)
   if (mqe->sendACKs)
   {
     std::unique_lock lk(ackLock);
-    sendAcks(key, v, mqe, 0);
+    returnCredits(key, v, mqe, 0);
   }
 }
 
@@ -645,235 +639,56 @@ void DistributedEngineComm::read_some(uint32_t key, uint32_t divisor, vector<SBS
   if (mqe->sendACKs)
   {
     std::unique_lock lk(ackLock);
-
-    if (mqe->throttled && !mqe->hasBigMsgs && queueSize.size <= flowControlDisableBytesThresh)
-      setFlowControl(false, key, mqe);
-
-    sendAcks(key, v, mqe, queueSize.size);
+    returnCredits(key, v, mqe, queueSize.size);
 
     if (flowControlOn)
-      *flowControlOn = mqe->throttled;
+      *flowControlOn = mqe->credits.exhausted();
   }
 }
 
-void DistributedEngineComm::sendAcks(uint32_t uniqueID, const vector<SBS>& msgs, boost::shared_ptr<MQE> mqe,
-                                     size_t queueSize)
+void DistributedEngineComm::returnCredits(uint32_t uniqueID, const vector<SBS>& msgs,
+                                          boost::shared_ptr<MQE> mqe, size_t queueSize)
 {
-  ISMPacketHeader* ism;
-  uint32_t l_msgCount = msgs.size();
+  uint32_t msgCount = 0;
+  uint64_t totalMsgSize = 0;
 
-  /* If the current queue size > target, do nothing.
-   * If the original queue size > target, ACK the msgs below the target.
-   */
-  if (!mqe->throttled || queueSize >= mqe->targetQueueSize)
+  for (auto& msg : msgs)
   {
-    /* no acks will be sent, but update unackedwork to keep the #s accurate */
-    uint16_t numack = 0;
-    uint32_t sockidx = 0;
-
-    while (l_msgCount > 0)
-    {
-      nextPMToACK(mqe, l_msgCount, &sockidx, &numack);
-      idbassert(numack <= l_msgCount);
-      l_msgCount -= numack;
-    }
+    if (!msg)
+      continue;
 
-    return;
+    ++msgCount;
+    totalMsgSize += msg->lengthWithHdrOverhead();
   }
 
-  size_t totalMsgSize = 0;
+  vector<FlowControlCredits::Grant> grants;
+  mqe->credits.consumed(msgCount, totalMsgSize, queueSize, grants);
 
-  for (uint32_t i = 0; i < msgs.size(); i++)
-    totalMsgSize += msgs[i]->lengthWithHdrOverhead();
-
-  if (queueSize + totalMsgSize > mqe->targetQueueSize)
+  // The ACK carries the number of messages and bytes the PM may send in addition, there is none
+  // until enough credits are returned.
+  for (auto& grant : grants)
   {
-    /* update unackedwork for the overage that will never be acked */
-    int64_t overage = queueSize + totalMsgSize - mqe->targetQueueSize;
-    uint16_t numack = 0;
-    uint32_t sockidx = 0;
-    uint32_t msgsToIgnore;
-
-    for (msgsToIgnore = 0; overage >= 0; msgsToIgnore++)
-      overage -= msgs[msgsToIgnore]->lengthWithHdrOverhead();
-
-    if (overage < 0)
-      msgsToIgnore--;
-
-    l_msgCount = msgs.size() - msgsToIgnore;  // this num gets acked
-
-    while (msgsToIgnore > 0)
-    {
-      nextPMToACK(mqe, msgsToIgnore, &sockidx, &numack);
-      idbassert(numack <= msgsToIgnore);
-      msgsToIgnore -= numack;
-    }
-  }
-
-  if (l_msgCount > 0)
-  {
-    SBS msg(new ByteStream(sizeof(ISMPacketHeader)));
-    uint16_t* toAck;
-    vector<bool> pmAcked(pmCount, false);
-
-    ism = (ISMPacketHeader*)msg->getInputPtr();
-    // The only var checked by ReadThread is the Command var.  The others
-    // are wasted space.  We hijack the Size, & Flags fields for the
-    // params to the ACK msg.
-
-    ism->Interleave = uniqueID;
-    ism->Command = BATCH_PRIMITIVE_ACK;
-    toAck = &ism->Size;
-
-    msg->advanceInputPtr(sizeof(ISMPacketHeader));
-    // There must be only one local connection here.
-    bool sendToLocal = false;
-    while (l_msgCount > 0)
-    {
-      /* could have to send up to pmCount ACKs */
-      uint32_t sockIndex = 0;
-
-      /* This will reset the ACK field in the Bytestream directly, and nothing
-       * else needs to change if multiple msgs are sent. */
-      nextPMToACK(mqe, l_msgCount, &sockIndex, toAck);
-      idbassert(*toAck <= l_msgCount);
-      l_msgCount -= *toAck;
-      if (sockIndex == localConnectionId_ && needToSendToLocalPM(fIsExeMgr, sockIndex))
-      {
-        sendToLocal = true;
-        continue;
-      }
-      pmAcked[sockIndex] = true;
-      writeToClient(sockIndex, msg);
-    }
-    if (sendToLocal)
-    {
-      pmAcked[localConnectionId_] = true;
-      writeToClient(localConnectionId_, msg);
-    }
-
-    // @bug4436, when no more unacked work, send an ack to all PMs that haven't been acked.
-    // This is apply to the big message case only.  For small messages, the flow control is
-    // disabled when the queue size is below the flowControlDisableBytesThresh.
-    if (mqe->hasBigMsgs)
-    {
-      uint64_t totalUnackedWork = 0;
-
-      for (uint32_t i = 0; i < pmCount; ++i)
-        totalUnackedWork += mqe->unackedWork[i];
-
-      if (totalUnackedWork == 0)
-      {
-        *toAck = 1;
-
-        for (uint32_t i = 0; i < pmCount; ++i)
-        {
-          if (!pmAcked[i])
-          {
-            if (i == localConnectionId_ && fIsExeMgr)
-            {
-              continue;
-            }
-            // MCOL-5637 Initialize a new bytestream before send a `ACK` command to Primitive Server.
-            SBS ackCommand = createBatchPrimitiveCommand(BATCH_PRIMITIVE_ACK, uniqueID, 1);
-            writeToClient(i, ackCommand);
-          }
-        }
-        if (needToSendToLocalPM(fIsExeMgr, localConnectionId_) && !pmAcked[localConnectionId_])
-        {
-          writeToClient(localConnectionId_, msg);
-        }
-      }
-    }
+    SBS ack = createBatchPrimitiveCommand(BATCH_PRIMITIVE_ACK, uniqueID, 0);
+    *ack << grant.msgs << grant.bytes;
+    writeToClient(grant.pmIndex, ack);
   }
 }
 
-void DistributedEngineComm::nextPMToACK(boost::shared_ptr<MQE> mqe, uint32_t maxAck, uint32_t* sockIndex,
-                                        uint16_t* numToAck)
+void DistributedEngineComm::appendInitialCredits(uint32_t uniqueID, ByteStream& createMsg)
 {
-  uint32_t& nextIndex = mqe->ackSocketIndex;
-
-  /* Other threads can be touching mqe->unackedWork at the same time, but because of
-   * the locking env, mqe->unackedWork can only grow; whatever gets latched in this fcn
-   * is a safe minimum at the point of use. */
-
-  if (mqe->unackedWork[nextIndex] >= maxAck)
-  {
-    (void)atomicops::atomicSub(&mqe->unackedWork[nextIndex], maxAck);
-    *sockIndex = nextIndex;
-    // FIXME: we're going to truncate here from 32 to 16 bits. Hopefully this will always fit...
-    *numToAck = maxAck;
-
-    if (pmCount > 0)
-      nextIndex = (nextIndex + 1) % pmCount;
-
-    return;
-  }
-  else
+  boost::shared_ptr<MQE> mqe;
   {
-    for (int i = pmCount - 1; i >= 0; --i)
-    {
-      uint32_t curVal = mqe->unackedWork[nextIndex];
-      uint32_t unackedWork = (curVal > maxAck ? maxAck : curVal);
-
-      if (unackedWork > 0)
-      {
-        (void)atomicops::atomicSub(&mqe->unackedWork[nextIndex], unackedWork);
-        *sockIndex = nextIndex;
-        *numToAck = unackedWork;
-
-        if (pmCount > 0)
-          nextIndex = (nextIndex + 1) % pmCount;
-
-        return;
-      }
-
-      if (pmCount > 0)
-        nextIndex = (nextIndex + 1) % pmCount;
-    }
-
-    cerr << "DEC::nextPMToACK(): Couldn't find a PM to ACK! ";
-
-    for (int i = pmCount - 1; i >= 0; --i)
-      cerr << mqe->unackedWork[i] << " ";
-
-    cerr << " max: " << maxAck;
-    cerr << endl;
-    // make sure the returned vars are legitimate
-    *sockIndex = nextIndex;
-    *numToAck = maxAck / pmCount;
-
-    if (pmCount > 0)
-      nextIndex = (nextIndex + 1) % pmCount;
+    std::lock_guard lk(fMlock);
+    auto it = fSessionMessages.find(uniqueID);
 
-    return;
+    if (it != fSessionMessages.end())
+      mqe = it->second;
   }
-}
-
-void DistributedEngineComm::setFlowControl(bool enabled, uint32_t uniqueID, boost::shared_ptr<MQE> mqe)
-{
-  mqe->throttled = enabled;
-  SBS msg(new ByteStream(sizeof(ISMPacketHeader)));
-  ISMPacketHeader* ism = (ISMPacketHeader*)msg->getInputPtr();
 
-  ism->Interleave = uniqueID;
-  ism->Command = BATCH_PRIMITIVE_ACK;
-  ism->Size = (enabled ? 0 : -1);
-
-  msg->advanceInputPtr(sizeof(ISMPacketHeader));
-
-  for (uint32_t i = 0; i < mqe->pmCount; ++i)
-  {
-    if (i == localConnectionId_ && fIsExeMgr)
-    {
-      continue;
-    }
-    writeToClient(i, msg);
-  }
-  if (needToSendToLocalPM(fIsExeMgr, localConnectionId_))
-  {
-    writeToClient(localConnectionId_, msg);
-  }
+  if (mqe && mqe->sendACKs)
+    createMsg << mqe->credits.initialMsgCredits() << mqe->credits.initialByteCredits();
+  else
+    createMsg << std::numeric_limits<uint32_t>::max() << (int64_t)0;  // no flow control
 }
 
 int32_t DistributedEngineComm::write(uint32_t senderID, const SBS& msg)
@@ -887,8 +702,7 @@ int32_t DistributedEngineComm::write(uint32_t senderID, const SBS& msg)
     switch (ism->Command)
     {
       case BATCH_PRIMITIVE_CREATE:
-        /* Disable flow control initially */
-        *msg << (uint32_t)-1;
+        appendInitialCredits(senderID, *msg);
         /* FALLTHRU */
 
       case BATCH_PRIMITIVE_DESTROY:
@@ -997,69 +811,30 @@ void DistributedEngineComm::addDataToOutput(SBS sbs, uint32_t connIndex, Stats*
   auto mqe = map_tok->second;
   lk.unlock();
 
-  if (pmCount > 0)
-  {
-    (void)atomicops::atomicInc(&mqe->unackedWork[connIndex % pmCount]);
-  }
-
-  TSQSize_t queueSize = mqe->queue.push(sbs);
-
-  if (mqe->sendACKs)
+  // Account the message before the consumer can see it.
+  if (mqe->sendACKs && pmCount > 0)
   {
     std::lock_guard lk(ackLock);
-    uint64_t msgSize = sbs->lengthWithHdrOverhead();
-
-    if (!mqe->throttled && msgSize > (flowControlEnableBytesThresh / 2))
-      doHasBigMsgs(
-          mqe, (bigMessageSize > 3 * msgSize ? bigMessageSize : 3 * msgSize));  // buffer at least 3 big msgs
-
-    if (!mqe->throttled && queueSize.size >= mqe->targetQueueSize)
-      setFlowControl(true, uniqueId, mqe);
+    mqe->credits.received(connIndex % pmCount, sbs->lengthWithHdrOverhead());
   }
 
+  mqe->queue.push(sbs);
+
   if (stats)
     mqe->stats.dataRecvd(stats->dataRecvd());
 }
 
-void DistributedEngineComm::doHasBigMsgs(boost::shared_ptr<MQE> mqe, uint64_t targetSize)
-{
-  mqe->hasBigMsgs = true;
-
-  if (mqe->targetQueueSize < targetSize)
-    mqe->targetQueueSize = targetSize;
-}
-
 DistributedEngineComm::SBSVector& DistributedEngineComm::readLocalQueueMessagesOrWait(
     SBSVector& receivedMessages)
 {
-  for (;;)
-  {
-    std::unique_lock<std::mutex> exchangeLock(inMemoryEM2PPExchMutex_);
-    if (inMemoryEM2PPExchQueue_.empty())
-    {
-      inMemoryEM2PPExchCV_.wait(exchangeLock);
-      continue;
-    }
-
-    // Batch processing to reduce the crit section
-    while (!inMemoryEM2PPExchQueue_.empty())
-    {
-      receivedMessages.push_back(inMemoryEM2PPExchQueue_.front());
-      inMemoryEM2PPExchQueue_.pop();
-    }
-    exchangeLock.unlock();
-    break;
-  }
-
+  // Takes all the messages available at once to reduce the number of wakeups.
+  inMemoryEM2PPExchRing_.popAll(receivedMessages);
   return receivedMessages;
 }
 
 void DistributedEngineComm::pushToTheLocalQueueAndNotifyRecv(const messageqcpp::SBS& bs)
 {
-  std::unique_lock<std::mutex> exchangeLock(inMemoryEM2PPExchMutex_);
-  inMemoryEM2PPExchQueue_.push(bs);
-  exchangeLock.unlock();
-  inMemoryEM2PPExchCV_.notify_one();
+  inMemoryEM2PPExchRing_.push(bs);
 }
 
 // This routine has an unexpected side-effect on its argument's SBS, namely
@@ -1121,7 +896,6 @@ int DistributedEngineComm::writeToClient(size_t aPMIndex, const SBS& bs, uint32_
     for (map_tok = fSessionMessages.begin(); map_tok != fSessionMessages.end(); ++map_tok)
     {
       map_tok->second->queue.clear();
-      (void)atomicops::atomicInc(&map_tok->second->unackedWork[0]);
       map_tok->second->queue.push(sbs);
     }
 
@@ -1232,12 +1006,10 @@ Stats DistributedEngineComm::getNetworkStats(uint32_t uniqueID)
 }
 
 DistributedEngineComm::MQE::MQE(const uint32_t pCount, const uint32_t initialInterleaverValue,
-                                const uint64_t flowControlEnableBytesThresh)
- : ackSocketIndex(0), pmCount(pCount), hasBigMsgs(false), targetQueueSize(flowControlEnableBytesThresh)
+                                const FlowControlCredits& flowControlCredits)
+ : pmCount(pCount), credits(flowControlCredits)
 {
-  unackedWork.reset(new volatile uint32_t[pmCount]);
   interleaver.reset(new uint32_t[pmCount]);
-  memset((void*)unackedWork.get(), 0, pmCount * sizeof(uint32_t));
   uint32_t interleaverValue = initialInterleaverValue;
   initialConnectionId = initialInterleaverValue;
   for (size_t pmId = 0; pmId < pmCount; ++pmId)
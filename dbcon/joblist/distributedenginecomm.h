@@ -50,6 +50,8 @@
 #include "rwlock_local.h"
 #include "resourcemanager.h"
 #include "messagequeue.h"
+#include "mpscring.h"
+#include "flowcontrolcredits.h"
 
 class TestDistributedEngineComm;
 
@@ -238,29 +240,20 @@ class DistributedEngineComm
   /* To keep some state associated with the connection.  These aren't copyable. */
   struct MQE : public boost::noncopyable
   {
-    MQE(const uint32_t pmCount, const uint32_t initialInterleaverValue, const uint64_t recvQueueSize);
+    MQE(const uint32_t pmCount, const uint32_t initialInterleaverValue, const FlowControlCredits& credits);
     uint32_t getNextConnectionId(const size_t pmIndex, const size_t pmConnectionsNumber,
                                  const uint32_t DECConnectionsPerQuery);
     messageqcpp::Stats stats;
     StepMsgQueue queue;
-    uint32_t ackSocketIndex;
-    boost::scoped_array<volatile uint32_t> unackedWork;
     boost::scoped_array<uint32_t> interleaver;
     uint32_t initialConnectionId;
     uint32_t pmCount;
     // non-BPP primitives don't do ACKs
     bool sendACKs;
 
-    // This var will allow us to toggle flow control for BPP instances when
-    // the UM is keeping up.  Send -1 as the ACK value to disable flow control
-    // on the PM side, positive value to reenable it.  Not yet impl'd on the UM side.
-    bool throttled;
-
-    // This var signifies that the PM can return msgs big enough to keep toggling
-    // FC on and off.  We force FC on in that case and maintain a larger buffer.
-    bool hasBigMsgs;
-
-    uint64_t targetQueueSize;
+    // The credits the PMs are given to send BPP results, see FlowControlCredits.
+    // Guarded by ackLock.
+    FlowControlCredits credits;
   };
 
   // The mapping of session ids to StepMsgQueueLists
@@ -305,26 +298,26 @@ class DistributedEngineComm
 
   bool fIsExeMgr;
 
-  // send-side throttling vars
-  uint64_t flowControlEnableBytesThresh = 50000000;
-  uint64_t flowControlDisableBytesThresh = 10000000;
-  uint64_t bigMessageSize = 300 * 1024 * 1024;
+  // flow control credits per query
+  uint64_t flowControlByteCredits = defaultFlowControlByteCredits;
+  uint64_t flowControlMaxByteCredits = defaultFlowControlMaxByteCredits;
+  uint32_t flowControlMsgCredits = defaultFlowControlMsgCredits;
+  uint32_t flowControlMaxMsgCredits = defaultFlowControlMaxMsgCredits;
   uint32_t tbpsThreadCount;
   uint32_t fDECConnectionsPerQuery;
 
-  void sendAcks(uint32_t uniqueID, const std::vector<messageqcpp::SBS>& msgs, boost::shared_ptr<MQE> mqe,
-                size_t qSize);
-  void nextPMToACK(boost::shared_ptr<MQE> mqe, uint32_t maxAck, uint32_t* sockIndex, uint16_t* numToAck);
-  void setFlowControl(bool enable, uint32_t uniqueID, boost::shared_ptr<MQE> mqe);
-  void doHasBigMsgs(boost::shared_ptr<MQE> mqe, uint64_t targetSize);
+  void returnCredits(uint32_t uniqueID, const std::vector<messageqcpp::SBS>& msgs,
+                     boost::shared_ptr<MQE> mqe, size_t queueSize);
+  void appendInitialCredits(uint32_t uniqueID, messageqcpp::ByteStream& createMsg);
   boost::mutex ackLock;
 
   // localConnectionId_ is set running Setup() method
   uint32_t localConnectionId_ = defaultLocalConnectionId();
   std::vector<struct in_addr> localNetIfaceSins_;
-  std::mutex inMemoryEM2PPExchMutex_;
-  std::condition_variable inMemoryEM2PPExchCV_;
-  std::queue<messageqcpp::SBS> inMemoryEM2PPExchQueue_;
+  // EM to PP exchange at the same host. Many EM threads push, PPSHServerThr is the only reader.
+  // Pushes past the ring size go to its unbounded overflow queue, senders never wait for PP.
+  static constexpr size_t inMemoryEM2PPExchRingSize = 64 * 1024;
+  utils::MPSCRing<messageqcpp::SBS> inMemoryEM2PPExchRing_{inMemoryEM2PPExchRingSize};
 };
 
 }  // namespace joblist
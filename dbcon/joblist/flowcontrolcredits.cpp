@@ -0,0 +1,163 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <algorithm>
+
+#include "flowcontrolcredits.h"
+
+namespace
+{
+bool anyOutOfCredits(const std::vector<int64_t>& credits)
+{
+  return std::any_of(credits.begin(), credits.end(), [](int64_t c) { return c <= 0; });
+}
+}  // namespace
+
+namespace joblist
+{
+FlowControlCredits::FlowControlCredits(uint32_t pmCount, uint64_t byteBudget, uint64_t maxByteBudget,
+                                       uint32_t msgBudget, uint32_t maxMsgBudget)
+ : pmCount_(std::max(pmCount, 1U))
+ , byteBudget_(byteBudget)
+ , maxByteBudget_(std::max(maxByteBudget, byteBudget))
+ , msgBudget_(msgBudget)
+ , maxMsgBudget_(std::max(maxMsgBudget, msgBudget))
+ , initialMsgsPerPM_(std::max(msgBudget / pmCount_, 1U))
+ , initialBytesPerPM_(std::max<int64_t>(byteBudget / pmCount_, 1))
+ , msgCredits_(pmCount_, initialMsgsPerPM_)
+ , byteCredits_(pmCount_, initialBytesPerPM_)
+ , heldMsgs_(pmCount_, 0)
+ , heldBytes_(pmCount_, 0)
+ , pendingMsgs_(pmCount_, 0)
+ , pendingBytes_(pmCount_, 0)
+{
+}
+
+void FlowControlCredits::received(uint32_t pmIndex, uint64_t bytes)
+{
+  pmIndex %= pmCount_;
+  --msgCredits_[pmIndex];
+  byteCredits_[pmIndex] -= bytes;
+  ++heldMsgs_[pmIndex];
+  heldBytes_[pmIndex] += bytes;
+}
+
+FlowControlCredits::Grant& FlowControlCredits::grantFor(uint32_t pmIndex, std::vector<Grant>& grants,
+                                                        size_t firstGrant)
+{
+  for (size_t i = firstGrant; i < grants.size(); ++i)
+  {
+    if (grants[i].pmIndex == pmIndex)
+      return grants[i];
+  }
+
+  grants.push_back({pmIndex, 0, 0});
+  return grants.back();
+}
+
+void FlowControlCredits::consumed(uint32_t msgs, uint64_t bytes, uint64_t queueBytes,
+                                  std::vector<Grant>& grants)
+{
+  const size_t firstGrant = grants.size();
+  // The consumer has emptied the queue while some PM was waiting for credits.
+  const bool byteStarved = queueBytes == 0 && anyOutOfCredits(byteCredits_);
+  const bool msgStarved = queueBytes == 0 && anyOutOfCredits(msgCredits_);
+
+  // The messages in the queue don't remember their PM, so the credits go back round-robin
+  // to the PMs that have messages in the queue. Some PM may get back credits another PM
+  // has spent, but a drained queue always gives every PM its share back.
+  for (uint32_t i = 0, pm = nextPM_; i < pmCount_ && (msgs > 0 || bytes > 0);
+       ++i, pm = (pm + 1) % pmCount_)
+  {
+    uint64_t msgsBack = std::min<uint64_t>(heldMsgs_[pm], msgs);
+    uint64_t bytesBack = std::min(heldBytes_[pm], bytes);
+
+    if (msgsBack == 0 && bytesBack == 0)
+      continue;
+
+    heldMsgs_[pm] -= msgsBack;
+    heldBytes_[pm] -= bytesBack;
+    pendingMsgs_[pm] += msgsBack;
+    pendingBytes_[pm] += bytesBack;
+    msgs -= msgsBack;
+    bytes -= bytesBack;
+  }
+
+  nextPM_ = (nextPM_ + 1) % pmCount_;
+
+  // The credits go back in batches of half the share of a PM so there is an ACK per batch rather
+  // than per message, a drained queue returns them all.
+  const uint64_t msgBatch = std::max<uint64_t>(msgBudget_ / pmCount_ / 2, 1);
+  const uint64_t byteBatch = std::max<uint64_t>(byteBudget_ / pmCount_ / 2, 1);
+
+  for (uint32_t pm = 0; pm < pmCount_; ++pm)
+  {
+    if (pendingMsgs_[pm] == 0 && pendingBytes_[pm] == 0)
+      continue;
+
+    if (queueBytes != 0 && pendingMsgs_[pm] < msgBatch && pendingBytes_[pm] < byteBatch)
+      continue;
+
+    msgCredits_[pm] += pendingMsgs_[pm];
+    byteCredits_[pm] += pendingBytes_[pm];
+
+    Grant& grant = grantFor(pm, grants, firstGrant);
+    grant.msgs += pendingMsgs_[pm];
+    grant.bytes += pendingBytes_[pm];
+    pendingMsgs_[pm] = 0;
+    pendingBytes_[pm] = 0;
+  }
+
+  if (byteStarved || msgStarved)
+    grow(grants, firstGrant, byteStarved, msgStarved);
+}
+
+void FlowControlCredits::grow(std::vector<Grant>& grants, size_t firstGrant, bool byteStarved,
+                              bool msgStarved)
+{
+  uint64_t extraBytesPerPM = 0;
+  uint32_t extraMsgsPerPM = 0;
+
+  if (byteStarved)
+    extraBytesPerPM = std::min(byteBudget_, maxByteBudget_ - byteBudget_) / pmCount_;
+
+  if (msgStarved)
+    extraMsgsPerPM = std::min(msgBudget_, maxMsgBudget_ - msgBudget_) / pmCount_;
+
+  if (extraBytesPerPM == 0 && extraMsgsPerPM == 0)
+    return;
+
+  byteBudget_ += extraBytesPerPM * pmCount_;
+  msgBudget_ += extraMsgsPerPM * pmCount_;
+
+  for (uint32_t pm = 0; pm < pmCount_; ++pm)
+  {
+    byteCredits_[pm] += extraBytesPerPM;
+    msgCredits_[pm] += extraMsgsPerPM;
+
+    Grant& grant = grantFor(pm, grants, firstGrant);
+    grant.msgs += extraMsgsPerPM;
+    grant.bytes += extraBytesPerPM;
+  }
+}
+
+bool FlowControlCredits::exhausted() const
+{
+  return anyOutOfCredits(msgCredits_) || anyOutOfCredits(byteCredits_);
+}
+
+}  // namespace joblist
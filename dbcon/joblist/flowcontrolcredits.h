@@ -0,0 +1,107 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace joblist
+{
+/** @brief Credit accounting for the BPP results flow control.
+ *
+ * Every PM may send BPP results for a query as long as it has both message and byte
+ * credits left; a message may overdraw the byte credits so a message bigger than
+ * the whole budget still goes through. The credits of a message come back to the PM
+ * when the consumer takes the message out of the DEC queue, so the data buffered on
+ * the UM for a query stays within the budget. They are sent back in batches of half the
+ * share of a PM, or all of them when the consumer drains the queue.
+ *
+ * The budget starts at the configured size and is doubled up to the maximum when the
+ * consumer drains the queue while a PM is out of credits, that is when the budget and
+ * not the PM or the consumer is the bottleneck.
+ *
+ * This class is not thread-safe, DEC calls it holding its ackLock.
+ */
+class FlowControlCredits
+{
+ public:
+  struct Grant
+  {
+    uint32_t pmIndex;
+    uint32_t msgs;
+    int64_t bytes;
+  };
+
+  FlowControlCredits(uint32_t pmCount, uint64_t byteBudget, uint64_t maxByteBudget, uint32_t msgBudget,
+                     uint32_t maxMsgBudget);
+
+  // The credits every PM starts with
+  uint32_t initialMsgCredits() const
+  {
+    return initialMsgsPerPM_;
+  }
+  int64_t initialByteCredits() const
+  {
+    return initialBytesPerPM_;
+  }
+
+  // A message of `bytes` from `pmIndex` was put into the queue.
+  void received(uint32_t pmIndex, uint64_t bytes);
+
+  // The consumer took `msgs` messages of `bytes` total out of the queue leaving `queueBytes`
+  // in it. Appends the credits to return to the PMs to `grants`, if there are enough of them.
+  void consumed(uint32_t msgs, uint64_t bytes, uint64_t queueBytes, std::vector<Grant>& grants);
+
+  // True if some PM has to wait for credits.
+  bool exhausted() const;
+
+  uint64_t byteBudget() const
+  {
+    return byteBudget_;
+  }
+  uint32_t msgBudget() const
+  {
+    return msgBudget_;
+  }
+
+ private:
+  void grow(std::vector<Grant>& grants, size_t firstGrant, bool byteStarved, bool msgStarved);
+  Grant& grantFor(uint32_t pmIndex, std::vector<Grant>& grants, size_t firstGrant);
+
+  uint32_t pmCount_;
+  uint64_t byteBudget_;
+  uint64_t maxByteBudget_;
+  uint32_t msgBudget_;
+  uint32_t maxMsgBudget_;
+  uint32_t initialMsgsPerPM_;
+  int64_t initialBytesPerPM_;
+
+  // The credits a PM has left as far as the UM knows
+  std::vector<int64_t> msgCredits_;
+  std::vector<int64_t> byteCredits_;
+  // The messages received from a PM that are still in the queue
+  std::vector<uint64_t> heldMsgs_;
+  std::vector<uint64_t> heldBytes_;
+  // The credits of the messages consumed that are not sent back yet
+  std::vector<uint64_t> pendingMsgs_;
+  std::vector<uint64_t> pendingBytes_;
+  uint32_t nextPM_ = 0;
+};
+
+}  // namespace joblist
@@ -319,6 +319,52 @@ void updateExp2Cols(JobStepVector& expSteps, TableInfoMap& tableInfoMap, JobInfo
   }
 }
 
+// ORDER BY ... LIMIT over a single table scan: PrimProc keeps the first rows of every job, so
+// the annex step sorts limit rows per job instead of all the rows of the table.
+void pushDownTopN(TupleDeliveryStep* ds, const RowGroup& rg, const JobInfo& jobInfo)
+{
+  TupleBPS* bps = dynamic_cast<TupleBPS*>(ds);
+
+  if (bps == NULL || jobInfo.orderByColVec.empty() || jobInfo.hasDistinct ||
+      jobInfo.limitCount > rowgroup::rgCommonSize || jobInfo.limitStart > rowgroup::rgCommonSize)
+    return;
+
+  uint64_t limit = jobInfo.limitStart + jobInfo.limitCount;
+
+  if (limit == 0 || limit > rowgroup::rgCommonSize)
+    return;
+
+  const vector<uint32_t>& keys = rg.getKeys();
+  vector<ordering::IdbSortSpec> spec;
+
+  for (const auto& orderBy : jobInfo.orderByColVec)
+  {
+    // the first column of the key, same as LimitedOrderBy
+    vector<uint32_t>::const_iterator key = find(keys.begin(), keys.end(), orderBy.first);
+
+    if (key == keys.end())
+      return;
+
+    spec.push_back(ordering::IdbSortSpec(key - keys.begin(), orderBy.second));
+  }
+
+  bps->setTopN(spec, limit);
+}
+
+// LIMIT without ORDER BY over a single table scan: any limit rows will do, so PrimProc stops
+// reading the blocks of a job once the job has found them and the scan stops once they arrived.
+void pushDownLimit(TupleDeliveryStep* ds, const JobInfo& jobInfo)
+{
+  TupleBPS* bps = dynamic_cast<TupleBPS*>(ds);
+
+  if (bps == NULL || !jobInfo.orderByColVec.empty() || jobInfo.hasDistinct ||
+      jobInfo.limitCount == 0 || jobInfo.limitCount == (uint64_t)-1 ||
+      jobInfo.limitStart > numeric_limits<uint64_t>::max() - jobInfo.limitCount)
+    return;
+
+  bps->setLimit(jobInfo.limitStart + jobInfo.limitCount);
+}
+
 void adjustLastStep(JobStepVector& querySteps, DeliveredTableMap& deliverySteps, JobInfo& jobInfo)
 {
   SJSTEP spjs = querySteps.back();
@@ -558,6 +604,8 @@ void adjustLastStep(JobStepVector& querySteps, DeliveredTableMap& deliverySteps,
 
     querySteps.push_back(jobInfo.annexStep);
     dynamic_cast<TupleAnnexStep*>(jobInfo.annexStep.get())->initialize(rg2, jobInfo);
+    pushDownTopN(ds, rg2, jobInfo);
+    pushDownLimit(ds, jobInfo);
     deliverySteps[CNX_VTABLE_ID] = jobInfo.annexStep;
   }
 
@@ -691,6 +691,44 @@ void TupleJobList::abort()
   }
 }
 
+uint64_t TupleJobList::estimateMemory()
+{
+  bool hashJoin = false;
+  bool sort = false;
+
+  for (auto& step : fQuery)
+  {
+    if (dynamic_cast<TupleHashJoinStep*>(step.get()))
+      hashJoin = true;
+
+    auto* annex = dynamic_cast<TupleAnnexStep*>(step.get());
+
+    if (annex && annex->hasOrderBy() && annex->getLimitCount() == (uint64_t)-1)
+      sort = true;
+  }
+
+  if (!hashJoin && !sort)
+    return 0;
+
+  // The largest table is the streamed large side of the joins and the input of the sort.
+  uint64_t largest = 0;
+  uint64_t total = 0;
+
+  for (auto& step : fQuery)
+  {
+    auto* bps = dynamic_cast<TupleBPS*>(step.get());
+
+    if (!bps)
+      continue;
+
+    uint64_t bytes = bps->getEstimatedRowCount() * bps->getOutputRowGroup().getRowSize();
+    largest = std::max(largest, bytes);
+    total += bytes;
+  }
+
+  return (hashJoin ? total - largest : 0) + (sort ? largest : 0);
+}
+
 }  // namespace joblist
 
 #ifdef __clang__
@@ -233,6 +233,15 @@ class TupleJobList : public JobList
   void setDeliveryFlag(bool f);
   void abort() override;
 
+  /** Estimates the memory the query holds at its peak, for the admission control
+   *
+   * Only the state that grows with the input is counted: the small sides of the hash joins
+   * and the rows an ORDER BY without a LIMIT sorts. Scans and the large side of the joins
+   * stream, aggregations are left to the per-query memory accounting as the number of groups
+   * isn't known before the query runs.
+   */
+  EXPORT uint64_t estimateMemory();
+
   /** Does some light validation on the final joblist
    *
    * Currently verifies that JobSteps are all tuple-oriented, that
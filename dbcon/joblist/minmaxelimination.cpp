@@ -0,0 +1,147 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <algorithm>
+
+#include "minmaxelimination.h"
+
+using namespace execplan;
+
+namespace joblist
+{
+MinMaxElimination::MinMaxElimination(const rowgroup::RowGroup& partials) : partials_(partials)
+{
+  partials_.initRow(&row_);
+}
+
+bool MinMaxElimination::supported(const CalpontSystemCatalog::ColType& colType)
+{
+  if (colType.colWidth > 8)
+    return false;
+
+  switch (colType.colDataType)
+  {
+    case CalpontSystemCatalog::TINYINT:
+    case CalpontSystemCatalog::SMALLINT:
+    case CalpontSystemCatalog::MEDINT:
+    case CalpontSystemCatalog::INT:
+    case CalpontSystemCatalog::BIGINT:
+    case CalpontSystemCatalog::DECIMAL:
+    case CalpontSystemCatalog::DATE:
+    case CalpontSystemCatalog::DATETIME:
+    case CalpontSystemCatalog::TIMESTAMP:
+    case CalpontSystemCatalog::UTINYINT:
+    case CalpontSystemCatalog::USMALLINT:
+    case CalpontSystemCatalog::UDECIMAL:
+    case CalpontSystemCatalog::UMEDINT:
+    case CalpontSystemCatalog::UINT:
+    case CalpontSystemCatalog::UBIGINT: return true;
+
+    default: return false;
+  }
+}
+
+void MinMaxElimination::addAggregate(uint32_t column, bool isMax, bool isUnsigned,
+                                     const std::vector<BRM::EMEntry>& extents)
+{
+  Aggregate aggregate;
+  aggregate.column = column;
+  aggregate.isMax = isMax;
+  aggregate.isUnsigned = isUnsigned;
+  aggregate.ranges.reserve(extents.size());
+
+  for (const auto& extent : extents)
+  {
+    const BRM::EMCasualPartition_t& cprange = extent.partition.cprange;
+    aggregate.ranges.push_back({cprange.isValid == BRM::CP_VALID, cprange.loVal, cprange.hiVal});
+  }
+
+  aggregates_.push_back(aggregate);
+}
+
+void MinMaxElimination::order(std::vector<uint32_t>& extentOrder,
+                              const std::vector<BRM::EMEntry>& extents) const
+{
+  if (aggregates_.empty())
+    return;
+
+  const Aggregate& aggregate = aggregates_.front();
+
+  // The extents without a range may hold anything, scan them first
+  auto first = [&aggregate](uint32_t lhs, uint32_t rhs)
+  {
+    const Range& left = aggregate.ranges[lhs];
+    const Range& right = aggregate.ranges[rhs];
+
+    if (!left.valid || !right.valid)
+      return !left.valid && right.valid;
+
+    return better(aggregate, bound(aggregate, left), bound(aggregate, right));
+  };
+
+  for (auto begin = extentOrder.begin(); begin != extentOrder.end();)
+  {
+    const uint16_t dbRoot = extents[*begin].dbRoot;
+    auto end = std::find_if(begin, extentOrder.end(),
+                            [&extents, dbRoot](uint32_t i) { return extents[i].dbRoot != dbRoot; });
+    std::stable_sort(begin, end, first);
+    begin = end;
+  }
+}
+
+void MinMaxElimination::update(rowgroup::RGData& partials)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  partials_.setData(&partials);
+  partials_.getRow(0, &row_);
+
+  for (uint32_t i = 0; i < partials_.getRowCount(); ++i, row_.nextRow())
+  {
+    for (auto& aggregate : aggregates_)
+    {
+      // MIN and MAX of no rows
+      if (row_.isNullValue(aggregate.column))
+        continue;
+
+      int64_t value = aggregate.isUnsigned ? static_cast<int64_t>(row_.getUintField(aggregate.column))
+                                           : row_.getIntField(aggregate.column);
+
+      if (!aggregate.found || better(aggregate, value, aggregate.result))
+      {
+        aggregate.found = true;
+        aggregate.result = value;
+      }
+    }
+  }
+}
+
+bool MinMaxElimination::needed(uint32_t extentIndex) const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+
+  for (const auto& aggregate : aggregates_)
+  {
+    const Range& range = aggregate.ranges[extentIndex];
+
+    if (!aggregate.found || !range.valid || better(aggregate, bound(aggregate, range), aggregate.result))
+      return true;
+  }
+
+  return false;
+}
+
+}  // namespace joblist
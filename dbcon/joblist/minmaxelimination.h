@@ -0,0 +1,110 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "calpontsystemcatalog.h"
+#include "extentmap.h"
+#include "rowgroup.h"
+
+namespace joblist
+{
+/** @brief Skips the extents that can't change the MIN()/MAX() aggregated on PM.
+ *
+ * For a scan whose PM aggregation is only MIN and MAX without GROUP BY the CP range of
+ * an extent bounds what the extent can add to the result: an extent whose lower bound is
+ * not below the MIN found so far can't lower it, the same goes for MAX and the upper bound.
+ * The extents are sent in the order of their bounds so the first jobs find the result and
+ * the rest of the extents are skipped as the partial results come back from PM.
+ *
+ * The CP ranges are only bounds, DML widens them and DELETE doesn't narrow them, and
+ * ExtentMap doesn't keep row counts, so the scan still reads the extents that may hold
+ * the result instead of answering from the ranges.
+ */
+class MinMaxElimination
+{
+ public:
+  // partials is the rowgroup of the PM aggregation results
+  explicit MinMaxElimination(const rowgroup::RowGroup& partials);
+
+  // The column types with CP ranges ordered as their values
+  static bool supported(const execplan::CalpontSystemCatalog::ColType& colType);
+
+  /** @brief Adds MIN or MAX of a column.
+   *
+   * @param column the column of the aggregate in the partials rowgroup
+   * @param extents the extents of the aggregated column in the order of the scanned ones
+   */
+  void addAggregate(uint32_t column, bool isMax, bool isUnsigned, const std::vector<BRM::EMEntry>& extents);
+  bool empty() const
+  {
+    return aggregates_.empty();
+  }
+
+  // Sorts the extents of every dbroot so that the ones holding the first aggregate go first
+  void order(std::vector<uint32_t>& extentOrder, const std::vector<BRM::EMEntry>& extents) const;
+
+  // Folds in the results of a PM job
+  void update(rowgroup::RGData& partials);
+
+  // False if the extent can't change any of the aggregates
+  bool needed(uint32_t extentIndex) const;
+
+ private:
+  struct Range
+  {
+    bool valid;
+    int64_t lo;
+    int64_t hi;
+  };
+
+  struct Aggregate
+  {
+    uint32_t column;
+    bool isMax;
+    bool isUnsigned;
+    std::vector<Range> ranges;
+    bool found = false;
+    int64_t result = 0;
+  };
+
+  static bool less(int64_t lhs, int64_t rhs, bool isUnsigned)
+  {
+    return isUnsigned ? static_cast<uint64_t>(lhs) < static_cast<uint64_t>(rhs) : lhs < rhs;
+  }
+  // The bound of the range that can change the aggregate
+  static int64_t bound(const Aggregate& aggregate, const Range& range)
+  {
+    return aggregate.isMax ? range.hi : range.lo;
+  }
+  // True if the value is better than the other one for the aggregate
+  static bool better(const Aggregate& aggregate, int64_t value, int64_t other)
+  {
+    return aggregate.isMax ? less(other, value, aggregate.isUnsigned) : less(value, other, aggregate.isUnsigned);
+  }
+
+  mutable std::mutex mutex_;
+  rowgroup::RowGroup partials_;
+  rowgroup::Row row_;
+  std::vector<Aggregate> aggregates_;
+};
+
+}  // namespace joblist
@@ -34,6 +34,8 @@
 #include <stdexcept>
 #include <sstream>
 #include <tr1/memory>
+#include <memory>
+#include <atomic>
 
 #include <boost/shared_ptr.hpp>
 
@@ -56,11 +58,14 @@
 #include "timestamp.h"
 #include "timeset.h"
 #include "resourcemanager.h"
+#include "sharedscans.h"
+#include "minmaxelimination.h"
 #include "joiner.h"
 #include "tuplejoiner.h"
 #include "rowgroup.h"
 #include "rowaggregation.h"
 #include "funcexpwrapper.h"
+#include "../../utils/windowfunction/idborderby.h"
 
 namespace joblist
 {
@@ -1103,6 +1108,12 @@ class TupleBPS : public BatchPrimitive, public TupleDeliveryStep
 
   void setAggregateStep(const rowgroup::SP_ROWAGG_PM_t& agg, const rowgroup::RowGroup& rg);
 
+  /* The Top-N of ORDER BY ... LIMIT over the delivered rowgroup, see run() for when PM uses it */
+  void setTopN(const std::vector<ordering::IdbSortSpec>& spec, uint32_t limit);
+
+  /* The LIMIT without ORDER BY over the delivered rowgroup, the scan stops once it has the rows */
+  void setLimit(uint64_t limit);
+
   /* This is called by TupleHashJoin only */
   void setJoinedResultRG(const rowgroup::RowGroup& rg);
 
@@ -1264,6 +1275,7 @@ class TupleBPS : public BatchPrimitive, public TupleDeliveryStep
   uint32_t fProcessorThreadsPerScan;  // The number of messages sent per logical extent.
   bool fSwallowRows;
   uint32_t fMaxOutstandingRequests;  // The number of logical extents have not processed by PrimProc
+  bool fSharedScan;                  // join the scans of the same column in progress, see SharedScans
   uint64_t fPhysicalIO;              // total physical I/O count
   uint64_t fCacheIO;                 // total cache I/O count
   uint64_t fNumBlksSkipped;          // total number of block scans skipped due to CP
@@ -1271,6 +1283,10 @@ class TupleBPS : public BatchPrimitive, public TupleDeliveryStep
   uint64_t fMsgBytesOut;             // total byte count for outcoming messages
   uint64_t fBlockTouched;            // total blocks touched
   uint32_t fExtentsPerSegFile;       // config num of Extents Per Segment File
+
+  // set when PM aggregates only MIN/MAX, skips the extents that can't change them
+  std::unique_ptr<MinMaxElimination> fMinMaxElimination;
+
   // uint64_t cThread;  //consumer thread. thread handle from thread pool
   uint64_t pThread;  // producer thread. thread handle from thread pool
   boost::mutex tplMutex;
@@ -1305,6 +1321,14 @@ class TupleBPS : public BatchPrimitive, public TupleDeliveryStep
   rowgroup::SP_ROWAGG_PM_t fAggregatorPm;
   rowgroup::RowGroup fAggRowGroupPm;
 
+  // Top-N support
+  std::vector<ordering::IdbSortSpec> fTopNSpec;
+  uint32_t fTopNLimit = 0;
+
+  // LIMIT support, the rows put in the output datalist so far
+  uint64_t fLimit = 0;
+  std::atomic<uint64_t> fLimitRows{0};
+
   // OR hacks
   uint8_t bop;  // BOP_AND or BOP_OR
 
@@ -1439,18 +1463,22 @@ class TupleBPS : public BatchPrimitive, public TupleDeliveryStep
   /* shared nothing support */
   struct Job
   {
-    Job(uint32_t d, uint32_t n, uint32_t b, boost::shared_ptr<messageqcpp::ByteStream>& bs)
-     : dbroot(d), connectionNum(n), expectedResponses(b), msg(bs)
+    Job(uint32_t d, uint32_t n, uint32_t b, boost::shared_ptr<messageqcpp::ByteStream>& bs,
+        BRM::LBID_t e = 0, uint32_t x = 0)
+     : dbroot(d), connectionNum(n), expectedResponses(b), msg(bs), extentStart(e), extentIndex(x)
     {
     }
     uint32_t dbroot;
     uint32_t connectionNum;
     uint32_t expectedResponses;
     boost::shared_ptr<messageqcpp::ByteStream> msg;
+    BRM::LBID_t extentStart;  // the first LBID of the extent the job scans
+    uint32_t extentIndex;     // the index of the extent in scannedExtents
   };
 
   void prepCasualPartitioning();
-  void makeJobs(std::vector<Job>* jobs);
+  void initMinMaxElimination();
+  void makeJobs(std::vector<Job>* jobs, const SharedScans::Positions& sharedScanPositions);
   void interleaveJobs(std::vector<Job>* jobs) const;
   void sendJobs(const std::vector<Job>& jobs);
   uint32_t numDBRoots;
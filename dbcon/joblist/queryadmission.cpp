@@ -0,0 +1,177 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <algorithm>
+
+#include "queryadmission.h"
+
+namespace joblist
+{
+QueryAdmission::Ticket::Ticket(Ticket&& rhs) noexcept : owner_(rhs.owner_), bytes_(rhs.bytes_)
+{
+  rhs.owner_ = nullptr;
+  rhs.bytes_ = 0;
+}
+
+QueryAdmission::Ticket& QueryAdmission::Ticket::operator=(Ticket&& rhs) noexcept
+{
+  if (this != &rhs)
+  {
+    release();
+    owner_ = rhs.owner_;
+    bytes_ = rhs.bytes_;
+    rhs.owner_ = nullptr;
+    rhs.bytes_ = 0;
+  }
+
+  return *this;
+}
+
+void QueryAdmission::Ticket::release()
+{
+  if (!owner_)
+    return;
+
+  owner_->release(bytes_);
+  owner_ = nullptr;
+  bytes_ = 0;
+}
+
+QueryAdmission::QueryAdmission(uint64_t budget, uint64_t minQueryMemory)
+ : budget_(std::max<uint64_t>(budget, 1)), minQueryMemory_(std::min(minQueryMemory, budget_))
+{
+}
+
+bool QueryAdmission::admit(uint64_t bytes, Priority priority, Ticket& ticket,
+                           const std::function<bool()>& cancelled)
+{
+  // A self-join re-admits the session while its ticket is held
+  ticket.release();
+  bytes = std::clamp(bytes, minQueryMemory_, budget_);
+
+  Waiter waiter{bytes, false, {}};
+  std::unique_lock<std::mutex> lk(mutex_);
+  queues_[priority].push_back(&waiter);
+  admitWaiters();
+
+  if (!waiter.admitted)
+  {
+    auto start = Clock::now();
+
+    if (!cancelled)
+      waiter.cv.wait(lk, [&waiter]() { return waiter.admitted; });
+
+    while (!waiter.admitted)
+    {
+      if (waiter.cv.wait_for(lk, CancelPollInterval, [&waiter]() { return waiter.admitted; }))
+        break;
+
+      lk.unlock();
+      bool stop = cancelled();
+      lk.lock();
+
+      if (stop && !waiter.admitted)
+      {
+        auto& queue = queues_[priority];
+        queue.erase(std::find(queue.begin(), queue.end(), &waiter));
+        // The queries queued behind this one may fit now
+        admitWaiters();
+        return false;
+      }
+    }
+
+    uint64_t waitMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+    ++waited_;
+    totalWaitMs_ += waitMs;
+    maxWaitMs_ = std::max(maxWaitMs_, waitMs);
+  }
+
+  ++admitted_;
+  ticket.owner_ = this;
+  ticket.bytes_ = bytes;
+  return true;
+}
+
+bool QueryAdmission::fits(uint64_t bytes) const
+{
+  return running_ == 0 || reserved_ + bytes <= budget_;
+}
+
+void QueryAdmission::reserve(uint64_t bytes)
+{
+  reserved_ += bytes;
+  ++running_;
+}
+
+void QueryAdmission::release(uint64_t bytes)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  reserved_ -= bytes;
+  --running_;
+  admitWaiters();
+}
+
+// Admits the heads of the queues, higher classes first, for as long as they fit.
+void QueryAdmission::admitWaiters()
+{
+  for (auto& queue : queues_)
+  {
+    while (!queue.empty())
+    {
+      Waiter* waiter = queue.front();
+
+      if (!fits(waiter->bytes))
+        return;
+
+      queue.pop_front();
+      reserve(waiter->bytes);
+      waiter->admitted = true;
+      waiter->cv.notify_one();
+    }
+  }
+}
+
+QueryAdmission::Stats QueryAdmission::stats() const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  Stats stats;
+  stats.budget = budget_;
+  stats.reserved = reserved_;
+  stats.running = running_;
+
+  for (uint32_t i = 0; i < PRIORITY_CLASSES; ++i)
+    stats.queued[i] = queues_[i].size();
+
+  stats.admitted = admitted_;
+  stats.waited = waited_;
+  stats.totalWaitMs = totalWaitMs_;
+  stats.maxWaitMs = maxWaitMs_;
+  return stats;
+}
+
+QueryAdmission::Priority QueryAdmission::priorityClass(uint32_t priorityLevel)
+{
+  if (priorityLevel > 66)
+    return HIGH_PRIORITY;
+
+  if (priorityLevel > 33)
+    return MEDIUM_PRIORITY;
+
+  return LOW_PRIORITY;
+}
+
+}  // namespace joblist
@@ -0,0 +1,146 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace joblist
+{
+/** @brief Memory-aware admission of queries into ExeMgr.
+ *
+ * ExecQueueSize only bounds the number of running statements, so a few queries with big
+ * hash joins or sorts can still overcommit TotalUmMemory and fail or spill together.
+ * Before it starts, a query reserves its estimated memory from a global budget. When the
+ * budget can't cover the estimate the query waits in the queue of its priority class.
+ * As reservations are returned the waiting queries are admitted in order: the higher
+ * classes first, first come first served within a class. A query never overtakes the
+ * head of the queues, so a big query is not starved by a stream of small ones.
+ *
+ * The estimate is clamped between the per-query minimum and the whole budget. A query
+ * is always admitted when nothing else is reserved, so a bad estimate only serializes
+ * queries and never blocks them.
+ */
+class QueryAdmission
+{
+ public:
+  enum Priority
+  {
+    HIGH_PRIORITY = 0,
+    MEDIUM_PRIORITY,
+    LOW_PRIORITY,
+    PRIORITY_CLASSES
+  };
+
+  /** @brief The memory reserved by an admitted query.
+   *
+   * Returns the reservation when it is destroyed, so it should live as long as the job
+   * list of the query does.
+   */
+  class Ticket
+  {
+   public:
+    Ticket() = default;
+    Ticket(Ticket&& rhs) noexcept;
+    Ticket& operator=(Ticket&& rhs) noexcept;
+    Ticket(const Ticket&) = delete;
+    Ticket& operator=(const Ticket&) = delete;
+    ~Ticket()
+    {
+      release();
+    }
+
+    void release();
+    uint64_t bytes() const
+    {
+      return bytes_;
+    }
+
+   private:
+    friend class QueryAdmission;
+
+    QueryAdmission* owner_ = nullptr;
+    uint64_t bytes_ = 0;
+  };
+
+  struct Stats
+  {
+    uint64_t budget;
+    uint64_t reserved;
+    uint32_t running;
+    uint32_t queued[PRIORITY_CLASSES];
+    uint64_t admitted;     // queries admitted since the start
+    uint64_t waited;       // the admitted queries that had to wait
+    uint64_t totalWaitMs;  // time the admitted queries spent waiting
+    uint64_t maxWaitMs;
+  };
+
+  QueryAdmission(uint64_t budget, uint64_t minQueryMemory);
+
+  /** @brief Waits until the query may run and reserves its memory.
+   *
+   * @param bytes the estimated memory of the query
+   * @param priority the class the query waits in
+   * @param ticket receives the reservation. What it held before is returned first.
+   * @param cancelled polled every CancelPollInterval while the query waits. The query
+   *        leaves the queue when it returns true.
+   * @return false if the wait was cancelled, the ticket is empty then
+   */
+  bool admit(uint64_t bytes, Priority priority, Ticket& ticket,
+             const std::function<bool()>& cancelled = std::function<bool()>());
+
+  Stats stats() const;
+
+  // Maps a user priority level (querystats LOW/MEDIUM/HIGH = 33/66/100) to a class.
+  static Priority priorityClass(uint32_t priorityLevel);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr std::chrono::milliseconds CancelPollInterval{100};
+
+  struct Waiter
+  {
+    uint64_t bytes;
+    bool admitted;
+    std::condition_variable cv;
+  };
+
+  bool fits(uint64_t bytes) const;
+  void reserve(uint64_t bytes);
+  void release(uint64_t bytes);
+  void admitWaiters();
+
+  const uint64_t budget_;
+  const uint64_t minQueryMemory_;
+
+  mutable std::mutex mutex_;
+  std::deque<Waiter*> queues_[PRIORITY_CLASSES];
+  uint64_t reserved_ = 0;
+  uint32_t running_ = 0;
+  uint64_t admitted_ = 0;
+  uint64_t waited_ = 0;
+  uint64_t totalWaitMs_ = 0;
+  uint64_t maxWaitMs_ = 0;
+};
+
+}  // namespace joblist
@@ -65,6 +65,8 @@ const uint32_t defaultRequestSize = 1;
 const uint32_t defaultMaxOutstandingRequests = 20;
 const uint32_t defaultProcessorThreadsPerScan = 16;
 const uint32_t defaultJoinerChunkSize = 16 * 1024 * 1024;
+const bool defaultColumnarRowGroupTransfer = false;
+const bool defaultSharedScans = false;
 
 // I estimate that the average non-cloud columnstore node has 64GB. I've seen from 16GB to 256GB. Cloud can be
 // as low as 4GB However, ExeMgr has a targetRecvQueueSize hardcoded to 50,000,000, so some number greater
@@ -85,6 +87,9 @@ const int defaultEMSecondsBetweenMemChecks = 1;
 const int defaultEMMaxPct = 95;
 const int defaultEMPriority = 21;  // @Bug 3385
 const int defaultEMExecQueueSize = 20;
+const bool defaultEMAdmissionControl = false;
+const uint32_t defaultEMAdmissionMemoryPct = 80;
+const uint64_t defaultEMAdmissionMinQueryMemory = 16 * 1024 * 1024ULL;
 
 const int defaultPSCount = 0;
 const int defaultConnectionsPerPrimProc = 1;
@@ -102,9 +107,11 @@ const uint64_t defaultRowsPerBatch = 10000;
 /* HJ CP feedback, see bug #1465 */
 const uint32_t defaultHjCPUniqueLimit = 100;
 
-const constexpr uint64_t defaultFlowControlEnableBytesThresh = 50000000;   // ~50Mb
-const constexpr uint64_t defaultFlowControlDisableBytesThresh = 10000000;  // ~10 MB
-const constexpr uint64_t defaultBPPSendThreadBytesThresh = 250000000;      // ~250 MB
+const constexpr uint64_t defaultFlowControlByteCredits = 50000000;      // ~50 MB
+const constexpr uint64_t defaultFlowControlMaxByteCredits = 500000000;  // ~500 MB
+const constexpr uint32_t defaultFlowControlMsgCredits = 256;
+const constexpr uint32_t defaultFlowControlMaxMsgCredits = 4096;
+const constexpr uint64_t defaultBPPSendThreadBytesThresh = 250000000;  // ~250 MB
 const constexpr uint64_t BPPSendThreadMsgThresh = 100;
 
 const bool defaultAllowDiskAggregation = false;
@@ -155,6 +162,19 @@ class ResourceManager
   {
     return getIntVal(fExeMgrStr, "ExecQueueSize", defaultEMExecQueueSize);
   }
+  bool getEmAdmissionControl() const
+  {
+    return getBoolVal(fExeMgrStr, "AdmissionControl", defaultEMAdmissionControl);
+  }
+  // The share of TotalUmMemory the admitted queries may reserve
+  uint32_t getEmAdmissionMemoryPct() const
+  {
+    return getUintVal(fExeMgrStr, "AdmissionMemoryPct", defaultEMAdmissionMemoryPct);
+  }
+  uint64_t getEmAdmissionMinQueryMemory() const
+  {
+    return getUintVal(fExeMgrStr, "AdmissionMinQueryMemory", defaultEMAdmissionMinQueryMemory);
+  }
 
   bool getAllowDiskAggregation() const
   {
@@ -243,6 +263,15 @@ class ResourceManager
     return getUintVal(fJobListStr, "JoinerChunkSize", defaultJoinerChunkSize);
   }
 
+  bool getJlColumnarRowGroupTransfer() const
+  {
+    return getBoolVal(fJobListStr, "ColumnarRowGroupTransfer", defaultColumnarRowGroupTransfer);
+  }
+  bool getJlSharedScans() const
+  {
+    return getBoolVal(fJobListStr, "SharedScans", defaultSharedScans);
+  }
+
   int getPsCount() const
   {
     return getUintVal(fPrimitiveServersStr, "Count", defaultPSCount);
@@ -284,16 +313,25 @@ class ResourceManager
     return getUintVal(fBatchInsertStr, "RowsPerBatch", defaultRowsPerBatch);
   }
 
-  uint64_t getDECEnableBytesThresh() const
+  // The results of a BPP query buffered in DEC are limited to these credits split between PMs.
+  uint64_t getDECFlowControlByteCredits() const
+  {
+    return getUintVal(FlowControlStr, "DECFlowControlByteCredits", defaultFlowControlByteCredits);
+  }
+
+  uint64_t getDECFlowControlMaxByteCredits() const
+  {
+    return getUintVal(FlowControlStr, "DECFlowControlMaxByteCredits", defaultFlowControlMaxByteCredits);
+  }
+
+  uint32_t getDECFlowControlMsgCredits() const
   {
-    return getUintVal(FlowControlStr, "DECFlowControlEnableBytesThresh(",
-                      defaultFlowControlEnableBytesThresh);
+    return getUintVal(FlowControlStr, "DECFlowControlMsgCredits", defaultFlowControlMsgCredits);
   }
 
-  uint32_t getDECDisableBytesThresh() const
+  uint32_t getDECFlowControlMaxMsgCredits() const
   {
-    return getUintVal(FlowControlStr, "DECFlowControlDisableBytesThresh",
-                      defaultFlowControlDisableBytesThresh);
+    return getUintVal(FlowControlStr, "DECFlowControlMaxMsgCredits", defaultFlowControlMaxMsgCredits);
   }
 
   uint32_t getBPPSendThreadBytesThresh() const
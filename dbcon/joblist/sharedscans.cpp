@@ -0,0 +1,92 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include "sharedscans.h"
+
+namespace joblist
+{
+SharedScans* SharedScans::instance()
+{
+  static SharedScans sharedScans;
+  return &sharedScans;
+}
+
+SharedScans::Positions SharedScans::attach(uint32_t oid)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  Scan& scan = scans_[oid];
+  ++scan.attached;
+  return scan.positions;
+}
+
+void SharedScans::progress(uint32_t oid, uint16_t dbRoot, BRM::LBID_t extentStart)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  auto scan = scans_.find(oid);
+
+  if (scan != scans_.end())
+    scan->second.positions[dbRoot] = extentStart;
+}
+
+void SharedScans::detach(uint32_t oid)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  auto scan = scans_.find(oid);
+
+  if (scan != scans_.end() && --scan->second.attached == 0)
+    scans_.erase(scan);
+}
+
+std::vector<uint32_t> SharedScans::scanOrder(const std::vector<BRM::EMEntry>& extents,
+                                             const Positions& positions)
+{
+  std::vector<uint32_t> order;
+  order.reserve(extents.size());
+
+  for (uint32_t first = 0, end = 0; first < extents.size(); first = end)
+  {
+    const uint16_t dbRoot = extents[first].dbRoot;
+
+    while (end < extents.size() && extents[end].dbRoot == dbRoot)
+      ++end;
+
+    uint32_t start = first;
+    auto position = positions.find(dbRoot);
+
+    if (position != positions.end())
+    {
+      for (uint32_t i = first; i < end; ++i)
+      {
+        if (extents[i].range.start == position->second)
+        {
+          start = i;
+          break;
+        }
+      }
+    }
+
+    for (uint32_t i = start; i < end; ++i)
+      order.push_back(i);
+
+    for (uint32_t i = first; i < start; ++i)
+      order.push_back(i);
+  }
+
+  return order;
+}
+
+}  // namespace joblist
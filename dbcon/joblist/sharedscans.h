@@ -0,0 +1,77 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "brmtypes.h"
+#include "extentmap.h"
+
+namespace joblist
+{
+/** @brief Keeps the concurrent scans of a column in step.
+ *
+ * Every TupleBPS scan sends the extents of a dbroot in the same order. When many queries
+ * scan the same table at once each of them used to start from the first extent, so the
+ * scans drifted apart and evicted each other's blocks from the PrimProc block cache.
+ * With shared scans a scan that starts while others are running on the same column joins
+ * them at the extent they are sending, goes on to the last extent and wraps around to the
+ * ones it skipped. The scans then ask PrimProc for the same blocks at about the same time,
+ * so a block is read and decompressed once and then served from the cache to every query.
+ *
+ * The position of a column is kept per dbroot as the extents of every dbroot are scanned
+ * by their own PM in parallel.
+ */
+class SharedScans
+{
+ public:
+  // dbroot -> the first LBID of the extent being sent
+  using Positions = std::map<uint16_t, BRM::LBID_t>;
+
+  static SharedScans* instance();
+
+  // Registers a scan of the column and returns where the scans in progress are.
+  Positions attach(uint32_t oid);
+  void progress(uint32_t oid, uint16_t dbRoot, BRM::LBID_t extentStart);
+  void detach(uint32_t oid);
+
+  /** @brief The order to scan the extents in to join the scans at the positions.
+   *
+   * @param extents the extents of the column sorted by BRM::ExtentSorter
+   * @return the indexes of all the extents. The extents of every dbroot start at its
+   * position and wrap around; a dbroot without a position keeps its order.
+   */
+  static std::vector<uint32_t> scanOrder(const std::vector<BRM::EMEntry>& extents,
+                                         const Positions& positions);
+
+ private:
+  struct Scan
+  {
+    uint32_t attached = 0;
+    Positions positions;
+  };
+
+  std::mutex mutex_;
+  std::unordered_map<uint32_t, Scan> scans_;
+};
+
+}  // namespace joblist
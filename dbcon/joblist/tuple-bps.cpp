@@ -403,6 +403,7 @@ void TupleBPS::initializeConfigParms()
   fRequestSize = fRm->getJlRequestSize();
   fMaxOutstandingRequests = fRm->getJlMaxOutstandingRequests();
   fProcessorThreadsPerScan = fRm->getJlProcessorThreadsPerScan();
+  fSharedScan = fRm->getJlSharedScans();
   fNumThreads = 0;
 
   fExtentsPerSegFile = DEFAULT_EXTENTS_PER_SEG_FILE;
@@ -1465,6 +1466,17 @@ void TupleBPS::run()
   if (fe2 && bRunFEonPM)
     fBPP->setFEGroup2(fe2, fe2Output);
 
+  // PM can keep the Top-N only if it sends the delivered rows as they are
+  if (fTopNLimit > 0 && !doJoin && !fAggregatorPm && (!fe2 || bRunFEonPM))
+    fBPP->setTopN(fTopNSpec, fTopNLimit);
+
+  // Same for the LIMIT, any limit rows of a job will do
+  if (fLimit > 0 && (doJoin || fAggregatorPm || (fe2 && !bRunFEonPM)))
+    fLimit = 0;
+
+  if (fLimit > 0)
+    fBPP->setLimit(fLimit);
+
   if (fe2)
   {
     primRowGroup.initRow(&fe2InRow);
@@ -1671,7 +1683,17 @@ void TupleBPS::sendJobs(const vector<Job>& jobs)
 
   for (i = 0; i < jobs.size() && !cancelled(); i++)
   {
+    if (fMinMaxElimination && !fMinMaxElimination->needed(jobs[i].extentIndex))
+    {
+      fNumBlksSkipped += jobs[i].expectedResponses * fColType.colWidth;
+      continue;
+    }
+
     fDec->write(uniqueID, jobs[i].msg);
+
+    if (fSharedScan)
+      SharedScans::instance()->progress(fOid, jobs[i].dbroot, jobs[i].extentStart);
+
     tplLock.lock();
     msgsSent += jobs[i].expectedResponses;
 
@@ -1996,7 +2018,7 @@ bool TupleBPS::processPseudoColFilters(uint32_t extentIndex,
   }
 }
 
-void TupleBPS::makeJobs(vector<Job>* jobs)
+void TupleBPS::makeJobs(vector<Job>* jobs, const SharedScans::Positions& sharedScanPositions)
 {
   boost::shared_ptr<ByteStream> bs;
   uint32_t i;
@@ -2014,9 +2036,15 @@ void TupleBPS::makeJobs(vector<Job>* jobs)
     storeCasualPartitionInfo(false);
 
   totalMsgs = 0;
+  vector<uint32_t> extentOrder = SharedScans::scanOrder(scannedExtents, sharedScanPositions);
+  initMinMaxElimination();
 
-  for (i = 0; i < scannedExtents.size(); i++)
+  if (fMinMaxElimination)
+    fMinMaxElimination->order(extentOrder, scannedExtents);
+
+  for (uint32_t k = 0; k < extentOrder.size(); k++)
   {
+    i = extentOrder[k];
     // the # of LBIDs to scan in this extent, if it will be scanned.
     //@bug 5322: status EXTENTSTATUSMAX+1 means single block extent.
     if ((scannedExtents[i].HWM == 0) && ((int)i < lastExtent[scannedExtents[i].dbRoot - 1]) &&
@@ -2107,8 +2135,8 @@ void TupleBPS::makeJobs(vector<Job>* jobs)
       fBPP->setCount(blocksThisJob);
       bs.reset(new ByteStream());
       fBPP->runBPP(*bs, (*dbRootConnectionMap)[scannedExtents[i].dbRoot], isExeMgrDEC);
-      jobs->push_back(
-          Job(scannedExtents[i].dbRoot, (*dbRootConnectionMap)[scannedExtents[i].dbRoot], blocksThisJob, bs));
+      jobs->push_back(Job(scannedExtents[i].dbRoot, (*dbRootConnectionMap)[scannedExtents[i].dbRoot],
+                          blocksThisJob, bs, scannedExtents[i].range.start, i));
       blocksToScan -= blocksThisJob;
       startingLBID += fColType.colWidth * blocksThisJob;
       fBPP->reset();
@@ -2116,18 +2144,75 @@ void TupleBPS::makeJobs(vector<Job>* jobs)
   }
 }
 
+void TupleBPS::initMinMaxElimination()
+{
+  fMinMaxElimination.reset();
+
+  if (!fAggregatorPm || fe2 || doJoin || fOid < 3000 || bop != BOP_AND ||
+      (fTraceFlags & CalpontSelectExecutionPlan::IGNORE_CP) != 0 || !fAggregatorPm->getGroupByCols().empty())
+    return;
+
+  std::unique_ptr<MinMaxElimination> elimination(new MinMaxElimination(fAggRowGroupPm));
+  vector<SCommand> commands = fBPP->getFilterSteps();
+  const vector<SCommand>& projections = fBPP->getProjectSteps();
+  commands.insert(commands.end(), projections.begin(), projections.end());
+
+  for (const auto& function : fAggregatorPm->getAggFunctions())
+  {
+    if (function->fAggFunction != ROWAGG_MIN && function->fAggFunction != ROWAGG_MAX)
+      return;
+
+    // The column the aggregate reads and its extents
+    const uint32_t oid = primRowGroup.getOIDs()[function->fInputColumnIndex];
+    ColumnCommandJL* column = NULL;
+
+    for (const auto& command : commands)
+    {
+      ColumnCommandJL* cc = dynamic_cast<ColumnCommandJL*>(command.get());
+
+      if (cc && !dynamic_cast<PseudoCCJL*>(cc) && cc->getOID() == oid)
+      {
+        column = cc;
+        break;
+      }
+    }
+
+    if (!column || !MinMaxElimination::supported(column->getColType()) ||
+        column->getExtents().size() != scannedExtents.size())
+      return;
+
+    for (const auto& extent : column->getExtents())
+    {
+      if (extent.colWid != column->getColType().colWidth)
+        return;
+    }
+
+    elimination->addAggregate(function->fOutputColumnIndex, function->fAggFunction == ROWAGG_MAX,
+                              datatypes::isUnsigned(column->getColType().colDataType), column->getExtents());
+  }
+
+  if (!elimination->empty())
+    fMinMaxElimination = std::move(elimination);
+}
+
 void TupleBPS::sendPrimitiveMessages()
 {
   vector<Job> jobs;
+  SharedScans::Positions sharedScanPositions;
+  // The system catalog is scanned by internal queries only
+  const bool sharedScan = fSharedScan && fOid >= 3000;
 
   idbassert(ffirstStepType == SCAN);
 
   if (cancelled())
     goto abort;
 
+  if (sharedScan)
+    sharedScanPositions = SharedScans::instance()->attach(fOid);
+
   try
   {
-    makeJobs(&jobs);
+    makeJobs(&jobs, sharedScanPositions);
     interleaveJobs(&jobs);
     sendJobs(jobs);
   }
@@ -2139,6 +2224,9 @@ void TupleBPS::sendPrimitiveMessages()
     abort_nolock();
   }
 
+  if (sharedScan)
+    SharedScans::instance()->detach(fOid);
+
 abort:
   boost::unique_lock<boost::mutex> tplLock(tplMutex);
   finishedSending = true;
@@ -2341,6 +2429,12 @@ void TupleBPS::processByteStreamVector(vector<boost::shared_ptr<messageqcpp::Byt
       }
       else
       {
+        if (fMinMaxElimination)
+          fMinMaxElimination->update(rgData);
+
+        if (fLimit > 0)
+          fLimitRows += data->local_primRG.getRowCount();
+
         rgDatav.push_back(rgData);
       }
       if (memAmount)
@@ -2535,6 +2629,11 @@ void TupleBPS::receiveMultiPrimitiveMessages()
       fProcessorThreads.clear();
       bsv.clear();
 
+      // The rows of the LIMIT are in the datalist, stop sending jobs and let PM drop the rest of
+      // the outstanding ones the same way the annex step does once it has seen them.
+      if (fLimit > 0 && fLimitRows >= fLimit)
+        abort_nolock();
+
       // @bug 4562
       if (traceOn() && fOid >= 3000)
         dlTimes.setFirstInsertTime();
@@ -3015,6 +3114,17 @@ void TupleBPS::setAggregateStep(const rowgroup::SP_ROWAGG_PM_t& agg, const rowgr
   }
 }
 
+void TupleBPS::setTopN(const vector<ordering::IdbSortSpec>& spec, uint32_t limit)
+{
+  fTopNSpec = spec;
+  fTopNLimit = limit;
+}
+
+void TupleBPS::setLimit(uint64_t limit)
+{
+  fLimit = limit;
+}
+
 void TupleBPS::setBOP(uint8_t op)
 {
   bop = op;
@@ -86,6 +86,14 @@ class TupleAnnexStep : public JobStep, public TupleDeliveryStep
     fLimitStart = s;
     fLimitCount = c;
   }
+  uint64_t getLimitCount() const
+  {
+    return fLimitCount;
+  }
+  bool hasOrderBy() const
+  {
+    return fOrderBy != nullptr;
+  }
   void setParallelOp()
   {
     fParallelOp = true;
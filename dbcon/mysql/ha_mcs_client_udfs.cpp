@@ -46,6 +46,8 @@ using namespace logging;
 #include "columnstoreversion.h"
 #include "ha_mcs_sysvars.h"
 
+#include <cinttypes>
+
 extern "C"
 {
 #define MAXSTRINGLENGTH 50
@@ -1010,10 +1012,26 @@ extern "C"
 
     msg >> runningSql;
     msg >> waitingSql;
-    delete mqc;
 
-    char ans[128];
-    sprintf(ans, "Running SQL statements %d, Waiting SQL statments %d", runningSql, waitingSql);
+    char ans[255];
+    int len = snprintf(ans, sizeof(ans), "Running SQL statements %d, Waiting SQL statments %d", runningSql,
+                       waitingSql);
+
+    // The admission control stats, sent if it is on
+    if (msg.length() > 0)
+    {
+      ByteStream::quadbyte queuedHigh, queuedMedium, queuedLow;
+      uint64_t admitted, waited, totalWaitMs, maxWaitMs, reserved, budget;
+      msg >> queuedHigh >> queuedMedium >> queuedLow;
+      msg >> admitted >> waited >> totalWaitMs >> maxWaitMs >> reserved >> budget;
+      snprintf(ans + len, sizeof(ans) - len,
+               ", Queued for memory %u/%u/%u (high/medium/low), Avg wait %" PRIu64 " ms, Max wait %" PRIu64
+               " ms, Reserved %" PRIu64 " of %" PRIu64 " MB",
+               queuedHigh, queuedMedium, queuedLow, (waited ? totalWaitMs / waited : 0), maxWaitMs,
+               reserved >> 20, budget >> 20);
+    }
+
+    delete mqc;
     *length = strlen(ans);
     memcpy(result, ans, *length);
     return result;
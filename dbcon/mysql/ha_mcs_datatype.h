@@ -211,6 +211,7 @@ class WriteBatchFieldMariaDB : public WriteBatchField
   // See strings/decimal.c
   const int dig2bytes[DIG_PER_DEC + 1] = {0, 1, 1, 2, 2, 3, 3, 4, 4, 4};
 
+ protected:
   // Returns the number of bytes required to store a given number
   // of decimal digits
   int numDecimalBytes(int digits)
@@ -877,4 +878,377 @@ class WriteBatchFieldMariaDB : public WriteBatchField
   }
 };
 
+/*******************************************************************************/
+// Writes a row as the fixed length record of a cpimport binary import that
+// accepts NULL values (cpimport -I1): every value in the width of its column,
+// NULL as the NULL value of the column type and strings padded with '\0'.
+// Values are converted the way cpimport converts the text of the other
+// writer, without the formatting and the parsing. The values it saturates
+// are added to saturatedCount, as cpimport counts the ones it saturates.
+class WriteBatchFieldMariaDBBinary : public WriteBatchFieldMariaDB
+{
+  uint64_t& m_saturatedCount;
+
+  bool isNull(bool nullVal) const
+  {
+    return nullVal && (m_type.constraintType != CalpontSystemCatalog::NOTNULL_CONSTRAINT);
+  }
+
+  template <typename T>
+  static void writeValue(const ColBatchWriter& ci, T value)
+  {
+    fwrite(&value, sizeof(value), 1, ci.filePtr());
+  }
+
+  // The two lowest values are the NULL and empty row values of a signed
+  // column, cpimport saturates a value to the ones above
+  template <typename T>
+  size_t writeSInt(const ColBatchWriter& ci, bool nullVal, int64_t value, size_t length)
+  {
+    typedef typename std::make_unsigned<T>::type UT;
+    const UT nullValue = UT(1) << (sizeof(T) * 8 - 1);
+
+    const int64_t minValue = std::numeric_limits<T>::min() + 2;
+
+    if (isNull(nullVal))
+    {
+      writeValue<UT>(ci, nullValue);
+    }
+    else if (value < minValue)
+    {
+      writeValue<T>(ci, static_cast<T>(minValue));
+      m_saturatedCount++;
+    }
+    else
+    {
+      writeValue<T>(ci, static_cast<T>(value));
+    }
+
+    return length;
+  }
+
+  // The two highest values are the NULL and empty row values of an unsigned
+  // column
+  template <typename T>
+  size_t writeUInt(const ColBatchWriter& ci, bool nullVal, uint64_t value, size_t length)
+  {
+    const uint64_t maxValue = std::numeric_limits<T>::max() - 2;
+
+    if (isNull(nullVal))
+    {
+      writeValue<T>(ci, std::numeric_limits<T>::max() - 1);
+    }
+    else if (value > maxValue)
+    {
+      writeValue<T>(ci, static_cast<T>(maxValue));
+      m_saturatedCount++;
+    }
+    else
+    {
+      writeValue<T>(ci, static_cast<T>(value));
+    }
+
+    return length;
+  }
+
+  void writeString(const ColBatchWriter& ci, const char* str, size_t length) const
+  {
+    size_t width = m_type.colWidth;
+    length = std::min(length, width);
+    fwrite(str, 1, length, ci.filePtr());
+
+    for (; length < width; length++)
+      fputc('\0', ci.filePtr());
+  }
+
+  void writeDateTime(const ColBatchWriter& ci, const MYSQL_TIME& ltime) const
+  {
+    writeValue(ci, dataconvert::DateTime(ltime.year, ltime.month, ltime.day, ltime.hour, ltime.minute,
+                                         ltime.second, ltime.second_part));
+  }
+
+ public:
+  WriteBatchFieldMariaDBBinary(Field* field, const CalpontSystemCatalog::ColType& type, uint32_t mbmaxlen,
+                               const long timeZone, uint64_t& saturatedCount)
+   : WriteBatchFieldMariaDB(field, type, mbmaxlen, timeZone), m_saturatedCount(saturatedCount)
+  {
+  }
+
+  // The column types written in their binary form, the others have no fixed
+  // width or no cpimport binary form
+  static bool supported(const CalpontSystemCatalog::ColType& type)
+  {
+    switch (type.colDataType)
+    {
+      case CalpontSystemCatalog::VARBINARY:
+      case CalpontSystemCatalog::BLOB:
+      case CalpontSystemCatalog::TEXT:
+      case CalpontSystemCatalog::CLOB:
+      case CalpontSystemCatalog::LONGDOUBLE:
+      case CalpontSystemCatalog::BIT:
+      case CalpontSystemCatalog::UNDEFINED: return false;
+
+      default: return true;
+    }
+  }
+
+  size_t ColWriteBatchDate(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    if (isNull(nullVal))
+    {
+      writeValue(ci, joblist::DATENULL);
+    }
+    else
+    {
+      uint32_t tmp = (buf[2] << 16) + (buf[1] << 8) + buf[0];
+      writeValue(ci, dataconvert::Date(tmp >> 9, (tmp >> 5) & 0xf, tmp & 0x1f));
+    }
+
+    return 3;
+  }
+
+  size_t ColWriteBatchDatetime(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    size_t length = (m_field->real_type() == MYSQL_TYPE_DATETIME2) ? m_field->pack_length() : 8;
+
+    if (isNull(nullVal))
+    {
+      writeValue(ci, joblist::DATETIMENULL);
+      return length;
+    }
+
+    MYSQL_TIME ltime;
+
+    if (m_field->real_type() == MYSQL_TYPE_DATETIME2)
+    {
+      TIME_from_longlong_datetime_packed(&ltime, my_datetime_packed_from_binary(buf, m_field->decimals()));
+    }
+    else
+    {
+      // Old DATETIME
+      long long value = *((long long*)buf);
+      long datePart = (long)(value / 1000000ll);
+      long timePart = (long)(value - (long long)datePart * 1000000ll);
+      ltime.year = datePart / 10000;
+      ltime.month = (datePart / 100) % 100;
+      ltime.day = datePart % 100;
+      ltime.hour = timePart / 10000;
+      ltime.minute = (timePart / 100) % 100;
+      ltime.second = timePart % 100;
+      ltime.second_part = 0;
+    }
+
+    writeDateTime(ci, ltime);
+    return length;
+  }
+
+  size_t ColWriteBatchTime(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    if (isNull(nullVal))
+    {
+      writeValue(ci, joblist::TIMENULL);
+      return m_field->pack_length();
+    }
+
+    MYSQL_TIME ltime;
+    TIME_from_longlong_time_packed(&ltime, my_time_packed_from_binary(buf, m_field->decimals()));
+
+    // As DataConvert::convertColumnTime() sets the fields of the time
+    dataconvert::Time atime;
+    atime.hour = ltime.neg ? -(int)ltime.hour : ltime.hour;
+    atime.minute = ltime.minute;
+    atime.second = ltime.second;
+    atime.msecond = ltime.second_part;
+    atime.is_neg = ltime.neg;
+    writeValue(ci, atime);
+
+    return m_field->pack_length();
+  }
+
+  size_t ColWriteBatchTimestamp(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    if (isNull(nullVal))
+    {
+      writeValue(ci, joblist::TIMESTAMPNULL);
+      return m_field->pack_length();
+    }
+
+    // Seconds from the epoch, no time zone conversion
+    struct timeval tm;
+    my_timestamp_from_binary(&tm, buf, m_field->decimals());
+    writeValue(ci, dataconvert::TimeStamp(tm.tv_usec, tm.tv_sec));
+
+    return m_field->pack_length();
+  }
+
+  size_t ColWriteBatchChar(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    if (isNull(nullVal))
+    {
+      writeString(ci, "", 0);
+    }
+    else
+    {
+      String value;
+      m_field->val_str(&value);
+
+      if (current_thd->variables.sql_mode & MODE_PAD_CHAR_TO_FULL_LENGTH)
+        writeString(ci, value.ptr(), m_field->pack_length());
+      else
+        writeString(ci, value.ptr(), value.length());
+    }
+
+    return m_field->pack_length();
+  }
+
+  size_t ColWriteBatchVarchar(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    if (isNull(nullVal))
+    {
+      writeString(ci, "", 0);
+    }
+    else
+    {
+      String value;
+      m_field->val_str(&value);
+      writeString(ci, value.ptr(), value.length());
+    }
+
+    return m_field->pack_length();
+  }
+
+  size_t ColWriteBatchSInt64(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    return writeSInt<int64_t>(ci, nullVal, *((int64_t*)buf), 8);
+  }
+
+  size_t ColWriteBatchUInt64(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    return writeUInt<uint64_t>(ci, nullVal, *((uint64_t*)buf), 8);
+  }
+
+  size_t ColWriteBatchSInt32(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    return writeSInt<int32_t>(ci, nullVal, *((int32_t*)buf), 4);
+  }
+
+  size_t ColWriteBatchUInt32(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    return writeUInt<uint32_t>(ci, nullVal, *((uint32_t*)buf), 4);
+  }
+
+  // A MEDIUMINT column is 4 bytes wide
+  size_t ColWriteBatchSInt24(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    int32_t tmp = ((buf[0] << 8) | (buf[1] << 16) | (buf[2] << 24)) >> 8;
+    return writeSInt<int32_t>(ci, nullVal, tmp, 3);
+  }
+
+  size_t ColWriteBatchUInt24(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    uint32_t tmp = buf[0] | (buf[1] << 8) | (buf[2] << 16);
+    return writeUInt<uint32_t>(ci, nullVal, tmp, 3);
+  }
+
+  size_t ColWriteBatchSInt16(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    return writeSInt<int16_t>(ci, nullVal, *((int16_t*)buf), 2);
+  }
+
+  size_t ColWriteBatchUInt16(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    return writeUInt<uint16_t>(ci, nullVal, *((uint16_t*)buf), 2);
+  }
+
+  size_t ColWriteBatchSInt8(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    return writeSInt<int8_t>(ci, nullVal, *((int8_t*)buf), 1);
+  }
+
+  size_t ColWriteBatchUInt8(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    return writeUInt<uint8_t>(ci, nullVal, *((uint8_t*)buf), 1);
+  }
+
+  size_t ColWriteBatchXFloat(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    if (isNull(nullVal))
+      writeValue(ci, joblist::FLOATNULL);
+    else
+      writeValue(ci, *((float*)buf));
+
+    return 4;
+  }
+
+  size_t ColWriteBatchXDouble(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    if (isNull(nullVal))
+      writeValue(ci, joblist::DOUBLENULL);
+    else
+      writeValue(ci, *((double*)buf));
+
+    return 8;
+  }
+
+  size_t ColWriteBatchXDecimal(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    size_t length = numDecimalBytes(m_type.precision - m_type.scale) + numDecimalBytes(m_type.scale);
+    int128_t value = 0;
+
+    if (!isNull(nullVal))
+    {
+      // The value with scale digits after the decimal point, from the words
+      // of 9 digits of the integer part and of the fraction
+      my_decimal dec(buf, m_type.precision, m_type.scale);
+      const decimal_digit_t* word = dec.buf;
+
+      for (int i = 0; i < (dec.intg + DIG_PER_DEC - 1) / DIG_PER_DEC; i++)
+        value = value * 1000000000 + *word++;
+
+      for (int digits = dec.frac; digits > 0; digits -= DIG_PER_DEC)
+      {
+        int32_t divisor = 1;
+
+        for (int i = digits; i < DIG_PER_DEC; i++)
+          divisor *= 10;
+
+        value = value * (1000000000 / divisor) + *word++ / divisor;
+      }
+
+      if (dec.sign())
+        value = -value;
+    }
+
+    switch (m_type.colWidth)
+    {
+      case 1: return writeSInt<int8_t>(ci, nullVal, value, length);
+      case 2: return writeSInt<int16_t>(ci, nullVal, value, length);
+      case 4: return writeSInt<int32_t>(ci, nullVal, value, length);
+      case 8: return writeSInt<int64_t>(ci, nullVal, value, length);
+
+      default:
+        writeValue(ci, isNull(nullVal) ? datatypes::Decimal128Null : value);
+        return length;
+    }
+  }
+
+  size_t ColWriteBatchSLongDouble(const uchar* buf, bool nullVal, ColBatchWriter& ci) override
+  {
+    idbassert(false);
+    return sizeof(long double);
+  }
+
+  size_t ColWriteBatchVarbinary(const uchar* buf0, bool nullVal, ColBatchWriter& ci) override
+  {
+    idbassert(false);
+    return m_field->pack_length();
+  }
+
+  size_t ColWriteBatchBlob(const uchar* buf0, bool nullVal, ColBatchWriter& ci) override
+  {
+    idbassert(false);
+    return m_field->pack_length();
+  }
+};
+
 }  // end of namespace datatypes
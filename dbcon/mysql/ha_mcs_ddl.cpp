@@ -170,8 +170,13 @@ int parseCompressionComment(std::string comment)
     //  (no digits) || (more chars)  || (other errors & value = 0)
     if ((ep == str) || (*ep != '\0') || (errno != 0 && compressiontype == 0))
     {
-      compressiontype = -1;
+      // compression=ZSTD etc., -1 if not a name either
+      compressiontype = compress::getCompressionTypeByName(compType);
     }
+
+    // A type this build has no codec for is invalid, e.g. LZ4 without LZ4
+    if ((compressiontype > 0) && !compress::CompressInterface::isCompressionAvail(compressiontype))
+      compressiontype = -1;
   }
   else
     compressiontype = MAX_INT;
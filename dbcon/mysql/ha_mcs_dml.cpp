@@ -71,6 +71,7 @@ using namespace joblist;
 
 #include "dbrm.h"
 
+#include "joblisttypes.h"
 #include "ha_mcs_datatype.h"
 
 #include "nullstring.h"
@@ -751,15 +752,29 @@ int ha_mcs_impl_write_batch_row_(const uchar* buf, TABLE* table, cal_impl_if::ca
         Field* fieldPtr = table->field[colpos];
         uint32_t mbmaxlen =
             (fieldPtr->charset() && fieldPtr->charset()->mbmaxlen) ? fieldPtr->charset()->mbmaxlen : 0;
-        datatypes::WriteBatchFieldMariaDB field(fieldPtr, colType, mbmaxlen, timeZone);
         idbassert(table == table->field[colpos]->table);
-        buf += h->ColWriteBatch(&field, buf, nullVal, writer);
+
+        if (ci.binaryImport)
+        {
+          datatypes::WriteBatchFieldMariaDBBinary field(fieldPtr, colType, mbmaxlen, timeZone,
+                                                        ci.binarySaturatedCount);
+          buf += h->ColWriteBatch(&field, buf, nullVal, writer);
+        }
+        else
+        {
+          datatypes::WriteBatchFieldMariaDB field(fieldPtr, colType, mbmaxlen, timeZone);
+          buf += h->ColWriteBatch(&field, buf, nullVal, writer);
+        }
       }
       colpos++;
     }
   }
 
-  rc = fprintf(ci.filePtr, "\n");  //@bug 6077 check whether the pipe is still open
+  // A binary record has no row end
+  if (ci.binaryImport)
+    rc = ferror(ci.filePtr) ? -1 : 0;
+  else
+    rc = fprintf(ci.filePtr, "\n");  //@bug 6077 check whether the pipe is still open
 
   if (rc < 0)
     rc = -1;
@@ -3124,12 +3124,18 @@ void ha_mcs_impl_start_bulk_insert(ha_rows rows, TABLE* table, bool is_cache_ins
       //@bug 6122 Check how many columns have not null constraint. columnn with not null constraint will not
       //show up in header.
       unsigned int numberNotNull = 0;
+      // The rows are piped as binary records unless a column has no fixed width
+      ci->binaryImport = get_import_for_batchinsert_binary(thd);
+      ci->binarySaturatedCount = 0;
 
       for (unsigned int j = 0; j < colrids.size(); j++)
       {
         CalpontSystemCatalog::ColType ctype = csc->colType(colrids[j].objnum);
         ci->columnTypes.push_back(ctype);
 
+        if (!datatypes::WriteBatchFieldMariaDBBinary::supported(ctype))
+          ci->binaryImport = false;
+
         if (((ctype.colDataType == CalpontSystemCatalog::VARCHAR) ||
              (ctype.colDataType == CalpontSystemCatalog::VARBINARY)) &&
             !ci->useXbit)
@@ -3194,17 +3200,21 @@ void ha_mcs_impl_start_bulk_insert(ha_rows rows, TABLE* table, bool is_cache_ins
         }
         else
         {
-          aCmdLine = "cpimport -m 1 -N -P " + boost::to_string(localModuleId) + " -s " + ci->delimiter +
-                     " -e 0" + " -T " + thd->variables.time_zone->get_name()->ptr() + " -E " + escapechar +
-                     ci->enclosed_by + " ";
+          aCmdLine = "cpimport -m 1 -N -P " + boost::to_string(localModuleId) + " ";
         }
       }
       else
       {
-        aCmdLine = std::string("cpimport -m 1 -N -s ") + ci->delimiter + " -e 0" + " -T " +
-                   thd->variables.time_zone->get_name()->ptr() + " -E " + escapechar + ci->enclosed_by + " ";
+        aCmdLine = "cpimport -m 1 -N ";
       }
 
+      // Binary records that accept NULL values need no delimiter nor enclosing
+      if (ci->binaryImport)
+        aCmdLine = aCmdLine + "-I 1 -e 0 -T " + thd->variables.time_zone->get_name()->ptr() + " ";
+      else
+        aCmdLine = aCmdLine + "-s " + ci->delimiter + " -e 0" + " -T " +
+                   thd->variables.time_zone->get_name()->ptr() + " -E " + escapechar + ci->enclosed_by + " ";
+
       aCmdLine = aCmdLine + table->s->db.str + " " + table->s->table_name.str;
 
       std::istringstream ss(aCmdLine);
@@ -3530,12 +3540,15 @@ int ha_mcs_impl_end_bulk_insert(bool abort, TABLE* table)
         }
 
         ci->columnTypes.clear();
-        // get extra warning count if any
+        ci->binaryImport = false;
+        // get extra warning count if any, the values saturated by the binary
+        // writer never reach cpimport as out of range
         ifstream dmlFile;
         ostringstream oss;
         oss << aTmpDir << ci->tableOid << ".txt";
         dmlFile.open(oss.str().c_str());
-        int totalWarnCount = 0;
+        uint64_t totalWarnCount = ci->binarySaturatedCount;
+        ci->binarySaturatedCount = 0;
         int colWarns = 0;
         string line;
 
@@ -3549,10 +3562,10 @@ int ha_mcs_impl_end_bulk_insert(bool abort, TABLE* table)
 
           dmlFile.close();
           remove(oss.str().c_str());
-
-          for (int i = 0; i < totalWarnCount; i++)
-            push_warning(thd, Sql_condition::WARN_LEVEL_WARN, 9999, "Values saturated");
         }
+
+        for (uint64_t i = 0; i < totalWarnCount; i++)
+          push_warning(thd, Sql_condition::WARN_LEVEL_WARN, 9999, "Values saturated");
       }
     }
     else
@@ -326,6 +326,8 @@ struct cal_connection_info
    , useXbit(false)
    , useCpimport(mcs_use_import_for_batchinsert_mode_t::ON)
    , delimiter('\7')
+   , binaryImport(false)
+   , binarySaturatedCount(0)
    , affectedRows(0)
   {
     auto* cf = config::Config::makeConfig();
@@ -400,6 +402,8 @@ struct cal_connection_info
   mcs_use_import_for_batchinsert_mode_t useCpimport;
   char delimiter;
   char enclosed_by;
+  bool binaryImport;              // rows are piped to cpimport as binary records (-I1)
+  uint64_t binarySaturatedCount;  // values saturated while writing the binary records
   std::vector<execplan::CalpontSystemCatalog::ColType> columnTypes;
   // MCOL-1101 remove compilation unit variable rmParms
   std::vector<execplan::RMParam> rmParms;
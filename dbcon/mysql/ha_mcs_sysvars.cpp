@@ -20,12 +20,16 @@
 #include "idb_mysql.h"
 #include "ha_mcs_sysvars.h"
 #include "mcsconfig.h"
+#include "idbcompress.h"
 
 const char* mcs_compression_type_names[] = {"SNAPPY",  // 0
                                             "SNAPPY",  // 1
                                             "SNAPPY",  // 2
-#ifdef HAVE_LZ4
+#if defined(HAVE_LZ4) || defined(HAVE_ZSTD)
                                             "LZ4",  // 3
+#endif
+#ifdef HAVE_ZSTD
+                                            "ZSTD",  // 4
 #endif
                                             NullS};
 
@@ -33,16 +37,50 @@ static TYPELIB mcs_compression_type_names_lib = {array_elements(mcs_compression_
                                                  "mcs_compression_type_names", mcs_compression_type_names,
                                                  NULL};
 
+// Without LZ4 a ZSTD build still names the type 3 for ZSTD to be the type 4,
+// so the types are checked against the codecs the build has.
+static int check_compression_type(MYSQL_THD thd, struct st_mysql_sys_var* var, void* save,
+                                  struct st_mysql_value* value)
+{
+  long long type;
+
+  if (value->value_type(value) == MYSQL_VALUE_TYPE_STRING)
+  {
+    char buf[16];
+    int length = sizeof(buf);
+    const char* str = value->val_str(value, buf, &length);
+
+    if (!str)
+      return 1;
+
+    // find_type() returns the position from 1, 0 if not found
+    type = (long long)find_type(str, &mcs_compression_type_names_lib, 0) - 1;
+  }
+  else if (value->val_int(value, &type))
+  {
+    return 1;
+  }
+
+  if ((type < 0) || (type >= (long long)mcs_compression_type_names_lib.count) ||
+      !compress::CompressInterface::isCompressionAvail(type))
+    return 1;
+
+  *(ulong*)save = (ulong)type;
+  return 0;
+}
+
 // compression type
 static MYSQL_THDVAR_ENUM(compression_type, PLUGIN_VAR_RQCMDARG,
                          "Controls compression algorithm for create tables. Possible values are: "
                          "SNAPPY segment files are Snappy compressed (default);"
 #ifdef HAVE_LZ4
-                         "LZ4 segment files are LZ4 compressed;",
-#else
-                         ,
+                         "LZ4 segment files are LZ4 compressed;"
 #endif
-                         NULL,                              // check
+#ifdef HAVE_ZSTD
+                         "ZSTD segment files are Zstandard compressed;"
+#endif
+                         ,
+                         check_compression_type,            // check
                          NULL,                              // update
                          1,                                 // default
                          &mcs_compression_type_names_lib);  // values lib
@@ -173,6 +211,11 @@ static MYSQL_THDVAR_ULONG(import_for_batchinsert_enclosed_by, PLUGIN_VAR_RQCMDAR
                           1      // block size
 );
 
+static MYSQL_THDVAR_BOOL(import_for_batchinsert_binary, PLUGIN_VAR_NOCMDARG,
+                         "Pipe the rows of LDI and INSERT..SELECT to cpimport as binary records "
+                         "instead of delimited text when the table has no BLOB, TEXT or VARBINARY column",
+                         NULL, NULL, 0);
+
 const char* mcs_use_import_for_batchinsert_mode_values[] = {"OFF", "ON", "ALWAYS", NullS};
 
 static TYPELIB mcs_use_import_for_batchinsert_mode_values_lib = {
@@ -250,6 +293,7 @@ st_mysql_sys_var* mcs_system_variables[] = {MYSQL_SYSVAR(compression_type),
                                             MYSQL_SYSVAR(use_import_for_batchinsert),
                                             MYSQL_SYSVAR(import_for_batchinsert_delimiter),
                                             MYSQL_SYSVAR(import_for_batchinsert_enclosed_by),
+                                            MYSQL_SYSVAR(import_for_batchinsert_binary),
                                             MYSQL_SYSVAR(varbin_always_hex),
                                             MYSQL_SYSVAR(replication_slave),
                                             MYSQL_SYSVAR(cache_inserts),
@@ -543,6 +587,15 @@ void set_import_for_batchinsert_enclosed_by(THD* thd, ulong value)
   THDVAR(thd, import_for_batchinsert_enclosed_by) = value;
 }
 
+bool get_import_for_batchinsert_binary(THD* thd)
+{
+  return (thd == NULL) ? false : THDVAR(thd, import_for_batchinsert_binary);
+}
+void set_import_for_batchinsert_binary(THD* thd, bool value)
+{
+  THDVAR(thd, import_for_batchinsert_binary) = value;
+}
+
 bool get_replication_slave(THD* thd)
 {
   return (thd == NULL) ? false : THDVAR(thd, replication_slave);
@@ -33,7 +33,10 @@ enum mcs_compression_type_t
   NO_COMPRESSION = 0,
   SNAPPY = 2,
 #ifdef HAVE_LZ4
-  LZ4 = 3
+  LZ4 = 3,
+#endif
+#ifdef HAVE_ZSTD
+  ZSTD = 4,
 #endif
 };
 
@@ -141,6 +144,9 @@ void set_import_for_batchinsert_delimiter(THD* thd, ulong value);
 ulong get_import_for_batchinsert_enclosed_by(THD* thd);
 void set_import_for_batchinsert_enclosed_by(THD* thd, ulong value);
 
+bool get_import_for_batchinsert_binary(THD* thd);
+void set_import_for_batchinsert_binary(THD* thd, bool value);
+
 bool get_replication_slave(THD* thd);
 void set_replication_slave(THD* thd, bool value);
 
@@ -636,4 +636,125 @@ void PrimitiveProcessor::p_Dictionary(const DictInput* in, vector<uint8_t>* out,
   memcpy(&(*out)[0], &header, sizeof(DictOutput));
 }
 
+bool PrimitiveProcessor::dictCodeMatches(const utils::DictOrderIndex& index, const uint8_t* filters,
+                                         uint16_t NOPS, uint8_t BOP, uint32_t charsetNumber,
+                                         const boost::shared_ptr<DictEqualityFilter>& eqFilter, uint8_t eqOp,
+                                         vector<uint8_t>& matches)
+{
+  const datatypes::Charset cs(charsetNumber);
+  const uint32_t count = index.size();
+  matches.assign(count, 0);
+
+  // The strings match as they do in p_Dictionary()
+  if (eqFilter)
+  {
+    if (eqFilter->size() > 1 && BOP == BOP_AND && eqOp == COMPARE_EQ)
+      return true;
+
+    if (eqFilter->size() > 1 && BOP == BOP_OR && eqOp == COMPARE_NE)
+    {
+      matches.assign(count, 1);
+      return true;
+    }
+
+    for (uint32_t code = 0; code < count; code++)
+    {
+      const utils::ConstString str = index.string(code);
+      string strData(str.str(), str.length());
+      boost::trim_right_if(strData, boost::is_any_of(" "));
+      bool gotIt = eqFilter->find(strData) != eqFilter->end();
+      matches[code] = (gotIt && eqOp == COMPARE_EQ) || (!gotIt && eqOp == COMPARE_NE);
+    }
+
+    return true;
+  }
+
+  // The codes of the strings equal to the literal of a comparison are [lo, hi), the other
+  // operators compare the strings of the codes
+  struct Comparison
+  {
+    uint8_t cop;
+    utils::ConstString literal;
+    uint32_t lo;
+    uint32_t hi;
+  };
+  vector<Comparison> comparisons;
+  const uint8_t* pos = filters;
+
+  for (uint32_t f = 0; f < NOPS; f++)
+  {
+    const DictFilterElement* filter = reinterpret_cast<const DictFilterElement*>(pos);
+    Comparison comparison{filter->COP, utils::ConstString((const char*)filter->data, filter->len), 0, 0};
+    pos += sizeof(DictFilterElement) + filter->len;
+
+    switch (filter->COP)
+    {
+      case COMPARE_EQ:
+      case COMPARE_NE:
+      case COMPARE_LT:
+      case COMPARE_LE:
+      case COMPARE_GT:
+      case COMPARE_GE:
+        comparison.lo = index.lowerBound(cs, comparison.literal);
+        comparison.hi = index.upperBound(cs, comparison.literal);
+        break;
+
+      default: break;
+    }
+
+    comparisons.push_back(comparison);
+  }
+
+  for (uint32_t code = 0; code < count; code++)
+  {
+    bool result = BOP != BOP_OR;
+
+    for (const auto& comparison : comparisons)
+    {
+      bool cmp;
+
+      switch (comparison.cop)
+      {
+        case COMPARE_EQ: cmp = code >= comparison.lo && code < comparison.hi; break;
+
+        case COMPARE_NE: cmp = code < comparison.lo || code >= comparison.hi; break;
+
+        case COMPARE_LT: cmp = code < comparison.lo; break;
+
+        case COMPARE_LE: cmp = code < comparison.hi; break;
+
+        case COMPARE_GT: cmp = code >= comparison.hi; break;
+
+        case COMPARE_GE: cmp = code >= comparison.lo; break;
+
+        default:
+        {
+          int error = 0;
+          cmp = StringComparator(cs).op(&error, comparison.cop, index.string(code), comparison.literal);
+
+          // p_Dictionary() logs the operator it doesn't know
+          if (error)
+            return false;
+        }
+      }
+
+      if (!cmp && BOP != BOP_OR)
+      {
+        result = false;
+        break;
+      }
+
+      if (cmp && BOP != BOP_AND)
+      {
+        result = true;
+        break;
+      }
+    }
+
+    matches[code] = result;
+  }
+
+  return true;
+}
+
 }  // namespace primitives
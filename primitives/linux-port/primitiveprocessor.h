@@ -45,6 +45,7 @@
 #include "stats.h"
 #include "primproc.h"
 #include "hasher.h"
+#include "dictorderindex.h"
 
 class PrimTest;
 
@@ -432,6 +433,19 @@ class PrimitiveProcessor
 #endif
   );
 
+  /** @brief Evaluates the filter of a p_Dictionary() request on the strings of an order index.
+   *
+   * The strings match as they do in p_Dictionary(), the codes of a comparison with an EQ, NE, LT,
+   * LE, GT or GE literal are found with two binary searches.
+   * @param filters the NOPS DictFilterElements of the request
+   * @param matches set to whether the string of each code passes the filter
+   * @return false if the filter can't be evaluated on the strings
+   */
+  static bool dictCodeMatches(const utils::DictOrderIndex& index, const uint8_t* filters, uint16_t NOPS,
+                              uint8_t BOP, uint32_t charsetNumber,
+                              const boost::shared_ptr<DictEqualityFilter>& eqFilter, uint8_t eqOp,
+                              std::vector<uint8_t>& matches);
+
   inline void setLogicalBlockMode(bool b)
   {
     logicalBlockMode = b;
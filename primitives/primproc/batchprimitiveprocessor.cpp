@@ -29,6 +29,7 @@
 //
 //
 
+#include <algorithm>
 #include <mutex>
 #include <stdexcept>
 #include <unistd.h>
@@ -85,6 +86,10 @@ extern uint32_t defaultBufferSize;
 extern int fCacheCount;
 extern uint32_t connectionsPerUM;
 extern int noVB;
+extern bool suspendOnCacheMiss;
+extern bool chunkZoneMaps;
+extern bool dictBloomFilters;
+extern bool dictOrderIndexes;
 
 // copied from https://graphics.stanford.edu/~seander/bithacks.html#RoundUpPowerOf2
 uint nextPowOf2(uint x)
@@ -113,6 +118,7 @@ BatchPrimitiveProcessor::BatchPrimitiveProcessor()
  , filterCount(0)
  , projectCount(0)
  , sendRidsAtDelivery(false)
+ , columnarOutput(false)
  , ridMap(0)
  , gotAbsRids(false)
  , gotValues(false)
@@ -168,6 +174,7 @@ BatchPrimitiveProcessor::BatchPrimitiveProcessor(ByteStream& b, double prefetch,
  , filterCount(0)
  , projectCount(0)
  , sendRidsAtDelivery(false)
+ , columnarOutput(false)
  , ridMap(0)
  , gotAbsRids(false)
  , gotValues(false)
@@ -261,6 +268,7 @@ void BatchPrimitiveProcessor::initBPP(ByteStream& bs)
   hasRowGroup = tmp16 & HAS_ROWGROUP;
   getTupleJoinRowGroupData = tmp16 & JOIN_ROWGROUP_DATA;
   bool hasWideColumnsIn = tmp16 & HAS_WIDE_COLUMNS;
+  columnarOutput = tmp16 & COLUMNAR_ROWGROUP_DATA;
 
   // This used to signify that there was input row data from previous jobsteps, and
   // it never quite worked right. No need to fix it or update it; all BPP's have started
@@ -511,6 +519,25 @@ void BatchPrimitiveProcessor::initBPP(ByteStream& bs)
         }
       }
     }
+
+    bs >> fTopNLimit;
+
+    if (fTopNLimit > 0)
+    {
+      uint32_t specCount;
+      int32_t index;
+      int8_t asc, nullsFirst;
+      bs >> specCount;
+      fTopNSpec.clear();
+
+      for (i = 0; i < specCount; ++i)
+      {
+        bs >> index >> asc >> nullsFirst;
+        fTopNSpec.emplace_back(index, asc > 0, nullsFirst > 0);
+      }
+    }
+
+    bs >> fLimit;
   }
 
   initProcessor();
@@ -585,6 +612,8 @@ void BatchPrimitiveProcessor::resetBPP(ByteStream& bs, const SP_UM_MUTEX& w, con
 
   /* init vars not part of the BS */
   currentBlockOffset = 0;
+  ioSuspendCount = 0;
+  loadingLBIDs.clear();
   memset(relLBID.get(), 0, sizeof(uint64_t) * (projectCount + 2));
   memset(asyncLoaded.get(), 0, sizeof(bool) * (projectCount + 2));
 
@@ -1110,6 +1139,10 @@ void BatchPrimitiveProcessor::initProcessor()
       fAggregator->setInputOutput(fe2 ? fe2Output : outputRG, &fAggregateRG);
   }
 
+  // The UM sends the Top-N only for the scans it can replace the output of
+  if (fTopNLimit > 0 && !doJoin && !fAggregator)
+    fTopN.reset(new ordering::TopNRows(fe2 ? fe2Output : outputRG, fTopNSpec, fTopNLimit));
+
   if (LIKELY(!hasWideColumnOut))
   {
     minVal = MAX64;
@@ -1389,8 +1422,12 @@ void BatchPrimitiveProcessor::execute(messageqcpp::SBS& bs)
 #endif
     utils::setThreadName("BPPFilt&Pr");
 
+    // The job has sent the rows of the LIMIT or the chunk zone map rules out the filter, the
+    // logical block goes out empty without being read
+    const bool skipBlock = blockSkipped;
+
     // if only one scan step which has no predicate, async load all columns
-    if (filterCount == 1 && hasScan)
+    if (filterCount == 1 && hasScan && !skipBlock)
     {
       ColumnCommand* col = dynamic_cast<ColumnCommand*>(filterSteps[0].get());
 
@@ -1431,7 +1468,11 @@ void BatchPrimitiveProcessor::execute(messageqcpp::SBS& bs)
 #endif
 
     // filters use relrids and values for intermediate results.
-    if (bop == BOP_AND)
+    if (skipBlock)
+    {
+      ridCount = 0;
+    }
+    else if (bop == BOP_AND)
     {
       for (j = 0; j < filterCount; ++j)
       {
@@ -1633,11 +1674,12 @@ void BatchPrimitiveProcessor::execute(messageqcpp::SBS& bs)
             }
           }
 
-          if (!fAggregator)
+          if (!fAggregator && !fTopN)
           {
             *bs << (uint8_t)1;  // the "count this msg" var
             fe2Output.setDBRoot(dbRoot);
-            fe2Output.serializeRGData(*bs);
+            serializeRowGroup(fe2Output, *bs);
+            fLimitRows += fe2Output.getRowCount();
             //*serialized << fe2Output.getDataSize();
             // serialized->append(fe2Output.getData(), fe2Output.getDataSize());
           }
@@ -1676,12 +1718,34 @@ void BatchPrimitiveProcessor::execute(messageqcpp::SBS& bs)
           }  // @bug4507, 8k
         }
 
-        if (!fAggregator && !fe2)
+        if (fTopN)
+        {
+          *bs << (uint8_t)1;  // the "count this msg" var
+
+          // Only the Top-N of the whole job is sent, with the last logical block
+          RowGroup& toSort = (fe2 ? fe2Output : outputRG);
+          fTopN->addRows(toSort);
+
+          if ((currentBlockOffset + 1) == count)
+          {
+            fTopN->result().setDBRoot(dbRoot);
+            serializeRowGroup(fTopN->result(), *bs);
+            fTopN->reset();
+          }
+          else
+          {
+            toSort.resetRowGroup(baseRid);
+            toSort.setDBRoot(dbRoot);
+            serializeRowGroup(toSort, *bs);
+          }
+        }
+        else if (!fAggregator && !fe2)
         {
           *bs << (uint8_t)1;  // the "count this msg" var
           outputRG.setDBRoot(dbRoot);
           // cerr << "serializing " << outputRG.toString() << endl;
-          outputRG.serializeRGData(*bs);
+          serializeRowGroup(outputRG, *bs);
+          fLimitRows += outputRG.getRowCount();
 
           //*serialized << outputRG.getDataSize();
           // serialized->append(outputRG.getData(), outputRG.getDataSize());
@@ -1826,7 +1890,7 @@ void BatchPrimitiveProcessor::execute(messageqcpp::SBS& bs)
               else
               {
                 // cerr <<" * serialzing " << nextRG.toString() << endl;
-                nextRG.serializeRGData(*bs);
+                serializeRowGroup(nextRG, *bs);
               }
 
               /* send the msg & reinit the BS */
@@ -1869,7 +1933,7 @@ void BatchPrimitiveProcessor::execute(messageqcpp::SBS& bs)
             *bs << (uint8_t)(startRid > 0 ? 0 : 1);  // the "count this msg" var
             outputRG.setDBRoot(dbRoot);
             // cerr << "serializing " << outputRG.toString() << endl;
-            outputRG.serializeRGData(*bs);
+            serializeRowGroup(outputRG, *bs);
 
             //*serialized << outputRG.getDataSize();
             // serialized->append(outputRG.getData(), outputRG.getDataSize());
@@ -2057,40 +2121,54 @@ void BatchPrimitiveProcessor::serializeStrings(messageqcpp::SBS& bs)
     *bs << strValues[i];
 }
 
+// The receiving side accepts both formats in RGData::deserialize().
+void BatchPrimitiveProcessor::serializeRowGroup(const rowgroup::RowGroup& rg,
+                                                messageqcpp::ByteStream& bs) const
+{
+  if (columnarOutput)
+    rg.serializeRGDataColumnar(bs);
+  else
+    rg.serializeRGData(bs);
+}
+
 void BatchPrimitiveProcessor::sendResponse(messageqcpp::SBS& bs)
 {
   // Here is the fast path for local EM to PM interaction. PM puts into the
   // input EM DEC queue directly.
   // !writelock has a 'same host connection' semantics here.
+  // Results are written directly while there are flow control credits for them,
+  // otherwise they wait for the credits in the send thread.
+  bool sendNow = sendThread->tryTakeCredits(bs->lengthWithHdrOverhead());
+
   if (initiatedByEM_ && !writelock)
   {
     // Flow Control now handles same node connections so the recieving DEC queue
     // is limited.
-    if (sendThread->flowControlEnabled())
+    if (sendNow)
     {
-      sendThread->sendResult({bs, sock, writelock, 0}, false);
+      sock->write(bs);
+      bs.reset();
     }
     else
     {
-      sock->write(bs);
-      bs.reset();
+      sendThread->sendResult({bs, sock, writelock, 0}, false);
     }
 
     return;
   }
 
-  if (sendThread->flowControlEnabled())
+  if (sendNow)
+  {
+    boost::mutex::scoped_lock lk(*writelock);
+    sock->write(*bs);
+  }
+  else
   {
     // newConnection should be set only for the first result of a batch job
     // it tells sendthread it should consider it for the connection array
     sendThread->sendResult(BPPSendThread::Msg_t(bs, sock, writelock, sockIndex), newConnection);
     newConnection = false;
   }
-  else
-  {
-    boost::mutex::scoped_lock lk(*writelock);
-    sock->write(*bs);
-  }
 
   bs.reset();
 }
@@ -2193,8 +2271,23 @@ int BatchPrimitiveProcessor::operator()()
   if (fAggregator && currentBlockOffset == 0)  // @bug4507, 8k
     fAggregator->aggReset();                   // @bug4507, 8k
 
+  if (fTopN && currentBlockOffset == 0)
+    fTopN->reset();
+
+  if (currentBlockOffset == 0)
+  {
+    fLimitRows = 0;
+    zoneMapHeaders.clear();
+    dictBloomResults.clear();
+    dictOrderFiles.clear();
+    dictOrderBlocks.clear();
+  }
+
   for (; currentBlockOffset < count; currentBlockOffset++)
   {
+    // Once the rows of the LIMIT are sent the remaining blocks are neither read nor waited for.
+    blockSkipped = (fLimit > 0 && fLimitRows >= fLimit) || chunkCantMatch();
+
     if (!(sessionID & 0x80000000))  // can't do this with syscat queries
     {
       if (sendThread->aborted())
@@ -2206,6 +2299,19 @@ int BatchPrimitiveProcessor::operator()()
         freeLargeBuffers();
         return -1;  // the reschedule error code
       }
+
+      // The blocks of this logical block are read in the background meanwhile, the thread can
+      // run other jobs instead of waiting for the disk. The job resumes from currentBlockOffset
+      // and the growing job weight puts it behind the ready jobs of the other queries.
+      if (suspendOnCacheMiss && !blockSkipped && ioSuspendCount < maxIOSuspends && columnBlocksLoading())
+      {
+        ++ioSuspendCount;
+        freeLargeBuffers();
+        return threadpool::RescheduleOnIO;
+      }
+
+      ioSuspendCount = 0;
+      loadingLBIDs.clear();
     }
 
     allocLargeBuffers();
@@ -2370,6 +2476,7 @@ SBPP BatchPrimitiveProcessor::duplicate()
   bpp->filtOnString = filtOnString;
   bpp->hasRowGroup = hasRowGroup;
   bpp->getTupleJoinRowGroupData = getTupleJoinRowGroupData;
+  bpp->columnarOutput = columnarOutput;
   bpp->bop = bop;
   bpp->hasPassThru = hasPassThru;
   bpp->forHJ = forHJ;
@@ -2470,6 +2577,10 @@ SBPP BatchPrimitiveProcessor::duplicate()
     bpp->fAggregator->timeZone(fAggregator->timeZone());
   }
 
+  bpp->fTopNSpec = fTopNSpec;
+  bpp->fTopNLimit = fTopNLimit;
+  bpp->fLimit = fLimit;
+
   bpp->sendRidsAtDelivery = sendRidsAtDelivery;
   bpp->prefetchThreshold = prefetchThreshold;
 
@@ -2510,6 +2621,193 @@ void BatchPrimitiveProcessor::asyncLoadProjectColumns()
   }
 }
 
+// Starts loading the first block of every column the current logical block reads asynchronously if it
+// isn't cached. Returns true if a load was started, the job has nothing to wait for otherwise: either
+// the blocks are cached, the loaders this job started for them before are still reading, or all the
+// loaders are busy, and it reads them itself.
+bool BatchPrimitiveProcessor::columnBlocksLoading()
+{
+  bool newReads = false;
+
+  auto checkBlock = [&](uint64_t lbid, int compType)
+  {
+    if (std::find(loadingLBIDs.begin(), loadingLBIDs.end(), lbid) != loadingLBIDs.end())
+      return;
+
+    bool readStarted = false;
+    loadBlockAsync(lbid, versionInfo, txnID, compType, &cachedIO, &physIO, LBIDTrace, sessionID, &counterLock,
+                   &busyLoaderCount, sendThread, &vssCache, &readStarted);
+
+    if (readStarted)
+    {
+      loadingLBIDs.push_back(lbid);
+      newReads = true;
+    }
+  };
+
+  auto checkColumn = [&](Command* step)
+  {
+    ColumnCommand* col = dynamic_cast<ColumnCommand*>(step);
+
+    if (col == nullptr || col->getLBID() == 0)
+      return;
+
+    checkBlock(col->getLBID(), col->getCompType());
+
+    if (col->hasAuxCol())
+      checkBlock(col->getLBIDAux(), 2);
+  };
+
+  for (uint32_t i = 0; i < filterCount; ++i)
+    checkColumn(filterSteps[i].get());
+
+  for (uint32_t i = 0; i < projectCount; ++i)
+    checkColumn(projectSteps[i].get());
+
+  return newReads;
+}
+
+bool BatchPrimitiveProcessor::chunkCantMatch()
+{
+  // With HDFS there is no version buffer to tell the blocks changed after the query started
+  if (noVB || !hasScan || bop != BOP_AND || (sessionID & 0x80000000))
+    return false;
+
+  for (uint32_t i = 0; i < filterCount; ++i)
+  {
+    if (dictBloomFilters && i > 0 && dictCantMatch(i))
+      return true;
+
+    ColumnCommand* col = dynamic_cast<ColumnCommand*>(filterSteps[i].get());
+    compress::ChunkZoneMap zoneMap;
+
+    if (!chunkZoneMaps || col == nullptr || col->getFilterCount() == 0 || col->getCompType() == 0 ||
+        col->getWidth() > 8 || col->getLBID() == 0)
+      continue;
+
+    if (getChunkZoneMap(col->getLBID(), col->getWidth(), zoneMap) && !col->canMatch(zoneMap))
+      return true;
+  }
+
+  return false;
+}
+
+bool BatchPrimitiveProcessor::dictCantMatch(uint32_t step)
+{
+  // The dictionary step filters the strings of the tokens of the column step before it
+  DictStep* dict = dynamic_cast<DictStep*>(filterSteps[step].get());
+  ColumnCommand* col = dynamic_cast<ColumnCommand*>(filterSteps[step - 1].get());
+
+  if (dict == nullptr || col == nullptr || dict->getBloomHashes().empty() ||
+      dict->filterFeeder() != Command::NOT_FEEDER || col->getLBID() == 0)
+    return false;
+
+  // The store files are append only, a token in the column has its string in the segment
+  // file the filter was built from whatever version of the block the query reads
+  BRM::OID_t oid;
+  uint16_t dbRoot;
+  uint32_t partNum;
+  uint16_t segNum;
+  uint32_t fbo;
+
+  if (brm->lookupLocal(col->getLBID(), 0, false, oid, dbRoot, partNum, segNum, fbo) != 0)
+    return false;
+
+  SegmentFile file(dict->getOID(), dbRoot, partNum, segNum);
+  auto it = dictBloomResults.find(file);
+
+  if (it == dictBloomResults.end())
+  {
+    bool mayMatch = dictBloomFilterMayMatch(dict->getOID(), dbRoot, partNum, segNum,
+                                            dict->getCharsetNumber(), dict->getBloomHashes());
+    it = dictBloomResults.insert(make_pair(file, mayMatch)).first;
+  }
+
+  return !it->second;
+}
+
+boost::shared_ptr<const utils::DictOrderIndex> BatchPrimitiveProcessor::getDictOrderIndex(
+    uint64_t lbid, uint32_t charsetNumber)
+{
+  boost::shared_ptr<const utils::DictOrderIndex> index;
+
+  if (!dictOrderIndexes)
+    return index;
+
+  auto it = dictOrderBlocks.find(lbid);
+
+  if (it != dictOrderBlocks.end())
+    return it->second;
+
+  // The codes are those of the tokens in the file whatever version of the blocks the query reads,
+  // the strings of the tokens never change and the tokens not in the index have no code
+  BRM::OID_t oid;
+  uint16_t dbRoot;
+  uint32_t partNum;
+  uint16_t segNum;
+  uint32_t fbo;
+
+  if (brm->lookupLocal(lbid, 0, false, oid, dbRoot, partNum, segNum, fbo) == 0)
+  {
+    SegmentFile file(oid, dbRoot, partNum, segNum);
+    auto fileIt = dictOrderFiles.find(file);
+
+    if (fileIt == dictOrderFiles.end())
+      fileIt = dictOrderFiles
+                   .insert(make_pair(file, dictOrderIndex(oid, dbRoot, partNum, segNum, charsetNumber)))
+                   .first;
+
+    index = fileIt->second;
+  }
+
+  dictOrderBlocks.insert(make_pair(lbid, index));
+  return index;
+}
+
+bool BatchPrimitiveProcessor::getChunkZoneMap(uint64_t lbid, uint32_t blockCount,
+                                              compress::ChunkZoneMap& zoneMap)
+{
+  // The zone map is about the blocks in the segment file. It doesn't hold for the versions
+  // of the blocks the query reads from the version buffer, nor for the blocks this txn changes.
+  for (uint64_t i = lbid; i < lbid + blockCount; i++)
+  {
+    VSSCache::iterator it = vssCache.find(i);
+
+    if (it == vssCache.end())
+    {
+      BRM::VSSData vd;
+      vd.returnCode = brm->vssLookup(i, versionInfo, txnID, &vd.verID, &vd.vbFlag);
+      it = vssCache.insert(make_pair(i, vd)).first;
+    }
+
+    const BRM::VSSData& vd = it->second;
+
+    if (vd.returnCode == BRM::ERR_SNAPSHOT_TOO_OLD || vd.vbFlag || (txnID > 0 && vd.verID == (int)txnID))
+      return false;
+  }
+
+  BRM::OID_t oid;
+  uint16_t dbRoot;
+  uint32_t partNum;
+  uint16_t segNum;
+  uint32_t fbo;
+
+  if (brm->lookupLocal(lbid, 0, false, oid, dbRoot, partNum, segNum, fbo) != 0)
+    return false;
+
+  SegmentFile file(oid, dbRoot, partNum, segNum);
+  auto it = zoneMapHeaders.find(file);
+
+  if (it == zoneMapHeaders.end())
+    it = zoneMapHeaders.insert(make_pair(file, readCompressedHeader(oid, dbRoot, partNum, segNum))).first;
+
+  if (!it->second)
+    return false;
+
+  const uint32_t blocksPerChunk = compress::CompressInterface::UNCOMPRESSED_INBUF_LEN / BLOCK_SIZE;
+  return compress::CompressInterface::getChunkZoneMap(it->second.get(), fbo / blocksPerChunk, zoneMap);
+}
+
 bool BatchPrimitiveProcessor::generateJoinedRowGroup(rowgroup::Row& baseRow, const uint32_t depth)
 {
   Row& smallRow = smallRows[depth];
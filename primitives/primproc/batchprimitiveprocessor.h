@@ -31,8 +31,11 @@
 #pragma once
 
 #include <boost/scoped_array.hpp>
+#include <boost/shared_array.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <map>
+#include <tuple>
 #include <unordered_map>
 #include <boost/thread.hpp>
 
@@ -47,8 +50,11 @@
 #include "rowgroup.h"
 #include "rowaggregation.h"
 #include "funcexpwrapper.h"
+#include "../../utils/windowfunction/topnrows.h"
 #include "bppsendthread.h"
 #include "columnwidth.h"
+#include "idbcompress.h"
+#include "dictorderindex.h"
 
 #ifdef PRIMPROC_STOPWATCH
 #include "stopwatch.h"
@@ -195,6 +201,7 @@ class BatchPrimitiveProcessor
   void writeProjectionPreamble(messageqcpp::SBS& bs);
   void makeResponse(messageqcpp::SBS& bs);
   void sendResponse(messageqcpp::SBS& bs);
+  void serializeRowGroup(const rowgroup::RowGroup& rg, messageqcpp::ByteStream& bs) const;
   /* Used by scan operations to increment the LBIDs in successive steps */
   void nextLBID();
 
@@ -203,6 +210,15 @@ class BatchPrimitiveProcessor
   void serializeStrings(messageqcpp::SBS& bs);
 
   void asyncLoadProjectColumns();
+  // True if a block the current logical block reads is not cached and is being read now
+  bool columnBlocksLoading();
+  // True if the chunk zone map of a filter column or the Bloom filter of a dictionary shows that no
+  // row of the logical block matches
+  bool chunkCantMatch();
+  bool getChunkZoneMap(uint64_t lbid, uint32_t blockCount, compress::ChunkZoneMap& zoneMap);
+  bool dictCantMatch(uint32_t step);
+  // The order index of the store segment file of a dictionary block, null if it has none
+  boost::shared_ptr<const utils::DictOrderIndex> getDictOrderIndex(uint64_t lbid, uint32_t charsetNumber);
   void writeErrorMsg(messageqcpp::SBS& bs, const std::string& error, uint16_t errCode, bool logIt = true, bool critical = true);
 
   BPSOutputType ot;
@@ -241,6 +257,8 @@ class BatchPrimitiveProcessor
   uint16_t filterCount;
   uint16_t projectCount;
   bool sendRidsAtDelivery;
+  // Send the output RowGroups column-wise encoded, see RGData::serializeColumnar().
+  bool columnarOutput;
   uint16_t ridMap;
   bool gotAbsRids;
   bool gotValues;
@@ -378,6 +396,26 @@ class BatchPrimitiveProcessor
   rowgroup::RowGroup fAggregateRG;
   rowgroup::RGData fAggRowGroupData;
 
+  /* PM Top-N of ORDER BY ... LIMIT, it replaces the output of a job with its first rows */
+  std::vector<ordering::IdbSortSpec> fTopNSpec;
+  uint32_t fTopNLimit = 0;
+  boost::scoped_ptr<ordering::TopNRows> fTopN;
+
+  /* LIMIT without ORDER BY, the job doesn't read more blocks once it has sent fLimit rows */
+  uint64_t fLimit = 0;
+  uint64_t fLimitRows = 0;
+
+  /* Chunk zone maps, the control headers of the compressed files are read once per job */
+  typedef std::tuple<BRM::OID_t, uint16_t, uint32_t, uint16_t> SegmentFile;
+  std::map<SegmentFile, boost::shared_array<char>> zoneMapHeaders;
+  // Whether the Bloom filter of a dictionary segment file may hold the strings of the filter
+  std::map<SegmentFile, bool> dictBloomResults;
+  // The order indexes of the dictionary segment files and of the store blocks of the tokens
+  std::map<SegmentFile, boost::shared_ptr<const utils::DictOrderIndex>> dictOrderFiles;
+  std::map<uint64_t, boost::shared_ptr<const utils::DictOrderIndex>> dictOrderBlocks;
+  // The current logical block is not read: the LIMIT is reached or the chunk can't match
+  bool blockSkipped = false;
+
   /* OR hacks */
   uint8_t bop;  // BOP_AND or BOP_OR
   bool hasPassThru;
@@ -409,6 +447,12 @@ class BatchPrimitiveProcessor
 
   /* To support reentrancy */
   uint32_t currentBlockOffset;
+  // The number of times the job gave up its thread waiting for the blocks of the current logical block
+  uint32_t ioSuspendCount = 0;
+  static const uint32_t maxIOSuspends = 16;
+  // The blocks of the current logical block this job started loaders for, a resumed job doesn't
+  // start them again nor suspends on them
+  std::vector<uint64_t> loadingLBIDs;
   boost::scoped_array<uint64_t> relLBID;
   boost::scoped_array<bool> asyncLoaded;
 
@@ -140,28 +140,49 @@ void BPPSendThread::sendResults(const vector<Msg_t>& msgs, bool newConnection)
     queueNotEmpty.notify_one();
 }
 
-void BPPSendThread::sendMore(int num)
+void BPPSendThread::setCredits(uint32_t msgs, int64_t bytes)
 {
   std::unique_lock<std::mutex> sl(ackLock);
 
-  if (num == -1)
+  if (msgs == NoFlowControl)
     fcEnabled = false;
-  else if (num == 0)
+  else
   {
+    msgCredits = msgs;
+    byteCredits = bytes;
     fcEnabled = true;
-    msgsLeft = 0;
   }
-  else
-    (void)atomicops::atomicAdd(&msgsLeft, num);
 
   sl.unlock();
   if (waiting)
     okToSend.notify_one();
 }
 
-bool BPPSendThread::flowControlEnabled()
+void BPPSendThread::addCredits(uint32_t msgs, int64_t bytes)
+{
+  std::unique_lock<std::mutex> sl(ackLock);
+  msgCredits += msgs;
+  byteCredits += bytes;
+  sl.unlock();
+
+  if (waiting)
+    okToSend.notify_one();
+}
+
+bool BPPSendThread::tryTakeCredits(uint64_t bytes)
 {
-  return fcEnabled;
+  if (!fcEnabled)
+    return true;
+
+  std::lock_guard<std::mutex> sl(ackLock);
+
+  // Don't overtake the queued results, they wait for the same credits.
+  if (currentByteSize > 0 || !haveCredits() || die)
+    return false;
+
+  --msgCredits;
+  byteCredits -= bytes;
+  return true;
 }
 
 void BPPSendThread::mainLoop()
@@ -199,17 +220,17 @@ void BPPSendThread::mainLoop()
     sl.unlock();
 
     /* In the send loop below, msgsSent tracks progress on sending the msg array,
-     * i how many msgs are sent by 1 run of the loop, limited by msgCount or msgsLeft. */
+     * i how many msgs are sent by 1 run of the loop, limited by msgCount or the credits. */
     msgsSent = 0;
 
     while (msgsSent < msgCount && !die)
     {
       uint64_t bsSize;
 
-      if (msgsLeft <= 0 && fcEnabled && !die)
+      if (fcEnabled && !haveCredits() && !die)
       {
         std::unique_lock<std::mutex> sl2(ackLock);
-        while (msgsLeft <= 0 && fcEnabled && !die)
+        while (fcEnabled && !haveCredits() && !die)
         {
           waiting = true;
           okToSend.wait(sl2);
@@ -217,7 +238,7 @@ void BPPSendThread::mainLoop()
         }
       }
 
-      for (i = 0; msgsSent < msgCount && ((fcEnabled && msgsLeft > 0) || !fcEnabled) && !die; msgsSent++, i++)
+      for (i = 0; msgsSent < msgCount && (!fcEnabled || haveCredits()) && !die; msgsSent++, i++)
       {
         if (doLoadBalancing)
         {
@@ -254,7 +275,12 @@ void BPPSendThread::mainLoop()
           }
         }
 
-        (void)atomicops::atomicDec(&msgsLeft);
+        if (fcEnabled)
+        {
+          --msgCredits;
+          byteCredits -= bsSize;
+        }
+
         (void)atomicops::atomicSub(&currentByteSize, bsSize);
         msg[msgsSent].msg.reset();
       }
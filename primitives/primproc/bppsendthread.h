@@ -28,7 +28,9 @@
 #include "umsocketselector.h"
 #include <queue>
 #include <set>
+#include <atomic>
 #include <condition_variable>
+#include <limits>
 #include <utility>
 #include "threadnaming.h"
 #include "fair_threadpool.h"
@@ -38,7 +40,7 @@ namespace primitiveprocessor
 class BPPSendThread
 {
  public:
-  BPPSendThread();  // starts unthrottled
+  BPPSendThread();  // starts without flow control
   virtual ~BPPSendThread();
 
   struct Msg_t
@@ -67,11 +69,18 @@ class BPPSendThread
            !die;
   }
 
-  void sendMore(int num);
+  // The UM sends this instead of the credits when the flow control is off for a query
+  static constexpr uint32_t NoFlowControl = std::numeric_limits<uint32_t>::max();
+
+  // Sets the initial credits sent by the UM with the BPP, see joblist::FlowControlCredits.
+  void setCredits(uint32_t msgs, int64_t bytes);
+  void addCredits(uint32_t msgs, int64_t bytes);
+  // Returns true if a result of `bytes` may be written right away by the caller:
+  // the flow control is off, or nothing is queued and the credits for it are taken.
+  bool tryTakeCredits(uint64_t bytes);
   void sendResults(const std::vector<Msg_t>& msgs, bool newConnection);
   void sendResult(const Msg_t& msg, bool newConnection);
   void mainLoop();
-  bool flowControlEnabled();
   void abort();
   inline bool aborted() const
   {
@@ -108,7 +117,9 @@ class BPPSendThread
   volatile bool mainThreadWaiting = false;
   std::string exceptionString;
   uint32_t queueMsgThresh = 0;
-  volatile int32_t msgsLeft = -1;
+  // Flow control credits. A message needs one message credit and may overdraw the byte credits.
+  std::atomic<int64_t> msgCredits{0};
+  std::atomic<int64_t> byteCredits{0};
   bool waiting = false;
   std::mutex ackLock;
   std::condition_variable okToSend;
@@ -138,6 +149,11 @@ class BPPSendThread
   bool sawAllConnections = false;
   volatile bool fcEnabled = false;
 
+  bool haveCredits() const
+  {
+    return msgCredits > 0 && byteCredits > 0;
+  }
+
   /* secondary queue size restriction based on byte size */
   volatile uint64_t currentByteSize = 0;
   uint64_t queueBytesThresh;
@@ -42,6 +42,7 @@ using namespace std;
 #include "primproc.h"
 #include "stats.h"
 #include "datatypes/mcs_int128.h"
+#include "nullvaluemanip.h"
 
 using namespace messageqcpp;
 using namespace rowgroup;
@@ -950,6 +951,64 @@ void ColumnCommand::enableFilters()
   prep(primMsg->OutputType, makeAbsRids);
 }
 
+bool ColumnCommand::canMatch(const compress::ChunkZoneMap& zoneMap) const
+{
+  if (!parsedColumnFilter || suppressFilter || filterCount == 0)
+    return true;
+
+  // The filter arguments are extended to int64 the same way as the zone map values
+  const bool isUnsigned = datatypes::isUnsigned(colType.colDataType);
+  const int64_t nullValue =
+      isUnsigned ? static_cast<int64_t>(utils::getNullValue(colType.colDataType, colType.colWidth))
+                 : utils::getSignedNullValue(colType.colDataType, colType.colWidth);
+  const bool hasValues = (zoneMap.flags & compress::ChunkZoneMap::HAS_VALUES) != 0;
+  auto less = [isUnsigned](int64_t lhs, int64_t rhs)
+  { return isUnsigned ? static_cast<uint64_t>(lhs) < static_cast<uint64_t>(rhs) : lhs < rhs; };
+  bool all = true;
+  bool any = false;
+
+  for (uint32_t i = 0; i < filterCount; ++i)
+  {
+    const int64_t arg = parsedColumnFilter->prestored_argVals[i];
+    const uint8_t cop = parsedColumnFilter->prestored_cops[i];
+    bool match = true;
+
+    if (cop == COMPARE_NULLEQ)
+      match = zoneMap.nullCount > 0;
+    else if (arg == nullValue)
+      match = cop != COMPARE_NE || hasValues;  // IS NOT NULL
+    else if (!hasValues)
+      match = false;  // NULLs match only the NULL value
+    else if (parsedColumnFilter->prestored_rfs[i] == 0)
+    {
+      switch (cop)
+      {
+        case COMPARE_EQ: match = !less(arg, zoneMap.min) && !less(zoneMap.max, arg); break;
+
+        case COMPARE_LT: match = less(zoneMap.min, arg); break;
+
+        case COMPARE_LE: match = !less(arg, zoneMap.min); break;
+
+        case COMPARE_GT: match = less(arg, zoneMap.max); break;
+
+        case COMPARE_GE: match = !less(zoneMap.max, arg); break;
+
+        case COMPARE_NE: match = zoneMap.min != arg || zoneMap.max != arg; break;
+
+        default: break;
+      }
+    }
+
+    all = all && match;
+    any = any || match;
+  }
+
+  if (filterCount == 1)
+    return any;
+
+  return BOP == BOP_AND ? all : (BOP == BOP_OR ? any : true);
+}
+
 void ColumnCommand::getLBIDList(uint32_t loopCount, vector<int64_t>* lbids)
 {
   int64_t firstLBID = lbid, lastLBID = firstLBID + (loopCount * colType.colWidth) - 1, i;
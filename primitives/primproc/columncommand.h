@@ -35,6 +35,7 @@
 #include "columnwidth.h"
 #include "command.h"
 #include "calpontsystemcatalog.h"
+#include "idbcompress.h"
 
 namespace primitiveprocessor
 {
@@ -117,6 +118,9 @@ class ColumnCommand : public Command
     return colType.compressionType;
   }
 
+  // False if no value of a chunk with the zone map passes the filter
+  virtual bool canMatch(const compress::ChunkZoneMap& zoneMap) const;
+
  protected:
   virtual void loadData();
   template <int W>
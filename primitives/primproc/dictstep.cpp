@@ -32,6 +32,7 @@
 #include <algorithm>
 
 #include "bpp.h"
+#include "dictbloomfilter.h"
 #include "primitiveserver.h"
 #include "pp_logger.h"
 #include "../linux-port/primitiveprocessor.h"
@@ -44,6 +45,14 @@ namespace primitiveprocessor
 {
 extern uint32_t dictBufferSize;
 
+namespace
+{
+// An IN list longer than this rarely misses every filter of a segment
+const uint32_t MAX_BLOOM_VALUES = 64;
+// Order indexes a step keeps the results of its filter for
+const size_t MAX_CODE_MATCHES = 64;
+}  // namespace
+
 DictStep::DictStep() : Command(DICT_STEP), strValues(NULL), filterCount(0), bufferSize(0)
 {
   fMinMax[0] = MAX_UBIGINT;
@@ -69,6 +78,7 @@ DictStep& DictStep::operator=(const DictStep& d)
   charsetNumber = d.charsetNumber;
   fMinMax[0] = d.fMinMax[0];
   fMinMax[1] = d.fMinMax[1];
+  bloomHashes = d.bloomHashes;
   return *this;
 }
 
@@ -101,9 +111,61 @@ void DictStep::createCommand(ByteStream& bs)
   else
     bs >> filterString;
 
+  makeBloomHashes();
   Command::createCommand(bs);
 }
 
+void DictStep::makeBloomHashes()
+{
+  datatypes::Charset cs(charsetNumber);
+  bloomHashes.clear();
+
+  if (filterCount == 0 || filterCount > MAX_BLOOM_VALUES)
+    return;
+
+  // The strings the filter looks for, the empty ones don't get into the store files
+  if (hasEqFilter)
+  {
+    if (eqOp != COMPARE_EQ)
+      return;
+
+    for (const auto& str : *eqFilter)
+    {
+      if (str.empty())
+      {
+        bloomHashes.clear();
+        return;
+      }
+
+      bloomHashes.push_back(utils::DictBloomFilter::hash(cs, str.data(), str.length()));
+    }
+
+    return;
+  }
+
+  if (filterCount > 1 && BOP != BOP_OR)
+    return;
+
+  ByteStream filters(filterString);
+  uint8_t cop;
+  uint16_t size;
+
+  for (uint32_t i = 0; i < filterCount; i++)
+  {
+    filters >> cop;
+    filters >> size;
+
+    if (cop != COMPARE_EQ || size == 0 || filters.length() < size)
+    {
+      bloomHashes.clear();
+      return;
+    }
+
+    bloomHashes.push_back(utils::DictBloomFilter::hash(cs, (const char*)filters.buf(), size));
+    filters.advance(size);
+  }
+}
+
 void DictStep::resetCommand(ByteStream& bs)
 {
 }
@@ -359,6 +421,11 @@ void DictStep::_execute()
   while (i < bpp->ridCount)
   {
     l_lbid = ((int64_t)newRidList[i].token) >> 10;
+
+    // The tokens with codes in an order index are filtered without reading their strings
+    if (fFilterFeeder == NOT_FEEDER && l_lbid >= 0 && filterByCodes(l_lbid, newRidList.get(), i))
+      continue;
+
     primMsg->LBID = (l_lbid == -1) ? l_lbid : l_lbid & 0xFFFFFFFFFL;
     primMsg->NVALS = 0;
 
@@ -413,6 +480,70 @@ void DictStep::_execute()
   // cout << "DS: /_execute()\n";
 }
 
+bool DictStep::filterByCodes(int64_t lbid, const OrderedToken* tokens, uint64_t& i)
+{
+  boost::shared_ptr<const utils::DictOrderIndex> index =
+      bpp->getDictOrderIndex(lbid & 0xFFFFFFFFFL, charsetNumber);
+
+  if (!index)
+    return false;
+
+  const std::vector<uint8_t>* matches = getCodeMatches(index);
+
+  if (matches == nullptr)
+    return false;
+
+  // The codes of all the tokens of the block are looked up before any row is taken
+  auto block = index->blockTokens(lbid & 0xFFFFFFFFFL);
+  tokenCodes.clear();
+
+  for (uint64_t j = i; j < bpp->ridCount && (((int64_t)tokens[j].token) >> 10) == lbid; j++)
+  {
+    uint32_t code;
+
+    if (!utils::DictOrderIndex::find(block.first, block.second, tokens[j].token, code))
+      return false;
+
+    tokenCodes.push_back(code);
+  }
+
+  // The rows are taken in the order processResult() takes them
+  for (auto code : tokenCodes)
+  {
+    if ((*matches)[code])
+    {
+      bpp->absRids[tmpResultCounter] = tokens[i].rid;
+      bpp->relRids[tmpResultCounter] = tokens[i].rid - bpp->baseRid;
+      tmpResultCounter++;
+    }
+
+    i++;
+  }
+
+  return true;
+}
+
+const std::vector<uint8_t>* DictStep::getCodeMatches(
+    const boost::shared_ptr<const utils::DictOrderIndex>& index)
+{
+  auto it = codeMatches.find(index.get());
+
+  if (it == codeMatches.end())
+  {
+    if (codeMatches.size() >= MAX_CODE_MATCHES)
+      codeMatches.clear();
+
+    // The entry holds the index, another one can't get its address
+    it = codeMatches.insert(make_pair(index.get(), CodeMatches())).first;
+    it->second.index = index;
+    it->second.usable = primitives::PrimitiveProcessor::dictCodeMatches(
+        *index, filterString.buf(), eqFilter ? 0 : filterCount, BOP, charsetNumber, eqFilter, eqOp,
+        it->second.matches);
+  }
+
+  return it->second.usable ? &it->second.matches : nullptr;
+}
+
 /* This will do the same thing as execute() but put the result in bpp->serialized */
 void DictStep::_project(messageqcpp::SBS& bs)
 {
@@ -694,6 +825,7 @@ SCommand DictStep::duplicate()
   ds->filterString = filterString;
   ds->filterCount = filterCount;
   ds->charsetNumber = charsetNumber;
+  ds->bloomHashes = bloomHashes;
   ds->Command::operator=(*this);
   return ret;
 }
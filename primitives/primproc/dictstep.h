@@ -30,7 +30,11 @@
 
 #pragma once
 
+#include <map>
+#include <vector>
+
 #include "command.h"
+#include "dictorderindex.h"
 #include "primitivemsg.h"
 
 namespace primitiveprocessor
@@ -68,10 +72,20 @@ class DictStep : public Command
   {
     compressionType = ct;
   }
+  uint32_t getCharsetNumber() const
+  {
+    return charsetNumber;
+  }
+  // The hashes of the strings an equality filter looks for, empty if it isn't one
+  const std::vector<uint32_t>& getBloomHashes() const
+  {
+    return bloomHashes;
+  }
 
  private:
   DictStep(const DictStep&);
   DictStep& operator=(const DictStep&);
+  void makeBloomHashes();
 
   struct StringPtr
   {
@@ -131,6 +145,21 @@ class DictStep : public Command
   void copyResultToTmpSpace(OrderedToken* ot);
   void copyResultToFinalPosition(OrderedToken* ot);
 
+  // Filters the tokens of a store block by their codes in the order index of its segment file,
+  // false if some token has no code
+  bool filterByCodes(int64_t lbid, const OrderedToken* tokens, uint64_t& i);
+  const std::vector<uint8_t>* getCodeMatches(const boost::shared_ptr<const utils::DictOrderIndex>& index);
+
+  // Whether the string of each code of an order index passes the filter
+  struct CodeMatches
+  {
+    boost::shared_ptr<const utils::DictOrderIndex> index;
+    std::vector<uint8_t> matches;
+    bool usable;  // the filter can be evaluated on the codes
+  };
+  std::map<const utils::DictOrderIndex*, CodeMatches> codeMatches;
+  std::vector<uint32_t> tokenCodes;
+
   // Worst case, 8192 tokens in the msg.  Each is 10 bytes. */
   boost::scoped_array<uint8_t> inputMsg;
   uint32_t tmpResultCounter;
@@ -157,6 +186,7 @@ class DictStep : public Command
   boost::shared_ptr<primitives::DictEqualityFilter> eqFilter;
   uint8_t eqOp;  // COMPARE_EQ or COMPARE_NE
   uint64_t fMinMax[2];
+  std::vector<uint32_t> bloomHashes;
 
   friend class RTSCommand;
 };
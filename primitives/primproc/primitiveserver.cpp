@@ -28,6 +28,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <list>
 #include <mutex>
 #include <stdexcept>
 
@@ -83,12 +84,16 @@ using namespace primitives;
 #include "exceptclasses.h"
 
 #include "idbcompress.h"
+#include "dictbloomfilter.h"
+#include "dictngramindex.h"
+#include "dictorderindex.h"
 using namespace compress;
 
 #include "IDBDataFile.h"
 #include "IDBPolicy.h"
 using namespace idbdatafile;
 
+#include "workstealing_threadpool.h"
 using namespace threadpool;
 
 #include "threadnaming.h"
@@ -136,6 +141,12 @@ uint32_t connectionsPerUM;
 uint32_t highPriorityThreads;
 uint32_t medPriorityThreads;
 uint32_t lowPriorityThreads;
+bool workStealingScheduler = false;
+bool suspendOnCacheMiss = false;
+bool chunkZoneMaps = true;
+bool dictBloomFilters = true;
+bool dictNgramIndexes = true;
+bool dictOrderIndexes = true;
 int directIOFlag = O_DIRECT;
 int noVB = 0;
 
@@ -914,11 +925,13 @@ struct AsynchLoader
   VSSCache* vssCache;
 };
 
-void loadBlockAsync(uint64_t lbid, const QueryContext& c, uint32_t txn, int compType, uint32_t* cCount,
+// Returns true if the block is cached already. readStarted tells whether a loader was started for it,
+// there is none when all the loaders are busy.
+bool loadBlockAsync(uint64_t lbid, const QueryContext& c, uint32_t txn, int compType, uint32_t* cCount,
                     uint32_t* rCount, bool LBIDTrace, uint32_t sessionID, boost::mutex* m,
                     uint32_t* busyLoaders,
                     boost::shared_ptr<BPPSendThread> sendThread,  // sendThread for abort upon exception.
-                    VSSCache* vssCache)
+                    VSSCache* vssCache, bool* readStarted)
 {
   blockCacheClient bc(*BRPp[cacheNum(lbid)]);
   bool vbFlag;
@@ -942,13 +955,13 @@ void loadBlockAsync(uint64_t lbid, const QueryContext& c, uint32_t txn, int comp
     brm->vssLookup((BRM::LBID_t)lbid, c, txn, &ver, &vbFlag);
 
   if (bc.exists(lbid, ver))
-    return;
+    return true;
 
   /* a quick and easy stand-in for a threadpool for loaders */
   atomicops::atomicMb();
 
   if (asyncCounter >= asyncMax)
-    return;
+    return false;
 
   (void)atomicops::atomicInc(&asyncCounter);
 
@@ -959,6 +972,9 @@ void loadBlockAsync(uint64_t lbid, const QueryContext& c, uint32_t txn, int comp
     boost::thread thd(AsynchLoader(lbid, c, txn, compType, cCount, rCount, LBIDTrace, sessionID, m,
                                    busyLoaders, sendThread, vssCache));
     (*busyLoaders)++;
+
+    if (readStarted)
+      *readStarted = true;
   }
   catch (boost::thread_resource_error& e)
   {
@@ -966,6 +982,180 @@ void loadBlockAsync(uint64_t lbid, const QueryContext& c, uint32_t txn, int comp
     idbassert(asyncCounter > 0);
     (void)atomicops::atomicDec(&asyncCounter);
   }
+
+  return false;
+}
+
+boost::shared_array<char> readCompressedHeader(BRM::OID_t oid, uint16_t dbRoot, uint32_t partNum,
+                                               uint16_t segNum)
+{
+  boost::shared_array<char> hdr;
+  char fileName[WriteEngine::FILE_NAME_SIZE] = {0};
+
+  try
+  {
+    buildOidFileName(oid, dbRoot, partNum, segNum, fileName);
+  }
+  catch (std::exception&)
+  {
+    return hdr;
+  }
+
+  boost::scoped_ptr<IDBDataFile> fp(
+      IDBDataFile::open(IDBPolicy::getType(fileName, IDBPolicy::PRIMPROC), fileName, "r", 0));
+
+  if (!fp)
+    return hdr;
+
+  hdr.reset(new char[CompressInterface::HDR_BUF_LEN]);
+
+  if (fp->pread(hdr.get(), 0, CompressInterface::HDR_BUF_LEN) != CompressInterface::HDR_BUF_LEN ||
+      CompressInterface::verifyHdr(hdr.get()) != 0)
+    hdr.reset();
+
+  return hdr;
+}
+
+bool dictBloomFilterMayMatch(BRM::OID_t dictOid, uint16_t dbRoot, uint32_t partNum, uint16_t segNum,
+                             uint32_t charsetNumber, const std::vector<uint32_t>& hashes)
+{
+  char fileName[WriteEngine::FILE_NAME_SIZE] = {0};
+
+  try
+  {
+    buildOidFileName(dictOid, dbRoot, partNum, segNum, fileName);
+  }
+  catch (std::exception&)
+  {
+    return true;
+  }
+
+  const std::string bloomName = utils::DictBloomFilter::fileName(fileName);
+  boost::scoped_ptr<IDBDataFile> fp(IDBDataFile::open(
+      IDBPolicy::getType(bloomName.c_str(), IDBPolicy::PRIMPROC), bloomName.c_str(), "r", 0));
+
+  if (!fp)
+    return true;
+
+  utils::DictBloomFilter::Header header;
+
+  if (fp->pread(&header, 0, sizeof(header)) != sizeof(header) || !utils::DictBloomFilter::isValid(header) ||
+      header.charsetNumber != charsetNumber)
+    return true;
+
+  for (auto hash : hashes)
+  {
+    uint32_t bits[utils::DictBloomFilter::HASH_COUNT];
+    bool present = true;
+    utils::DictBloomFilter::bits(hash, header.filterBytes, bits);
+
+    for (uint32_t i = 0; present && i < utils::DictBloomFilter::HASH_COUNT; i++)
+    {
+      uint8_t byte;
+
+      if (fp->pread(&byte, utils::DictBloomFilter::offset(bits[i]), 1) != 1)
+        return true;
+
+      present = utils::DictBloomFilter::test(byte, bits[i]);
+    }
+
+    if (present)
+      return true;
+  }
+
+  return false;
+}
+
+namespace
+{
+// The order indexes read, kept until their files are written anew. The memory they take is
+// counted by the ResourceManager, the least recently used ones are dropped past the limit.
+const uint64_t MAX_ORDER_INDEX_BYTES = 128 * 1024 * 1024;
+typedef std::tuple<BRM::OID_t, uint16_t, uint32_t, uint16_t> OrderIndexKey;
+struct OrderIndexEntry
+{
+  boost::shared_ptr<const utils::DictOrderIndex> index;
+  uint64_t memUsage;
+  std::list<OrderIndexKey>::iterator lru;
+};
+boost::mutex orderIndexesMutex;
+std::map<OrderIndexKey, OrderIndexEntry> orderIndexes;
+std::list<OrderIndexKey> orderIndexesLru;  // the most recently used first
+uint64_t orderIndexesMemUsage = 0;
+
+// Call with orderIndexesMutex locked
+void dropOrderIndex(std::map<OrderIndexKey, OrderIndexEntry>::iterator it)
+{
+  joblist::ResourceManager::instance()->returnMemory(it->second.memUsage);
+  orderIndexesMemUsage -= it->second.memUsage;
+  orderIndexesLru.erase(it->second.lru);
+  orderIndexes.erase(it);
+}
+}  // namespace
+
+boost::shared_ptr<const utils::DictOrderIndex> dictOrderIndex(BRM::OID_t dictOid, uint16_t dbRoot,
+                                                              uint32_t partNum, uint16_t segNum,
+                                                              uint32_t charsetNumber)
+{
+  boost::shared_ptr<const utils::DictOrderIndex> index;
+  char fileName[WriteEngine::FILE_NAME_SIZE] = {0};
+
+  try
+  {
+    buildOidFileName(dictOid, dbRoot, partNum, segNum, fileName);
+  }
+  catch (std::exception&)
+  {
+    return index;
+  }
+
+  const std::string orderName = utils::DictOrderIndex::fileName(fileName);
+  boost::scoped_ptr<IDBDataFile> fp(IDBDataFile::open(
+      IDBPolicy::getType(orderName.c_str(), IDBPolicy::PRIMPROC), orderName.c_str(), "r", 0));
+  utils::DictOrderIndex::Header header;
+
+  if (!fp || fp->pread(&header, 0, sizeof(header)) != sizeof(header) ||
+      !utils::DictOrderIndex::isValid(header) || header.charsetNumber != charsetNumber)
+    return index;
+
+  const OrderIndexKey key = std::make_tuple(dictOid, dbRoot, partNum, segNum);
+
+  {
+    boost::mutex::scoped_lock lk(orderIndexesMutex);
+    auto it = orderIndexes.find(key);
+
+    if (it != orderIndexes.end() && it->second.index->generation() == header.generation)
+    {
+      orderIndexesLru.splice(orderIndexesLru.begin(), orderIndexesLru, it->second.lru);
+      return it->second.index;
+    }
+  }
+
+  boost::shared_ptr<utils::DictOrderIndex> newIndex(new utils::DictOrderIndex());
+  std::string body(utils::DictOrderIndex::bodyLength(header), '\0');
+
+  if (fp->pread(&body[0], sizeof(header), body.size()) != (ssize_t)body.size() ||
+      !newIndex->deserialize(header, body.data(), body.size()))
+    return index;
+
+  const uint64_t memUsage = newIndex->getMemUsage();
+  boost::mutex::scoped_lock lk(orderIndexesMutex);
+  auto it = orderIndexes.find(key);
+
+  if (it != orderIndexes.end())
+    dropOrderIndex(it);
+
+  while (!orderIndexesLru.empty() && orderIndexesMemUsage + memUsage > MAX_ORDER_INDEX_BYTES)
+    dropOrderIndex(orderIndexes.find(orderIndexesLru.back()));
+
+  // The queries get the index all the same when it isn't kept
+  if (memUsage > MAX_ORDER_INDEX_BYTES || !joblist::ResourceManager::instance()->getMemory(memUsage, false))
+    return newIndex;
+
+  orderIndexesLru.push_front(key);
+  orderIndexes[key] = OrderIndexEntry{newIndex, memUsage, orderIndexesLru.begin()};
+  orderIndexesMemUsage += memUsage;
+  return newIndex;
 }
 
 }  // namespace primitiveprocessor
@@ -1006,6 +1196,127 @@ namespace
 {
 using namespace primitiveprocessor;
 
+/** @brief Skips the blocks of a dictionary scan that can't match its LIKE filters.
+ *
+ * The n-gram index of the store segment file tells the blocks that miss a trigram of the
+ * literal parts of a pattern, see utils::DictNgramIndex.
+ */
+class DictNgramFilter
+{
+ public:
+  explicit DictNgramFilter(const TokenByScanRequestHeader* cmd);
+
+  // True if no string of the block matches
+  bool cantMatch(uint64_t lbid);
+
+ private:
+  bool openIndex(BRM::OID_t oid, uint16_t dbRoot, uint32_t partNum, uint16_t segNum);
+
+  std::vector<std::vector<uint32_t>> patterns;  // the trigram bits of every LIKE pattern
+  bool allMiss = false;                         // BOP_OR, every pattern must miss
+  uint32_t charsetNumber;
+  std::tuple<BRM::OID_t, uint16_t, uint32_t, uint16_t> file;
+  boost::scoped_ptr<IDBDataFile> index;  // null if the file has no usable index
+  std::vector<uint8_t> signature;
+};
+
+DictNgramFilter::DictNgramFilter(const TokenByScanRequestHeader* cmd) : charsetNumber(cmd->charsetNumber)
+{
+  if (!dictNgramIndexes || (cmd->flags & HAS_EQ_FILTER) || cmd->NVALS == 0 || cmd->NVALS > 2)
+    return;
+
+  const datatypes::Charset cs(cmd->charsetNumber);
+
+  if (!utils::DictNgramIndex::supported(cs.getCharset()))
+    return;
+
+  const bool exact = utils::DictNgramIndex::exact(cs.getCharset());
+  const uint8_t* args = reinterpret_cast<const uint8_t*>(cmd) + sizeof(TokenByScanRequestHeader);
+  allMiss = cmd->NVALS > 1 && cmd->BOP == BOP_OR;
+
+  for (uint32_t i = 0; i < cmd->NVALS; i++)
+  {
+    const NonNullDataValue* arg = reinterpret_cast<const NonNullDataValue*>(args);
+    std::vector<uint32_t> bits;
+    args += sizeof(NonNullDataValue) + arg->len;
+
+    if ((i == 0 ? cmd->COP1 : cmd->COP2) == COMPARE_LIKE &&
+        utils::DictNgramIndex::patternBits(arg->data, arg->len, exact, bits))
+      patterns.push_back(bits);
+    else if (allMiss)
+    {
+      // The other filter may match any block
+      patterns.clear();
+      return;
+    }
+  }
+}
+
+bool DictNgramFilter::cantMatch(uint64_t lbid)
+{
+  if (patterns.empty())
+    return false;
+
+  BRM::OID_t oid;
+  uint16_t dbRoot;
+  uint32_t partNum;
+  uint16_t segNum;
+  uint32_t fbo;
+
+  if (brm->lookupLocal(lbid, 0, false, oid, dbRoot, partNum, segNum, fbo) != 0 ||
+      !openIndex(oid, dbRoot, partNum, segNum))
+    return false;
+
+  // A block past the end of the index got no strings while it was valid
+  signature.resize(utils::DictNgramIndex::SIGNATURE_BYTES);
+
+  if (index->pread(signature.data(), utils::DictNgramIndex::offset(fbo), signature.size()) !=
+      (ssize_t)signature.size())
+    return false;
+
+  for (const auto& bits : patterns)
+  {
+    bool miss = !utils::DictNgramIndex::mayMatch(signature.data(), bits);
+
+    if (miss != allMiss)
+      return miss;
+  }
+
+  return allMiss;
+}
+
+bool DictNgramFilter::openIndex(BRM::OID_t oid, uint16_t dbRoot, uint32_t partNum, uint16_t segNum)
+{
+  auto key = std::make_tuple(oid, dbRoot, partNum, segNum);
+
+  if (key == file)
+    return index.get() != nullptr;
+
+  char fileName[WriteEngine::FILE_NAME_SIZE] = {0};
+  file = key;
+  index.reset();
+
+  try
+  {
+    buildOidFileName(oid, dbRoot, partNum, segNum, fileName);
+  }
+  catch (std::exception&)
+  {
+    return false;
+  }
+
+  const std::string indexName = utils::DictNgramIndex::fileName(fileName);
+  index.reset(IDBDataFile::open(IDBPolicy::getType(indexName.c_str(), IDBPolicy::PRIMPROC),
+                                indexName.c_str(), "r", 0));
+  utils::DictNgramIndex::Header header;
+
+  if (index && (index->pread(&header, 0, sizeof(header)) != sizeof(header) ||
+                !utils::DictNgramIndex::isValid(header) || header.charsetNumber != charsetNumber))
+    index.reset();
+
+  return index.get() != nullptr;
+}
+
 /** @brief The job type to process a dictionary scan (pDictionaryScan class on the UM)
  * TODO: Move this & the impl into different files
  */
@@ -1108,20 +1419,35 @@ int DictScanJob::operator()()
       }
     }
 
+    DictNgramFilter ngramFilter(cmd);
+
     for (uint16_t i = 0; i < runCount; ++i)
     {
       SBS results(new ByteStream(output_buf_size));
       output = (TokenByScanResultHeader*)results->getInputPtr();
 
-      loadBlock(cmd->LBID, verInfo, cmd->Hdr.TransactionID, cmd->CompType, data, &wasBlockInCache,
-                &blocksRead, fLBIDTraceOn, session);
-      pproc.setBlockPtr((int*)data);
-      pproc.p_TokenByScan(cmd, output, output_buf_size, eqFilter);
-
-      if (wasBlockInCache)
-        output->CacheIO++;
+      if (ngramFilter.cantMatch(cmd->LBID))
+      {
+        // The result p_TokenByScan() gives for a block without matches
+        memcpy((void*)output, cmd, sizeof(ISMPacketHeader) + sizeof(PrimitiveHeader));
+        output->ism.Command = DICT_SCAN_COMPARE_RESULTS;
+        output->NBYTES = sizeof(TokenByScanResultHeader);
+        output->NVALS = 0;
+        output->CacheIO = 0;
+        output->PhysicalIO = 0;
+      }
       else
-        output->PhysicalIO += blocksRead;
+      {
+        loadBlock(cmd->LBID, verInfo, cmd->Hdr.TransactionID, cmd->CompType, data, &wasBlockInCache,
+                  &blocksRead, fLBIDTraceOn, session);
+        pproc.setBlockPtr((int*)data);
+        pproc.p_TokenByScan(cmd, output, output_buf_size, eqFilter);
+
+        if (wasBlockInCache)
+          output->CacheIO++;
+        else
+          output->PhysicalIO += blocksRead;
+      }
 
       results->advanceInputPtr(output->NBYTES);
       write(results);
@@ -1336,19 +1662,19 @@ struct BPPHandler
   int doAck(ByteStream& bs)
   {
     uint32_t key;
-    int16_t msgCount;
+    uint32_t msgCredits;
+    int64_t byteCredits;
     SBPPV bpps;
     const ISMPacketHeader* ism = (const ISMPacketHeader*)bs.buf();
 
     key = ism->Interleave;
-    msgCount = (int16_t)ism->Size;
-    bs.advance(sizeof(ISMPacketHeader));
-
     bpps = grabBPPs(key);
 
     if (bpps)
     {
-      bpps->getSendThread()->sendMore(msgCount);
+      bs.advance(sizeof(ISMPacketHeader));
+      bs >> msgCredits >> byteCredits;
+      bpps->getSendThread()->addCredits(msgCredits, byteCredits);
       return 0;
     }
     else
@@ -1361,7 +1687,9 @@ struct BPPHandler
   void createBPP(ByteStream& bs)
   {
     uint32_t i;
-    uint32_t key, initMsgsLeft;
+    uint32_t key;
+    uint32_t initMsgCredits = BPPSendThread::NoFlowControl;
+    int64_t initByteCredits = 0;
     SBPP bpp;
     SBPPV bppv;
 
@@ -1371,14 +1699,10 @@ struct BPPHandler
                                           fPrimitiveServerPtr->ProcessorThreads()));
 
     if (bs.length() > 0)
-      bs >> initMsgsLeft;
-    else
-    {
-      initMsgsLeft = -1;
-    }
+      bs >> initMsgCredits >> initByteCredits;
 
     idbassert(bs.length() == 0);
-    bppv->getSendThread()->sendMore(initMsgsLeft);
+    bppv->getSendThread()->setCredits(initMsgCredits, initByteCredits);
     bppv->add(bpp);
 
     // this block of code creates some BPP instances up front for user queries,
@@ -2263,8 +2587,13 @@ PrimitiveServer::PrimitiveServer(int serverThreads, int serverQueueSize, int pro
   fServerpool.setQueueSize(fServerQueueSize);
   fServerpool.setName("PrimitiveServer");
 
-  fProcessorPool.reset(new threadpool::FairThreadPool(fProcessorWeight, highPriorityThreads,
-                                                      medPriorityThreads, lowPriorityThreads, 0));
+  if (workStealingScheduler)
+    fProcessorPool.reset(new threadpool::WorkStealingThreadPool(fProcessorWeight, highPriorityThreads,
+                                                                medPriorityThreads, lowPriorityThreads, 0));
+  else
+    fProcessorPool.reset(new threadpool::FairThreadPool(fProcessorWeight, highPriorityThreads,
+                                                        medPriorityThreads, lowPriorityThreads, 0));
+
   // We're not using either the priority or the job-clustering features, just need a threadpool
   // that can reschedule jobs, and an unlimited non-blocking queue
   fOOBPool.reset(new threadpool::PriorityThreadPool(1, 5, 0, 0, 1));
@@ -28,6 +28,8 @@
 #include <tr1/unordered_map>
 #include <tr1/unordered_set>
 #include <unordered_map>
+#include <vector>
+#include <boost/shared_array.hpp>
 #include <boost/thread.hpp>
 
 #include "threadpool.h"
@@ -89,16 +91,26 @@ void prefetchExtent(uint64_t lbid, uint32_t ver, uint32_t txn, uint32_t* rCount)
 void loadBlock(uint64_t lbid, BRM::QueryContext q, uint32_t txn, int compType, void* bufferPtr,
                bool* pWasBlockInCache, uint32_t* rCount = nullptr, bool LBIDTrace = false,
                uint32_t sessionID = 0, bool doPrefetch = true, VSSCache* vssCache = nullptr);
-void loadBlockAsync(uint64_t lbid, const BRM::QueryContext& q, uint32_t txn, int CompType, uint32_t* cCount,
+bool loadBlockAsync(uint64_t lbid, const BRM::QueryContext& q, uint32_t txn, int CompType, uint32_t* cCount,
                     uint32_t* rCount, bool LBIDTrace, uint32_t sessionID, boost::mutex* m,
                     uint32_t* busyLoaders, boost::shared_ptr<BPPSendThread> sendThread,
-                    VSSCache* vssCache = nullptr);
+                    VSSCache* vssCache = nullptr, bool* readStarted = nullptr);
 uint32_t loadBlocks(BRM::LBID_t* lbids, BRM::QueryContext q, BRM::VER_t txn, int compType,
                     uint8_t** bufferPtrs, uint32_t* rCount, bool LBIDTrace, uint32_t sessionID,
                     uint32_t blockCount, bool* wasVersioned, bool doPrefetch = true,
                     VSSCache* vssCache = nullptr);
 uint32_t cacheNum(uint64_t lbid);
 void buildFileName(BRM::OID_t oid, char* fileName);
+// The control header of a compressed segment file, null if it can't be read
+boost::shared_array<char> readCompressedHeader(BRM::OID_t oid, uint16_t dbRoot, uint32_t partNum,
+                                               uint16_t segNum);
+// False if the Bloom filter of the dictionary segment file has none of the hashes, true if it can't tell
+bool dictBloomFilterMayMatch(BRM::OID_t dictOid, uint16_t dbRoot, uint32_t partNum, uint16_t segNum,
+                             uint32_t charsetNumber, const std::vector<uint32_t>& hashes);
+// The order index of the dictionary segment file, null if it has no valid one
+boost::shared_ptr<const utils::DictOrderIndex> dictOrderIndex(BRM::OID_t dictOid, uint16_t dbRoot,
+                                                              uint32_t partNum, uint16_t segNum,
+                                                              uint32_t charsetNumber);
 
 /** @brief process primitives as they arrive
  */
@@ -88,6 +88,12 @@ extern uint32_t connectionsPerUM;
 extern uint32_t highPriorityThreads;
 extern uint32_t medPriorityThreads;
 extern uint32_t lowPriorityThreads;
+extern bool workStealingScheduler;
+extern bool suspendOnCacheMiss;
+extern bool chunkZoneMaps;
+extern bool dictBloomFilters;
+extern bool dictNgramIndexes;
+extern bool dictOrderIndexes;
 extern int directIOFlag;
 extern int noVB;
 
@@ -649,6 +655,42 @@ int ServicePrimProc::Child()
   if ((strVal == "n") || (strVal == "N"))
     directIOFlag = 0;
 
+  // Run the primitives on WorkStealingThreadPool instead of FairThreadPool
+  strVal = cf->getConfig(primitiveServers, "WorkStealingScheduler");
+
+  if ((strVal == "y") || (strVal == "Y"))
+    workStealingScheduler = true;
+
+  // Let a BPP job give up its thread while the blocks it needs are read from disk
+  strVal = cf->getConfig(primitiveServers, "SuspendOnCacheMiss");
+
+  if ((strVal == "y") || (strVal == "Y"))
+    suspendOnCacheMiss = true;
+
+  // Skip the chunks of a scan whose zone maps can't match the filter
+  strVal = cf->getConfig(primitiveServers, "ChunkZoneMaps");
+
+  if ((strVal == "n") || (strVal == "N"))
+    chunkZoneMaps = false;
+
+  // Skip the token blocks of the dictionary segments whose Bloom filters miss an equality filter
+  strVal = cf->getConfig(primitiveServers, "DictBloomFilters");
+
+  if ((strVal == "n") || (strVal == "N"))
+    dictBloomFilters = false;
+
+  // Skip the dictionary blocks of a LIKE scan whose n-gram signatures miss the pattern
+  strVal = cf->getConfig(primitiveServers, "DictNgramIndexes");
+
+  if ((strVal == "n") || (strVal == "N"))
+    dictNgramIndexes = false;
+
+  // Filter the tokens of a dictionary column by the codes of the order indexes of its store files
+  strVal = cf->getConfig(primitiveServers, "DictOrderIndexes");
+
+  if ((strVal == "n") || (strVal == "N"))
+    dictOrderIndexes = false;
+
 
   IDBPolicy::configIDBPolicy();
 
@@ -32,6 +32,11 @@ class PseudoCC : public ColumnCommand
   SCommand duplicate() override;
   void createCommand(messageqcpp::ByteStream&) override;
   void resetCommand(messageqcpp::ByteStream&) override;
+  // The filter is on the pseudo column values, not on the column data
+  bool canMatch(const compress::ChunkZoneMap&) const override
+  {
+    return true;
+  }
 
  protected:
   void loadData() override;
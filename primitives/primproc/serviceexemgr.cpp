@@ -328,6 +328,12 @@ int ServiceExeMgr::Child()
   messageqcpp::MessageQueueServer* mqs;
 
   statementsRunningCount_ = new ActiveStatementCounter(rm_->getEmExecQueueSize());
+
+  if (rm_->getEmAdmissionControl())
+    queryAdmission_ = new joblist::QueryAdmission(
+        rm_->getConfiguredUMMemLimit() / 100 * std::min(rm_->getEmAdmissionMemoryPct(), 100U),
+        rm_->getEmAdmissionMinQueryMemory());
+
   const std::string ExeMgr = "ExeMgr1";
   for (;;)
   {
@@ -31,6 +31,7 @@
 #include "mcsanalyzetableexecutionplan.h"
 #include "activestatementcounter.h"
 #include "distributedenginecomm.h"
+#include "queryadmission.h"
 #include "resourcemanager.h"
 #include "configcpp.h"
 #include "queryteleserverparms.h"
@@ -248,6 +249,11 @@ class ServiceExeMgr : public Service, public Opt
   {
     return statementsRunningCount_;
   }
+  // nullptr if the memory-aware admission control is off
+  joblist::QueryAdmission* getQueryAdmission()
+  {
+    return queryAdmission_;
+  }
   joblist::DistributedEngineComm* getDec()
   {
     return dec_;
@@ -367,6 +373,7 @@ class ServiceExeMgr : public Service, public Opt
   ThreadCntPerSessionMap_t threadCntPerSessionMap_;
   std::mutex threadCntPerSessionMapMutex_;
   ActiveStatementCounter* statementsRunningCount_ = nullptr;
+  joblist::QueryAdmission* queryAdmission_ = nullptr;
   joblist::DistributedEngineComm* dec_ = nullptr;
   joblist::ResourceManager* rm_ = nullptr;
   // Its attributes are set in Child()
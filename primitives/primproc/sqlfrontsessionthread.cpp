@@ -15,6 +15,8 @@
    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
    MA 02110-1301, USA. */
 
+#include <poll.h>
+
 #include "sqlfrontsessionthread.h"
 #include "primproc.h"
 #include "primitiveserverthreadpools.h"
@@ -187,6 +189,21 @@ void SQLFrontSessionThread::writeCodeAndError(messageqcpp::ByteStream::quadbyte
   fIos.write(emsgBs);
 }
 
+bool SQLFrontSessionThread::clientClosed() const
+{
+  // A cancel sends the abort signal before the FE drops the connection, so the hang up is
+  // looked for rather than EOF, which stays behind the unread data.
+  struct pollfd pfd;
+  pfd.fd = fIos.getConnectionNum();
+  pfd.events = POLLRDHUP;
+  pfd.revents = 0;
+
+  if (poll(&pfd, 1, 0) < 0)
+    return false;
+
+  return pfd.revents & (POLLRDHUP | POLLHUP | POLLERR | POLLNVAL);
+}
+
 void SQLFrontSessionThread::analyzeTableExecute(messageqcpp::ByteStream& bs, joblist::SJLP& jl,
                                                 bool& stmtCounted)
 {
@@ -338,6 +355,9 @@ void SQLFrontSessionThread::operator()()
   bool usingTuples = false;
   bool stmtCounted = false;
   auto* statementsRunningCount = globServiceExeMgr->getStatementsRunningCount();
+  auto* queryAdmission = globServiceExeMgr->getQueryAdmission();
+  // The memory reserved for the query; returned when its joblist is destroyed
+  joblist::QueryAdmission::Ticket admissionTicket;
 
   try
   {
@@ -354,7 +374,7 @@ void SQLFrontSessionThread::operator()()
         std::unique_lock<std::mutex> scoped(jlMutex);
         destructing++;
         std::thread bgdtor(
-            [jl, &jlMutex, &jlCleanupDone, &destructing]
+            [jl, ticket = std::move(admissionTicket), &jlMutex, &jlCleanupDone, &destructing]
             {
               std::unique_lock<std::mutex> scoped(jlMutex);
               const_cast<joblist::SJLP&>(jl).reset();  // this happens second; does real destruction
@@ -406,6 +426,22 @@ void SQLFrontSessionThread::operator()()
           bs << qb;
           qb = statementsRunningCount->waiting();
           bs << qb;
+
+          if (queryAdmission)
+          {
+            auto stats = queryAdmission->stats();
+
+            for (uint32_t i = 0; i < joblist::QueryAdmission::PRIORITY_CLASSES; ++i)
+              bs << (messageqcpp::ByteStream::quadbyte)stats.queued[i];
+
+            bs << stats.admitted;
+            bs << stats.waited;
+            bs << stats.totalWaitMs;
+            bs << stats.maxWaitMs;
+            bs << stats.reserved;
+            bs << stats.budget;
+          }
+
           fIos.write(bs);
           fIos.close();
           break;
@@ -527,8 +563,6 @@ void SQLFrontSessionThread::operator()()
       oss << sqlText << "; |" << csep.schemaName() << "|";
       logging::SQLLogger sqlLog(oss.str(), li);
 
-      statementsRunningCount->incr(stmtCounted);
-
       PrimitiveServerThreadPools primitiveServerThreadPools(
           ServicePrimProc::instance()->getPrimitiveServerThreadPool());
 
@@ -606,6 +640,26 @@ void SQLFrontSessionThread::operator()()
         }
       }
 
+      // The query waits for its memory before it takes an ExecQueueSize slot, so the queued
+      // queries don't hold the slots the admitted ones need.
+      if (queryAdmission && !csep.isInternal())
+      {
+        auto* tjlp = dynamic_cast<joblist::TupleJobList*>(jl.get());
+
+        if (!queryAdmission->admit(tjlp ? tjlp->estimateMemory() : 0,
+                                   joblist::QueryAdmission::priorityClass(csep.priority()), admissionTicket,
+                                   [this]() { return clientClosed(); }))
+        {
+          if (gDebug)
+            std::cout << "### Got a close while waiting for admission for session id " << csep.sessionID()
+                      << std::endl;
+
+          fIos.close();
+          break;
+        }
+      }
+
+      statementsRunningCount->incr(stmtCounted);
       jl->doQuery();
 
       execplan::CalpontSystemCatalog::OID tableOID;
@@ -894,7 +948,8 @@ void SQLFrontSessionThread::operator()()
         std::unique_lock<std::mutex> scoped(jlMutex);
         destructing++;
         std::thread bgdtor(
-            [jl, &jlMutex, &jlCleanupDone, stmtID, li, &destructing, &msgLog]
+            [jl, ticket = std::move(admissionTicket), &jlMutex, &jlCleanupDone, stmtID, li, &destructing,
+             &msgLog]
             {
               std::unique_lock<std::mutex> scoped(jlMutex);
               const_cast<joblist::SJLP&>(jl).reset();  // this happens second; does real destruction
@@ -122,6 +122,8 @@ namespace exemgr
     void buildSysCache(const execplan::CalpontSelectExecutionPlan& csep,
                       boost::shared_ptr<execplan::CalpontSystemCatalog> csc);
     void writeCodeAndError(messageqcpp::ByteStream::quadbyte code, const std::string emsg);
+    //...True once the FE has closed the connection or dropped it to cancel the query.
+    bool clientClosed() const;
     void analyzeTableExecute(messageqcpp::ByteStream& bs, joblist::SJLP& jl, bool& stmtCounted);
     void analyzeTableHandleStats(messageqcpp::ByteStream& bs);
     uint64_t roundMB(uint64_t value) const;
@@ -0,0 +1,171 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+#include "we_fieldscan.h"
+
+using WriteEngine::findEitherChar;
+using WriteEngine::findLastRowEnd;
+
+namespace
+{
+// The end of the last complete row, a byte at a time with the field states of tokenize()
+size_t lastRowEnd(const std::string& data, char delim, char enclosed, char escape)
+{
+  enum
+  {
+    LEADING,
+    NORMAL,
+    ENCLOSED,
+    TRAILING
+  } state = enclosed ? LEADING : NORMAL;
+  size_t rowEnd = 0;
+
+  for (size_t i = 0; i < data.length(); i++)
+  {
+    char c = data[i];
+
+    if (state == ENCLOSED)
+    {
+      if (i + 1 < data.length() &&
+          ((c == escape && (data[i + 1] == enclosed || data[i + 1] == escape || data[i + 1] == '\r' ||
+                            data[i + 1] == '\n')) ||
+           (c == enclosed && data[i + 1] == enclosed)))
+        i++;
+      else if (c == enclosed)
+        state = TRAILING;
+
+      continue;
+    }
+
+    if (state == LEADING && c == enclosed)
+    {
+      state = ENCLOSED;
+      continue;
+    }
+
+    if (c == delim || c == '\n')
+    {
+      if (c == '\n')
+        rowEnd = i + 1;
+
+      state = enclosed ? LEADING : NORMAL;
+    }
+    else if (state == LEADING)
+    {
+      state = NORMAL;
+    }
+  }
+
+  return rowEnd;
+}
+}  // namespace
+
+TEST(BulkLoadFieldScan, FindsFirstOfEither)
+{
+  std::string data = "abcdefghijklmnopqrstuvwxyz|0123456789\nABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  char* begin = &data[0];
+  char* end = begin + data.length();
+
+  EXPECT_EQ(findEitherChar(begin, end, '|', '\n') - begin, 26);
+  EXPECT_EQ(findEitherChar(begin + 27, end, '|', '\n') - begin, 37);
+  EXPECT_EQ(findEitherChar(begin + 38, end, '|', '\n'), end);
+  EXPECT_EQ(findEitherChar(begin, end, 'Z', 'Z') - begin, 63);
+  EXPECT_EQ(findEitherChar(end, end, '|', '\n'), end);
+
+  // The end bounds the search
+  EXPECT_EQ(findEitherChar(begin, begin + 26, '|', '\n'), begin + 26);
+}
+
+TEST(BulkLoadFieldScan, MatchesByteLoop)
+{
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::uniform_int_distribution<int> sparse(0, 40);
+
+  for (int run = 0; run < 200; run++)
+  {
+    std::string data(1 + run * 3, 'x');
+
+    for (auto& c : data)
+      c = sparse(gen) == 0 ? (gen() & 1 ? '"' : '\\') : static_cast<char>(byte(gen) | 0x80);
+
+    char* end = &data[0] + data.length();
+
+    for (char* p = &data[0]; p < end; p++)
+    {
+      char* expected = p;
+
+      while (expected < end && *expected != '"' && *expected != '\\')
+        expected++;
+
+      ASSERT_EQ(findEitherChar(p, end, '"', '\\'), expected);
+    }
+  }
+}
+
+TEST(BulkLoadFieldScan, FindsLastRowEnd)
+{
+  std::string data = "1|abc\n2|\"x\ny\"\n3|\"z\n";
+  char* begin = &data[0];
+  char* end = begin + data.length();
+
+  // Without enclosed fields any newline ends a row
+  EXPECT_EQ(findLastRowEnd(begin, end, '|', '\0', '\\') - begin, 19);
+
+  // The newline in the enclosed field of the second row and the open third row don't
+  EXPECT_EQ(findLastRowEnd(begin, end, '|', '"', '\\') - begin, 14);
+  EXPECT_EQ(findLastRowEnd(begin, begin + 13, '|', '"', '\\') - begin, 6);
+  EXPECT_EQ(findLastRowEnd(begin, begin + 5, '|', '"', '\\'), begin);
+
+  // Escaped and doubled enclosing characters don't end the enclosed field
+  data = "1|\"a\\\"\n\"\"\n\"\n2|b\n";
+  begin = &data[0];
+  EXPECT_EQ(findLastRowEnd(begin, begin + data.length(), '|', '"', '\\') - begin,
+            static_cast<long>(data.length()));
+  EXPECT_EQ(findLastRowEnd(begin, begin + 11, '|', '"', '\\'), begin);
+
+  // Only a field starting with the enclosing character is enclosed
+  data = "a\"b|c\n\"d\n";
+  begin = &data[0];
+  EXPECT_EQ(findLastRowEnd(begin, begin + data.length(), '|', '"', '\\') - begin, 6);
+}
+
+TEST(BulkLoadFieldScan, LastRowEndMatchesFieldStates)
+{
+  std::mt19937 gen(42);
+  const char bytes[] = {'"', '"', '\\', '|', '\n', '\n', '\r', 'a', 'b', 'c', 'd', 'e'};
+  std::uniform_int_distribution<int> pick(0, sizeof(bytes) - 1);
+
+  for (int run = 0; run < 2000; run++)
+  {
+    std::string data(run % 97, 'x');
+
+    for (auto& c : data)
+      c = bytes[pick(gen)];
+
+    char* begin = &data[0];
+    char* end = begin + data.length();
+
+    ASSERT_EQ(findLastRowEnd(begin, end, '|', '"', '\\') - begin, lastRowEnd(data, '|', '"', '\\')) << data;
+    ASSERT_EQ(findLastRowEnd(begin, end, '|', '"', '"') - begin, lastRowEnd(data, '|', '"', '"')) << data;
+    ASSERT_EQ(findLastRowEnd(begin, end, '|', '\0', '\\') - begin, lastRowEnd(data, '|', '\0', '\\')) << data;
+  }
+}
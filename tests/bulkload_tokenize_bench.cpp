@@ -0,0 +1,150 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <benchmark/benchmark.h>
+
+#include "we_fieldscan.h"
+
+// Splits CSV into fields the way BulkLoadBuffer::tokenize() does, a byte at a time and with
+// the vectorized search, and reports bytes/s.
+// Synthetic input: 40 columns of integers, decimals, dates and strings, some of them enclosed.
+// Set TOKENIZE_BENCH_FILE to the path of a CSV file to run on real data as well.
+
+namespace
+{
+const char DELIM = '|';
+const char ENCLOSED = '"';
+const char ESCAPE = '\\';
+const char NEWLINE = '\n';
+
+std::string syntheticCsv(size_t bytes)
+{
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int> num(0, 1000000);
+  std::uniform_int_distribution<int> len(5, 60);
+  std::ostringstream csv;
+
+  while (static_cast<size_t>(csv.tellp()) < bytes)
+  {
+    for (int col = 0; col < 40; col++)
+    {
+      if (col)
+        csv << DELIM;
+
+      switch (col % 5)
+      {
+        case 0: csv << num(gen); break;
+        case 1: csv << num(gen) << '.' << num(gen) % 100; break;
+        case 2: csv << "2024-05-" << 10 + num(gen) % 20; break;
+        case 3: csv << std::string(len(gen), 'a' + num(gen) % 26); break;
+        default: csv << ENCLOSED << std::string(len(gen), 'A' + num(gen) % 26) << ", \"\"x\"\"" << ENCLOSED;
+      }
+    }
+
+    csv << NEWLINE;
+  }
+
+  return csv.str();
+}
+
+const std::string& input(bool real)
+{
+  static const std::string synthetic = syntheticCsv(64 * 1024 * 1024);
+  static std::string file;
+
+  if (real && file.empty() && std::getenv("TOKENIZE_BENCH_FILE"))
+  {
+    std::ifstream in(std::getenv("TOKENIZE_BENCH_FILE"), std::ios::binary);
+    file.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+
+  return real ? file : synthetic;
+}
+
+// Field and row count with the enclosed fields taken into account
+template <bool VECTORIZED>
+size_t countFields(char* p, const char* end)
+{
+  size_t fields = 0;
+
+  while (p < end)
+  {
+    if (*p == ENCLOSED)
+    {
+      for (p++; p < end; p++)
+      {
+        if (VECTORIZED)
+          p = WriteEngine::findEitherChar(p, end, ENCLOSED, ESCAPE);
+
+        if (p + 1 < end && (*p == ESCAPE || (*p == ENCLOSED && p[1] == ENCLOSED)))
+          p++;
+        else if (p < end && *p == ENCLOSED)
+          break;
+      }
+    }
+
+    if (VECTORIZED)
+      p = WriteEngine::findEitherChar(p, end, DELIM, NEWLINE);
+    else
+    {
+      while (p < end && *p != DELIM && *p != NEWLINE)
+        p++;
+    }
+
+    fields++;
+    p++;
+  }
+
+  return fields;
+}
+
+template <bool VECTORIZED>
+void BM_tokenize(benchmark::State& state)
+{
+  std::string data = input(state.range(0));
+
+  if (data.empty())
+  {
+    state.SkipWithError("TOKENIZE_BENCH_FILE is not set");
+    return;
+  }
+
+  char* begin = &data[0];
+  const char* end = begin + data.length();
+
+  if (countFields<true>(begin, end) != countFields<false>(begin, end))
+  {
+    state.SkipWithError("field counts differ");
+    return;
+  }
+
+  for (auto _ : state)
+    benchmark::DoNotOptimize(countFields<VECTORIZED>(begin, end));
+
+  state.SetBytesProcessed(state.iterations() * data.length());
+}
+
+BENCHMARK_TEMPLATE(BM_tokenize, false)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_tokenize, true)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -16,10 +16,22 @@
    MA 02110-1301, USA. */
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <random>
 #include <string>
 #include <vector>
 
+#include "col4block.h"
+#include "col8block.h"
+#include "col_double_block.h"
+#include "col_float_block.h"
+#include "chunkencoding.h"
 #include "idbcompress.h"
+#include "joblisttypes.h"
+#include "mcsconfig.h"
+#include "we_fileop.h"
 
 class CompressionTest : public ::testing::Test
 {
@@ -106,3 +118,322 @@ TEST_F(CompressionTest, LZvsSnappyUnique)
     std::cout << "Snappy ratio: " << (float)((float)generatedSize / (float)compressedSizeSnappy) << std::endl;
   }
 }
+
+// Only the types the build has a codec for are available
+TEST_F(CompressionTest, AvailableTypesAreBuiltIn)
+{
+  using compress::CompressInterface;
+
+  EXPECT_TRUE(CompressInterface::isCompressionAvail(2));
+#ifdef HAVE_LZ4
+  EXPECT_TRUE(CompressInterface::isCompressionAvail(3));
+#else
+  EXPECT_FALSE(CompressInterface::isCompressionAvail(3));
+#endif
+#ifdef HAVE_ZSTD
+  EXPECT_TRUE(CompressInterface::isCompressionAvail(4));
+#else
+  EXPECT_FALSE(CompressInterface::isCompressionAvail(4));
+#endif
+  EXPECT_FALSE(CompressInterface::isCompressionAvail(5));
+}
+
+TEST_F(CompressionTest, ZSTDCanCompress)
+{
+  if (!compress::CompressInterface::isCompressionAvail(4))
+    GTEST_SKIP() << "Built without Zstandard";
+
+  std::string seed("aaadefgh");
+  std::string originalData = genPermutations(seed);
+  // Any level reads back with the default one
+  std::unique_ptr<compress::CompressInterface> compressor(compress::getCompressInterfaceByType(4, 0, 9));
+  std::unique_ptr<compress::CompressInterface> decompressor(compress::getCompressInterfaceByType(4));
+  ASSERT_TRUE(compressor && decompressor);
+
+  size_t originalSize = originalData.size();
+  size_t compressedSize = compressor->maxCompressedSize(originalSize);
+  std::unique_ptr<char[]> compressedData(new char[compressedSize]);
+  auto rc = compressor->compress(originalData.data(), originalSize, compressedData.get(), &compressedSize);
+  ASSERT_EQ(rc, 0);
+  EXPECT_LT(compressedSize, originalSize);
+
+  size_t uncompressedSize = 0;
+  ASSERT_TRUE(decompressor->getUncompressedSize(compressedData.get(), compressedSize, &uncompressedSize));
+  EXPECT_EQ(uncompressedSize, originalSize);
+
+  std::unique_ptr<char[]> uncompressedData(new char[uncompressedSize]);
+  rc = decompressor->uncompress(compressedData.get(), compressedSize, uncompressedData.get(),
+                                &uncompressedSize);
+  ASSERT_EQ(rc, 0);
+  EXPECT_EQ(originalData, std::string(uncompressedData.get(), uncompressedSize));
+
+  // Data that is not a Zstandard frame is rejected
+  EXPECT_NE(decompressor->uncompress(originalData.data(), originalSize, uncompressedData.get(),
+                                     &uncompressedSize),
+            0);
+}
+
+TEST_F(CompressionTest, CompressionTypeByName)
+{
+  EXPECT_EQ(compress::getCompressionTypeByName("SNAPPY"), 2);
+  EXPECT_EQ(compress::getCompressionTypeByName("LZ4"), 3);
+  EXPECT_EQ(compress::getCompressionTypeByName("ZSTD"), 4);
+  EXPECT_EQ(compress::getCompressionTypeByName("GZIP"), -1);
+
+  std::unique_ptr<char[]> hdr(new char[compress::CompressInterface::HDR_BUF_LEN * 2]);
+  compress::CompressInterface::initHdr(hdr.get(), 8, execplan::CalpontSystemCatalog::BIGINT, 4);
+  EXPECT_EQ(compress::CompressInterface::getCompressionType(hdr.get()), 4U);
+}
+
+// Ratio and speed of the compression types on chunks of real column blocks
+TEST_F(CompressionTest, ColumnBlocksRatioAndSpeed)
+{
+  struct Block
+  {
+    const char* name;
+    const unsigned char* data;
+    size_t len;
+    uint32_t width;
+    execplan::CalpontSystemCatalog::ColDataType dataType;
+  };
+  const Block blocks[] = {
+      {"BIGINT", ___bin_col8block_cdf, ___bin_col8block_cdf_len, 8, execplan::CalpontSystemCatalog::BIGINT},
+      {"INT", __col4block_cdf, __col4block_cdf_len, 4, execplan::CalpontSystemCatalog::INT},
+      {"DOUBLE", ___bin_col_double_block_cdf, ___bin_col_double_block_cdf_len, 8,
+       execplan::CalpontSystemCatalog::DOUBLE},
+      {"FLOAT", ___bin_col_float_block_cdf, ___bin_col_float_block_cdf_len, 4,
+       execplan::CalpontSystemCatalog::FLOAT}};
+  const uint32_t chunkSize = compress::CompressInterface::UNCOMPRESSED_INBUF_LEN;
+
+  for (const auto& block : blocks)
+  {
+    std::string chunk;
+    chunk.reserve(chunkSize);
+
+    while (chunk.size() < chunkSize)
+      chunk.append(reinterpret_cast<const char*>(block.data), block.len);
+
+    chunk.resize(chunkSize);
+
+    for (uint32_t type = 2; type <= 4; type++)
+    {
+      if (!compress::CompressInterface::isCompressionAvail(type))
+        continue;
+
+      // Without and with the integer encodings, that are kept only if smaller
+      size_t plainSize = 0;
+
+      for (uint32_t colWidth : {0U, block.width})
+      {
+        std::unique_ptr<compress::CompressInterface> compressor(
+            compress::getCompressInterfaceByType(type, 0, 0, colWidth != 0));
+        size_t compressedSize = compressor->maxCompressedSize(chunkSize);
+        std::unique_ptr<unsigned char[]> compressedData(new unsigned char[compressedSize]);
+        size_t uncompressedSize = chunkSize;
+        std::unique_ptr<unsigned char[]> uncompressedData(new unsigned char[uncompressedSize]);
+
+        auto start = std::chrono::steady_clock::now();
+        auto rc = compressor->compressBlock(chunk.data(), chunkSize, compressedData.get(), compressedSize,
+                                            colWidth, block.dataType);
+        auto compressed = std::chrono::steady_clock::now();
+        ASSERT_EQ(rc, 0);
+        rc = compressor->uncompressBlock(reinterpret_cast<char*>(compressedData.get()), compressedSize,
+                                         uncompressedData.get(), uncompressedSize);
+        auto uncompressed = std::chrono::steady_clock::now();
+        ASSERT_EQ(rc, 0);
+        ASSERT_EQ(uncompressedSize, chunkSize);
+        EXPECT_EQ(std::memcmp(uncompressedData.get(), chunk.data(), chunkSize), 0);
+
+        if (colWidth == 0)
+          plainSize = compressedSize;
+        else
+          EXPECT_LE(compressedSize, plainSize);
+
+        auto usecs = [](auto from, auto to)
+        { return std::chrono::duration_cast<std::chrono::microseconds>(to - from).count() + 1; };
+        std::cout << block.name << " type " << type << (colWidth ? " encoded" : "")
+                  << " ratio: " << (float)chunkSize / compressedSize
+                  << " compress MB/s: " << chunkSize / usecs(start, compressed)
+                  << " uncompress MB/s: " << chunkSize / usecs(compressed, uncompressed) << std::endl;
+      }
+    }
+  }
+}
+
+template <typename T>
+std::string makeChunk(size_t len, std::function<T(size_t)> value)
+{
+  std::string chunk(len, '\0');
+
+  for (size_t i = 0; i < len / sizeof(T); i++)
+  {
+    T v = value(i);
+    std::memcpy(&chunk[i * sizeof(T)], &v, sizeof(T));
+  }
+
+  return chunk;
+}
+
+TEST_F(CompressionTest, ChunkEncodingRoundTrip)
+{
+  std::mt19937_64 gen(42);
+  const size_t chunkSize = compress::CompressInterface::UNCOMPRESSED_INBUF_LEN;
+  struct Case
+  {
+    const char* name;
+    std::string chunk;
+    uint32_t width;
+    bool encoded;
+    bool floats = false;
+  };
+  // Sensor readings with two decimals, and the values ALP keeps apart
+  auto reading = [&](size_t i)
+  {
+    const double special[] = {-0.0, std::numeric_limits<double>::infinity(), 0.1 + 0.2, 1e300};
+    return i % 1000 == 7 ? special[i / 1000 % 4] : (20000 + int64_t(gen() % 1000)) / 100.0;
+  };
+  std::vector<Case> cases{
+      {"ascending ids", makeChunk<int64_t>(chunkSize, [](size_t i) { return 1000000000000 + i * 3; }), 8,
+       true},
+      {"20 bit values", makeChunk<int64_t>(chunkSize, [&](size_t) { return gen() % (1 << 20); }), 8, true},
+      {"negative values", makeChunk<int32_t>(chunkSize, [&](size_t) { return -int32_t(gen() % 1000); }), 4,
+       true},
+      {"descending", makeChunk<int16_t>(chunkSize, [](size_t i) { return int16_t(30000 - i % 60000); }), 2,
+       true},
+      {"constant", makeChunk<int8_t>(chunkSize, [](size_t) { return int8_t(-2); }), 1, true},
+      {"tail", makeChunk<int32_t>(8192 * 3 + 100, [](size_t i) { return i; }), 4, true},
+      {"random", makeChunk<uint64_t>(chunkSize, [&](size_t) { return gen(); }), 8, false},
+      {"doubles", makeChunk<double>(chunkSize, reading), 8, true, true},
+      {"floats", makeChunk<float>(chunkSize, [&](size_t i) { return float(reading(i)); }), 4, true, true},
+      {"random doubles", makeChunk<uint64_t>(chunkSize, [&](size_t) { return gen(); }), 8, false, true},
+  };
+
+  for (auto& c : cases)
+  {
+    SCOPED_TRACE(c.name);
+    std::vector<char> encoded(c.chunk.size() + compress::ChunkEncoding::SLACK);
+    size_t encodedLen =
+        compress::ChunkEncoding::encode(c.chunk.data(), c.chunk.size(), c.width, c.floats, encoded.data());
+    ASSERT_EQ(encodedLen > 0, c.encoded);
+
+    if (!c.encoded)
+      continue;
+
+    EXPECT_LT(encodedLen, c.chunk.size());
+
+    if (c.floats)
+    {
+      // The decimal digits pack smaller than the bits of the floats
+      std::vector<char> integers(encoded.size());
+      size_t integersLen =
+          compress::ChunkEncoding::encode(c.chunk.data(), c.chunk.size(), c.width, false, integers.data());
+      EXPECT_TRUE(integersLen == 0 || encodedLen < integersLen);
+    }
+    std::string decoded(c.chunk.size(), '\0');
+    size_t decodedLen = decoded.size();
+    ASSERT_TRUE(compress::ChunkEncoding::decode(encoded.data(), encodedLen, &decoded[0], &decodedLen));
+    EXPECT_EQ(decodedLen, c.chunk.size());
+    EXPECT_TRUE(decoded == c.chunk);
+
+    // Too small an output or a truncated chunk is an error
+    decodedLen = decoded.size() - 1;
+    EXPECT_FALSE(compress::ChunkEncoding::decode(encoded.data(), encodedLen, &decoded[0], &decodedLen));
+    decodedLen = decoded.size();
+    EXPECT_FALSE(compress::ChunkEncoding::decode(encoded.data(), encodedLen - 1, &decoded[0], &decodedLen));
+  }
+
+  // Encoded chunks are compressed smaller and read back by uncompressBlock()
+  std::unique_ptr<compress::CompressInterface> compressor(new compress::CompressInterfaceLZ4());
+  const std::string& chunk = cases[1].chunk;
+  size_t plainLen = compressor->maxCompressedSize(chunkSize);
+  size_t encodedLen = plainLen;
+  std::unique_ptr<unsigned char[]> plain(new unsigned char[plainLen]);
+  std::unique_ptr<unsigned char[]> encoded(new unsigned char[encodedLen]);
+  // Off by default: the column width alone does not encode the chunk
+  EXPECT_FALSE(compressor->encodeChunks());
+  ASSERT_EQ(compressor->compressBlock(chunk.data(), chunkSize, plain.get(), plainLen, 8), 0);
+  compressor->encodeChunks(true);
+  ASSERT_EQ(compressor->compressBlock(chunk.data(), chunkSize, encoded.get(), encodedLen, 8), 0);
+  EXPECT_LT(encodedLen, plainLen);
+
+  std::string uncompressed(chunkSize, '\0');
+  size_t uncompressedLen = chunkSize;
+  ASSERT_EQ(compressor->uncompressBlock(reinterpret_cast<char*>(encoded.get()), encodedLen,
+                                        reinterpret_cast<unsigned char*>(&uncompressed[0]), uncompressedLen),
+            0);
+  EXPECT_EQ(uncompressedLen, chunkSize);
+  EXPECT_TRUE(uncompressed == chunk);
+}
+
+TEST_F(CompressionTest, ChunkZoneMapsInHeader)
+{
+  std::unique_ptr<char[]> hdr(new char[compress::CompressInterface::HDR_BUF_LEN * 2]);
+  compress::CompressInterface::initHdr(hdr.get(), 8, execplan::CalpontSystemCatalog::BIGINT, 2);
+
+  // A fresh header has no zone maps
+  compress::ChunkZoneMap zoneMap;
+  EXPECT_FALSE(compress::CompressInterface::getChunkZoneMap(hdr.get(), 0, zoneMap));
+
+  compress::ChunkZoneMap written{-5, 100, 3,
+                                 compress::ChunkZoneMap::VALID | compress::ChunkZoneMap::HAS_VALUES};
+  compress::CompressInterface::setChunkZoneMap(hdr.get(), 1, written);
+  compress::CompressInterface::setChunkZoneMap(hdr.get(), 2, written);
+  compress::CompressInterface::setChunkZoneMap(hdr.get(), compress::CompressInterface::MAX_CHUNK_ZONE_MAPS,
+                                               written);
+  compress::CompressInterface::setLBIDByIndex(hdr.get(), 1234, 0);
+
+  ASSERT_TRUE(compress::CompressInterface::getChunkZoneMap(hdr.get(), 1, zoneMap));
+  EXPECT_EQ(zoneMap.min, -5);
+  EXPECT_EQ(zoneMap.max, 100);
+  EXPECT_EQ(zoneMap.nullCount, 3U);
+  EXPECT_FALSE(compress::CompressInterface::getChunkZoneMap(
+      hdr.get(), compress::CompressInterface::MAX_CHUNK_ZONE_MAPS, zoneMap));
+  EXPECT_EQ(compress::CompressInterface::getLBIDByIndex(hdr.get(), 0), 1234U);
+
+  compress::CompressInterface::clearChunkZoneMaps(hdr.get(), 2);
+  EXPECT_TRUE(compress::CompressInterface::getChunkZoneMap(hdr.get(), 1, zoneMap));
+  EXPECT_FALSE(compress::CompressInterface::getChunkZoneMap(hdr.get(), 2, zoneMap));
+}
+
+TEST_F(CompressionTest, ChunkZoneMapOfValues)
+{
+  WriteEngine::FileOp fileOp(false);
+  const uint8_t* emptyVal = fileOp.getEmptyRowValue(execplan::CalpontSystemCatalog::INT, 4);
+  std::vector<int32_t> values(1024);
+  unsigned char* buf = reinterpret_cast<unsigned char*>(values.data());
+  WriteEngine::BlockOp::setEmptyBuf(buf, values.size() * 4, emptyVal, 4);
+  values[3] = -7;
+  values[10] = 42;
+  values[11] = static_cast<int32_t>(joblist::INTNULL);
+  values[500] = 5;
+
+  compress::ChunkZoneMap zoneMap;
+  ASSERT_TRUE(WriteEngine::FileOp::computeChunkZoneMap(buf, values.size() * 4,
+                                                       execplan::CalpontSystemCatalog::INT, 4, emptyVal,
+                                                       zoneMap));
+  EXPECT_EQ(zoneMap.min, -7);
+  EXPECT_EQ(zoneMap.max, 42);
+  EXPECT_EQ(zoneMap.nullCount, 1U);
+  EXPECT_TRUE(zoneMap.flags & compress::ChunkZoneMap::HAS_VALUES);
+
+  // Unsigned values are kept zero-extended
+  emptyVal = fileOp.getEmptyRowValue(execplan::CalpontSystemCatalog::UINT, 4);
+  WriteEngine::BlockOp::setEmptyBuf(buf, values.size() * 4, emptyVal, 4);
+  values[0] = static_cast<int32_t>(0xF0000000);
+  values[1] = 1;
+  ASSERT_TRUE(WriteEngine::FileOp::computeChunkZoneMap(buf, values.size() * 4,
+                                                       execplan::CalpontSystemCatalog::UINT, 4, emptyVal,
+                                                       zoneMap));
+  EXPECT_EQ(zoneMap.min, 1);
+  EXPECT_EQ(zoneMap.max, 0xF0000000LL);
+
+  // A chunk of empty rows has a zone map without values, strings have none
+  WriteEngine::BlockOp::setEmptyBuf(buf, values.size() * 4, emptyVal, 4);
+  ASSERT_TRUE(WriteEngine::FileOp::computeChunkZoneMap(buf, values.size() * 4,
+                                                       execplan::CalpontSystemCatalog::UINT, 4, emptyVal,
+                                                       zoneMap));
+  EXPECT_FALSE(zoneMap.flags & compress::ChunkZoneMap::HAS_VALUES);
+  EXPECT_FALSE(WriteEngine::FileOp::computeChunkZoneMap(buf, values.size() * 4,
+                                                        execplan::CalpontSystemCatalog::VARCHAR, 4, emptyVal,
+                                                        zoneMap));
+}
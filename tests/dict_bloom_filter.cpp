@@ -0,0 +1,125 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "dictbloomfilter.h"
+
+using utils::DictBloomFilter;
+
+namespace
+{
+const uint32_t BINARY = 63;
+const uint32_t UTF8MB4_GENERAL_CI = 45;
+
+void add(std::vector<uint8_t>& filter, const datatypes::Charset& cs, const std::string& str)
+{
+  uint32_t bits[DictBloomFilter::HASH_COUNT];
+  DictBloomFilter::bits(DictBloomFilter::hash(cs, str.data(), str.length()), filter.size(), bits);
+
+  for (auto bit : bits)
+    DictBloomFilter::set(filter.data(), bit);
+}
+
+bool mayHave(const std::vector<uint8_t>& filter, const datatypes::Charset& cs, const std::string& str)
+{
+  uint32_t bits[DictBloomFilter::HASH_COUNT];
+  DictBloomFilter::bits(DictBloomFilter::hash(cs, str.data(), str.length()), filter.size(), bits);
+
+  for (auto bit : bits)
+  {
+    // The file offsets of the bits index the filter after the header
+    if (!DictBloomFilter::test(filter[DictBloomFilter::offset(bit) - DictBloomFilter::HEADER_LEN], bit))
+      return false;
+  }
+
+  return true;
+}
+}  // namespace
+
+TEST(DictBloomFilter, Header)
+{
+  DictBloomFilter::Header header;
+  DictBloomFilter::initHeader(header, UTF8MB4_GENERAL_CI, 65536, true);
+  EXPECT_TRUE(DictBloomFilter::isValid(header));
+  EXPECT_EQ(header.charsetNumber, UTF8MB4_GENERAL_CI);
+  EXPECT_EQ(header.filterBytes, 65536U);
+  EXPECT_LE(sizeof(header), DictBloomFilter::HEADER_LEN);
+
+  DictBloomFilter::initHeader(header, UTF8MB4_GENERAL_CI, 65536, false);
+  EXPECT_FALSE(DictBloomFilter::isValid(header));
+
+  DictBloomFilter::initHeader(header, BINARY, 65536, true);
+  header.magic[0] = 'X';
+  EXPECT_FALSE(DictBloomFilter::isValid(header));
+
+  // The bits of a string are masked with the size, it must be a power of 2
+  DictBloomFilter::initHeader(header, BINARY, 65536 + 4096, true);
+  EXPECT_FALSE(DictBloomFilter::isValid(header));
+  DictBloomFilter::initHeader(header, BINARY, 2 * DictBloomFilter::MAX_FILTER_BYTES, true);
+  EXPECT_FALSE(DictBloomFilter::isValid(header));
+}
+
+TEST(DictBloomFilter, SizedForTheStrings)
+{
+  const uint32_t minBytes = DictBloomFilter::MIN_FILTER_BYTES;
+  const uint32_t maxBytes = DictBloomFilter::MAX_FILTER_BYTES;
+  EXPECT_EQ(DictBloomFilter::filterBytes(0), minBytes);
+  EXPECT_EQ(DictBloomFilter::filterBytes(1000), minBytes);
+  // 10 bits a string rounded up to a power of 2
+  EXPECT_EQ(DictBloomFilter::filterBytes(100000), 131072U);
+  EXPECT_EQ(DictBloomFilter::filterBytes(104857), 131072U);
+  EXPECT_EQ(DictBloomFilter::filterBytes(104858), 262144U);
+  EXPECT_EQ(DictBloomFilter::filterBytes(uint64_t(1) << 40), maxBytes);
+}
+
+TEST(DictBloomFilter, FindsAddedStrings)
+{
+  datatypes::Charset cs(BINARY);
+  std::vector<uint8_t> filter(DictBloomFilter::filterBytes(100000), 0);
+
+  for (uint32_t i = 0; i < 100000; i++)
+    add(filter, cs, "customer#" + std::to_string(i * 2));
+
+  uint32_t falsePositives = 0;
+
+  for (uint32_t i = 0; i < 100000; i++)
+  {
+    EXPECT_TRUE(mayHave(filter, cs, "customer#" + std::to_string(i * 2)));
+    falsePositives += mayHave(filter, cs, "customer#" + std::to_string(i * 2 + 1));
+  }
+
+  // About 1.5% with 3 bits per string and 10.5 bits a string
+  EXPECT_LT(falsePositives, 2000U);
+}
+
+TEST(DictBloomFilter, FollowsCollation)
+{
+  std::vector<uint8_t> filter(DictBloomFilter::MIN_FILTER_BYTES, 0);
+  datatypes::Charset ci(UTF8MB4_GENERAL_CI);
+  add(filter, ci, "Some Longer String");
+  EXPECT_TRUE(mayHave(filter, ci, "some longer string"));
+  EXPECT_TRUE(mayHave(filter, ci, "SOME LONGER STRING  "));
+
+  std::vector<uint8_t> binFilter(DictBloomFilter::MIN_FILTER_BYTES, 0);
+  datatypes::Charset bin(BINARY);
+  add(binFilter, bin, "Some Longer String");
+  EXPECT_FALSE(mayHave(binFilter, bin, "some longer string"));
+}
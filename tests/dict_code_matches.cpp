@@ -0,0 +1,253 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "primitives/linux-port/primitiveprocessor.h"
+#include "dictorderindex.h"
+
+using namespace primitives;
+using utils::DictOrderIndex;
+
+namespace
+{
+const uint32_t BINARY = 63;
+const uint32_t UTF8MB4_GENERAL_CI = 45;
+const uint64_t LBID = 100;
+}  // namespace
+
+// The strings of a store block a filter keeps, with p_Dictionary() and with the codes of
+// the order index of the block
+class DictCodeMatchesTest : public ::testing::Test
+{
+ protected:
+  PrimitiveProcessor pp;
+  alignas(int) uint8_t block[BLOCK_SIZE];
+  std::vector<std::string> strings;
+  std::vector<uint8_t> filters;
+  uint16_t nops = 0;
+
+  void SetUp() override
+  {
+    // Strings equal under utf8mb4_general_ci, some with trailing spaces
+    setStrings({"apple", "Apple", "APPLE ", "apple  ", "banana", "Banana", "b", "cherry", "ab", "abc", "a%c",
+                "date", " apple", "aPpLe pie", "zebra"});
+  }
+
+  void setStrings(const std::vector<std::string>& strs)
+  {
+    strings = strs;
+    memset(block, 0, sizeof(block));
+    uint16_t* offsets = reinterpret_cast<uint16_t*>(&block[10]);
+    offsets[0] = BLOCK_SIZE;
+
+    for (uint32_t i = 0; i < strings.size(); i++)
+    {
+      offsets[i + 1] = offsets[i] - strings[i].length();
+      memcpy(&block[offsets[i + 1]], strings[i].data(), strings[i].length());
+    }
+
+    offsets[strings.size() + 1] = 0xffff;
+  }
+
+  void addFilter(uint8_t cop, const std::string& literal)
+  {
+    size_t pos = filters.size();
+    filters.resize(pos + sizeof(DictFilterElement) + literal.length());
+    DictFilterElement* filter = reinterpret_cast<DictFilterElement*>(&filters[pos]);
+    filter->COP = cop;
+    filter->len = literal.length();
+    memcpy(filter->data, literal.data(), literal.length());
+    nops++;
+  }
+
+  boost::shared_ptr<DictEqualityFilter> makeEqFilter(uint32_t charsetNumber,
+                                                     const std::vector<std::string>& values)
+  {
+    boost::shared_ptr<DictEqualityFilter> eqFilter(new DictEqualityFilter(datatypes::Charset(charsetNumber)));
+
+    for (const auto& value : values)
+      eqFilter->insert(value);
+
+    return eqFilter;
+  }
+
+  std::set<std::string> dictionaryMatches(uint8_t bop, uint32_t charsetNumber,
+                                          const boost::shared_ptr<DictEqualityFilter>& eqFilter, uint8_t eqOp)
+  {
+    std::vector<uint8_t> input(sizeof(DictInput) + filters.size());
+    DictInput* in = reinterpret_cast<DictInput*>(input.data());
+    in->LBID = LBID;
+    in->BOP = bop;
+    in->InputFlags = 0;
+    in->OutputType = OT_DATAVALUE;
+    in->NOPS = eqFilter ? 0 : nops;
+    in->NVALS = 0;
+    memcpy(&input[sizeof(DictInput)], filters.data(), filters.size());
+
+    std::vector<uint8_t> out;
+    pp.setBlockPtr(reinterpret_cast<int*>(block));
+    pp.p_Dictionary(in, &out, false, charsetNumber, eqFilter, eqOp);
+
+    const DictOutput* header = reinterpret_cast<const DictOutput*>(out.data());
+    std::set<std::string> result;
+    size_t pos = sizeof(DictOutput);
+
+    for (uint32_t i = 0; i < header->NVALS; i++)
+    {
+      const DataValue* value = reinterpret_cast<const DataValue*>(&out[pos]);
+      result.insert(std::string(value->data, value->len));
+      pos += sizeof(DataValue) + value->len;
+    }
+
+    return result;
+  }
+
+  std::set<std::string> codeMatches(uint8_t bop, uint32_t charsetNumber,
+                                    const boost::shared_ptr<DictEqualityFilter>& eqFilter, uint8_t eqOp)
+  {
+    std::vector<std::pair<uint64_t, uint32_t>> tokens;
+
+    for (uint32_t i = 0; i < strings.size(); i++)
+      tokens.push_back(std::make_pair((LBID << 10) | (i + 1), i));
+
+    DictOrderIndex index;
+    index.build(datatypes::Charset(charsetNumber), strings, tokens);
+
+    std::vector<uint8_t> matches;
+    std::set<std::string> result;
+    EXPECT_TRUE(PrimitiveProcessor::dictCodeMatches(index, filters.data(), eqFilter ? 0 : nops, bop,
+                                                    charsetNumber, eqFilter, eqOp, matches));
+    EXPECT_EQ(matches.size(), strings.size());
+
+    for (uint32_t code = 0; code < matches.size(); code++)
+    {
+      if (matches[code])
+        result.insert(std::string(index.string(code).str(), index.string(code).length()));
+    }
+
+    return result;
+  }
+
+  void expectSameMatches(uint8_t bop, uint32_t charsetNumber,
+                         const boost::shared_ptr<DictEqualityFilter>& eqFilter = nullptr,
+                         uint8_t eqOp = COMPARE_EQ)
+  {
+    EXPECT_EQ(codeMatches(bop, charsetNumber, eqFilter, eqOp),
+              dictionaryMatches(bop, charsetNumber, eqFilter, eqOp));
+  }
+};
+
+TEST_F(DictCodeMatchesTest, Comparisons)
+{
+  for (uint32_t charsetNumber : {UTF8MB4_GENERAL_CI, BINARY})
+  {
+    for (uint8_t cop : {COMPARE_EQ, COMPARE_NE, COMPARE_LT, COMPARE_LE, COMPARE_GT, COMPARE_GE})
+    {
+      for (const std::string literal : {"apple", "APPLE  ", "b", "a", "zzz", ""})
+      {
+        filters.clear();
+        nops = 0;
+        addFilter(cop, literal);
+        SCOPED_TRACE(std::to_string(charsetNumber) + " " + std::to_string(cop) + " '" + literal + "'");
+        expectSameMatches(BOP_NONE, charsetNumber);
+      }
+    }
+  }
+}
+
+TEST_F(DictCodeMatchesTest, EqFilterTrimsTrailingSpaces)
+{
+  for (uint32_t charsetNumber : {UTF8MB4_GENERAL_CI, BINARY})
+  {
+    for (uint8_t eqOp : {COMPARE_EQ, COMPARE_NE})
+    {
+      SCOPED_TRACE(std::to_string(charsetNumber) + " " + std::to_string(eqOp));
+      expectSameMatches(BOP_OR, charsetNumber, makeEqFilter(charsetNumber, {"apple"}), eqOp);
+      expectSameMatches(BOP_OR, charsetNumber, makeEqFilter(charsetNumber, {"apple", "b", "nothing"}), eqOp);
+    }
+  }
+
+  // The strings with trailing spaces are in the list
+  auto matches = codeMatches(BOP_OR, BINARY, makeEqFilter(BINARY, {"apple"}), COMPARE_EQ);
+  EXPECT_EQ(matches, std::set<std::string>({"apple", "apple  "}));
+}
+
+TEST_F(DictCodeMatchesTest, EqFilterOfSeveralValues)
+{
+  // col = 'a' AND col = 'b' keeps nothing, col <> 'a' OR col <> 'b' keeps everything
+  auto eqFilter = makeEqFilter(UTF8MB4_GENERAL_CI, {"apple", "banana"});
+  expectSameMatches(BOP_AND, UTF8MB4_GENERAL_CI, eqFilter, COMPARE_EQ);
+  expectSameMatches(BOP_OR, UTF8MB4_GENERAL_CI, eqFilter, COMPARE_NE);
+  expectSameMatches(BOP_OR, UTF8MB4_GENERAL_CI, eqFilter, COMPARE_EQ);
+  expectSameMatches(BOP_AND, UTF8MB4_GENERAL_CI, eqFilter, COMPARE_NE);
+  EXPECT_TRUE(codeMatches(BOP_AND, UTF8MB4_GENERAL_CI, eqFilter, COMPARE_EQ).empty());
+  EXPECT_EQ(codeMatches(BOP_OR, UTF8MB4_GENERAL_CI, eqFilter, COMPARE_NE).size(), strings.size());
+}
+
+TEST_F(DictCodeMatchesTest, NotEqualWithAndOr)
+{
+  addFilter(COMPARE_NE, "apple");
+  addFilter(COMPARE_NE, "b");
+
+  for (uint8_t bop : {BOP_AND, BOP_OR})
+  {
+    SCOPED_TRACE(std::to_string(bop));
+    expectSameMatches(bop, UTF8MB4_GENERAL_CI);
+    expectSameMatches(bop, BINARY);
+  }
+}
+
+TEST_F(DictCodeMatchesTest, Like)
+{
+  for (uint8_t cop : {COMPARE_LIKE, COMPARE_NLIKE})
+  {
+    for (const std::string pattern : {"ap%", "%E", "_", "a\\%c", "%an%", "apple"})
+    {
+      filters.clear();
+      nops = 0;
+      addFilter(cop, pattern);
+      SCOPED_TRACE(std::to_string(cop) + " '" + pattern + "'");
+      expectSameMatches(BOP_NONE, UTF8MB4_GENERAL_CI);
+      expectSameMatches(BOP_NONE, BINARY);
+    }
+  }
+}
+
+TEST_F(DictCodeMatchesTest, MixedOperators)
+{
+  // col >= 'a' AND col < 'c' AND col NOT LIKE '%n%'
+  addFilter(COMPARE_GE, "a");
+  addFilter(COMPARE_LT, "c");
+  addFilter(COMPARE_NLIKE, "%n%");
+  expectSameMatches(BOP_AND, UTF8MB4_GENERAL_CI);
+  expectSameMatches(BOP_AND, BINARY);
+
+  // col = 'date' OR col LIKE 'b%' OR col > 'y'
+  filters.clear();
+  nops = 0;
+  addFilter(COMPARE_EQ, "date");
+  addFilter(COMPARE_LIKE, "b%");
+  addFilter(COMPARE_GT, "y");
+  expectSameMatches(BOP_OR, UTF8MB4_GENERAL_CI);
+  expectSameMatches(BOP_OR, BINARY);
+}
@@ -0,0 +1,97 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "dictngramindex.h"
+
+using utils::DictNgramIndex;
+
+namespace
+{
+// A block signature of the strings
+std::vector<uint8_t> signature(const std::vector<std::string>& strs, bool exact)
+{
+  std::vector<uint8_t> sig(DictNgramIndex::SIGNATURE_BYTES, 0);
+
+  for (const auto& str : strs)
+    DictNgramIndex::add(sig.data(), reinterpret_cast<const uint8_t*>(str.data()), str.length(), exact);
+
+  return sig;
+}
+
+bool mayMatch(const std::vector<uint8_t>& sig, const std::string& pattern, bool exact)
+{
+  std::vector<uint32_t> bits;
+  EXPECT_TRUE(DictNgramIndex::patternBits(pattern.data(), pattern.length(), exact, bits));
+  return DictNgramIndex::mayMatch(sig.data(), bits);
+}
+}  // namespace
+
+TEST(DictNgramIndex, SupportedCollations)
+{
+  EXPECT_TRUE(DictNgramIndex::supported(datatypes::Charset(63).getCharset()));   // binary
+  EXPECT_TRUE(DictNgramIndex::supported(datatypes::Charset(8).getCharset()));    // latin1_swedish_ci
+  EXPECT_TRUE(DictNgramIndex::supported(datatypes::Charset(45).getCharset()));   // utf8mb4_general_ci
+  EXPECT_FALSE(DictNgramIndex::supported(datatypes::Charset(28).getCharset()));  // gbk_chinese_ci
+  EXPECT_TRUE(DictNgramIndex::exact(datatypes::Charset(46).getCharset()));       // utf8mb4_bin
+  EXPECT_FALSE(DictNgramIndex::exact(datatypes::Charset(45).getCharset()));
+}
+
+TEST(DictNgramIndex, PatternTrigrams)
+{
+  std::vector<uint32_t> bits;
+
+  // Too short between the wildcards
+  EXPECT_FALSE(DictNgramIndex::patternBits("%ab%", 4, true, bits));
+  EXPECT_FALSE(DictNgramIndex::patternBits("a_c%de", 6, true, bits));
+  EXPECT_TRUE(DictNgramIndex::patternBits("%abc%", 5, true, bits));
+  EXPECT_EQ(bits.size(), 1U);
+  EXPECT_TRUE(DictNgramIndex::patternBits("%abcd_efg%", 10, true, bits));
+  EXPECT_EQ(bits.size(), 3U);
+
+  // The escaped wildcards are literal
+  std::string escaped = "%50\\%o%";
+  EXPECT_TRUE(DictNgramIndex::patternBits(escaped.data(), escaped.length(), true, bits));
+  EXPECT_EQ(bits.size(), 2U);
+}
+
+TEST(DictNgramIndex, SkipsBlocksWithoutPattern)
+{
+  auto sig = signature({"connection timeout on node 7", "disk full"}, true);
+  EXPECT_TRUE(mayMatch(sig, "%timeout%", true));
+  EXPECT_TRUE(mayMatch(sig, "connection%node%", true));
+  EXPECT_TRUE(mayMatch(sig, "%disk_full", true));
+  EXPECT_FALSE(mayMatch(sig, "%segfault%", true));
+  EXPECT_FALSE(mayMatch(sig, "%TIMEOUT%", true));
+}
+
+TEST(DictNgramIndex, FoldsCase)
+{
+  auto sig = signature({"Connection Timeout"}, false);
+  EXPECT_TRUE(mayMatch(sig, "%TIMEOUT%", false));
+  EXPECT_TRUE(mayMatch(sig, "%connection%", false));
+  EXPECT_FALSE(mayMatch(sig, "%refused%", false));
+
+  // The collation may match other bytes to the pattern
+  auto accented = signature({"caf\xc3\xa9 ol\xc3\xa9"}, false);
+  EXPECT_TRUE(mayMatch(accented, "%cafe%", false));
+  EXPECT_TRUE(mayMatch(accented, "%anything%", false));
+}
@@ -0,0 +1,282 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dictorderindex.h"
+
+using utils::ConstString;
+using utils::DictOrderIndex;
+using utils::DictOrderIndexWriter;
+
+namespace
+{
+const uint32_t BINARY = 63;
+const uint32_t UTF8MB4_GENERAL_CI = 45;
+
+// A token of the op-th string of a store block
+uint64_t token(uint64_t lbid, uint32_t op)
+{
+  return (lbid << 10) | op;
+}
+
+// Writes and reads back the index of the strings, every string has a token in block 100
+DictOrderIndex makeIndex(const datatypes::Charset& cs, uint32_t charsetNumber,
+                         const std::vector<std::string>& strings)
+{
+  std::vector<std::pair<uint64_t, uint32_t>> tokens;
+
+  for (uint32_t i = 0; i < strings.size(); i++)
+    tokens.push_back(std::make_pair(token(100, i + 1), i));
+
+  DictOrderIndex written;
+  std::string file;
+  written.build(cs, strings, tokens);
+  written.serialize(charsetNumber, 42, file);
+
+  DictOrderIndex::Header header;
+  memcpy(&header, file.data(), sizeof(header));
+  EXPECT_TRUE(DictOrderIndex::isValid(header));
+  EXPECT_EQ(file.length(), sizeof(header) + DictOrderIndex::bodyLength(header));
+
+  DictOrderIndex index;
+  EXPECT_TRUE(index.deserialize(header, file.data() + sizeof(header), file.length() - sizeof(header)));
+  EXPECT_EQ(index.generation(), 42U);
+  return index;
+}
+
+// The code of the string of a token in the index a writer writes
+bool writtenCode(const DictOrderIndexWriter& writer, uint64_t tok, std::string& str)
+{
+  DictOrderIndex index;
+  writer.build(index);
+  auto block = index.blockTokens(tok >> 10);
+  uint32_t code;
+
+  if (!DictOrderIndex::find(block.first, block.second, tok, code))
+    return false;
+
+  str.assign(index.string(code).str(), index.string(code).length());
+  return true;
+}
+}  // namespace
+
+TEST(DictOrderIndex, Header)
+{
+  DictOrderIndex::Header header;
+  DictOrderIndex::initHeader(header, UTF8MB4_GENERAL_CI, true);
+  EXPECT_TRUE(DictOrderIndex::isValid(header));
+  EXPECT_EQ(header.charsetNumber, UTF8MB4_GENERAL_CI);
+
+  DictOrderIndex::initHeader(header, UTF8MB4_GENERAL_CI, false);
+  EXPECT_FALSE(DictOrderIndex::isValid(header));
+
+  DictOrderIndex::initHeader(header, BINARY, true);
+  header.stringCount = DictOrderIndex::MAX_STRINGS + 1;
+  EXPECT_FALSE(DictOrderIndex::isValid(header));
+}
+
+TEST(DictOrderIndex, CodesFollowTheCollation)
+{
+  datatypes::Charset cs(UTF8MB4_GENERAL_CI);
+  std::vector<std::string> strings;
+
+  for (uint32_t i = 0; i < 1000; i++)
+    strings.push_back((i % 3 ? "Part#" : "part#") + std::to_string((i * 7919) % 1000));
+
+  DictOrderIndex index = makeIndex(cs, UTF8MB4_GENERAL_CI, strings);
+  ASSERT_EQ(index.size(), strings.size());
+
+  for (uint32_t code = 1; code < index.size(); code++)
+    EXPECT_LE(cs.strnncollsp(index.string(code - 1), index.string(code)), 0);
+
+  // Every string has the code the token of its position gives
+  auto block = index.blockTokens(100);
+  ASSERT_EQ(block.second - block.first, (ptrdiff_t)strings.size());
+
+  for (uint32_t i = 0; i < strings.size(); i++)
+  {
+    uint32_t code;
+    ASSERT_TRUE(DictOrderIndex::find(block.first, block.second, token(100, i + 1), code));
+    EXPECT_EQ(cs.strnncollsp(index.string(code), ConstString(strings[i])), 0);
+  }
+
+  uint32_t code;
+  EXPECT_FALSE(DictOrderIndex::find(block.first, block.second, token(100, 1001), code));
+  EXPECT_EQ(index.blockTokens(99).first, index.blockTokens(99).second);
+  EXPECT_EQ(index.blockTokens(101).first, index.blockTokens(101).second);
+}
+
+TEST(DictOrderIndex, BoundsMatchTheComparisons)
+{
+  datatypes::Charset cs(UTF8MB4_GENERAL_CI);
+  std::vector<std::string> strings = {"apple", "Apple", "banana", "APPLE ", "cherry", "b", "Banana", "date"};
+  DictOrderIndex index = makeIndex(cs, UTF8MB4_GENERAL_CI, strings);
+
+  for (const std::string literal : {"apple", "BANANA", "a", "c", "zzz", "", "cherry"})
+  {
+    ConstString str(literal);
+    uint32_t lo = index.lowerBound(cs, str);
+    uint32_t hi = index.upperBound(cs, str);
+    ASSERT_LE(lo, hi);
+
+    // The codes below lo are less than the literal, the ones from hi greater than it
+    for (uint32_t code = 0; code < index.size(); code++)
+    {
+      int cmp = cs.strnncollsp(index.string(code), str);
+      EXPECT_EQ(cmp < 0, code < lo) << literal << " " << code;
+      EXPECT_EQ(cmp == 0, code >= lo && code < hi) << literal << " " << code;
+    }
+  }
+
+  // "apple", "Apple" and "APPLE " are equal under the collation
+  ConstString apple("apple", 5);
+  EXPECT_EQ(index.upperBound(cs, apple) - index.lowerBound(cs, apple), 3U);
+
+  datatypes::Charset bin(BINARY);
+  DictOrderIndex binIndex = makeIndex(bin, BINARY, strings);
+  EXPECT_EQ(binIndex.upperBound(bin, apple) - binIndex.lowerBound(bin, apple), 1U);
+}
+
+TEST(DictOrderIndex, RejectsInconsistentFiles)
+{
+  datatypes::Charset cs(BINARY);
+  DictOrderIndex written;
+  std::string file;
+  written.build(cs, {"one", "two"}, {{token(7, 1), 0}, {token(7, 2), 1}});
+  written.serialize(BINARY, 1, file);
+
+  DictOrderIndex::Header header;
+  memcpy(&header, file.data(), sizeof(header));
+  std::string body = file.substr(sizeof(header));
+  DictOrderIndex index;
+
+  EXPECT_TRUE(index.deserialize(header, body.data(), body.length()));
+  EXPECT_FALSE(index.deserialize(header, body.data(), body.length() - 1));
+
+  // A code past the strings
+  std::string badCode = body;
+  DictOrderIndex::TokenCode* tokens =
+      reinterpret_cast<DictOrderIndex::TokenCode*>(&badCode[badCode.length() - 2 * sizeof(*tokens)]);
+  tokens[1].code = 2;
+  EXPECT_FALSE(index.deserialize(header, badCode.data(), badCode.length()));
+}
+
+TEST(DictOrderIndexWriter, FirstStringAddedRemovesTheFile)
+{
+  DictOrderIndexWriter writer;
+  writer.open(true);
+  EXPECT_FALSE(writer.changed());
+  EXPECT_TRUE(writer.add(token(100, 1), BINARY, "one", 3));
+  EXPECT_FALSE(writer.add(token(100, 2), BINARY, "two", 3));
+  EXPECT_TRUE(writer.changed());
+
+  // The strings added once the file is written make it stale again, all of them are kept
+  writer.written();
+  EXPECT_FALSE(writer.changed());
+  EXPECT_TRUE(writer.add(token(100, 3), BINARY, "three", 5));
+  EXPECT_TRUE(writer.changed());
+
+  std::string str;
+  ASSERT_TRUE(writtenCode(writer, token(100, 1), str));
+  EXPECT_EQ(str, "one");
+  ASSERT_TRUE(writtenCode(writer, token(100, 3), str));
+  EXPECT_EQ(str, "three");
+}
+
+TEST(DictOrderIndexWriter, StoreFileWithStringsIsNotIndexed)
+{
+  // DML appends to a store file with an index: the file is removed, not written anew
+  DictOrderIndexWriter writer;
+  writer.open(false);
+  EXPECT_TRUE(writer.add(token(100, 1), BINARY, "one", 3));
+  EXPECT_FALSE(writer.add(token(100, 2), BINARY, "two", 3));
+  EXPECT_FALSE(writer.changed());
+
+  std::string str;
+  EXPECT_FALSE(writtenCode(writer, token(100, 1), str));
+}
+
+TEST(DictOrderIndexWriter, ReusedTokenGetsTheNewString)
+{
+  // The token of a rolled back string is given to the next one
+  DictOrderIndexWriter writer;
+  writer.open(true);
+  writer.add(token(100, 1), BINARY, "b", 1);
+  writer.add(token(100, 2), BINARY, "a", 1);
+  writer.add(token(100, 1), BINARY, "c", 1);
+
+  std::string str;
+  ASSERT_TRUE(writtenCode(writer, token(100, 1), str));
+  EXPECT_EQ(str, "c");
+  ASSERT_TRUE(writtenCode(writer, token(100, 2), str));
+  EXPECT_EQ(str, "a");
+}
+
+TEST(DictOrderIndexWriter, OtherCollationDropsTheIndex)
+{
+  DictOrderIndexWriter writer;
+  writer.open(true);
+  writer.add(token(100, 1), UTF8MB4_GENERAL_CI, "one", 3);
+  EXPECT_EQ(writer.collation(), UTF8MB4_GENERAL_CI);
+  EXPECT_TRUE(writer.changed());
+
+  writer.add(token(100, 2), BINARY, "two", 3);
+  EXPECT_FALSE(writer.changed());
+
+  // Neither are the strings added afterwards kept
+  writer.add(token(100, 3), UTF8MB4_GENERAL_CI, "three", 5);
+  EXPECT_FALSE(writer.changed());
+
+  // Nor the strings of no collation
+  writer.open(true);
+  writer.add(token(100, 1), 0, "one", 3);
+  EXPECT_FALSE(writer.changed());
+}
+
+TEST(DictOrderIndexWriter, TooManyStringsDropTheIndex)
+{
+  DictOrderIndexWriter writer;
+  writer.open(true);
+
+  for (uint32_t i = 0; i < DictOrderIndex::MAX_STRINGS; i++)
+  {
+    std::string str = std::to_string(i);
+    writer.add(token(100 + i / 1000, i % 1000 + 1), BINARY, str.data(), str.length());
+  }
+
+  EXPECT_TRUE(writer.changed());
+  writer.add(token(200, 1), BINARY, "more", 4);
+  EXPECT_FALSE(writer.changed());
+}
+
+TEST(DictOrderIndexWriter, StringsSpanningBlocksHaveNoCode)
+{
+  DictOrderIndexWriter writer;
+  writer.open(true);
+  EXPECT_TRUE(writer.add(token(100, 1), BINARY, NULL, 9000));
+  writer.add(token(102, 1), BINARY, "one", 3);
+  EXPECT_TRUE(writer.changed());
+
+  std::string str;
+  EXPECT_FALSE(writtenCode(writer, token(100, 1), str));
+  EXPECT_TRUE(writtenCode(writer, token(102, 1), str));
+}
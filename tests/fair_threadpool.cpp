@@ -206,4 +206,85 @@ TEST_F(FairThreadPoolTest, FairThreadPoolReschedule)
   EXPECT_EQ(results.size(), 3ULL);
   EXPECT_EQ(results[0], 1);
   EXPECT_TRUE(isThisOrThat(results, 1, 2, 2, 3));
-}
\ No newline at end of file
+}
+// Records into its own results, the threads of the previous tests may still be writing to the global ones.
+class TestSuspendFunctor : public FairThreadPool::Functor
+{
+ public:
+  TestSuspendFunctor(ResultsType& out, const size_t id, const uint32_t suspends, const size_t delay)
+   : out_(out), id_(id), suspends_(suspends), delay_(delay)
+  {
+  }
+  int operator()() override
+  {
+    if (suspends_ > 0)
+    {
+      --suspends_;
+      return RescheduleOnIO;
+    }
+    usleep(delay_);
+    std::lock_guard<std::mutex> gl(globMutex);
+    out_.push_back(id_);
+    return 0;
+  }
+
+ private:
+  ResultsType& out_;
+  size_t id_;
+  uint32_t suspends_;
+  size_t delay_;
+};
+
+TEST_F(FairThreadPoolTest, FairThreadPoolRescheduleOnIO)
+{
+  SP_UM_IOSOCK sock(new messageqcpp::IOSocket);
+  ResultsType out;
+  // Keeps the only thread busy until the other jobs are queued
+  auto functor0 = boost::shared_ptr<FairThreadPool::Functor>(new TestSuspendFunctor(out, 0, 0, 50000));
+  FairThreadPool::Job job0(0, 1, 3, functor0, sock, 1, 0, 3);
+  auto functor1 = boost::shared_ptr<FairThreadPool::Functor>(new TestSuspendFunctor(out, 1, 3, 0));
+  FairThreadPool::Job job1(1, 1, 1, functor1, sock, 1, 0, 1);
+  auto functor2 = boost::shared_ptr<FairThreadPool::Functor>(new TestSuspendFunctor(out, 2, 0, 50000));
+  FairThreadPool::Job job2(2, 1, 2, functor2, sock, 1, 0, 2);
+
+  threadPool->addJob(job0);
+  usleep(10000);
+  threadPool->addJob(job1);
+  threadPool->addJob(job2);
+
+  while (threadPool->queueSize())
+  {
+    usleep(250000);
+  }
+
+  std::lock_guard<std::mutex> gl(globMutex);
+  EXPECT_EQ(threadPool->queueSize(), 0ULL);
+  ASSERT_EQ(out.size(), 3ULL);
+  // The suspended job goes behind the ready job of the other txn
+  EXPECT_EQ(out[0], 0);
+  EXPECT_EQ(out[1], 2);
+  EXPECT_EQ(out[2], 1);
+}
+
+TEST(FairThreadPoolWeightTest, RescheduleOnIOWeightIsCapped)
+{
+  uint32_t weight = 1;
+
+  // Doubling would wrap uint32_t after a few dozen suspensions.
+  for (uint32_t i = 0; i < 100; ++i)
+  {
+    uint32_t next = rescheduledJobWeight(weight, RescheduleOnIO);
+    EXPECT_GE(next, weight);
+    EXPECT_LE(next - weight, RescheduleWeightIncrement);
+    weight = next;
+  }
+
+  EXPECT_EQ(weight, MaxRescheduleOnIOWeight);
+  // A heavier job keeps its weight.
+  EXPECT_EQ(rescheduledJobWeight(4 * MaxRescheduleOnIOWeight, RescheduleOnIO),
+            4 * MaxRescheduleOnIOWeight);
+
+  // The other reschedules keep doubling the weight.
+  EXPECT_EQ(rescheduledJobWeight(0, -1), RescheduleWeightIncrement);
+  EXPECT_EQ(rescheduledJobWeight(3, -1), 6U);
+}
@@ -0,0 +1,307 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+#include "flowcontrolcredits.h"
+
+using namespace std;
+using joblist::FlowControlCredits;
+
+// A tick based replay of PMs sending BPP results into the DEC queue of one query.
+// Messages and ACKs travel `latency` ticks over the wire.
+class FlowControlSimulator
+{
+ public:
+  struct PM
+  {
+    uint32_t msgsToSend;
+    uint64_t msgSize;
+    uint32_t msgsPerTick;  // the PM production rate
+    int64_t msgCredits = 0;
+    int64_t byteCredits = 0;
+    uint32_t sent = 0;
+  };
+
+  FlowControlSimulator(vector<PM> pms, uint64_t byteBudget, uint64_t maxByteBudget, uint32_t msgBudget,
+                       uint32_t maxMsgBudget, uint32_t latency)
+   : pms_(std::move(pms))
+   , credits_(pms_.size(), byteBudget, maxByteBudget, msgBudget, maxMsgBudget)
+   , latency_(latency)
+  {
+    for (auto& pm : pms_)
+    {
+      pm.msgCredits = credits_.initialMsgCredits();
+      pm.byteCredits = credits_.initialByteCredits();
+    }
+  }
+
+  // Returns the number of ticks it took to deliver everything, or 0 if it got stuck.
+  uint64_t run(uint32_t consumerMsgsPerTick, uint64_t maxTicks = 1000000)
+  {
+    for (tick_ = 0; tick_ < maxTicks; ++tick_)
+    {
+      deliver();
+      produce();
+      consume(consumerMsgsPerTick);
+
+      if (done())
+        return tick_ + 1;
+    }
+
+    return 0;
+  }
+
+  uint64_t maxQueueBytes() const
+  {
+    return maxQueueBytes_;
+  }
+  uint64_t acksSent() const
+  {
+    return acksSent_;
+  }
+  const FlowControlCredits& credits() const
+  {
+    return credits_;
+  }
+  const vector<PM>& pms() const
+  {
+    return pms_;
+  }
+
+ private:
+  struct InFlight
+  {
+    uint64_t arrival;
+    uint32_t pm;
+    uint64_t bytes;
+  };
+
+  struct AckInFlight
+  {
+    uint64_t arrival;
+    FlowControlCredits::Grant grant;
+  };
+
+  void deliver()
+  {
+    while (!wire_.empty() && wire_.front().arrival <= tick_)
+    {
+      credits_.received(wire_.front().pm, wire_.front().bytes);
+      queue_.push_back(wire_.front().bytes);
+      queueBytes_ += wire_.front().bytes;
+      wire_.pop_front();
+    }
+
+    maxQueueBytes_ = max(maxQueueBytes_, queueBytes_);
+
+    while (!acks_.empty() && acks_.front().arrival <= tick_)
+    {
+      PM& pm = pms_[acks_.front().grant.pmIndex];
+      pm.msgCredits += acks_.front().grant.msgs;
+      pm.byteCredits += acks_.front().grant.bytes;
+      acks_.pop_front();
+    }
+  }
+
+  void produce()
+  {
+    for (uint32_t i = 0; i < pms_.size(); ++i)
+    {
+      PM& pm = pms_[i];
+
+      for (uint32_t n = 0; n < pm.msgsPerTick && pm.sent < pm.msgsToSend; ++n)
+      {
+        if (pm.msgCredits <= 0 || pm.byteCredits <= 0)
+          break;
+
+        --pm.msgCredits;
+        pm.byteCredits -= pm.msgSize;
+        ++pm.sent;
+        wire_.push_back({tick_ + latency_, i, pm.msgSize});
+      }
+    }
+  }
+
+  void consume(uint32_t msgsPerTick)
+  {
+    uint32_t msgs = 0;
+    uint64_t bytes = 0;
+
+    for (; msgs < msgsPerTick && !queue_.empty(); ++msgs)
+    {
+      bytes += queue_.front();
+      queue_.pop_front();
+    }
+
+    if (msgs == 0)
+      return;
+
+    queueBytes_ -= bytes;
+    vector<FlowControlCredits::Grant> grants;
+    credits_.consumed(msgs, bytes, queueBytes_, grants);
+
+    for (auto& grant : grants)
+      acks_.push_back({tick_ + latency_, grant});
+
+    acksSent_ += grants.size();
+  }
+
+  bool done() const
+  {
+    return queue_.empty() && wire_.empty() &&
+           all_of(pms_.begin(), pms_.end(), [](const PM& pm) { return pm.sent == pm.msgsToSend; });
+  }
+
+  vector<PM> pms_;
+  FlowControlCredits credits_;
+  uint32_t latency_;
+  uint64_t tick_ = 0;
+  deque<InFlight> wire_;
+  deque<AckInFlight> acks_;
+  deque<uint64_t> queue_;
+  uint64_t queueBytes_ = 0;
+  uint64_t maxQueueBytes_ = 0;
+  uint64_t acksSent_ = 0;
+};
+
+static const uint64_t MB = 1024 * 1024;
+
+TEST(FlowControlCredits, InitialCreditsAreSplitBetweenPMs)
+{
+  FlowControlCredits credits(4, 100 * MB, 400 * MB, 256, 1024);
+  EXPECT_EQ(credits.initialMsgCredits(), 64U);
+  EXPECT_EQ(credits.initialByteCredits(), (int64_t)(25 * MB));
+  EXPECT_FALSE(credits.exhausted());
+
+  // There is always at least one message per PM
+  FlowControlCredits few(4, 100 * MB, 100 * MB, 2, 2);
+  EXPECT_EQ(few.initialMsgCredits(), 1U);
+}
+
+TEST(FlowControlCredits, ConsumedMessagesReturnCredits)
+{
+  FlowControlCredits credits(2, 10 * MB, 10 * MB, 2, 2);
+  credits.received(0, 6 * MB);
+  EXPECT_TRUE(credits.exhausted());
+
+  vector<FlowControlCredits::Grant> grants;
+  credits.consumed(1, 6 * MB, 0, grants);
+  ASSERT_EQ(grants.size(), 1U);
+  EXPECT_EQ(grants[0].pmIndex, 0U);
+  EXPECT_EQ(grants[0].msgs, 1U);
+  EXPECT_EQ(grants[0].bytes, (int64_t)(6 * MB));
+  EXPECT_FALSE(credits.exhausted());
+}
+
+TEST(FlowControlCredits, CreditsGoBackInBatches)
+{
+  // Half the share of a PM is 4 messages or 2MB
+  FlowControlCredits credits(2, 8 * MB, 8 * MB, 16, 16);
+
+  for (uint32_t i = 0; i < 8; ++i)
+    credits.received(0, 1024);
+
+  vector<FlowControlCredits::Grant> grants;
+
+  for (uint32_t i = 0; i < 3; ++i)
+    credits.consumed(1, 1024, (7 - i) * 1024, grants);
+
+  EXPECT_TRUE(grants.empty());
+  credits.consumed(1, 1024, 4 * 1024, grants);
+  ASSERT_EQ(grants.size(), 1U);
+  EXPECT_EQ(grants[0].msgs, 4U);
+  EXPECT_EQ(grants[0].bytes, 4 * 1024);
+
+  // The drained queue returns what is left
+  grants.clear();
+  credits.consumed(1, 1024, 3 * 1024, grants);
+  EXPECT_TRUE(grants.empty());
+  credits.consumed(3, 3 * 1024, 0, grants);
+  ASSERT_EQ(grants.size(), 1U);
+  EXPECT_EQ(grants[0].msgs, 4U);
+  EXPECT_FALSE(credits.exhausted());
+
+  // A byte batch is enough on its own
+  grants.clear();
+  credits.received(1, 3 * MB);
+  credits.received(1, 1024);
+  credits.consumed(1, 3 * MB, 1024, grants);
+  ASSERT_EQ(grants.size(), 1U);
+  EXPECT_EQ(grants[0].pmIndex, 1U);
+  EXPECT_EQ(grants[0].msgs, 1U);
+}
+
+// The consumer is 10 times slower than the PMs: the queue must stay within the budget
+// plus one message per PM in flight, and every PM must finish.
+TEST(FlowControlCredits, SlowConsumerKeepsQueueWithinBudget)
+{
+  vector<FlowControlSimulator::PM> pms(3, {2000, 256 * 1024, 10});
+  FlowControlSimulator sim(pms, 16 * MB, 16 * MB, 256, 256, 2);
+
+  EXPECT_GT(sim.run(3), 0U);
+  EXPECT_LE(sim.maxQueueBytes(), 16 * MB + 3 * 256 * 1024);
+  EXPECT_EQ(sim.credits().byteBudget(), 16 * MB);
+
+  // An ACK returns the credits of many messages
+  EXPECT_LT(sim.acksSent(), 3 * 2000 / 10U);
+}
+
+// A consumer that only wakes up now and then must not deadlock the PMs.
+TEST(FlowControlCredits, StopAndGoConsumer)
+{
+  vector<FlowControlSimulator::PM> pms(4, {500, 1 * MB, 50});
+  FlowControlSimulator sim(pms, 8 * MB, 8 * MB, 16, 16, 5);
+
+  EXPECT_GT(sim.run(1), 0U);
+  EXPECT_LE(sim.maxQueueBytes(), 8 * MB + 4 * MB);
+}
+
+// A message larger than the whole budget overdraws the byte credits instead of getting stuck.
+TEST(FlowControlCredits, MessagesBiggerThanBudget)
+{
+  vector<FlowControlSimulator::PM> pms(2, {20, 300 * MB, 1});
+  FlowControlSimulator sim(pms, 50 * MB, 50 * MB, 100, 100, 1);
+
+  EXPECT_GT(sim.run(1), 0U);
+}
+
+// One slow PM and a fast one: the fast PM must not get stuck because the slow one
+// holds the credits, and all the credits come back once the queue drains.
+TEST(FlowControlCredits, SkewedPMs)
+{
+  vector<FlowControlSimulator::PM> pms{{5000, 64 * 1024, 20}, {100, 64 * 1024, 1}};
+  FlowControlSimulator sim(pms, 4 * MB, 4 * MB, 64, 64, 3);
+
+  EXPECT_GT(sim.run(2), 0U);
+  EXPECT_FALSE(sim.credits().exhausted());
+}
+
+// The consumer is faster than the budget allows: the budget grows up to its maximum.
+TEST(FlowControlCredits, FastConsumerGrowsBudget)
+{
+  vector<FlowControlSimulator::PM> pms(2, {5000, 1 * MB, 100});
+  FlowControlSimulator sim(pms, 8 * MB, 64 * MB, 16, 128, 10);
+
+  EXPECT_GT(sim.run(100), 0U);
+  EXPECT_GT(sim.credits().byteBudget(), 8 * MB);
+  EXPECT_LE(sim.credits().byteBudget(), 64 * MB);
+  EXPECT_LE(sim.credits().msgBudget(), 128U);
+}
@@ -0,0 +1,208 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#include "minmaxelimination.h"
+
+using namespace joblist;
+using namespace rowgroup;
+using CSCDataType = execplan::CalpontSystemCatalog::ColDataType;
+
+namespace
+{
+struct TestRange
+{
+  uint16_t dbRoot;
+  bool valid;
+  int64_t lo;
+  int64_t hi;
+};
+
+std::vector<BRM::EMEntry> makeExtents(const std::vector<TestRange>& ranges)
+{
+  std::vector<BRM::EMEntry> extents(ranges.size());
+
+  for (uint32_t i = 0; i < ranges.size(); ++i)
+  {
+    extents[i].dbRoot = ranges[i].dbRoot;
+    extents[i].range.start = i * 1000;
+    extents[i].partition.cprange.isValid = ranges[i].valid ? BRM::CP_VALID : BRM::CP_INVALID;
+    extents[i].partition.cprange.loVal = ranges[i].lo;
+    extents[i].partition.cprange.hiVal = ranges[i].hi;
+  }
+
+  return extents;
+}
+
+// The PM aggregation results: MIN(a), MAX(a) and MAX of an unsigned column
+class MinMaxEliminationTest : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    std::vector<uint32_t> offsets{2, 10, 18, 26};
+    std::vector<uint32_t> oids{3000, 3000, 3001};
+    std::vector<uint32_t> keys{1, 2, 3};
+    std::vector<CSCDataType> types{execplan::CalpontSystemCatalog::BIGINT,
+                                   execplan::CalpontSystemCatalog::BIGINT,
+                                   execplan::CalpontSystemCatalog::UBIGINT};
+    std::vector<uint32_t> charsets{8, 8, 8};
+    std::vector<uint32_t> scale{0, 0, 0};
+    std::vector<uint32_t> precision{19, 19, 20};
+    rg = RowGroup(oids.size(), offsets, oids, keys, types, charsets, scale, precision, 20, false);
+    rgData.reinit(rg, 1);
+    rg.setData(&rgData);
+    rg.initRow(&row);
+  }
+
+  // A job result, nullptr leaves a column NULL
+  void addResult(MinMaxElimination& elimination, const int64_t* min, const int64_t* max,
+                 const uint64_t* umax = nullptr)
+  {
+    rg.resetRowGroup(0);
+    rg.getRow(0, &row);
+    row.setToNull(0);
+    row.setToNull(1);
+    row.setToNull(2);
+
+    if (min)
+      row.setIntField(*min, 0);
+
+    if (max)
+      row.setIntField(*max, 1);
+
+    if (umax)
+      row.setUintField(*umax, 2);
+
+    rg.setRowCount(1);
+    elimination.update(rgData);
+  }
+
+  RowGroup rg;
+  RGData rgData;
+  Row row;
+};
+}  // namespace
+
+TEST(MinMaxElimination, SupportedTypes)
+{
+  execplan::CalpontSystemCatalog::ColType colType;
+  colType.colDataType = execplan::CalpontSystemCatalog::INT;
+  colType.colWidth = 4;
+  EXPECT_TRUE(MinMaxElimination::supported(colType));
+
+  colType.colDataType = execplan::CalpontSystemCatalog::DECIMAL;
+  colType.colWidth = 16;
+  EXPECT_FALSE(MinMaxElimination::supported(colType));
+
+  colType.colDataType = execplan::CalpontSystemCatalog::VARCHAR;
+  colType.colWidth = 8;
+  EXPECT_FALSE(MinMaxElimination::supported(colType));
+
+  colType.colDataType = execplan::CalpontSystemCatalog::DOUBLE;
+  EXPECT_FALSE(MinMaxElimination::supported(colType));
+}
+
+TEST_F(MinMaxEliminationTest, OrdersByBoundPerDbRoot)
+{
+  auto extents = makeExtents({{1, true, 50, 90},
+                              {1, true, 10, 20},
+                              {1, false, 0, 0},
+                              {2, true, 30, 95},
+                              {2, true, 5, 99}});
+  std::vector<uint32_t> order{0, 1, 2, 3, 4};
+
+  MinMaxElimination min(rg);
+  min.addAggregate(0, false, false, extents);
+  min.order(order, extents);
+  EXPECT_EQ(order, (std::vector<uint32_t>{2, 1, 0, 4, 3}));
+
+  // The scan may start in the middle of a dbroot
+  order = {1, 2, 0, 4, 3};
+  MinMaxElimination max(rg);
+  max.addAggregate(1, true, false, extents);
+  max.order(order, extents);
+  EXPECT_EQ(order, (std::vector<uint32_t>{2, 0, 1, 4, 3}));
+}
+
+TEST_F(MinMaxEliminationTest, SkipsExtentsAboveMin)
+{
+  auto extents = makeExtents({{1, true, 10, 20}, {1, true, 15, 40}, {1, true, 5, 8}, {1, false, 99, 99}});
+  MinMaxElimination elimination(rg);
+  elimination.addAggregate(0, false, false, extents);
+
+  // Nothing is known before the first result
+  for (uint32_t i = 0; i < extents.size(); ++i)
+    EXPECT_TRUE(elimination.needed(i));
+
+  // No rows qualified in the job
+  addResult(elimination, nullptr, nullptr);
+  EXPECT_TRUE(elimination.needed(1));
+
+  int64_t min = 12;
+  addResult(elimination, &min, nullptr);
+  EXPECT_TRUE(elimination.needed(0));
+  EXPECT_FALSE(elimination.needed(1));
+  EXPECT_TRUE(elimination.needed(2));
+  EXPECT_TRUE(elimination.needed(3));
+
+  // A worse result doesn't change anything, the extent holding the MIN can't lower it
+  min = 30;
+  addResult(elimination, &min, nullptr);
+  min = 10;
+  addResult(elimination, &min, nullptr);
+  EXPECT_FALSE(elimination.needed(0));
+  EXPECT_TRUE(elimination.needed(2));
+}
+
+TEST_F(MinMaxEliminationTest, NeedsExtentsChangingAnyAggregate)
+{
+  auto extents = makeExtents({{1, true, 10, 20}, {1, true, 15, 40}, {1, true, 12, 18}});
+  MinMaxElimination elimination(rg);
+  elimination.addAggregate(0, false, false, extents);
+  elimination.addAggregate(1, true, false, extents);
+
+  int64_t min = 11, max = 19;
+  addResult(elimination, &min, &max);
+  EXPECT_TRUE(elimination.needed(0));
+  EXPECT_TRUE(elimination.needed(1));
+  EXPECT_FALSE(elimination.needed(2));
+
+  max = 40;
+  addResult(elimination, nullptr, &max);
+  EXPECT_FALSE(elimination.needed(1));
+}
+
+TEST_F(MinMaxEliminationTest, ComparesUnsignedAsUnsigned)
+{
+  const uint64_t big = 0xF000000000000000ULL;
+  auto extents = makeExtents({{1, true, 0, static_cast<int64_t>(big)}, {1, true, 0, 100}});
+  MinMaxElimination elimination(rg);
+  elimination.addAggregate(2, true, true, extents);
+
+  uint64_t max = 1000;
+  addResult(elimination, nullptr, nullptr, &max);
+  EXPECT_TRUE(elimination.needed(0));
+  EXPECT_FALSE(elimination.needed(1));
+
+  max = big;
+  addResult(elimination, nullptr, nullptr, &max);
+  EXPECT_FALSE(elimination.needed(0));
+}
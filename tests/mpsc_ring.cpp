@@ -0,0 +1,166 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "mpscring.h"
+
+using namespace std;
+
+TEST(MPSCRingTest, CapacityIsPowerOf2)
+{
+  utils::MPSCRing<int> ring(1000);
+  EXPECT_EQ(ring.capacity(), 1024U);
+}
+
+TEST(MPSCRingTest, SingleThreadFIFO)
+{
+  utils::MPSCRing<int> ring(4);
+  vector<int> out;
+
+  EXPECT_EQ(ring.tryPopAll(out), 0U);
+
+  for (int i = 0; i < 3; ++i)
+    ring.push(i);
+
+  EXPECT_EQ(ring.popAll(out), 3U);
+  ring.push(3);
+  ring.push(4);
+  EXPECT_EQ(ring.tryPopAll(out), 2U);
+  EXPECT_EQ(out, vector<int>({0, 1, 2, 3, 4}));
+}
+
+TEST(MPSCRingTest, ReleasesPoppedValues)
+{
+  utils::MPSCRing<shared_ptr<int>> ring(2);
+  vector<shared_ptr<int>> out;
+  auto value = make_shared<int>(1);
+
+  ring.push(value);
+  ring.popAll(out);
+  out.clear();
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+// Pushes past the capacity go to the overflow queue and keep their order with the ring.
+TEST(MPSCRingTest, FullRingOverflowsWithoutBlocking)
+{
+  utils::MPSCRing<int> ring(4);
+  vector<int> out;
+
+  for (int i = 0; i < 10; ++i)
+    ring.push(i);
+
+  EXPECT_EQ(ring.overflowSize(), 6U);
+  EXPECT_EQ(ring.tryPopAll(out), 10U);
+  EXPECT_EQ(ring.overflowSize(), 0U);
+
+  // The ring is used again once the overflow is drained.
+  ring.push(10);
+  EXPECT_EQ(ring.overflowSize(), 0U);
+  EXPECT_EQ(ring.popAll(out), 1U);
+
+  vector<int> expected(11);
+  for (int i = 0; i < 11; ++i)
+    expected[i] = i;
+  EXPECT_EQ(out, expected);
+}
+
+// A tiny ring makes producers overflow while the consumer sleeps on an empty one.
+TEST(MPSCRingTest, ManyProducersKeepPerProducerOrder)
+{
+  const uint32_t producers = 4;
+  const uint32_t perProducer = 100000;
+  utils::MPSCRing<uint64_t> ring(8);
+  vector<thread> threads;
+
+  for (uint32_t p = 0; p < producers; ++p)
+    threads.emplace_back(
+        [&ring, p]()
+        {
+          for (uint64_t i = 0; i < perProducer; ++i)
+            ring.push(((uint64_t)p << 32) | i);
+        });
+
+  vector<uint64_t> next(producers, 0);
+  vector<uint64_t> out;
+  uint64_t received = 0;
+
+  while (received < producers * perProducer)
+  {
+    out.clear();
+    received += ring.popAll(out);
+
+    for (auto v : out)
+    {
+      uint32_t p = v >> 32;
+      ASSERT_LT(p, producers);
+      ASSERT_EQ(v & 0xffffffff, next[p]);
+      ++next[p];
+    }
+  }
+
+  for (auto& t : threads)
+    t.join();
+
+  out.clear();
+  EXPECT_EQ(ring.tryPopAll(out), 0U);
+}
+
+// More producers than slots: the consumer often finds a slot claimed and not published yet
+// while the elements after it and the overflow are ready.
+TEST(MPSCRingTest, OverflowWaitsForClaimedSlots)
+{
+  const uint32_t producers = 16;
+  const uint32_t perProducer = 50000;
+  utils::MPSCRing<uint64_t> ring(2);
+  vector<thread> threads;
+
+  for (uint32_t p = 0; p < producers; ++p)
+    threads.emplace_back(
+        [&ring, p]()
+        {
+          for (uint64_t i = 0; i < perProducer; ++i)
+            ring.push(((uint64_t)p << 32) | i);
+        });
+
+  vector<uint64_t> next(producers, 0);
+  vector<uint64_t> out;
+  uint64_t received = 0;
+
+  while (received < producers * perProducer)
+  {
+    out.clear();
+    received += ring.tryPopAll(out);
+
+    for (auto v : out)
+    {
+      uint32_t p = v >> 32;
+      ASSERT_LT(p, producers);
+      ASSERT_EQ(v & 0xffffffff, next[p]);
+      ++next[p];
+    }
+  }
+
+  for (auto& t : threads)
+    t.join();
+
+  EXPECT_EQ(ring.overflowSize(), 0U);
+}
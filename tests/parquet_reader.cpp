@@ -0,0 +1,278 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#include <parquet/arrow/writer.h>
+
+#include "we_parquetreader.h"
+#include "we_define.h"
+#include "dataconvert.h"
+#include "joblisttypes.h"
+#include "mcs_decimal.h"
+
+using namespace WriteEngine;
+using CSC = execplan::CalpontSystemCatalog;
+
+namespace
+{
+class ParquetReaderTest : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    fileName = "/tmp/parquet_reader_test_" + std::to_string(getpid()) + ".parquet";
+  }
+
+  void TearDown() override
+  {
+    unlink(fileName.c_str());
+  }
+
+  void write(const std::shared_ptr<arrow::Table>& table)
+  {
+    auto file = arrow::io::FileOutputStream::Open(fileName);
+    ASSERT_TRUE(file.ok());
+    ASSERT_TRUE(
+        parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), *file, table->num_rows()).ok());
+    ASSERT_TRUE((*file)->Close().ok());
+  }
+
+  template <typename T>
+  static T field(const std::vector<char>& records, unsigned recordLength, unsigned row, unsigned offset)
+  {
+    T value;
+    memcpy(&value, records.data() + row * recordLength + offset, sizeof(value));
+    return value;
+  }
+
+  std::string fileName;
+};
+
+template <typename Builder, typename T>
+std::shared_ptr<arrow::Array> makeArray(Builder&& builder, const std::vector<T>& values,
+                                        const std::vector<bool>& valid)
+{
+  for (size_t i = 0; i < values.size(); i++)
+  {
+    if (valid[i])
+      EXPECT_TRUE(builder.Append(values[i]).ok());
+    else
+      EXPECT_TRUE(builder.AppendNull().ok());
+  }
+
+  return *builder.Finish();
+}
+}  // namespace
+
+TEST_F(ParquetReaderTest, ConvertsToBinaryRecords)
+{
+  auto decimalType = arrow::decimal128(10, 3);
+  auto timestampType = arrow::timestamp(arrow::TimeUnit::MILLI);
+  auto schema = arrow::schema({arrow::field("i", arrow::int64()), arrow::field("d", decimalType),
+                               arrow::field("s", arrow::utf8()), arrow::field("day", arrow::date32()),
+                               arrow::field("ts", timestampType), arrow::field("f", arrow::float64())});
+
+  // 2024-02-29 is day 19782
+  auto table = arrow::Table::Make(
+      schema, {makeArray(arrow::Int64Builder(), std::vector<int64_t>{5, 300, 0}, {true, true, false}),
+               makeArray(arrow::Decimal128Builder(decimalType),
+                         std::vector<arrow::Decimal128>{arrow::Decimal128(12345), arrow::Decimal128(-1255),
+                                                        arrow::Decimal128(0)},
+                         {true, true, false}),
+               makeArray(arrow::StringBuilder(), std::vector<std::string>{"abc", "truncated", ""},
+                         {true, true, false}),
+               makeArray(arrow::Date32Builder(), std::vector<int32_t>{19782, 0, 0}, {true, true, false}),
+               makeArray(arrow::TimestampBuilder(timestampType, arrow::default_memory_pool()),
+                         std::vector<int64_t>{1709210096789, -1000, 0}, {true, true, false}),
+               makeArray(arrow::DoubleBuilder(), std::vector<double>{2.5, -1.0, 0}, {true, true, false})});
+  write(table);
+
+  // TINYINT, DECIMAL(4,2), VARCHAR(4), DATE, DATETIME, INT
+  std::vector<ParquetReader::Column> columns{{CSC::TINYINT, 1, 0},  {CSC::DECIMAL, 2, 2},
+                                             {CSC::VARCHAR, 4, 0},  {CSC::DATE, 4, 0},
+                                             {CSC::DATETIME, 8, 0}, {CSC::INT, 4, 0}};
+  ParquetReader reader;
+  std::string errMsg;
+  ASSERT_EQ(reader.open(fileName, columns, errMsg), NO_ERROR) << errMsg;
+  EXPECT_EQ(reader.recordLength(), 23u);
+  EXPECT_EQ(reader.rowCount(), 3u);
+
+  std::vector<char> records;
+  ASSERT_EQ(reader.readRecords(records, errMsg), NO_ERROR) << errMsg;
+  ASSERT_EQ(records.size(), 3u * 23);
+
+  EXPECT_EQ(field<int8_t>(records, 23, 0, 0), 5);
+  // Saturated short of the NULL and empty row values
+  EXPECT_EQ(field<int8_t>(records, 23, 1, 0), 127);
+  EXPECT_EQ(field<uint8_t>(records, 23, 2, 0), joblist::TINYINTNULL);
+
+  // 12.345 and -1.255 rounded to 2 digits
+  EXPECT_EQ(field<int16_t>(records, 23, 0, 1), 1235);
+  EXPECT_EQ(field<int16_t>(records, 23, 1, 1), -126);
+  EXPECT_EQ(field<uint16_t>(records, 23, 2, 1), joblist::SMALLINTNULL);
+
+  EXPECT_EQ(std::string(records.data() + 3, 4), std::string("abc\0", 4));
+  EXPECT_EQ(std::string(records.data() + 23 + 3, 4), "trun");
+  EXPECT_EQ(std::string(records.data() + 46 + 3, 4), std::string(4, '\0'));
+
+  dataconvert::Date date(field<uint32_t>(records, 23, 0, 7));
+  EXPECT_EQ(date.year, 2024u);
+  EXPECT_EQ(date.month, 2u);
+  EXPECT_EQ(date.day, 29u);
+  date = dataconvert::Date(field<uint32_t>(records, 23, 1, 7));
+  EXPECT_EQ(date.convertToMySQLint(), 19700101);
+  EXPECT_EQ(field<uint32_t>(records, 23, 2, 7), joblist::DATENULL);
+
+  // 2024-02-29 12:34:56.789 and a second before 1970
+  dataconvert::DateTime dateTime(field<uint64_t>(records, 23, 0, 11));
+  EXPECT_EQ(dateTime.convertToMySQLint(), 20240229123456LL);
+  EXPECT_EQ(dateTime.msecond, 789000u);
+  dateTime = dataconvert::DateTime(field<uint64_t>(records, 23, 1, 11));
+  EXPECT_EQ(dateTime.convertToMySQLint(), 19691231235959LL);
+  EXPECT_EQ(field<uint64_t>(records, 23, 2, 11), joblist::DATETIMENULL);
+
+  EXPECT_EQ(field<int32_t>(records, 23, 0, 19), 3);
+  EXPECT_EQ(field<int32_t>(records, 23, 1, 19), -1);
+  EXPECT_EQ(field<uint32_t>(records, 23, 2, 19), joblist::INTNULL);
+
+  ASSERT_EQ(reader.readRecords(records, errMsg), NO_ERROR);
+  EXPECT_TRUE(records.empty());
+  EXPECT_TRUE(reader.eof());
+}
+
+TEST_F(ParquetReaderTest, ConvertsWideDecimalsAndUnsigned)
+{
+  auto decimalType = arrow::decimal128(38, 0);
+  auto schema = arrow::schema({arrow::field("d", decimalType), arrow::field("u", arrow::int32())});
+  auto big = arrow::Decimal128::FromString("12345678901234567890123456789");
+  ASSERT_TRUE(big.ok());
+  auto table = arrow::Table::Make(
+      schema, {makeArray(arrow::Decimal128Builder(decimalType), std::vector<arrow::Decimal128>{*big, 0},
+                         {true, false}),
+               makeArray(arrow::Int32Builder(), std::vector<int32_t>{-7, 300}, {true, true})});
+  write(table);
+
+  std::vector<ParquetReader::Column> columns{{CSC::DECIMAL, 16, 2}, {CSC::UTINYINT, 1, 0}};
+  ParquetReader reader;
+  std::string errMsg;
+  ASSERT_EQ(reader.open(fileName, columns, errMsg), NO_ERROR) << errMsg;
+
+  std::vector<char> records;
+  ASSERT_EQ(reader.readRecords(records, errMsg), NO_ERROR) << errMsg;
+  ASSERT_EQ(records.size(), 2u * 17);
+
+  int128_t expected = (int128_t(big->high_bits()) << 64 | big->low_bits()) * 100;
+  EXPECT_TRUE(field<int128_t>(records, 17, 0, 0) == expected);
+  EXPECT_TRUE(field<int128_t>(records, 17, 1, 0) == datatypes::Decimal128Null);
+  EXPECT_EQ(field<uint8_t>(records, 17, 0, 16), 0);
+  EXPECT_EQ(field<uint8_t>(records, 17, 1, 16), 253);
+}
+
+TEST_F(ParquetReaderTest, ReadsArrowStream)
+{
+  // More rows than a converted batch, in one record batch
+  const int64_t rows = 100000;
+  arrow::Int32Builder ints;
+  arrow::StringDictionaryBuilder names;
+  arrow::DoubleBuilder reals;
+
+  for (int64_t i = 0; i < rows; i++)
+  {
+    ASSERT_TRUE((i % 7 == 0) ? ints.AppendNull().ok() : ints.Append(i).ok());
+    ASSERT_TRUE((i % 5 == 0) ? names.AppendNull().ok() : names.Append((i % 2) ? "odd" : "even").ok());
+    ASSERT_TRUE(reals.Append(i / 4.0).ok());
+  }
+
+  auto intArray = *ints.Finish();
+  auto nameArray = *names.Finish();
+  auto realArray = *reals.Finish();
+  auto schema = arrow::schema({arrow::field("i", intArray->type()), arrow::field("name", nameArray->type()),
+                               arrow::field("r", realArray->type())});
+  {
+    auto file = arrow::io::FileOutputStream::Open(fileName);
+    ASSERT_TRUE(file.ok());
+    auto writer = arrow::ipc::MakeStreamWriter(*file, schema);
+    ASSERT_TRUE(writer.ok());
+    ASSERT_TRUE((*writer)->WriteRecordBatch(*arrow::RecordBatch::Make(schema, rows,
+                                                                       {intArray, nameArray, realArray}))
+                    .ok());
+    ASSERT_TRUE((*writer)->Close().ok());
+    ASSERT_TRUE((*file)->Close().ok());
+  }
+
+  // INT, CHAR(3), DOUBLE
+  std::vector<ParquetReader::Column> columns{{CSC::INT, 4, 0}, {CSC::CHAR, 3, 0}, {CSC::DOUBLE, 8, 0}};
+  ParquetReader reader;
+  std::string errMsg;
+  ASSERT_EQ(reader.openStream(fileName, columns, errMsg), NO_ERROR) << errMsg;
+  EXPECT_EQ(reader.recordLength(), 15u);
+
+  std::vector<char> records;
+  int64_t row = 0;
+
+  while (true)
+  {
+    ASSERT_EQ(reader.readRecords(records, errMsg), NO_ERROR) << errMsg;
+
+    if (records.empty())
+      break;
+
+    EXPECT_LT(records.size(), size_t(rows) * 15);
+
+    for (unsigned i = 0; i < records.size() / 15; i++, row++)
+    {
+      if (row % 7 == 0)
+        EXPECT_EQ(field<uint32_t>(records, 15, i, 0), joblist::INTNULL);
+      else
+        EXPECT_EQ(field<int32_t>(records, 15, i, 0), row);
+
+      std::string name(records.data() + i * 15 + 4, 3);
+      EXPECT_EQ(name, (row % 5 == 0) ? std::string(3, '\0') : ((row % 2) ? std::string("odd") : "eve"));
+      EXPECT_EQ(field<double>(records, 15, i, 7), row / 4.0);
+    }
+  }
+
+  EXPECT_EQ(row, rows);
+  EXPECT_TRUE(reader.eof());
+}
+
+TEST_F(ParquetReaderTest, RejectsMismatchedColumns)
+{
+  auto schema = arrow::schema({arrow::field("s", arrow::utf8())});
+  write(arrow::Table::Make(
+      schema, {makeArray(arrow::StringBuilder(), std::vector<std::string>{"2024-01-01"}, {true})}));
+
+  ParquetReader reader;
+  std::string errMsg;
+  std::vector<ParquetReader::Column> columns{{CSC::DATE, 4, 0}};
+  EXPECT_EQ(reader.open(fileName, columns, errMsg), ERR_BULK_PARQUET_SCHEMA);
+  EXPECT_NE(errMsg.find("(s)"), std::string::npos);
+
+  columns = {{CSC::VARCHAR, 10, 0}, {CSC::INT, 4, 0}};
+  EXPECT_EQ(reader.open(fileName, columns, errMsg), ERR_BULK_PARQUET_SCHEMA);
+
+  EXPECT_EQ(reader.open(fileName + ".missing", columns, errMsg), ERR_FILE_OPEN);
+}
@@ -0,0 +1,266 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "queryadmission.h"
+
+using namespace joblist;
+
+namespace
+{
+uint32_t queued(const QueryAdmission& admission)
+{
+  auto stats = admission.stats();
+  return stats.queued[0] + stats.queued[1] + stats.queued[2];
+}
+
+// Waits until the given number of queries is queued
+void waitForQueued(const QueryAdmission& admission, uint32_t expected)
+{
+  for (uint32_t i = 0; i < 3000 && queued(admission) < expected; ++i)
+    usleep(1000);
+
+  ASSERT_EQ(queued(admission), expected);
+}
+
+// Admits a query in a thread and records the order the queries are admitted in
+class Query
+{
+ public:
+  Query(QueryAdmission& admission, uint64_t bytes, QueryAdmission::Priority priority, int id,
+        std::vector<int>& order, std::mutex& orderMutex)
+   : thread_(
+         [&, bytes, priority, id]()
+         {
+           admission.admit(bytes, priority, ticket_);
+           std::lock_guard<std::mutex> lk(orderMutex);
+           order.push_back(id);
+           admitted_ = true;
+         })
+  {
+  }
+
+  ~Query()
+  {
+    if (thread_.joinable())
+      thread_.join();
+  }
+
+  bool admitted() const
+  {
+    return admitted_;
+  }
+
+  void finish()
+  {
+    thread_.join();
+    ticket_.release();
+  }
+
+ private:
+  QueryAdmission::Ticket ticket_;
+  std::atomic<bool> admitted_{false};
+  std::thread thread_;
+};
+
+}  // namespace
+
+TEST(QueryAdmission, AdmitsWhatFits)
+{
+  QueryAdmission admission(100, 1);
+  QueryAdmission::Ticket t1, t2;
+
+  admission.admit(40, QueryAdmission::LOW_PRIORITY, t1);
+  admission.admit(60, QueryAdmission::LOW_PRIORITY, t2);
+
+  auto stats = admission.stats();
+  EXPECT_EQ(stats.reserved, 100ULL);
+  EXPECT_EQ(stats.running, 2U);
+  EXPECT_EQ(stats.admitted, 2ULL);
+  EXPECT_EQ(stats.waited, 0ULL);
+
+  t1.release();
+  t2.release();
+  EXPECT_EQ(admission.stats().reserved, 0ULL);
+  EXPECT_EQ(admission.stats().running, 0U);
+}
+
+TEST(QueryAdmission, EstimateIsClamped)
+{
+  QueryAdmission admission(100, 10);
+  QueryAdmission::Ticket small, big;
+
+  admission.admit(0, QueryAdmission::LOW_PRIORITY, small);
+  EXPECT_EQ(small.bytes(), 10ULL);
+  small.release();
+
+  // Bigger than the whole budget, admitted when nothing else runs
+  admission.admit(1000, QueryAdmission::LOW_PRIORITY, big);
+  EXPECT_EQ(big.bytes(), 100ULL);
+  EXPECT_EQ(admission.stats().reserved, 100ULL);
+}
+
+TEST(QueryAdmission, WaitsForMemory)
+{
+  QueryAdmission admission(100, 1);
+  std::vector<int> order;
+  std::mutex orderMutex;
+  QueryAdmission::Ticket running;
+
+  admission.admit(80, QueryAdmission::LOW_PRIORITY, running);
+  Query query(admission, 50, QueryAdmission::LOW_PRIORITY, 1, order, orderMutex);
+  waitForQueued(admission, 1);
+  EXPECT_FALSE(query.admitted());
+
+  running.release();
+  query.finish();
+
+  auto stats = admission.stats();
+  EXPECT_EQ(order, std::vector<int>{1});
+  EXPECT_EQ(stats.admitted, 2ULL);
+  EXPECT_EQ(stats.waited, 1ULL);
+  EXPECT_EQ(stats.reserved, 0ULL);
+}
+
+TEST(QueryAdmission, HigherClassesFirst)
+{
+  QueryAdmission admission(100, 1);
+  std::vector<int> order;
+  std::mutex orderMutex;
+  QueryAdmission::Ticket running;
+
+  admission.admit(100, QueryAdmission::LOW_PRIORITY, running);
+  Query low(admission, 60, QueryAdmission::LOW_PRIORITY, 1, order, orderMutex);
+  waitForQueued(admission, 1);
+  Query medium(admission, 60, QueryAdmission::MEDIUM_PRIORITY, 2, order, orderMutex);
+  waitForQueued(admission, 2);
+  Query high(admission, 60, QueryAdmission::HIGH_PRIORITY, 3, order, orderMutex);
+  waitForQueued(admission, 3);
+
+  auto stats = admission.stats();
+  EXPECT_EQ(stats.queued[QueryAdmission::HIGH_PRIORITY], 1U);
+  EXPECT_EQ(stats.queued[QueryAdmission::MEDIUM_PRIORITY], 1U);
+  EXPECT_EQ(stats.queued[QueryAdmission::LOW_PRIORITY], 1U);
+
+  // Only one of the waiting queries fits at a time
+  running.release();
+  high.finish();
+  medium.finish();
+  low.finish();
+
+  EXPECT_EQ(order, (std::vector<int>{3, 2, 1}));
+}
+
+TEST(QueryAdmission, SmallQueryDoesNotOvertake)
+{
+  QueryAdmission admission(100, 1);
+  std::vector<int> order;
+  std::mutex orderMutex;
+  QueryAdmission::Ticket running;
+
+  admission.admit(60, QueryAdmission::LOW_PRIORITY, running);
+  Query big(admission, 80, QueryAdmission::LOW_PRIORITY, 1, order, orderMutex);
+  waitForQueued(admission, 1);
+  // Would fit right away but the big query is ahead
+  Query small(admission, 10, QueryAdmission::LOW_PRIORITY, 2, order, orderMutex);
+  waitForQueued(admission, 2);
+  EXPECT_FALSE(small.admitted());
+
+  running.release();
+  big.finish();
+  small.finish();
+
+  EXPECT_EQ(order, (std::vector<int>{1, 2}));
+}
+
+TEST(QueryAdmission, CancelledWaitLeavesTheQueue)
+{
+  QueryAdmission admission(100, 1);
+  std::vector<int> order;
+  std::mutex orderMutex;
+  QueryAdmission::Ticket running;
+  std::atomic<bool> cancel{false};
+  std::atomic<int> result{-1};
+  QueryAdmission::Ticket cancelledTicket;
+
+  admission.admit(60, QueryAdmission::LOW_PRIORITY, running);
+  std::thread cancelled(
+      [&]()
+      {
+        result = admission.admit(80, QueryAdmission::LOW_PRIORITY, cancelledTicket,
+                                 [&cancel]() { return cancel.load(); });
+      });
+  waitForQueued(admission, 1);
+  // Waits behind the cancelled query
+  Query small(admission, 10, QueryAdmission::LOW_PRIORITY, 1, order, orderMutex);
+  waitForQueued(admission, 2);
+  EXPECT_FALSE(small.admitted());
+
+  cancel = true;
+  cancelled.join();
+  EXPECT_EQ(result, 0);
+  EXPECT_EQ(cancelledTicket.bytes(), 0ULL);
+
+  // The query behind it no longer waits for the memory the cancelled one asked for
+  small.finish();
+  EXPECT_EQ(order, std::vector<int>{1});
+
+  auto stats = admission.stats();
+  EXPECT_EQ(queued(admission), 0U);
+  EXPECT_EQ(stats.admitted, 2ULL);
+  EXPECT_EQ(stats.reserved, 60ULL);
+}
+
+TEST(QueryAdmission, TicketMoves)
+{
+  QueryAdmission admission(100, 1);
+  QueryAdmission::Ticket t1, t2;
+
+  admission.admit(30, QueryAdmission::LOW_PRIORITY, t1);
+  admission.admit(20, QueryAdmission::LOW_PRIORITY, t2);
+
+  {
+    QueryAdmission::Ticket moved(std::move(t1));
+    EXPECT_EQ(t1.bytes(), 0ULL);
+    EXPECT_EQ(admission.stats().reserved, 50ULL);
+  }
+
+  EXPECT_EQ(admission.stats().reserved, 20ULL);
+
+  // Assigning returns what the ticket held
+  t2 = QueryAdmission::Ticket();
+  EXPECT_EQ(admission.stats().reserved, 0ULL);
+
+  // So does re-admitting with the same ticket
+  admission.admit(30, QueryAdmission::LOW_PRIORITY, t1);
+  admission.admit(40, QueryAdmission::LOW_PRIORITY, t1);
+  EXPECT_EQ(admission.stats().reserved, 40ULL);
+  EXPECT_EQ(admission.stats().running, 1U);
+}
+
+TEST(QueryAdmission, PriorityClasses)
+{
+  EXPECT_EQ(QueryAdmission::priorityClass(33), QueryAdmission::LOW_PRIORITY);
+  EXPECT_EQ(QueryAdmission::priorityClass(66), QueryAdmission::MEDIUM_PRIORITY);
+  EXPECT_EQ(QueryAdmission::priorityClass(100), QueryAdmission::HIGH_PRIORITY);
+}
@@ -16,11 +16,16 @@
    MA 02110-1301, USA. */
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <fstream>
 #include <string>
 #include <vector>
+#include <boost/filesystem.hpp>
 
+#include "we_blockop.h"
 #include "we_convertor.h"
 #include "we_fileop.h"
+#include "rebuildEM.h"
 
 using namespace idbdatafile;
 using namespace WriteEngine;
@@ -152,3 +157,65 @@ TEST_F(RebuildEMTest, File2OidCalculationTest)
     EXPECT_EQ(expectedFileId.segment, calculatedFileId.segment);
   }
 }
+
+// Writes system catalog segment files of INT columns and checks that the
+// extents collected by several workers are the ones a single worker collects.
+TEST_F(RebuildEMTest, CollectExtentsInParallelTest)
+{
+  namespace fs = boost::filesystem;
+  const fs::path dbRoot = fs::temp_directory_path() / fs::unique_path("rebuild-em-%%%%-%%%%");
+  const std::vector<uint32_t> oids = {1003, 1006, 1007, 1008, 1009, 1010, 1011, 1012};
+  const auto intType = execplan::CalpontSystemCatalog::INT;
+
+  WriteEngine::BlockOp blockOp;
+  const uint8_t* emptyValue = blockOp.getEmptyRowValue(intType, 4);
+  std::vector<char> emptyBlock(BYTE_PER_BLOCK);
+  for (uint32_t i = 0; i < BYTE_PER_BLOCK; i += 4)
+    memcpy(&emptyBlock[i], emptyValue, 4);
+  const std::vector<char> dataBlock(BYTE_PER_BLOCK, 0);
+
+  // The file of the i-th OID has i + 1 data blocks followed by empty ones.
+  for (uint32_t i = 0; i < oids.size(); ++i)
+  {
+    char fileName[WriteEngine::FILE_NAME_SIZE];
+    char dbDirName[WriteEngine::MAX_DB_DIR_LEVEL][WriteEngine::MAX_DB_DIR_NAME_SIZE];
+    ASSERT_EQ(WriteEngine::Convertor::oid2FileName(oids[i], fileName, dbDirName, 0, 0), 0);
+
+    const fs::path filePath = dbRoot / fileName;
+    fs::create_directories(filePath.parent_path());
+    std::ofstream file(filePath.string(), std::ios::binary);
+    for (uint32_t block = 0; block < 16; ++block)
+      file.write(block <= i ? dataBlock.data() : emptyBlock.data(), BYTE_PER_BLOCK);
+  }
+
+  auto collect = [&](uint32_t threadCount)
+  {
+    RebuildExtentMap::EMReBuilder emReBuilder(false, true, threadCount);
+    emReBuilder.setDBRoot(1);
+    EXPECT_EQ(emReBuilder.collectFiles(dbRoot.string()), 0);
+    EXPECT_EQ(emReBuilder.collectExtents(), 0);
+    EXPECT_TRUE(emReBuilder.getExtents().empty());
+
+    std::vector<RebuildExtentMap::FileId> extents = emReBuilder.getSystemExtents();
+    std::sort(extents.begin(), extents.end(),
+              [](const RebuildExtentMap::FileId& lhs, const RebuildExtentMap::FileId& rhs)
+              { return lhs.oid < rhs.oid; });
+    return extents;
+  };
+
+  const auto expected = collect(1);
+  const auto collected = collect(4);
+  fs::remove_all(dbRoot);
+
+  ASSERT_EQ(expected.size(), oids.size());
+  ASSERT_EQ(collected.size(), oids.size());
+  for (uint32_t i = 0; i < oids.size(); ++i)
+  {
+    EXPECT_EQ(expected[i].oid, oids[i]);
+    EXPECT_EQ(expected[i].hwm, i);
+    EXPECT_EQ(collected[i].oid, expected[i].oid);
+    EXPECT_EQ(collected[i].hwm, expected[i].hwm);
+    EXPECT_EQ(collected[i].lbid, expected[i].lbid);
+    EXPECT_EQ(collected[i].dbroot, 1U);
+  }
+}
@@ -410,3 +410,72 @@ TEST_F(RGDataTest, AllocData)
 
     // reinit
 }
+
+// The columnar encoding of the rows of a RowGroup decodes to the same rows
+void columnarRoundTrip(rowgroup::RowGroup& rg)
+{
+  const uint32_t rowCount = 1000;
+  rowgroup::RGData rgD(rg);
+  rowgroup::Row r;
+  rg.setData(&rgD);
+  rg.resetRowGroup(0);
+  rg.initRow(&r);
+  rg.getRow(0, &r);
+
+  for (uint32_t i = 0; i < rowCount; ++i, r.nextRow())
+  {
+    std::string s = "value" + std::to_string(i % 5);
+    r.setStringField(utils::ConstString(s), 0);
+    r.setInt128Field(static_cast<int128_t>(i) * 1000000007, 1);
+    r.setIntField(i, 2);
+    r.setIntField(-static_cast<int64_t>(i % 100), 3);
+    r.setIntField(7, 4);
+
+    if (i % 7 == 0)
+      r.setToNull(5);
+    else
+      r.setIntField(i % 3, 5);
+  }
+
+  rg.setRowCount(rowCount);
+
+  messageqcpp::ByteStream rowMajor;
+  messageqcpp::ByteStream columnar;
+  rg.serializeRGData(rowMajor);
+  rg.serializeRGDataColumnar(columnar);
+  EXPECT_LT(columnar.length(), rowMajor.length());
+
+  rowgroup::RGData rgDOut;
+  rowgroup::RowGroup rgOut(rg);
+  rowgroup::Row rOut;
+  rgDOut.deserialize(columnar, true);
+  rgOut.setData(&rgDOut);
+  ASSERT_EQ(rgOut.getRowCount(), rowCount);
+  EXPECT_EQ(columnar.length(), 0U);
+
+  rgOut.initRow(&rOut);
+  rgOut.getRow(0, &rOut);
+  rg.getRow(0, &r);
+
+  for (uint32_t i = 0; i < rowCount; ++i, r.nextRow(), rOut.nextRow())
+  {
+    EXPECT_TRUE(r.equals(rOut));
+    EXPECT_EQ(rOut.isNullValue(5), i % 7 == 0);
+  }
+}
+
+TEST_F(RGDataTest, ColumnarSerializeRoundTrip)
+{
+  // The VARCHAR is in the string table, its lane is the string table pointer
+  ASSERT_TRUE(rg.usesStringTable());
+  columnarRoundTrip(rg);
+
+  // All the columns inline
+  rowgroup::RowGroup inlineRG =
+      setupRG({execplan::CalpontSystemCatalog::VARCHAR, execplan::CalpontSystemCatalog::UDECIMAL,
+               execplan::CalpontSystemCatalog::DECIMAL, execplan::CalpontSystemCatalog::DECIMAL,
+               execplan::CalpontSystemCatalog::DECIMAL, execplan::CalpontSystemCatalog::DECIMAL},
+              {8, 16, 8, 4, 2, 1}, {8, 8, 8, 8, 8, 8});
+  ASSERT_FALSE(inlineRG.usesStringTable());
+  columnarRoundTrip(inlineRG);
+}
@@ -0,0 +1,87 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "sharedscans.h"
+
+using namespace joblist;
+
+namespace
+{
+// The extents of a column as TupleBPS sorts them: two on dbroot 1, three on dbroot 2
+std::vector<BRM::EMEntry> makeExtents()
+{
+  std::vector<BRM::EMEntry> extents(5);
+  const uint16_t dbRoots[] = {1, 1, 2, 2, 2};
+
+  for (uint32_t i = 0; i < extents.size(); ++i)
+  {
+    extents[i].dbRoot = dbRoots[i];
+    extents[i].range.start = i * 1000;
+  }
+
+  return extents;
+}
+}  // namespace
+
+TEST(SharedScans, OrderWithoutPositions)
+{
+  EXPECT_EQ(SharedScans::scanOrder(makeExtents(), {}), (std::vector<uint32_t>{0, 1, 2, 3, 4}));
+}
+
+TEST(SharedScans, OrderStartsAtPositions)
+{
+  SharedScans::Positions positions{{1, 1000}, {2, 3000}};
+  EXPECT_EQ(SharedScans::scanOrder(makeExtents(), positions), (std::vector<uint32_t>{1, 0, 3, 4, 2}));
+}
+
+TEST(SharedScans, OrderIgnoresUnknownPositions)
+{
+  // dbroot 1 is at an extent this scan doesn't have, dbroot 3 isn't scanned
+  SharedScans::Positions positions{{1, 500}, {2, 4000}, {3, 7000}};
+  EXPECT_EQ(SharedScans::scanOrder(makeExtents(), positions), (std::vector<uint32_t>{0, 1, 4, 2, 3}));
+}
+
+TEST(SharedScans, JoinsScanInProgress)
+{
+  SharedScans scans;
+  const uint32_t oid = 3001;
+
+  EXPECT_TRUE(scans.attach(oid).empty());
+  scans.progress(oid, 1, 1000);
+  scans.progress(oid, 2, 3000);
+  scans.progress(oid, 2, 4000);
+  // Another column
+  EXPECT_TRUE(scans.attach(oid + 1).empty());
+
+  auto positions = scans.attach(oid);
+  EXPECT_EQ(positions, (SharedScans::Positions{{1, 1000}, {2, 4000}}));
+
+  // The position is kept while any scan of the column runs
+  scans.detach(oid);
+  EXPECT_EQ(scans.attach(oid).size(), 2U);
+  scans.detach(oid);
+  scans.detach(oid);
+
+  EXPECT_TRUE(scans.attach(oid).empty());
+  scans.detach(oid);
+  // Progress of a column nobody scans is dropped
+  scans.progress(oid, 1, 1000);
+  EXPECT_TRUE(scans.attach(oid).empty());
+}
@@ -0,0 +1,141 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+#include "utils/threadpool/fair_threadpool.h"
+#include "utils/threadpool/workstealing_threadpool.h"
+
+using namespace std;
+using namespace threadpool;
+
+// Compares FairThreadPool and WorkStealingThreadPool running many small jobs of several queries
+// pushed by several producers, as ReadThreads do in PrimProc.
+// Arguments: worker threads, busy loop iterations per job.
+// Reports jobs/s and the percentiles of the time a job waits in the queue.
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr uint32_t Producers = 4;
+constexpr uint32_t Queries = 8;
+constexpr uint32_t JobsPerRun = 20000;
+
+class BenchFunctor : public FairThreadPool::Functor
+{
+ public:
+  BenchFunctor(Clock::time_point enqueued, int64_t& waitNs, uint32_t work, std::atomic<uint32_t>& done)
+   : enqueued_(enqueued), waitNs_(waitNs), work_(work), done_(done)
+  {
+  }
+
+  int operator()() override
+  {
+    waitNs_ = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - enqueued_).count();
+    uint64_t x = 0;
+
+    for (uint32_t i = 0; i < work_; ++i)
+      benchmark::DoNotOptimize(x += i);
+
+    done_.fetch_add(1, std::memory_order_release);
+    return 0;
+  }
+
+ private:
+  Clock::time_point enqueued_;
+  int64_t& waitNs_;
+  uint32_t work_;
+  std::atomic<uint32_t>& done_;
+};
+
+template <typename Pool>
+void BM_ThreadPool(benchmark::State& state)
+{
+  const uint32_t workers = state.range(0);
+  const uint32_t work = state.range(1);
+  // FairThreadPool threads are detached and outlive the pool, so the pools are never destroyed
+  // and are reused by all the runs with the same number of workers.
+  static std::map<uint32_t, Pool*> pools;
+  Pool*& poolPtr = pools[workers];
+
+  if (!poolPtr)
+    poolPtr = new Pool(1, workers, 0, 0);
+
+  Pool& pool = *poolPtr;
+  primitiveprocessor::SP_UM_IOSOCK sock;
+  std::vector<int64_t> waits(JobsPerRun);
+  std::vector<int64_t> allWaits;
+  std::atomic<uint32_t> done{0};
+
+  for (auto _ : state)
+  {
+    done.store(0, std::memory_order_relaxed);
+    std::vector<std::thread> producers;
+
+    for (uint32_t p = 0; p < Producers; ++p)
+    {
+      producers.emplace_back(
+          [&, p]()
+          {
+            for (uint32_t i = p; i < JobsPerRun; i += Producers)
+            {
+              boost::shared_ptr<FairThreadPool::Functor> functor(
+                  new BenchFunctor(Clock::now(), waits[i], work, done));
+              pool.addJob(FairThreadPool::Job(i % Queries, 1, i % Queries, functor, sock));
+            }
+          });
+    }
+
+    for (auto& producer : producers)
+      producer.join();
+
+    while (done.load(std::memory_order_acquire) < JobsPerRun)
+      std::this_thread::yield();
+
+    allWaits.insert(allWaits.end(), waits.begin(), waits.end());
+  }
+
+  state.SetItemsProcessed(state.iterations() * JobsPerRun);
+
+  std::sort(allWaits.begin(), allWaits.end());
+  auto percentile = [&](double p) { return allWaits[(size_t)(p * (allWaits.size() - 1))] / 1000.0; };
+  state.counters["wait_p50_us"] = percentile(0.5);
+  state.counters["wait_p99_us"] = percentile(0.99);
+  state.counters["wait_p999_us"] = percentile(0.999);
+  state.counters["wait_max_us"] = allWaits.back() / 1000.0;
+}
+
+void threadPoolArgs(benchmark::internal::Benchmark* b)
+{
+  for (int64_t workers : {4, 16, 64})
+    for (int64_t work : {0, 1000, 20000})
+      b->Args({workers, work});
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ThreadPool, FairThreadPool)->Apply(threadPoolArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ThreadPool, WorkStealingThreadPool)->Apply(threadPoolArgs)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,189 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rowgroup.h"
+#include "../utils/windowfunction/topnrows.h"
+
+using namespace rowgroup;
+using namespace ordering;
+using CSCDataType = execplan::CalpontSystemCatalog::ColDataType;
+
+namespace
+{
+// Two BIGINTs and a VARCHAR long enough to go to the string table
+RowGroup makeRowGroup()
+{
+  std::vector<uint32_t> offsets{2, 10, 18, 48};
+  std::vector<uint32_t> oids{3000, 3001, 3002};
+  std::vector<uint32_t> keys{1, 2, 3};
+  std::vector<CSCDataType> types{execplan::CalpontSystemCatalog::BIGINT,
+                                 execplan::CalpontSystemCatalog::BIGINT,
+                                 execplan::CalpontSystemCatalog::VARCHAR};
+  std::vector<uint32_t> charsets{8, 8, 8};
+  std::vector<uint32_t> scale{0, 0, 0};
+  std::vector<uint32_t> precision{19, 19, 30};
+  return RowGroup(oids.size(), offsets, oids, keys, types, charsets, scale, precision, 20, true);
+}
+
+class TopNRowsTest : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    rg = makeRowGroup();
+    rgData.reinit(rg, rgCommonSize);
+    rg.setData(&rgData);
+    rg.initRow(&row);
+  }
+
+  // Feeds the values in RowGroups of batch rows, the string is the values written out
+  void addRows(TopNRows& topN, const std::vector<std::pair<int64_t, int64_t>>& values, uint32_t batch)
+  {
+    for (uint32_t first = 0; first < values.size(); first += batch)
+    {
+      rg.resetRowGroup(first);
+      rg.getRow(0, &row);
+
+      for (uint32_t i = first; i < values.size() && i < first + batch; ++i, row.nextRow())
+      {
+        std::string str = toString(values[i]);
+        row.setIntField(values[i].first, 0);
+        row.setIntField(values[i].second, 1);
+        row.setStringField(utils::ConstString(str.c_str(), str.length()), 2);
+        rg.incRowCount();
+      }
+
+      topN.addRows(rg);
+    }
+  }
+
+  static std::string toString(const std::pair<int64_t, int64_t>& value)
+  {
+    return std::to_string(value.first) + " / " + std::to_string(value.second);
+  }
+
+  // The kept rows, checks their strings came along
+  static std::vector<std::pair<int64_t, int64_t>> result(TopNRows& topN)
+  {
+    std::vector<std::pair<int64_t, int64_t>> values;
+    RowGroup& out = topN.result();
+    Row outRow;
+    out.initRow(&outRow);
+    out.getRow(0, &outRow);
+
+    for (uint32_t i = 0; i < out.getRowCount(); ++i, outRow.nextRow())
+    {
+      values.emplace_back(outRow.getIntField(0), outRow.getIntField(1));
+      EXPECT_EQ(outRow.getStringField(2).safeString(""), toString(values.back()));
+    }
+
+    return values;
+  }
+
+  RowGroup rg;
+  RGData rgData;
+  Row row;
+};
+
+std::vector<std::pair<int64_t, int64_t>> randomValues(uint32_t count, int64_t range)
+{
+  std::mt19937 gen(count);
+  std::uniform_int_distribution<int64_t> dist(-range, range);
+  std::vector<std::pair<int64_t, int64_t>> values(count);
+
+  for (auto& value : values)
+    value = {dist(gen), dist(gen)};
+
+  return values;
+}
+}  // namespace
+
+TEST_F(TopNRowsTest, KeepsFirstRowsAscending)
+{
+  TopNRows topN(rg, {IdbSortSpec(0, true), IdbSortSpec(1, true)}, 100);
+  auto values = randomValues(20000, 1000);
+  addRows(topN, values, rgCommonSize);
+
+  auto kept = result(topN);
+  std::sort(kept.begin(), kept.end());
+  std::sort(values.begin(), values.end());
+  values.resize(100);
+  EXPECT_EQ(kept, values);
+}
+
+TEST_F(TopNRowsTest, KeepsFirstRowsDescending)
+{
+  TopNRows topN(rg, {IdbSortSpec(1, false), IdbSortSpec(0, true)}, 7);
+  auto values = randomValues(5000, 50);
+  addRows(topN, values, 333);
+
+  auto order = [](const std::pair<int64_t, int64_t>& lhs, const std::pair<int64_t, int64_t>& rhs)
+  { return lhs.second > rhs.second || (lhs.second == rhs.second && lhs.first < rhs.first); };
+  auto kept = result(topN);
+  std::sort(kept.begin(), kept.end(), order);
+  std::sort(values.begin(), values.end(), order);
+  values.resize(7);
+  EXPECT_EQ(kept, values);
+}
+
+TEST_F(TopNRowsTest, KeepsAllWhenFewerRows)
+{
+  TopNRows topN(rg, {IdbSortSpec(0, true)}, 1000);
+  auto values = randomValues(300, 1000000);
+  addRows(topN, values, 128);
+
+  auto kept = result(topN);
+  std::sort(kept.begin(), kept.end());
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ(kept, values);
+}
+
+TEST_F(TopNRowsTest, StringsSurviveCompaction)
+{
+  // Descending input replaces the kept rows all the time
+  TopNRows topN(rg, {IdbSortSpec(0, true)}, 3);
+  std::vector<std::pair<int64_t, int64_t>> values;
+
+  for (int64_t i = 1000; i > 0; --i)
+    values.emplace_back(i, -i);
+
+  addRows(topN, values, 10);
+
+  auto kept = result(topN);
+  std::sort(kept.begin(), kept.end());
+  EXPECT_EQ(kept, (std::vector<std::pair<int64_t, int64_t>>{{1, -1}, {2, -2}, {3, -3}}));
+}
+
+TEST_F(TopNRowsTest, ResetStartsOver)
+{
+  TopNRows topN(rg, {IdbSortSpec(0, true)}, 2);
+  addRows(topN, {{1, 1}, {2, 2}, {3, 3}}, 10);
+  topN.reset();
+  EXPECT_EQ(topN.result().getRowCount(), 0U);
+
+  addRows(topN, {{9, 9}, {8, 8}, {7, 7}}, 10);
+  auto kept = result(topN);
+  std::sort(kept.begin(), kept.end());
+  EXPECT_EQ(kept, (std::vector<std::pair<int64_t, int64_t>>{{7, 7}, {8, 8}}));
+}
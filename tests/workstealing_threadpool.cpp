@@ -0,0 +1,328 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+#include "utils/threadpool/workstealing_threadpool.h"
+
+using namespace primitiveprocessor;
+using namespace std;
+using namespace threadpool;
+
+using ResultsType = std::vector<int>;
+static ResultsType results;
+static std::mutex globMutex;
+
+// The FairThreadPool tests: with one worker the pool must schedule exactly like FairThreadPool.
+class WorkStealingThreadPoolTest : public testing::Test
+{
+ public:
+  void SetUp() override
+  {
+    results.clear();
+    threadPool.reset(new WorkStealingThreadPool(1, 1, 0, 0));
+  }
+
+  void waitForEmptyQueue(useconds_t step)
+  {
+    while (threadPool->queueSize())
+    {
+      usleep(step);
+    }
+  }
+
+  boost::shared_ptr<FairThreadPool> threadPool;
+};
+
+class TestFunctor : public FairThreadPool::Functor
+{
+ public:
+  TestFunctor(const size_t id, const size_t delay) : id_(id), delay_(delay)
+  {
+  }
+  ~TestFunctor(){};
+  int operator()() override
+  {
+    std::lock_guard<std::mutex> gl(globMutex);
+    usleep(delay_);
+    results.push_back(id_);
+    return 0;
+  }
+
+ private:
+  size_t id_;
+  size_t delay_;
+};
+
+class TestRescheduleFunctor : public FairThreadPool::Functor
+{
+ public:
+  TestRescheduleFunctor(const size_t id, const size_t delay) : id_(id), delay_(delay)
+  {
+  }
+  ~TestRescheduleFunctor(){};
+  int operator()() override
+  {
+    if (firstRun)
+    {
+      firstRun = false;
+      return 1;  // re-schedule the Job
+    }
+    usleep(delay_);
+    std::lock_guard<std::mutex> gl(globMutex);
+    results.push_back(id_);
+    return 0;
+  }
+
+ private:
+  size_t id_;
+  size_t delay_;
+  bool firstRun = true;
+};
+
+testing::AssertionResult isThisOrThat(const ResultsType& arr, const size_t idxA, const int a,
+                                      const size_t idxB, const int b)
+{
+  if (arr.empty() || arr.size() <= max(idxA, idxB))
+    return testing::AssertionFailure() << "The supplied vector is either empty or not big enough.";
+  if (arr[idxA] == a && arr[idxB] == b)
+    return testing::AssertionSuccess();
+  if (arr[idxA] == b && arr[idxB] == a)
+    return testing::AssertionSuccess();
+  return testing::AssertionFailure() << "The values at positions " << idxA << " " << idxB << " are not " << a
+                                     << " and " << b << std::endl;
+}
+
+TEST_F(WorkStealingThreadPoolTest, WorkStealingThreadPoolAdd)
+{
+  SP_UM_IOSOCK sock(new messageqcpp::IOSocket);
+  auto functor1 = boost::shared_ptr<FairThreadPool::Functor>(new TestFunctor(1, 150000));
+  FairThreadPool::Job job1(1, 1, 1, functor1, sock, 1);
+  auto functor2 = boost::shared_ptr<FairThreadPool::Functor>(new TestFunctor(2, 150000));
+  FairThreadPool::Job job2(2, 1, 1, functor2, sock, 2);
+  auto functor3 = boost::shared_ptr<FairThreadPool::Functor>(new TestFunctor(3, 5000));
+  FairThreadPool::Job job3(3, 1, 1, functor3, sock, 1);
+  auto functor4 = boost::shared_ptr<FairThreadPool::Functor>(new TestFunctor(4, 5000));
+  FairThreadPool::Job job4(4, 1, 2, functor4, sock, 1);
+
+  threadPool->addJob(job1);
+  threadPool->addJob(job2);
+  threadPool->addJob(job3);
+  threadPool->addJob(job4);
+
+  waitForEmptyQueue(350000);
+
+  EXPECT_EQ(threadPool->queueSize(), 0ULL);
+  EXPECT_EQ(results.size(), 4ULL);
+  EXPECT_EQ(results[0], 1);
+  EXPECT_EQ(results[1], 4);
+  EXPECT_TRUE(isThisOrThat(results, 2, 2, 3, 3));
+}
+
+TEST_F(WorkStealingThreadPoolTest, WorkStealingThreadPoolRemove)
+{
+  SP_UM_IOSOCK sock(new messageqcpp::IOSocket);
+  auto functor1 = boost::shared_ptr<FairThreadPool::Functor>(new TestFunctor(1, 100000));
+  FairThreadPool::Job job1(1, 1, 1, functor1, sock, 1, 0, 1);
+  auto functor2 = boost::shared_ptr<FairThreadPool::Functor>(new TestFunctor(2, 50000));
+  FairThreadPool::Job job2(2, 1, 1, functor2, sock, 1, 0, 2);
+  auto functor3 = boost::shared_ptr<FairThreadPool::Functor>(new TestFunctor(3, 50000));
+  FairThreadPool::Job job3(3, 1, 2, functor3, sock, 1, 0, 3);
+
+  threadPool->addJob(job1);
+  threadPool->addJob(job2);
+  threadPool->addJob(job3);
+  threadPool->removeJobs(job2.id_);
+
+  waitForEmptyQueue(250000);
+
+  EXPECT_EQ(threadPool->queueSize(), 0ULL);
+  EXPECT_EQ(results.size(), 2ULL);
+  EXPECT_EQ(results[0], 1);
+  EXPECT_EQ(results[1], 3);
+}
+
+TEST_F(WorkStealingThreadPoolTest, WorkStealingThreadPoolCleanUp)
+{
+  SP_UM_IOSOCK sock(new messageqcpp::IOSocket);
+  auto functor1 = boost::shared_ptr<FairThreadPool::Functor>(new TestFunctor(1, 100000));
+  FairThreadPool::Job job1(1, 1, 1, functor1, sock, 1, 0, 1);
+  auto functor2 = boost::shared_ptr<FairThreadPool::Functor>(new TestFunctor(2, 50000));
+  FairThreadPool::Job job2(2, 1, 1, functor2, sock, 1, 0, 2);
+  auto functor3 = boost::shared_ptr<FairThreadPool::Functor>(new TestFunctor(3, 50000));
+  FairThreadPool::Job job3(3, 1, 2, functor3, sock, 1, 0, 3);
+
+  threadPool->addJob(job1);
+  threadPool->removeJobs(job1.id_);
+  threadPool->addJob(job2);
+  threadPool->removeJobs(job2.id_);
+  threadPool->addJob(job3);
+  threadPool->removeJobs(job3.id_);
+  threadPool->removeJobs(job1.id_);
+  threadPool->removeJobs(job1.id_);
+
+  waitForEmptyQueue(250000);
+
+  EXPECT_EQ(threadPool->queueSize(), 0ULL);
+}
+
+TEST_F(WorkStealingThreadPoolTest, WorkStealingThreadPoolReschedule)
+{
+  SP_UM_IOSOCK sock(new messageqcpp::IOSocket);
+  auto functor1 = boost::shared_ptr<FairThreadPool::Functor>(new TestRescheduleFunctor(1, 100000));
+  FairThreadPool::Job job1(1, 1, 1, functor1, sock, 1, 0, 1);
+  auto functor2 = boost::shared_ptr<FairThreadPool::Functor>(new TestFunctor(2, 50000));
+  FairThreadPool::Job job2(2, 1, 2, functor2, sock, 1, 0, 2);
+  auto functor3 = boost::shared_ptr<FairThreadPool::Functor>(new TestFunctor(3, 50000));
+  FairThreadPool::Job job3(3, 1, 3, functor3, sock, 1, 0, 3);
+
+  threadPool->addJob(job1);
+  threadPool->addJob(job2);
+  threadPool->addJob(job3);
+
+  waitForEmptyQueue(250000);
+  usleep(250000);
+
+  EXPECT_EQ(threadPool->queueSize(), 0ULL);
+  EXPECT_EQ(results.size(), 3ULL);
+  // The rescheduled job goes behind the other txns
+  EXPECT_TRUE(isThisOrThat(results, 0, 2, 1, 3));
+  EXPECT_EQ(results[2], 1);
+}
+
+class WaitFunctor : public FairThreadPool::Functor
+{
+ public:
+  WaitFunctor(std::shared_future<void> released, std::atomic<bool>& wasReleased, std::atomic<uint32_t>& done)
+   : released_(std::move(released)), wasReleased_(wasReleased), done_(done)
+  {
+  }
+  int operator()() override
+  {
+    wasReleased_ = released_.wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+    ++done_;
+    return 0;
+  }
+
+ private:
+  std::shared_future<void> released_;
+  std::atomic<bool>& wasReleased_;
+  std::atomic<uint32_t>& done_;
+};
+
+class ReleaseFunctor : public FairThreadPool::Functor
+{
+ public:
+  explicit ReleaseFunctor(std::promise<void>& release) : release_(release)
+  {
+  }
+  int operator()() override
+  {
+    release_.set_value();
+    return 0;
+  }
+
+ private:
+  std::promise<void>& release_;
+};
+
+class CountFunctor : public FairThreadPool::Functor
+{
+ public:
+  explicit CountFunctor(std::atomic<uint32_t>& counter) : counter_(counter)
+  {
+  }
+  int operator()() override
+  {
+    ++counter_;
+    return 0;
+  }
+
+ private:
+  std::atomic<uint32_t>& counter_;
+};
+
+static void waitForCount(const std::atomic<uint32_t>& counter, uint32_t expected)
+{
+  for (uint32_t i = 0; i < 3000 && counter < expected; ++i)
+    usleep(10000);
+}
+
+// The second job in the queue of a busy worker is stolen by an idle one.
+TEST(WorkStealingThreadPool, IdleWorkerStealsJob)
+{
+  const uint32_t workers = 4;
+  WorkStealingThreadPool pool(1, workers, 0, 0);
+  SP_UM_IOSOCK sock(new messageqcpp::IOSocket);
+  std::promise<void> release;
+  std::atomic<bool> wasReleased{false};
+  std::atomic<uint32_t> counter{0};
+
+  // External jobs go round-robin: the release job lands behind the waiting one.
+  pool.addJob(FairThreadPool::Job(1, 1, 1,
+                                  boost::shared_ptr<FairThreadPool::Functor>(
+                                      new WaitFunctor(release.get_future().share(), wasReleased, counter)),
+                                  sock));
+
+  for (uint32_t i = 1; i < workers; ++i)
+    pool.addJob(FairThreadPool::Job(
+        2, 1, 2, boost::shared_ptr<FairThreadPool::Functor>(new CountFunctor(counter)), sock));
+
+  pool.addJob(FairThreadPool::Job(
+      3, 1, 3, boost::shared_ptr<FairThreadPool::Functor>(new ReleaseFunctor(release)), sock));
+
+  waitForCount(counter, workers);
+
+  EXPECT_TRUE(wasReleased);
+  EXPECT_EQ(counter, workers);
+}
+
+// Every job runs exactly once with many producers and workers.
+TEST(WorkStealingThreadPool, ManyProducers)
+{
+  const uint32_t producers = 4;
+  const uint32_t jobsPerProducer = 5000;
+  WorkStealingThreadPool pool(1, 8, 0, 0);
+  SP_UM_IOSOCK sock(new messageqcpp::IOSocket);
+  std::atomic<uint32_t> counter{0};
+  std::vector<std::thread> threads;
+
+  for (uint32_t p = 0; p < producers; ++p)
+  {
+    threads.emplace_back(
+        [&, p]()
+        {
+          for (uint32_t i = 0; i < jobsPerProducer; ++i)
+            pool.addJob(FairThreadPool::Job(
+                p, 1, i % 7, boost::shared_ptr<FairThreadPool::Functor>(new CountFunctor(counter)), sock));
+        });
+  }
+
+  for (auto& thread : threads)
+    thread.join();
+
+  waitForCount(counter, producers * jobsPerProducer);
+
+  EXPECT_EQ(counter, producers * jobsPerProducer);
+  EXPECT_EQ(pool.queueSize(), 0ULL);
+}
@@ -15,8 +15,10 @@
    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
    MA 02110-1301, USA. */
 
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <ftw.h>
 #include <boost/algorithm/string/case_conv.hpp>
 
@@ -30,7 +32,7 @@ using namespace RebuildExtentMap;
 
 static void usage(const std::string& pname)
 {
-  std::cout << "usage: " << pname << " [-vdhs]" << std::endl;
+  std::cout << "usage: " << pname << " [-vdhs] [-j threads]" << std::endl;
   std::cout << "rebuilds the extent map from the contents of the database file "
                "system."
             << std::endl;
@@ -38,6 +40,7 @@ static void usage(const std::string& pname)
   std::cout << "   -d display what would be done--don't do it" << std::endl;
   std::cout << "   -h display this help text" << std::endl;
   std::cout << "   -s show extent map and quit" << std::endl;
+  std::cout << "   -j number of threads to scan segment files, defaults to the number of CPUs" << std::endl;
 }
 
 static bool isYes()
@@ -61,8 +64,9 @@ int main(int argc, char** argv)
   bool showExtentMap = false;
   bool verbose = false;
   bool display = false;
+  uint32_t threadCount = std::max(1U, std::thread::hardware_concurrency());
 
-  while ((option = getopt(argc, argv, "vdhs")) != EOF)
+  while ((option = getopt(argc, argv, "vdhsj:")) != EOF)
   {
     switch (option)
     {
@@ -72,6 +76,8 @@ int main(int argc, char** argv)
 
       case 's': showExtentMap = true; break;
 
+      case 'j': threadCount = std::max(1, atoi(optarg)); break;
+
       case 'h':
       case '?':
       default:
@@ -81,7 +87,7 @@ int main(int argc, char** argv)
     }
   }
 
-  EMReBuilder emReBuilder(verbose, display);
+  EMReBuilder emReBuilder(verbose, display, threadCount);
   // Just show EM and quit.
   if (showExtentMap)
   {
@@ -126,9 +132,12 @@ int main(int argc, char** argv)
     std::string dbRootName = "DBRoot" + std::to_string(dbRootNumber);
     auto dbRootPath = config->getConfig("SystemConfig", dbRootName);
     emReBuilder.setDBRoot(dbRootNumber);
-    emReBuilder.collectExtents(dbRootPath.c_str());
+    emReBuilder.collectFiles(dbRootPath.c_str());
   }
 
+  // Scan segment files of all DBRoots in parallel.
+  emReBuilder.collectExtents();
+
   emReBuilder.rebuildExtentMap();
   emReBuilder.clear();
 
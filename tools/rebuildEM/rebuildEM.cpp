@@ -15,8 +15,12 @@
    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
    MA 02110-1301, USA. */
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <sstream>
 #include <stdint.h>
+#include <thread>
 
 #include "rebuildEM.h"
 #include "calpontsystemcatalog.h"
@@ -97,24 +101,86 @@ void EMReBuilder::collectFileNames(const std::string& partialPath, std::string c
     collectFileNames(partialPath, currentPath, fileNames);
 }
 
-int32_t EMReBuilder::collectExtents(const std::string& dbRootPath)
+int32_t EMReBuilder::collectFiles(const std::string& dbRootPath)
 {
   if (doVerbose())
   {
-    std::cout << "Collect extents for the DBRoot " << dbRootPath << std::endl;
+    std::cout << "Collect files for the DBRoot " << dbRootPath << std::endl;
   }
 
   std::vector<std::string> fileNames;
   collectFileNames(dbRootPath, "", fileNames);
-  for (const auto& fileName : fileNames)
+  for (auto& fileName : fileNames)
+    collectedFiles.emplace_back(getDBRoot(), std::move(fileName));
+
+  return 0;
+}
+
+int32_t EMReBuilder::collectExtents()
+{
+  const uint32_t workersCount =
+      std::max<uint32_t>(1, std::min<size_t>(getThreadCount(), collectedFiles.size()));
+  // Read it once, `ExtentMap` reads the config on the first call.
+  const uint32_t extentRows = getEM().getExtentRows();
+
+  if (doVerbose())
+  {
+    std::cout << "Collect extents from " << collectedFiles.size() << " files using " << workersCount
+              << " threads" << std::endl;
+  }
+
+  // Segment files are independent from each other, so the workers just take
+  // the next unprocessed file regardless of its DBRoot and OID.
+  std::atomic<size_t> nextFile{0};
+  std::vector<std::vector<FileId>> workerExtents(workersCount);
+  std::vector<std::vector<FileId>> workerSystemExtents(workersCount);
+
+  auto worker = [&](uint32_t workerId)
+  {
+    for (size_t i = nextFile.fetch_add(1); i < collectedFiles.size(); i = nextFile.fetch_add(1))
+    {
+      std::ostringstream log;
+      (void)collectExtent(collectedFiles[i].second, collectedFiles[i].first, extentRows,
+                          workerExtents[workerId], workerSystemExtents[workerId], log);
+
+      if (doVerbose() && log.tellp() > 0)
+      {
+        std::lock_guard<std::mutex> lk(logMutex);
+        std::cout << log.str();
+      }
+    }
+  };
+
+  if (workersCount == 1)
+  {
+    worker(0);
+  }
+  else
+  {
+    std::vector<std::thread> workers;
+    workers.reserve(workersCount);
+    for (uint32_t workerId = 0; workerId < workersCount; ++workerId)
+      workers.emplace_back(worker, workerId);
+
+    for (auto& thread : workers)
+      thread.join();
+  }
+
+  // Merge the results in bulk, `rebuildExtentMap` sorts them by LBID anyway.
+  for (uint32_t workerId = 0; workerId < workersCount; ++workerId)
   {
-    (void)collectExtent(fileName);
+    extentMap.insert(extentMap.end(), workerExtents[workerId].begin(), workerExtents[workerId].end());
+    systemExtentMap.insert(systemExtentMap.end(), workerSystemExtents[workerId].begin(),
+                           workerSystemExtents[workerId].end());
   }
 
+  collectedFiles.clear();
   return 0;
 }
 
-int32_t EMReBuilder::collectExtent(const std::string& fullFileName)
+int32_t EMReBuilder::collectExtent(const std::string& fullFileName, uint32_t fileDBRoot,
+                                   uint32_t extentRows, std::vector<FileId>& extents,
+                                   std::vector<FileId>& systemExtents, std::ostream& log)
 {
   WriteEngine::FileOp fileOp;
   uint32_t oid;
@@ -160,9 +226,9 @@ int32_t EMReBuilder::collectExtent(const std::string& fullFileName)
 
     if (doVerbose())
     {
-      std::cout << "Processing file: " << fullFileName << std::endl;
-      std::cout << "fileName2Oid:  [OID: " << oid << ", partition: " << partition << ", segment: " << segment
-                << "] " << std::endl;
+      log << "Processing file: " << fullFileName << std::endl;
+      log << "fileName2Oid:  [OID: " << oid << ", partition: " << partition << ", segment: " << segment
+          << "] " << std::endl;
     }
 
     // Read the `colDataType` and `colWidth` from the given header.
@@ -186,7 +252,7 @@ int32_t EMReBuilder::collectExtent(const std::string& fullFileName)
     if (colDataType == execplan::CalpontSystemCatalog::UNDEFINED)
     {
       if (doVerbose())
-        std::cout << "File header has invalid data. " << std::endl;
+        log << "File header has invalid data. " << std::endl;
 
       return -1;
     }
@@ -197,51 +263,51 @@ int32_t EMReBuilder::collectExtent(const std::string& fullFileName)
 
     if (doVerbose())
     {
-      std::cout << "Searching for HWM... " << std::endl;
-      std::cout << "Block count: " << blockCount << std::endl;
+      log << "Searching for HWM... " << std::endl;
+      log << "Block count: " << blockCount << std::endl;
     }
 
     uint64_t hwm = 0;
-    rc = searchHWMInSegmentFile(fullFileName, oid, getDBRoot(), partition, segment, colDataType, colWidth,
+    rc = searchHWMInSegmentFile(fullFileName, oid, fileDBRoot, partition, segment, colDataType, colWidth,
                                 blockCount, isDict, compressionType, hwm);
 
     if (rc != 0)
       return rc;
 
     if (doVerbose())
-      std::cout << "HWM is: " << hwm << std::endl;
+      log << "HWM is: " << hwm << std::endl;
 
-    const uint32_t extentMaxBlockCount = getEM().getExtentRows() * colWidth / BLOCK_SIZE;
+    const uint32_t extentMaxBlockCount = extentRows * colWidth / BLOCK_SIZE;
     // We found multiple extents per one segment file.
     if (hwm >= extentMaxBlockCount)
     {
       for (uint32_t lbidIndex = 0; lbidIndex < lbidCount - 1; ++lbidIndex)
       {
         auto lbid = compress::CompressInterface::getLBIDByIndex(fileHeader, lbidIndex);
-        FileId fileId(oid, partition, segment, getDBRoot(), colWidth, colDataType, lbid, /*hwm*/ 0, isDict);
-        extentMap.push_back(fileId);
+        FileId fileId(oid, partition, segment, fileDBRoot, colWidth, colDataType, lbid, /*hwm*/ 0, isDict);
+        extents.push_back(fileId);
       }
 
       // Last one has an actual HWM.
       auto lbid = compress::CompressInterface::getLBIDByIndex(fileHeader, lbidCount - 1);
-      FileId fileId(oid, partition, segment, getDBRoot(), colWidth, colDataType, lbid, hwm, isDict);
-      extentMap.push_back(fileId);
+      FileId fileId(oid, partition, segment, fileDBRoot, colWidth, colDataType, lbid, hwm, isDict);
+      extents.push_back(fileId);
 
       if (doVerbose())
       {
-        std::cout << "Found multiple extents per segment file " << std::endl;
-        std::cout << "FileId is collected " << fileId << std::endl;
+        log << "Found multiple extents per segment file " << std::endl;
+        log << "FileId is collected " << fileId << std::endl;
       }
     }
     else
     {
       // One extent per segment file.
       auto lbid = compress::CompressInterface::getLBIDByIndex(fileHeader, 0);
-      FileId fileId(oid, partition, segment, getDBRoot(), colWidth, colDataType, lbid, hwm, isDict);
-      extentMap.push_back(fileId);
+      FileId fileId(oid, partition, segment, fileDBRoot, colWidth, colDataType, lbid, hwm, isDict);
+      extents.push_back(fileId);
 
       if (doVerbose())
-        std::cout << "FileId is collected " << fileId << std::endl;
+        log << "FileId is collected " << fileId << std::endl;
     }
   }
   else
@@ -256,13 +322,14 @@ int32_t EMReBuilder::collectExtent(const std::string& fullFileName)
     const uint64_t blockCount = fileSize / BLOCK_SIZE;
     if (doVerbose())
     {
-      std::cout << "Searching for HWM for system catalog file..." << std::endl;
-      std::cout << "Block count: " << blockCount << std::endl;
+      log << "Searching for HWM for system catalog file..." << std::endl;
+      log << "Block count: " << blockCount << std::endl;
     }
 
     auto it = systemCatalogMap.find(oid);
     if (it == systemCatalogMap.end())
     {
+      std::lock_guard<std::mutex> lk(logMutex);
       std::cout << "Cannot find a system extent for OID: " << oid << std::endl;
       std::cout << "Continuing..." << std::endl;
       return 0;
@@ -270,18 +337,18 @@ int32_t EMReBuilder::collectExtent(const std::string& fullFileName)
 
     FileId systemFileId = it->second;
     uint64_t hwm = 0;
-    rc = searchHWMInSegmentFile(fullFileName, oid, getDBRoot(), systemFileId.partition, systemFileId.segment,
+    rc = searchHWMInSegmentFile(fullFileName, oid, fileDBRoot, systemFileId.partition, systemFileId.segment,
                                 systemFileId.colDataType, systemFileId.colWidth, blockCount,
                                 systemFileId.isDict, 0 /*=compressionType*/, hwm);
     if (rc != 0)
       return rc;
 
     if (doVerbose())
-      std::cout << "HWM is: " << hwm << std::endl;
+      log << "HWM is: " << hwm << std::endl;
 
     systemFileId.hwm = hwm;
-    systemFileId.dbroot = getDBRoot();
-    systemExtentMap.push_back(systemFileId);
+    systemFileId.dbroot = fileDBRoot;
+    systemExtents.push_back(systemFileId);
   }
 
   return 0;
@@ -19,6 +19,10 @@
 
 #include <string>
 #include <map>
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
 #include <ftw.h>
 
 #include "calpontsystemcatalog.h"
@@ -70,15 +74,22 @@ std::ostream& operator<<(std::ostream& os, const FileId& fileID);
 class EMReBuilder
 {
  public:
-  EMReBuilder(bool verbose, bool display) : verbose(verbose), display(display)
+  EMReBuilder(bool verbose, bool display, uint32_t threadCount = 1)
+   : verbose(verbose), display(display), threadCount(threadCount ? threadCount : 1)
   {
     // Initalize plugins.
     IDBPolicy::configIDBPolicy();
   }
   ~EMReBuilder() = default;
 
-  // Collects extents from the given DBRoot path.
-  int32_t collectExtents(const std::string& dbRootPath);
+  // Collects segment file names from the given DBRoot path and queues them
+  // for `collectExtents` with the current DBRoot number.
+  int32_t collectFiles(const std::string& dbRootPath);
+
+  // Collects extents from all queued segment files. Files are processed by
+  // `threadCount` workers, every worker accumulates its own extents which are
+  // merged once all the files are processed.
+  int32_t collectExtents();
 
   // Collects file names for the given `partialPath` direcotory.
   void collectFileNames(const std::string& partialPath, std::string currentPath,
@@ -88,6 +99,8 @@ class EMReBuilder
   void clear()
   {
     extentMap.clear();
+    systemExtentMap.clear();
+    collectedFiles.clear();
   }
 
   // Specifies whether we need verbose to output.
@@ -103,6 +116,24 @@ class EMReBuilder
     return display;
   }
 
+  // Returns the number of threads used to collect extents.
+  uint32_t getThreadCount() const
+  {
+    return threadCount;
+  }
+
+  // Returns the extents collected from the column and dictionary segment files.
+  const std::vector<FileId>& getExtents() const
+  {
+    return extentMap;
+  }
+
+  // Returns the extents collected from the system catalog segment files.
+  const std::vector<FileId>& getSystemExtents() const
+  {
+    return systemExtentMap;
+  }
+
   // Returns the number of current DBRoot.
   uint32_t getDBRoot() const
   {
@@ -152,14 +183,21 @@ class EMReBuilder
   EMReBuilder& operator=(EMReBuilder&&) = delete;
 
   // Collects the information for extent from the given file and stores
-  // it in `extentMap` set.
-  int32_t collectExtent(const std::string& fullFileName);
+  // it in `extents` or `systemExtents`. Verbose output goes to `log`, so
+  // messages from different workers do not interleave.
+  int32_t collectExtent(const std::string& fullFileName, uint32_t fileDBRoot, uint32_t extentRows,
+                        std::vector<FileId>& extents, std::vector<FileId>& systemExtents,
+                        std::ostream& log);
   bool verbose;
   bool display;
+  uint32_t threadCount;
   uint32_t dbRoot;
   BRM::ExtentMap em;
   std::vector<FileId> systemExtentMap;
   std::vector<FileId> extentMap;
+  // Pairs of DBRoot number and full file name.
+  std::vector<std::pair<uint32_t, std::string>> collectedFiles;
+  std::mutex logMutex;
 };
 
 // The base class aroud `ChunkManager` to read and write decompressed blocks
@@ -0,0 +1,138 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "collation.h"
+
+namespace utils
+{
+/** @brief Bloom filter of the strings of a dictionary store segment file.
+ *
+ * The CP range of a dictionary column only covers an 8 byte prefix of the strings, so an
+ * equality filter never eliminates an extent of long strings that share it. WriteEngine
+ * sets the bits of every string it adds to a store file in a file next to it and PrimProc
+ * skips the token column blocks of the segment when none of the strings an equality filter
+ * looks for is in there.
+ *
+ * Bits are never cleared, the strings rolled back or no longer referenced only make false
+ * positives. A filter is started together with an empty store file, the store files that
+ * got strings before have no valid filter. The hashes follow the collation of the column so
+ * the strings equal under it set the same bits.
+ *
+ * The filter gets BITS_PER_STRING bits for every string the store file is expected to hold,
+ * rounded up to a power of 2, and its size is kept in the header.
+ */
+class DictBloomFilter
+{
+ public:
+  static const uint32_t HEADER_LEN = 4096;
+  static const uint32_t BITS_PER_STRING = 10;
+  static const uint32_t MIN_FILTER_BYTES = 4096;
+  static const uint32_t MAX_FILTER_BYTES = 4 * 1024 * 1024;
+  static const uint32_t HASH_COUNT = 3;
+  static const uint32_t VERSION = 2;
+
+  struct Header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t charsetNumber;  // collation of the hashes
+    uint32_t valid;
+    uint32_t filterBytes;  // size of the filter after the header
+  };
+
+  static std::string fileName(const std::string& storeFileName)
+  {
+    return storeFileName + ".bloom";
+  }
+
+  // Size of the filter of a store file expected to hold the given number of strings
+  static uint32_t filterBytes(uint64_t expectedStrings)
+  {
+    uint64_t bytes = (expectedStrings * BITS_PER_STRING + 7) / 8;
+    uint32_t filterBytes = MIN_FILTER_BYTES;
+
+    while (filterBytes < bytes && filterBytes < MAX_FILTER_BYTES)
+      filterBytes *= 2;
+
+    return filterBytes;
+  }
+
+  static void initHeader(Header& header, uint32_t charsetNumber, uint32_t filterBytes, bool valid)
+  {
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.charsetNumber = charsetNumber;
+    header.valid = valid ? 1 : 0;
+    header.filterBytes = filterBytes;
+  }
+
+  static bool isValid(const Header& header)
+  {
+    return std::memcmp(header.magic, MAGIC, sizeof(header.magic)) == 0 && header.version == VERSION &&
+           header.valid == 1 && header.filterBytes >= MIN_FILTER_BYTES &&
+           header.filterBytes <= MAX_FILTER_BYTES && (header.filterBytes & (header.filterBytes - 1)) == 0;
+  }
+
+  static uint32_t hash(const datatypes::Charset& cs, const char* str, size_t len)
+  {
+    return cs.hash(str, len);
+  }
+
+  // The bits of a string in a filter of filterBytes, double hashing with the remixed hash as the step
+  static void bits(uint32_t hash, uint32_t filterBytes, uint32_t (&bits)[HASH_COUNT])
+  {
+    uint32_t step = hash;
+    step ^= step >> 16;
+    step *= 0x85ebca6b;
+    step ^= step >> 13;
+    step *= 0xc2b2ae35;
+    step ^= step >> 16;
+    step |= 1;
+
+    for (uint32_t i = 0; i < HASH_COUNT; i++)
+      bits[i] = (hash + i * step) & (filterBytes * 8 - 1);
+  }
+
+  static void set(uint8_t* filter, uint32_t bit)
+  {
+    filter[bit >> 3] |= 1 << (bit & 7);
+  }
+
+  // byte is the byte of the filter holding the bit
+  static bool test(uint8_t byte, uint32_t bit)
+  {
+    return (byte & (1 << (bit & 7))) != 0;
+  }
+
+  // Offset of the byte holding the bit in the filter file
+  static uint64_t offset(uint32_t bit)
+  {
+    return HEADER_LEN + (bit >> 3);
+  }
+
+ private:
+  static constexpr const char* MAGIC = "MCSBLOOM";
+};
+
+}  // namespace utils
@@ -0,0 +1,200 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "collation.h"
+
+namespace utils
+{
+/** @brief Trigram signatures of the blocks of a dictionary store segment file.
+ *
+ * WriteEngine sets a bit for every trigram of the bytes it stores in a block, the signature
+ * of the block with file block offset fbo is at offset(fbo) of a file next to the store file.
+ * A dictionary scan of LIKE '%foo%' skips the blocks whose signatures miss a trigram of the
+ * literal parts of the pattern.
+ *
+ * With a _bin collation the trigrams are the bytes. Otherwise they are ASCII case folded and
+ * a block that gets a string with other than printable ASCII bytes has all the bits set, the
+ * collation may match such strings to a pattern they don't contain. Only the collations of
+ * the charsets whose multibyte characters have no ASCII bytes are supported.
+ *
+ * As with DictBloomFilter bits are never cleared and an index is started together with an
+ * empty store file.
+ */
+class DictNgramIndex
+{
+ public:
+  static const uint32_t HEADER_LEN = 4096;
+  static const uint32_t SIGNATURE_BYTES = 512;
+  static const uint32_t SIGNATURE_SHIFT = 12;  // SIGNATURE_BYTES * 8 == 1 << SIGNATURE_SHIFT
+  static const uint32_t VERSION = 1;
+
+  struct Header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t charsetNumber;  // collation the trigrams are folded with
+    uint32_t valid;
+  };
+
+  static std::string fileName(const std::string& storeFileName)
+  {
+    return storeFileName + ".ngram";
+  }
+
+  static void initHeader(Header& header, uint32_t charsetNumber, bool valid)
+  {
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.charsetNumber = charsetNumber;
+    header.valid = valid ? 1 : 0;
+  }
+
+  static bool isValid(const Header& header)
+  {
+    return std::memcmp(header.magic, MAGIC, sizeof(header.magic)) == 0 && header.version == VERSION &&
+           header.valid == 1;
+  }
+
+  static bool supported(const CHARSET_INFO& cs)
+  {
+    return cs.mbmaxlen == 1 || (cs.mbminlen == 1 && std::strncmp(cs.cs_name.str, "utf8", 4) == 0);
+  }
+
+  // The collation matches the bytes themselves
+  static bool exact(const CHARSET_INFO& cs)
+  {
+    return (cs.state & MY_CS_BINSORT) != 0;
+  }
+
+  // Offset of the signature of a store file block in the index file
+  static uint64_t offset(uint32_t fbo)
+  {
+    return HEADER_LEN + uint64_t(fbo) * SIGNATURE_BYTES;
+  }
+
+  // Adds the trigrams of bytes stored in a block to its signature
+  static void add(uint8_t* signature, const uint8_t* str, size_t len, bool exact)
+  {
+    if (!exact)
+    {
+      for (size_t i = 0; i < len; i++)
+      {
+        if (!printable(str[i]))
+        {
+          std::memset(signature, 0xff, SIGNATURE_BYTES);
+          return;
+        }
+      }
+    }
+
+    for (size_t i = 0; i + 2 < len; i++)
+    {
+      uint32_t bit = trigramBit(str + i, exact);
+      signature[bit >> 3] |= 1 << (bit & 7);
+    }
+  }
+
+  /** @brief The bits of the trigrams every string matching a LIKE pattern contains.
+   *
+   * The pattern uses '\' as the escape character as Charset::like() does.
+   * @return false if the pattern has no usable trigram
+   */
+  static bool patternBits(const char* pattern, size_t len, bool exact, std::vector<uint32_t>& bits)
+  {
+    std::string run;
+    auto addRun = [&]()
+    {
+      for (size_t i = 0; i + 2 < run.length(); i++)
+        bits.push_back(trigramBit(reinterpret_cast<const uint8_t*>(run.data()) + i, exact));
+
+      run.clear();
+    };
+
+    bits.clear();
+
+    for (size_t i = 0; i < len; i++)
+    {
+      uint8_t c = pattern[i];
+
+      if (c == '%' || c == '_')
+      {
+        addRun();
+        continue;
+      }
+
+      if (c == '\\' && i + 1 < len)
+        c = pattern[++i];
+
+      if (!exact && !printable(c))
+      {
+        addRun();
+        continue;
+      }
+
+      run.push_back(c);
+    }
+
+    addRun();
+    return !bits.empty();
+  }
+
+  static bool mayMatch(const uint8_t* signature, const std::vector<uint32_t>& bits)
+  {
+    for (auto bit : bits)
+    {
+      if ((signature[bit >> 3] & (1 << (bit & 7))) == 0)
+        return false;
+    }
+
+    return true;
+  }
+
+ private:
+  static bool printable(uint8_t c)
+  {
+    return c >= 0x20 && c < 0x7f;
+  }
+
+  static uint32_t trigramBit(const uint8_t* trigram, bool exact)
+  {
+    uint32_t value = 0;
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+      uint8_t c = trigram[i];
+
+      if (!exact && c >= 'A' && c <= 'Z')
+        c += 'a' - 'A';
+
+      value = (value << 8) | c;
+    }
+
+    return (value * 2654435761U) >> (32 - SIGNATURE_SHIFT);
+  }
+
+  static constexpr const char* MAGIC = "MCSNGRAM";
+};
+
+}  // namespace utils
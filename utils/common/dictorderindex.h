@@ -0,0 +1,414 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "collation.h"
+
+namespace utils
+{
+/** @brief Order preserving codes of the strings of a dictionary store segment file.
+ *
+ * The distinct strings of a store file are numbered in the order of the collation of the
+ * column, the strings equal under it get consecutive codes. A file next to the store file
+ * holds the strings by code and the code of the string of every token. The strings an EQ,
+ * LT, LE, GT or GE comparison matches then have a range of codes found with two binary
+ * searches, and PrimProc filters the tokens of a column by their codes instead of reading
+ * their strings from the store file.
+ *
+ * As with DictBloomFilter an index is started together with an empty store file, see
+ * DictOrderIndexWriter. Only low cardinality store files get one, and strings that span
+ * blocks are not in the index: PrimProc reads the strings of the tokens it has no code for.
+ *
+ * Index file:
+ *   Header
+ *   uint32_t offsets of the strings in the string bytes, stringCount + 1 of them
+ *   the string bytes, by code
+ *   TokenCode tokenCount of them, sorted by token
+ */
+class DictOrderIndex
+{
+ public:
+  static const uint32_t VERSION = 1;
+  // WriteEngine keeps the strings and tokens in memory while the store file is open
+  static const uint32_t MAX_STRINGS = 4096;
+  static const uint32_t MAX_TOKENS = 16384;
+  static const uint64_t MAX_STRING_BYTES = 1024 * 1024;
+
+  struct Header
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t charsetNumber;  // collation of the order
+    uint32_t valid;
+    uint32_t stringCount;
+    uint32_t tokenCount;
+    uint32_t unused;
+    uint64_t stringBytes;
+    uint64_t generation;  // when the file was written, tells it from the one written before
+  };
+
+  struct TokenCode
+  {
+    uint64_t token;
+    uint32_t code;
+    uint32_t unused;
+  };
+
+  static std::string fileName(const std::string& storeFileName)
+  {
+    return storeFileName + ".order";
+  }
+
+  static void initHeader(Header& header, uint32_t charsetNumber, bool valid)
+  {
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.charsetNumber = charsetNumber;
+    header.valid = valid ? 1 : 0;
+  }
+
+  static bool isValid(const Header& header)
+  {
+    return std::memcmp(header.magic, MAGIC, sizeof(header.magic)) == 0 && header.version == VERSION &&
+           header.valid == 1 && header.stringCount <= MAX_STRINGS && header.tokenCount <= MAX_TOKENS &&
+           header.stringBytes <= MAX_STRING_BYTES;
+  }
+
+  // Length of the index file after the header
+  static uint64_t bodyLength(const Header& header)
+  {
+    return (uint64_t(header.stringCount) + 1) * sizeof(uint32_t) + header.stringBytes +
+           uint64_t(header.tokenCount) * sizeof(TokenCode);
+  }
+
+  DictOrderIndex() : offsets(1, 0), fileGeneration(0)
+  {
+  }
+
+  /** @brief Numbers the strings in the order of the collation.
+   *
+   * @param tokens the tokens with the position of their string in strings
+   */
+  void build(const datatypes::Charset& cs, const std::vector<std::string>& strings,
+             const std::vector<std::pair<uint64_t, uint32_t>>& tokens)
+  {
+    std::vector<uint32_t> order(strings.size());
+    std::vector<uint32_t> codes(strings.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](uint32_t a, uint32_t b) { return cs.strnncollsp(strings[a], strings[b]) < 0; });
+
+    offsets.assign(1, 0);
+    bytes.clear();
+
+    for (uint32_t code = 0; code < order.size(); code++)
+    {
+      codes[order[code]] = code;
+      bytes.append(strings[order[code]]);
+      offsets.push_back(bytes.length());
+    }
+
+    tokenCodes.clear();
+
+    for (const auto& token : tokens)
+      tokenCodes.push_back(TokenCode{token.first, codes[token.second], 0});
+
+    std::sort(tokenCodes.begin(), tokenCodes.end(),
+              [](const TokenCode& a, const TokenCode& b) { return a.token < b.token; });
+  }
+
+  // The index file with a valid header
+  void serialize(uint32_t charsetNumber, uint64_t generation, std::string& out) const
+  {
+    Header header;
+    initHeader(header, charsetNumber, true);
+    header.stringCount = size();
+    header.tokenCount = tokenCodes.size();
+    header.stringBytes = bytes.length();
+    header.generation = generation;
+
+    out.assign(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.append(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint32_t));
+    out.append(bytes);
+    out.append(reinterpret_cast<const char*>(tokenCodes.data()), tokenCodes.size() * sizeof(TokenCode));
+  }
+
+  /** @brief Reads the index from the file.
+   *
+   * @param body the file after the header, bodyLength(header) bytes
+   * @return false if the index is not consistent
+   */
+  bool deserialize(const Header& header, const char* body, size_t len)
+  {
+    if (len != bodyLength(header))
+      return false;
+
+    offsets.resize(header.stringCount + 1);
+    std::memcpy(offsets.data(), body, offsets.size() * sizeof(uint32_t));
+    body += offsets.size() * sizeof(uint32_t);
+
+    if (offsets[0] != 0 || offsets.back() != header.stringBytes ||
+        !std::is_sorted(offsets.begin(), offsets.end()))
+      return false;
+
+    bytes.assign(body, header.stringBytes);
+    body += header.stringBytes;
+
+    tokenCodes.resize(header.tokenCount);
+    std::memcpy(tokenCodes.data(), body, tokenCodes.size() * sizeof(TokenCode));
+
+    for (size_t i = 0; i < tokenCodes.size(); i++)
+    {
+      if (tokenCodes[i].code >= size() || (i > 0 && tokenCodes[i - 1].token >= tokenCodes[i].token))
+        return false;
+    }
+
+    fileGeneration = header.generation;
+    return true;
+  }
+
+  uint32_t size() const
+  {
+    return offsets.size() - 1;
+  }
+
+  uint64_t generation() const
+  {
+    return fileGeneration;
+  }
+
+  // Bytes of memory the index takes
+  uint64_t getMemUsage() const
+  {
+    return sizeof(*this) + offsets.capacity() * sizeof(uint32_t) + bytes.capacity() +
+           tokenCodes.capacity() * sizeof(TokenCode);
+  }
+
+  // The codes of the tokens, sorted by token
+  const std::vector<TokenCode>& tokens() const
+  {
+    return tokenCodes;
+  }
+
+  ConstString string(uint32_t code) const
+  {
+    return ConstString(bytes.data() + offsets[code], offsets[code + 1] - offsets[code]);
+  }
+
+  // The first code of the strings not less than str under the collation
+  uint32_t lowerBound(const datatypes::Charset& cs, const ConstString& str) const
+  {
+    return bound(cs, str, false);
+  }
+
+  // The first code of the strings greater than str under the collation
+  uint32_t upperBound(const datatypes::Charset& cs, const ConstString& str) const
+  {
+    return bound(cs, str, true);
+  }
+
+  // The tokens of the strings stored in a block, [first, last)
+  std::pair<const TokenCode*, const TokenCode*> blockTokens(uint64_t lbid) const
+  {
+    auto less = [](const TokenCode& a, uint64_t token) { return a.token < token; };
+    const TokenCode* begin = tokenCodes.data();
+    const TokenCode* end = begin + tokenCodes.size();
+    const TokenCode* first = std::lower_bound(begin, end, lbid << 10, less);
+    return std::make_pair(first, std::lower_bound(first, end, (lbid + 1) << 10, less));
+  }
+
+  static bool find(const TokenCode* first, const TokenCode* last, uint64_t token, uint32_t& code)
+  {
+    const TokenCode* it = std::lower_bound(first, last, token,
+                                           [](const TokenCode& a, uint64_t t) { return a.token < t; });
+
+    if (it == last || it->token != token)
+      return false;
+
+    code = it->code;
+    return true;
+  }
+
+ private:
+  uint32_t bound(const datatypes::Charset& cs, const ConstString& str, bool upper) const
+  {
+    uint32_t first = 0;
+    uint32_t count = size();
+
+    while (count > 0)
+    {
+      uint32_t step = count / 2;
+      int cmp = cs.strnncollsp(string(first + step), str);
+
+      if (cmp < 0 || (upper && cmp == 0))
+      {
+        first += step + 1;
+        count -= step + 1;
+      }
+      else
+        count = step;
+    }
+
+    return first;
+  }
+
+  static constexpr const char* MAGIC = "MCSORDER";
+
+  std::vector<uint32_t> offsets;
+  std::string bytes;
+  std::vector<TokenCode> tokenCodes;
+  uint64_t fileGeneration;
+};
+
+/** @brief The strings WriteEngine adds to a store file, kept to write its order index.
+ *
+ * The first string added makes the index file of the store file stale, the caller removes
+ * it. Only the strings of a store file started empty are kept: the index of a store file
+ * opened with strings is dropped rather than read back and written anew, DML adds a few
+ * strings at a time. The strings are dropped too once there are too many of them or one of
+ * another collation is added.
+ */
+class DictOrderIndexWriter
+{
+ public:
+  DictOrderIndexWriter() : indexing(false), added(false), charsetNumber(0), stringBytes(0)
+  {
+  }
+
+  // newStoreFile: the store file has no strings yet
+  void open(bool newStoreFile)
+  {
+    clear();
+    indexing = newStoreFile;
+  }
+
+  void clear()
+  {
+    drop();
+    added = false;
+    charsetNumber = 0;
+  }
+
+  // No index is written for the strings added
+  void drop()
+  {
+    indexing = false;
+    stringBytes = 0;
+    strings.clear();
+    ids.clear();
+    tokenIds.clear();
+  }
+
+  /** @brief Keeps the string of a token added to the store file.
+   *
+   * @param str the string, NULL for a string that spans blocks
+   * @return true for the first string added since open() or written(), the index file has
+   *         to be removed before the string is in the store file
+   */
+  bool add(uint64_t token, uint32_t strCharsetNumber, const char* str, size_t len)
+  {
+    const bool first = !added;
+    added = true;
+
+    if (!indexing)
+      return first;
+
+    if (charsetNumber == 0)
+      charsetNumber = strCharsetNumber;
+
+    // Strings of another collation would be out of order
+    if (strCharsetNumber == 0 || strCharsetNumber != charsetNumber)
+    {
+      drop();
+      return first;
+    }
+
+    if (str == nullptr)
+      return first;
+
+    std::string value(str, len);
+    auto it = ids.find(value);
+
+    if (it == ids.end())
+    {
+      if (strings.size() >= DictOrderIndex::MAX_STRINGS ||
+          stringBytes + len > DictOrderIndex::MAX_STRING_BYTES)
+      {
+        drop();
+        return first;
+      }
+
+      it = ids.insert(std::make_pair(value, (uint32_t)strings.size())).first;
+      strings.push_back(value);
+      stringBytes += len;
+    }
+
+    // A token rolled back and given to another string gets the new one
+    tokenIds[token] = it->second;
+
+    if (tokenIds.size() > DictOrderIndex::MAX_TOKENS)
+      drop();
+
+    return first;
+  }
+
+  // Strings were added since the index file was written, and they can be indexed
+  bool changed() const
+  {
+    return added && indexing;
+  }
+
+  // The index file is written, the next string added makes it stale
+  void written()
+  {
+    added = false;
+  }
+
+  uint32_t collation() const
+  {
+    return charsetNumber;
+  }
+
+  void build(DictOrderIndex& index) const
+  {
+    std::vector<std::pair<uint64_t, uint32_t>> tokens(tokenIds.begin(), tokenIds.end());
+    index.build(datatypes::Charset(charsetNumber), strings, tokens);
+  }
+
+ private:
+  bool indexing;                                  // the strings added are kept
+  bool added;                                     // strings were added since the index file was written
+  uint32_t charsetNumber;                         // collation of the order
+  uint64_t stringBytes;                           // length of strings
+  std::vector<std::string> strings;               // the distinct strings
+  std::unordered_map<std::string, uint32_t> ids;  // position of a string in strings
+  std::map<uint64_t, uint32_t> tokenIds;          // position of the string of a token
+};
+
+}  // namespace utils
@@ -0,0 +1,246 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#pragma once
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace utils
+{
+inline void futexWait(std::atomic<uint32_t>& word, uint32_t expected)
+{
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+inline void futexWakeAll(std::atomic<uint32_t>& word)
+{
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+}
+
+/** @brief Lock-free multi-producer single-consumer ring with an unbounded overflow.
+ *
+ * Every slot carries a sequence number that tells whether it is free for the producer
+ * that claimed the position or already published for the consumer, so producers only
+ * contend on one fetch-and-add-like CAS and the consumer never takes a lock. Producers
+ * never block: when the ring is full they append to a mutex protected overflow queue,
+ * so a slow consumer makes the exchange fall back to the locked queue it replaced
+ * instead of stalling the senders. The consumer spins briefly and then sleeps on a
+ * futex, a wakeup syscall is only made when it is known to sleep.
+ * Elements from one producer are popped in the order they were pushed.
+ */
+template <typename T>
+class MPSCRing
+{
+ public:
+  // capacity is rounded up to a power of 2
+  explicit MPSCRing(size_t capacity)
+  {
+    size_t cap = 2;
+
+    while (cap < capacity)
+      cap <<= 1;
+
+    mask_ = cap - 1;
+    slots_.reset(new Slot[cap]);
+
+    for (size_t i = 0; i < cap; ++i)
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+  }
+
+  MPSCRing(const MPSCRing&) = delete;
+  MPSCRing& operator=(const MPSCRing&) = delete;
+
+  size_t capacity() const
+  {
+    return mask_ + 1;
+  }
+
+  // Thread-safe. Never blocks, goes to the overflow queue while the ring is full.
+  void push(T value)
+  {
+    // Once an element has overflowed the later ones follow it until the consumer has taken
+    // it, otherwise they could pass it in the ring.
+    if (overflowSize_.load(std::memory_order_acquire) != 0 || !tryPushToRing(value))
+    {
+      std::lock_guard<std::mutex> lk(overflowMutex_);
+      overflow_.push_back(std::move(value));
+      overflowSize_.fetch_add(1, std::memory_order_release);
+    }
+
+    wake(dataEpoch_, consumerSleeping_);
+  }
+
+  // The number of the elements pushed to the overflow queue and not popped yet.
+  size_t overflowSize() const
+  {
+    return overflowSize_.load(std::memory_order_relaxed);
+  }
+
+  // Consumer only. Moves all the published elements into `out` and returns their number.
+  size_t tryPopAll(std::vector<T>& out)
+  {
+    // Take the overflow before draining the ring: the ring elements of a producer pushed
+    // before its overflowed ones were published by then, and it pushes nothing to the ring
+    // until we release them.
+    if (overflowed_.empty() && overflowSize_.load(std::memory_order_acquire) != 0)
+    {
+      std::lock_guard<std::mutex> lk(overflowMutex_);
+      overflowed_.swap(overflow_);
+    }
+
+    size_t popped = 0;
+
+    for (;;)
+    {
+      Slot& slot = slots_[tail_ & mask_];
+
+      if (slot.seq.load(std::memory_order_acquire) != tail_ + 1)
+        break;
+
+      out.push_back(std::move(slot.value));
+      slot.value = T();
+      slot.seq.store(tail_ + mask_ + 1, std::memory_order_release);
+      ++tail_;
+      ++popped;
+    }
+
+    // A slot claimed and not published yet stops the drain, the elements after it may come
+    // before the overflowed ones of their producers. The overflow waits for the next call.
+    if (!overflowed_.empty() && tail_ == head_.load(std::memory_order_acquire))
+    {
+      std::move(overflowed_.begin(), overflowed_.end(), std::back_inserter(out));
+      popped += overflowed_.size();
+      overflowSize_.fetch_sub(overflowed_.size(), std::memory_order_release);
+      overflowed_.clear();
+    }
+
+    return popped;
+  }
+
+  // Consumer only. Blocks until there is at least one element.
+  size_t popAll(std::vector<T>& out)
+  {
+    for (uint32_t spins = 0;; ++spins)
+    {
+      if (size_t popped = tryPopAll(out))
+        return popped;
+
+      if (spins >= SpinsBeforeSleep)
+        waitFor(dataEpoch_, consumerSleeping_,
+                [this]()
+                {
+                  // The overflow taken waits for a slot to be published
+                  return slots_[tail_ & mask_].seq.load(std::memory_order_acquire) == tail_ + 1 ||
+                         (overflowed_.empty() && overflowSize_.load(std::memory_order_acquire) != 0);
+                });
+    }
+  }
+
+ private:
+  static constexpr uint32_t SpinsBeforeSleep = 64;
+
+  struct Slot
+  {
+    std::atomic<uint64_t> seq;
+    T value;
+  };
+
+  // Moves from value only if it got a slot.
+  bool tryPushToRing(T& value)
+  {
+    uint64_t pos = head_.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    for (;;)
+    {
+      slot = &slots_[pos & mask_];
+      int64_t diff = (int64_t)slot->seq.load(std::memory_order_acquire) - (int64_t)pos;
+
+      if (diff == 0)
+      {
+        if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+          break;
+      }
+      else if (diff < 0)
+      {
+        // The ring is full: the consumer hasn't released this slot yet.
+        return false;
+      }
+      else
+      {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->value = std::move(value);
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // The sleeper announces itself first and re-checks the condition, the waker publishes its
+  // change first and checks for sleepers. The seq_cst fences on both sides guarantee at least
+  // one of them sees the other, so a wakeup is never lost.
+  template <typename Ready>
+  static void waitFor(std::atomic<uint32_t>& epoch, std::atomic<uint32_t>& sleeping, Ready ready)
+  {
+    uint32_t e = epoch.load(std::memory_order_relaxed);
+    sleeping.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (!ready())
+      futexWait(epoch, e);
+
+    sleeping.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  static void wake(std::atomic<uint32_t>& epoch, std::atomic<uint32_t>& sleeping)
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (sleeping.load(std::memory_order_relaxed) == 0)
+      return;
+
+    epoch.fetch_add(1, std::memory_order_relaxed);
+    futexWakeAll(epoch);
+  }
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_;
+
+  alignas(64) std::atomic<uint64_t> head_{0};
+  alignas(64) uint64_t tail_ = 0;
+  alignas(64) std::atomic<uint32_t> dataEpoch_{0};
+  std::atomic<uint32_t> consumerSleeping_{0};
+  alignas(64) std::atomic<size_t> overflowSize_{0};
+  std::mutex overflowMutex_;
+  std::deque<T> overflow_;
+  std::deque<T> overflowed_;  // consumer only, taken from overflow_ and not popped yet
+};
+
+}  // namespace utils
@@ -0,0 +1,557 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include "chunkencoding.h"
+
+namespace
+{
+enum BlockKind : uint8_t
+{
+  RAW = 0,
+  PACKED = 1,
+  DELTA = 2,
+  ALP = 3
+};
+
+const size_t CHUNK_HEADER_LEN = 5;
+const uint32_t BLOCK_SIZE = compress::ChunkEncoding::BLOCK_SIZE;
+const uint32_t MAX_PACKED_BITS = 56;  // the values are read 8 bytes at a time
+
+// The decimal scales of ALP, exact as doubles
+const double POW10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8, 1e9,
+                        1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+const double ALP_MAX_INT = 2251799813685248.0;  // 2^51, alpScale() converts smaller integers exactly
+const size_t ALP_SAMPLES = 32;
+
+// The floats stored in a column of integer width T
+template <typename T>
+struct FloatOf
+{
+};
+
+template <>
+struct FloatOf<int32_t>
+{
+  using type = float;
+  static const uint32_t MAX_EXPONENT = 10;
+};
+
+template <>
+struct FloatOf<int64_t>
+{
+  using type = double;
+  static const uint32_t MAX_EXPONENT = 18;
+};
+
+uint32_t bitsNeeded(uint64_t range)
+{
+  return range == 0 ? 0 : 64 - __builtin_clzll(range);
+}
+
+size_t packedLen(size_t count, uint32_t bits)
+{
+  return (count * bits + 7) / 8;
+}
+
+template <typename T>
+int64_t load(const char* p)
+{
+  T v;
+  std::memcpy(&v, p, sizeof(T));
+  return v;
+}
+
+template <typename T>
+void store(char* p, uint64_t v)
+{
+  T t = static_cast<T>(v);
+  std::memcpy(p, &t, sizeof(T));
+}
+
+// Packs the values minus ref in bits each
+void pack(const uint64_t* values, size_t count, uint64_t ref, uint32_t bits, char* out)
+{
+  std::memset(out, 0, packedLen(count, bits) + compress::ChunkEncoding::SLACK);
+
+  if (bits == 0)
+    return;
+
+  for (size_t i = 0, pos = 0; i < count; i++, pos += bits)
+  {
+    uint64_t word;
+    char* p = out + (pos >> 3);
+    std::memcpy(&word, p, sizeof(word));
+    word |= (values[i] - ref) << (pos & 7);
+    std::memcpy(p, &word, sizeof(word));
+  }
+}
+
+// Stores count values of T starting at out
+template <typename T, bool delta>
+void unpack(const char* in, size_t count, uint64_t first, uint64_t ref, uint32_t bits, char* out)
+{
+  const uint64_t mask = (uint64_t(1) << bits) - 1;
+  uint64_t prev = first;
+
+  for (size_t i = 0, pos = 0; i < count; i++, pos += bits)
+  {
+    uint64_t word;
+    std::memcpy(&word, in + (pos >> 3), sizeof(word));
+    uint64_t v = ref + ((word >> (pos & 7)) & mask);
+
+    if (delta)
+    {
+      prev += v;
+      v = prev;
+    }
+
+    store<T>(out + i * sizeof(T), v);
+  }
+}
+
+template <typename F>
+F alpDecode(int64_t n, uint32_t exponent)
+{
+  return static_cast<F>(double(n) / POW10[exponent]);
+}
+
+// The integer of the decimal digits of v, false if it does not decode to v
+template <typename F>
+bool alpEncode(F v, uint32_t exponent, int64_t& n)
+{
+  double scaled = double(v) * POW10[exponent];
+
+  if (!(std::fabs(scaled) < ALP_MAX_INT))
+    return false;
+
+  n = std::llrint(scaled);
+  F decoded = alpDecode<F>(n, exponent);
+  return std::memcmp(&decoded, &v, sizeof(F)) == 0;
+}
+
+// Stores the floats of count integers with |n| < 2^51 starting at out
+template <typename F>
+void alpScale(const int64_t* ints, size_t count, uint32_t exponent, char* out)
+{
+  size_t i = 0;
+#if defined(__x86_64__)
+  // The bits of 2^52 + 2^51 plus the integer are the double of the integer plus 2^52 + 2^51
+  const __m128d magic = _mm_set1_pd(6755399441055744.0);
+  const __m128d divisor = _mm_set1_pd(POW10[exponent]);
+
+  for (; i + 2 <= count; i += 2)
+  {
+    __m128i n = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ints + i));
+    __m128d d = _mm_sub_pd(_mm_castsi128_pd(_mm_add_epi64(n, _mm_castpd_si128(magic))), magic);
+    d = _mm_div_pd(d, divisor);
+
+    if constexpr (sizeof(F) == 8)
+      _mm_storeu_pd(reinterpret_cast<double*>(out + i * sizeof(F)), d);
+    else
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i * sizeof(F)), _mm_castps_si128(_mm_cvtpd_ps(d)));
+  }
+#elif defined(__aarch64__)
+  const float64x2_t divisor = vdupq_n_f64(POW10[exponent]);
+
+  for (; i + 2 <= count; i += 2)
+  {
+    float64x2_t d = vdivq_f64(vcvtq_f64_s64(vld1q_s64(ints + i)), divisor);
+
+    if constexpr (sizeof(F) == 8)
+      vst1q_f64(reinterpret_cast<double*>(out + i * sizeof(F)), d);
+    else
+      vst1_f32(reinterpret_cast<float*>(out + i * sizeof(F)), vcvt_f32_f64(d));
+  }
+#endif
+
+  for (; i < count; i++)
+  {
+    F v = alpDecode<F>(ints[i], exponent);
+    std::memcpy(out + i * sizeof(F), &v, sizeof(F));
+  }
+}
+
+/* ALP: the floats of a block as the integers of their decimal digits, scaled by
+ * the power of ten that leaves the fewest values of a sample out. The values
+ * out are exceptions stored as they are, their integers are the smallest one.
+ * Returns the length of the encoded block, 0 if it has no integer or they need
+ * too many bits.
+ */
+template <typename T>
+size_t alpAnalyze(const char* block, int64_t* ints, uint16_t* exceptions, size_t& exceptionCount,
+                  uint32_t& exponent, uint32_t& bits, int64_t& ref)
+{
+  using F = typename FloatOf<T>::type;
+  const size_t count = BLOCK_SIZE / sizeof(T);
+  auto value = [block](size_t i)
+  {
+    F v;
+    std::memcpy(&v, block + i * sizeof(F), sizeof(F));
+    return v;
+  };
+
+  size_t fewestMisses = ALP_SAMPLES + 1;
+  exponent = 0;
+
+  for (uint32_t e = 0; e <= FloatOf<T>::MAX_EXPONENT && fewestMisses > 0; e++)
+  {
+    size_t misses = 0;
+    int64_t n;
+
+    for (size_t i = 0; i < count; i += count / ALP_SAMPLES)
+      misses += alpEncode(value(i), e, n) ? 0 : 1;
+
+    if (misses < fewestMisses)
+    {
+      fewestMisses = misses;
+      exponent = e;
+    }
+  }
+
+  int64_t min = INT64_MAX, max = INT64_MIN;
+  exceptionCount = 0;
+
+  for (size_t i = 0; i < count; i++)
+  {
+    if (alpEncode(value(i), exponent, ints[i]))
+    {
+      min = ints[i] < min ? ints[i] : min;
+      max = ints[i] > max ? ints[i] : max;
+    }
+    else
+    {
+      exceptions[exceptionCount++] = i;
+    }
+  }
+
+  if (exceptionCount == count)
+    return 0;
+
+  for (size_t k = 0; k < exceptionCount; k++)
+    ints[exceptions[k]] = min;
+
+  ref = min;
+  bits = bitsNeeded(uint64_t(max) - uint64_t(min));
+
+  if (bits > MAX_PACKED_BITS)
+    return 0;
+
+  return 3 + sizeof(int64_t) + sizeof(uint16_t) + packedLen(count, bits) +
+         exceptionCount * (sizeof(uint16_t) + sizeof(T));
+}
+
+template <typename T>
+size_t encodeBlocks(const char* in, size_t inLen, bool floatValues, char* out, size_t outPos)
+{
+  const size_t count = BLOCK_SIZE / sizeof(T);
+  const size_t fullLen = inLen - inLen % BLOCK_SIZE;
+  // The values of a block, on the heap as they take 144KB for 1 byte values
+  std::unique_ptr<uint64_t[]> values(new uint64_t[count]);
+  std::unique_ptr<int64_t[]> ints(new int64_t[count]);
+  std::unique_ptr<uint16_t[]> exceptions(new uint16_t[count]);
+
+  for (size_t inPos = 0; inPos < fullLen; inPos += BLOCK_SIZE)
+  {
+    const char* block = in + inPos;
+    int64_t min, max, minDelta, maxDelta;
+    min = max = load<T>(block);
+    minDelta = INT64_MAX;
+    maxDelta = INT64_MIN;
+    values[0] = min;
+
+    for (size_t i = 1; i < count; i++)
+    {
+      int64_t v = load<T>(block + i * sizeof(T));
+      int64_t d = static_cast<int64_t>(uint64_t(v) - values[i - 1]);
+      values[i] = v;
+      min = v < min ? v : min;
+      max = v > max ? v : max;
+      minDelta = d < minDelta ? d : minDelta;
+      maxDelta = d > maxDelta ? d : maxDelta;
+    }
+
+    uint32_t bits = bitsNeeded(uint64_t(max) - uint64_t(min));
+    uint32_t deltaBits = bitsNeeded(uint64_t(maxDelta) - uint64_t(minDelta));
+    size_t packed = 2 + sizeof(int64_t) + packedLen(count, bits);
+    size_t deltaPacked = 2 + 2 * sizeof(int64_t) + packedLen(count - 1, deltaBits);
+    bool delta = deltaPacked < packed;
+
+    if (delta)
+    {
+      bits = deltaBits;
+      packed = deltaPacked;
+    }
+
+    if (bits > MAX_PACKED_BITS)
+      packed = 1 + BLOCK_SIZE;
+
+    if constexpr (sizeof(T) >= 4)
+    {
+      size_t exceptionCount;
+      uint32_t exponent, alpBits;
+      int64_t ref;
+      size_t alp = floatValues ? alpAnalyze<T>(block, ints.get(), exceptions.get(), exceptionCount, exponent,
+                                               alpBits, ref)
+                               : 0;
+
+      if (alp > 0 && alp < packed)
+      {
+        if (outPos + alp >= inLen)
+          return 0;
+
+        out[outPos++] = ALP;
+        out[outPos++] = alpBits;
+        out[outPos++] = exponent;
+        std::memcpy(out + outPos, &ref, sizeof(ref));
+        outPos += sizeof(ref);
+        uint16_t exceptionCount16 = exceptionCount;
+        std::memcpy(out + outPos, &exceptionCount16, sizeof(exceptionCount16));
+        outPos += sizeof(exceptionCount16);
+        pack(reinterpret_cast<const uint64_t*>(ints.get()), count, ref, alpBits, out + outPos);
+        outPos += packedLen(count, alpBits);
+        std::memcpy(out + outPos, exceptions.get(), exceptionCount * sizeof(uint16_t));
+        outPos += exceptionCount * sizeof(uint16_t);
+
+        for (size_t k = 0; k < exceptionCount; k++, outPos += sizeof(T))
+          std::memcpy(out + outPos, block + exceptions[k] * sizeof(T), sizeof(T));
+
+        continue;
+      }
+    }
+
+    if (packed >= 1 + BLOCK_SIZE)
+    {
+      if (outPos + 1 + BLOCK_SIZE >= inLen)
+        return 0;
+
+      out[outPos++] = RAW;
+      std::memcpy(out + outPos, block, BLOCK_SIZE);
+      outPos += BLOCK_SIZE;
+      continue;
+    }
+
+    if (outPos + packed >= inLen)
+      return 0;
+
+    out[outPos++] = delta ? DELTA : PACKED;
+    out[outPos++] = bits;
+
+    if (delta)
+    {
+      std::memcpy(out + outPos, &values[0], sizeof(int64_t));
+      outPos += sizeof(int64_t);
+      std::memcpy(out + outPos, &minDelta, sizeof(int64_t));
+      outPos += sizeof(int64_t);
+
+      // The differences replace the values, the first one is kept above
+      for (size_t i = count - 1; i > 0; i--)
+        values[i] -= values[i - 1];
+
+      pack(values.get() + 1, count - 1, minDelta, bits, out + outPos);
+      outPos += packedLen(count - 1, bits);
+    }
+    else
+    {
+      std::memcpy(out + outPos, &min, sizeof(int64_t));
+      outPos += sizeof(int64_t);
+      pack(values.get(), count, min, bits, out + outPos);
+      outPos += packedLen(count, bits);
+    }
+  }
+
+  if (outPos + inLen - fullLen >= inLen)
+    return 0;
+
+  std::memcpy(out + outPos, in + fullLen, inLen - fullLen);
+  return outPos + inLen - fullLen;
+}
+
+// Decodes the ALP block after its kind at inPos, moving inPos past it
+template <typename T>
+bool decodeAlpBlock(const char* in, size_t inLen, size_t& inPos, char* out)
+{
+  const size_t count = BLOCK_SIZE / sizeof(T);
+  const size_t headerLen = 2 + sizeof(int64_t) + sizeof(uint16_t);
+
+  if (inPos + headerLen > inLen)
+    return false;
+
+  uint32_t bits = static_cast<uint8_t>(in[inPos]);
+  uint32_t exponent = static_cast<uint8_t>(in[inPos + 1]);
+  uint64_t ref;
+  uint16_t exceptionCount;
+  std::memcpy(&ref, in + inPos + 2, sizeof(ref));
+  std::memcpy(&exceptionCount, in + inPos + 2 + sizeof(ref), sizeof(exceptionCount));
+  inPos += headerLen;
+
+  if (bits > MAX_PACKED_BITS || exponent > FloatOf<T>::MAX_EXPONENT || exceptionCount > count ||
+      inPos + packedLen(count, bits) + exceptionCount * (sizeof(uint16_t) + sizeof(T)) > inLen)
+    return false;
+
+  int64_t ints[count];
+  unpack<int64_t, false>(in + inPos, count, 0, ref, bits, reinterpret_cast<char*>(ints));
+  inPos += packedLen(count, bits);
+  alpScale<typename FloatOf<T>::type>(ints, count, exponent, out);
+
+  const char* values = in + inPos + exceptionCount * sizeof(uint16_t);
+
+  for (size_t k = 0; k < exceptionCount; k++)
+  {
+    uint16_t position;
+    std::memcpy(&position, in + inPos + k * sizeof(uint16_t), sizeof(position));
+
+    if (position >= count)
+      return false;
+
+    std::memcpy(out + position * sizeof(T), values + k * sizeof(T), sizeof(T));
+  }
+
+  inPos += exceptionCount * (sizeof(uint16_t) + sizeof(T));
+  return true;
+}
+
+template <typename T>
+bool decodeBlocks(const char* in, size_t inLen, size_t inPos, char* out, size_t outLen)
+{
+  const size_t count = BLOCK_SIZE / sizeof(T);
+  const size_t fullLen = outLen - outLen % BLOCK_SIZE;
+
+  for (size_t outPos = 0; outPos < fullLen; outPos += BLOCK_SIZE)
+  {
+    if (inPos + 1 > inLen)
+      return false;
+
+    uint8_t kind = in[inPos++];
+
+    if (kind == RAW)
+    {
+      if (inPos + BLOCK_SIZE > inLen)
+        return false;
+
+      std::memcpy(out + outPos, in + inPos, BLOCK_SIZE);
+      inPos += BLOCK_SIZE;
+      continue;
+    }
+
+    if (kind == ALP)
+    {
+      if constexpr (sizeof(T) >= 4)
+      {
+        if (!decodeAlpBlock<T>(in, inLen, inPos, out + outPos))
+          return false;
+
+        continue;
+      }
+
+      return false;
+    }
+
+    bool delta = kind == DELTA;
+    size_t headerLen = 1 + (delta ? 2 : 1) * sizeof(int64_t);
+
+    if ((kind != PACKED && !delta) || inPos + headerLen > inLen)
+      return false;
+
+    uint32_t bits = static_cast<uint8_t>(in[inPos++]);
+    size_t packedCount = delta ? count - 1 : count;
+
+    if (bits > MAX_PACKED_BITS || inPos + headerLen - 1 + packedLen(packedCount, bits) > inLen)
+      return false;
+
+    if (delta)
+    {
+      uint64_t first, ref;
+      std::memcpy(&first, in + inPos, sizeof(first));
+      std::memcpy(&ref, in + inPos + sizeof(first), sizeof(ref));
+      inPos += 2 * sizeof(int64_t);
+      store<T>(out + outPos, first);
+      unpack<T, true>(in + inPos, packedCount, first, ref, bits, out + outPos + sizeof(T));
+    }
+    else
+    {
+      uint64_t ref;
+      std::memcpy(&ref, in + inPos, sizeof(ref));
+      inPos += sizeof(int64_t);
+      unpack<T, false>(in + inPos, packedCount, 0, ref, bits, out + outPos);
+    }
+
+    inPos += packedLen(packedCount, bits);
+  }
+
+  if (inLen - inPos != outLen - fullLen)
+    return false;
+
+  std::memcpy(out + fullLen, in + inPos, outLen - fullLen);
+  return true;
+}
+
+}  // namespace
+
+namespace compress
+{
+size_t ChunkEncoding::encode(const char* in, size_t inLen, uint32_t colWidth, bool floatValues, char* out)
+{
+  if (!supported(colWidth) || inLen < BLOCK_SIZE || inLen > UINT32_MAX)
+    return 0;
+
+  out[0] = colWidth;
+  uint32_t len = inLen;
+  std::memcpy(out + 1, &len, sizeof(len));
+
+  switch (colWidth)
+  {
+    case 1: return encodeBlocks<int8_t>(in, inLen, false, out, CHUNK_HEADER_LEN);
+    case 2: return encodeBlocks<int16_t>(in, inLen, false, out, CHUNK_HEADER_LEN);
+    case 4: return encodeBlocks<int32_t>(in, inLen, floatValues, out, CHUNK_HEADER_LEN);
+    default: return encodeBlocks<int64_t>(in, inLen, floatValues, out, CHUNK_HEADER_LEN);
+  }
+}
+
+bool ChunkEncoding::decode(const char* in, size_t inLen, char* out, size_t* outLen)
+{
+  if (inLen < CHUNK_HEADER_LEN)
+    return false;
+
+  uint32_t colWidth = static_cast<uint8_t>(in[0]);
+  uint32_t len;
+  std::memcpy(&len, in + 1, sizeof(len));
+
+  if (!supported(colWidth) || len > *outLen)
+    return false;
+
+  *outLen = len;
+
+  switch (colWidth)
+  {
+    case 1: return decodeBlocks<int8_t>(in, inLen, CHUNK_HEADER_LEN, out, len);
+    case 2: return decodeBlocks<int16_t>(in, inLen, CHUNK_HEADER_LEN, out, len);
+    case 4: return decodeBlocks<int32_t>(in, inLen, CHUNK_HEADER_LEN, out, len);
+    default: return decodeBlocks<int64_t>(in, inLen, CHUNK_HEADER_LEN, out, len);
+  }
+}
+
+}  // namespace compress
@@ -0,0 +1,86 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+/** @file
+ * Integer encodings of the blocks of a column chunk, applied before the chunk
+ * is compressed.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace compress
+{
+/** @brief Frame of reference, bit-packing and delta encoding of column blocks.
+ *
+ * The values of every 8KB block of a chunk are stored as their difference to
+ * the smallest value of the block, packed in the bits the largest difference
+ * needs. A block of ascending or descending values stores the differences of
+ * consecutive values instead when they pack smaller.
+ *
+ * A block of FLOAT or DOUBLE values is also tried with ALP: most floats are
+ * decimals with a few digits, so the values multiplied by a power of ten are
+ * packed as integers when they divide back to the same bits. The power is the
+ * one that fits a sample of the block best, the values that do not divide
+ * back are stored apart as exceptions. Decoding converts and divides two
+ * values at a time with SSE2 or NEON.
+ *
+ * A block that does not get smaller is stored as it is, as is the part of a
+ * chunk after its last full block.
+ *
+ * Encoded chunk:
+ *   uint8_t  column width
+ *   uint32_t length of the chunk
+ *   blocks:  uint8_t kind; for PACKED and DELTA uint8_t bits, int64_t
+ *            reference (DELTA: int64_t first value first) and the packed
+ *            values; for ALP uint8_t bits, uint8_t exponent, int64_t
+ *            reference, uint16_t exception count, the packed integers, the
+ *            uint16_t exception positions and values; for RAW the block
+ */
+class ChunkEncoding
+{
+ public:
+  static const uint32_t BLOCK_SIZE = 8192;
+
+  // Bytes encode() may write and decode() may read past the encoded data
+  static const uint32_t SLACK = 8;
+
+  static bool supported(uint32_t colWidth)
+  {
+    return colWidth == 1 || colWidth == 2 || colWidth == 4 || colWidth == 8;
+  }
+
+  /** @brief Encodes a chunk of values of colWidth bytes.
+   *
+   * @param floatValues the values are FLOAT or DOUBLE
+   * @param out at least inLen + SLACK bytes
+   * @return the length of the encoded chunk, 0 if it is not shorter than inLen
+   */
+  static size_t encode(const char* in, size_t inLen, uint32_t colWidth, bool floatValues, char* out);
+
+  /** @brief Decodes a chunk encoded by encode().
+   *
+   * @param in followed by SLACK readable bytes
+   * @param outLen the size of out, set to the length of the chunk
+   * @return false if in is not an encoded chunk that fits out
+   */
+  static bool decode(const char* in, size_t inLen, char* out, size_t* outLen);
+};
+
+}  // namespace compress
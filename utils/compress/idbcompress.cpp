@@ -19,13 +19,16 @@
  * $Id: idbcompress.cpp 3907 2013-06-18 13:32:46Z dcathey $
  *
  ******************************************************************************************/
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <unordered_map>
 using namespace std;
 
 #include "blocksize.h"
+#include "chunkencoding.h"
 #include "logger.h"
 #include "snappy.h"
 #include "hasher.h"
@@ -38,6 +41,13 @@ using namespace std;
 #define LZ4_COMPRESSBOUND(isize) \
   ((unsigned)(isize) > (unsigned)LZ4_MAX_INPUT_SIZE ? 0 : (isize) + ((isize) / 255) + 16)
 #endif
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#else
+// Taken from zstd.h.
+#define ZSTD_COMPRESSBOUND(srcSize) \
+  ((srcSize) + ((srcSize) >> 8) + (((srcSize) < (128 << 10)) ? (((128 << 10) - (srcSize)) >> 11) : 0))
+#endif
 
 #define IDBCOMP_DLLEXPORT
 #include "idbcompress.h"
@@ -69,6 +79,7 @@ struct CompressedDBFileHeader
   execplan::CalpontSystemCatalog::ColDataType fColDataType;
   uint64_t fLBIDCount;
   uint64_t fLBIDS[LBID_MAX_SIZE];
+  compress::ChunkZoneMap fZoneMaps[compress::CompressInterface::MAX_CHUNK_ZONE_MAPS];
 };
 
 // Make the header to be 4K, regardless number of fields being defined/used in header.
@@ -78,6 +89,9 @@ union CompressedDBFileHeaderBlock
   char fDummy[compress::CompressInterface::HDR_BUF_LEN];
 };
 
+static_assert(sizeof(CompressedDBFileHeader) <= compress::CompressInterface::HDR_BUF_LEN,
+              "The compressed file header must fit its block");
+
 void initCompressedDBFileHeader(void* hdrBuf, uint32_t columnWidth,
                                 execplan::CalpontSystemCatalog::ColDataType colDataType, int compressionType,
                                 int hdrSize)
@@ -92,6 +106,7 @@ void initCompressedDBFileHeader(void* hdrBuf, uint32_t columnWidth,
   hdr->fHeader.fColDataType = colDataType;
   hdr->fHeader.fLBIDCount = 0;
   std::memset(hdr->fHeader.fLBIDS, 0, sizeof(hdr->fHeader.fLBIDS));
+  std::memset(hdr->fHeader.fZoneMaps, 0, sizeof(hdr->fHeader.fZoneMaps));
 }
 
 }  // namespace
@@ -101,7 +116,7 @@ namespace compress
 #ifndef SKIP_IDB_COMPRESSION
 
 CompressInterface::CompressInterface(unsigned int numUserPaddingBytes)
- : fNumUserPaddingBytes(numUserPaddingBytes)
+ : fNumUserPaddingBytes(numUserPaddingBytes), fEncodeChunks(false)
 {
 }
 
@@ -112,23 +127,33 @@ CompressInterface::CompressInterface(unsigned int numUserPaddingBytes)
 /*static*/
 bool CompressInterface::isCompressionAvail(int compressionType)
 {
-  return ((compressionType == 0) || (compressionType == 1) || (compressionType == 2) ||
-          (compressionType == 3));
+  return ((compressionType == 0) || (compressionType == 1) || (compressionType == 2)
+#ifdef HAVE_LZ4
+          || (compressionType == 3)
+#endif
+#ifdef HAVE_ZSTD
+          || (compressionType == 4)
+#endif
+  );
 }
 
 size_t CompressInterface::getMaxCompressedSizeGeneric(size_t inLen)
 {
-  return std::max(snappy::MaxCompressedLength(inLen), LZ4_COMPRESSBOUND(inLen)) + HEADER_SIZE;
+  return std::max({snappy::MaxCompressedLength(inLen), size_t(LZ4_COMPRESSBOUND(inLen)),
+                   size_t(ZSTD_COMPRESSBOUND(inLen))}) +
+         HEADER_SIZE;
 }
 
 //------------------------------------------------------------------------------
 // Compress a block of data
 //------------------------------------------------------------------------------
 int CompressInterface::compressBlock(const char* in, const size_t inLen, unsigned char* out,
-                                     size_t& outLen) const
+                                     size_t& outLen, uint32_t colWidth,
+                                     execplan::CalpontSystemCatalog::ColDataType colDataType) const
 {
   size_t snaplen = 0;
   utils::Hasher128 hasher;
+  uint8_t magic = getChunkMagicNumber();
 
   // loose input checking.
   if (outLen < maxCompressedSize(inLen))
@@ -144,11 +169,38 @@ int CompressInterface::compressBlock(const char* in, const size_t inLen, unsigne
     return rc;
   }
 
+  if (fEncodeChunks && ChunkEncoding::supported(colWidth))
+  {
+    // The encoded chunk replaces the chunk only if it compresses smaller
+    bool floatValues = colDataType == execplan::CalpontSystemCatalog::FLOAT ||
+                       colDataType == execplan::CalpontSystemCatalog::UFLOAT ||
+                       colDataType == execplan::CalpontSystemCatalog::DOUBLE ||
+                       colDataType == execplan::CalpontSystemCatalog::UDOUBLE;
+    const size_t encodedSize = inLen + ChunkEncoding::SLACK;
+    const size_t compressedSize = maxCompressedSize(inLen);
+    std::unique_ptr<char[]> buffer(new char[encodedSize + compressedSize]);
+    char* encoded = buffer.get();
+    size_t encodedLen = ChunkEncoding::encode(in, inLen, colWidth, floatValues, encoded);
+
+    if (encodedLen > 0)
+    {
+      char* compressed = encoded + encodedSize;
+      size_t compressedLen = compressedSize;
+
+      if (compress(encoded, encodedLen, compressed, &compressedLen) == ERR_OK && compressedLen < outLen)
+      {
+        memcpy(&out[HEADER_SIZE], compressed, compressedLen);
+        outLen = compressedLen;
+        magic = getEncodedChunkMagicNumber();
+      }
+    }
+  }
+
   snaplen = outLen;
   uint8_t* signature = (uint8_t*)&out[SIG_OFFSET];
   uint32_t* checksum = (uint32_t*)&out[CHECKSUM_OFFSET];
   uint32_t* len = (uint32_t*)&out[LEN_OFFSET];
-  *signature = getChunkMagicNumber();
+  *signature = magic;
   *checksum = hasher((char*)&out[HEADER_SIZE], snaplen);
   *len = snaplen;
 
@@ -179,7 +231,7 @@ int CompressInterface::uncompressBlock(const char* in, const size_t inLen, unsig
 
   storedMagic = *((uint8_t*)&in[SIG_OFFSET]);
 
-  if (storedMagic == getChunkMagicNumber())
+  if (storedMagic == getChunkMagicNumber() || storedMagic == getEncodedChunkMagicNumber())
   {
     if (inLen < HEADER_SIZE)
       return ERR_BADINPUT;
@@ -195,11 +247,28 @@ int CompressInterface::uncompressBlock(const char* in, const size_t inLen, unsig
     if (storedChecksum != realChecksum)
       return ERR_CHECKSUM;
 
-    auto rc = uncompress(&in[HEADER_SIZE], storedLen, reinterpret_cast<char*>(out), &tmpOutLen);
-    if (rc != ERR_OK)
+    if (storedMagic == getEncodedChunkMagicNumber())
     {
-      cerr << "uncompressBlock failed!" << endl;
-      return ERR_DECOMPRESS;
+      // The encoded chunk is shorter than the chunk out is sized for
+      std::unique_ptr<char[]> encoded(new char[tmpOutLen + ChunkEncoding::SLACK]);
+      size_t encodedLen = tmpOutLen;
+      auto rc = uncompress(&in[HEADER_SIZE], storedLen, encoded.get(), &encodedLen);
+
+      if (rc != ERR_OK ||
+          !ChunkEncoding::decode(encoded.get(), encodedLen, reinterpret_cast<char*>(out), &tmpOutLen))
+      {
+        cerr << "uncompressBlock failed!" << endl;
+        return ERR_DECOMPRESS;
+      }
+    }
+    else
+    {
+      auto rc = uncompress(&in[HEADER_SIZE], storedLen, reinterpret_cast<char*>(out), &tmpOutLen);
+      if (rc != ERR_OK)
+      {
+        cerr << "uncompressBlock failed!" << endl;
+        return ERR_DECOMPRESS;
+      }
     }
 
     outLen = tmpOutLen;
@@ -439,6 +508,38 @@ uint64_t CompressInterface::getLBIDCount(void* hdrBuf)
   return reinterpret_cast<const CompressedDBFileHeader*>(hdrBuf)->fLBIDCount;
 }
 
+//------------------------------------------------------------------------------
+// Set the zone map of a chunk
+//------------------------------------------------------------------------------
+void CompressInterface::setChunkZoneMap(void* hdrBuf, uint64_t chunkIndex, const ChunkZoneMap& zoneMap)
+{
+  if (chunkIndex < MAX_CHUNK_ZONE_MAPS)
+    reinterpret_cast<CompressedDBFileHeader*>(hdrBuf)->fZoneMaps[chunkIndex] = zoneMap;
+}
+
+//------------------------------------------------------------------------------
+// Get the zone map of a chunk
+//------------------------------------------------------------------------------
+bool CompressInterface::getChunkZoneMap(const void* hdrBuf, uint64_t chunkIndex, ChunkZoneMap& zoneMap)
+{
+  if (chunkIndex >= MAX_CHUNK_ZONE_MAPS)
+    return false;
+
+  zoneMap = reinterpret_cast<const CompressedDBFileHeader*>(hdrBuf)->fZoneMaps[chunkIndex];
+  return (zoneMap.flags & ChunkZoneMap::VALID) != 0;
+}
+
+//------------------------------------------------------------------------------
+// Drop the zone maps of the chunks from firstChunkIndex on
+//------------------------------------------------------------------------------
+void CompressInterface::clearChunkZoneMaps(void* hdrBuf, uint64_t firstChunkIndex)
+{
+  CompressedDBFileHeader* hdr = reinterpret_cast<CompressedDBFileHeader*>(hdrBuf);
+
+  for (uint64_t i = firstChunkIndex; i < MAX_CHUNK_ZONE_MAPS; i++)
+    hdr->fZoneMaps[i] = ChunkZoneMap();
+}
+
 //------------------------------------------------------------------------------
 // Calculates the chunk and block offset within the chunk for the specified
 // block number.
@@ -614,16 +715,100 @@ uint8_t CompressInterfaceLZ4::getChunkMagicNumber() const
   return CHUNK_MAGIC_LZ4;
 }
 
-CompressInterface* getCompressInterfaceByType(uint32_t compressionType, uint32_t numUserPaddingBytes)
+// ZSTD
+CompressInterfaceZSTD::CompressInterfaceZSTD(uint32_t numUserPaddingBytes, int32_t compressionLevel)
+ : CompressInterface(numUserPaddingBytes), fCompressionLevel(compressionLevel)
+{
+}
+
+int32_t CompressInterfaceZSTD::compress(const char* in, size_t inLen, char* out, size_t* outLen) const
+{
+#ifdef HAVE_ZSTD
+  auto compressedLen = ZSTD_compress(out, *outLen, in, inLen, fCompressionLevel);
+
+  if (ZSTD_isError(compressedLen))
+  {
+    cerr << "ZSTD_compress failed: " << ZSTD_getErrorName(compressedLen) << ". InLen: " << inLen << endl;
+    return ERR_COMPRESS;
+  }
+
+#ifdef DEBUG_COMPRESSION
+  std::cout << "ZSTD::compress: inLen " << inLen << ", comressedLen " << compressedLen << std::endl;
+#endif
+
+  *outLen = compressedLen;
+  return ERR_OK;
+#else
+  return ERR_COMPRESS;
+#endif
+}
+
+int32_t CompressInterfaceZSTD::uncompress(const char* in, size_t inLen, char* out, size_t* outLen) const
+{
+#ifdef HAVE_ZSTD
+  auto decompressedLen = ZSTD_decompress(out, *outLen, in, inLen);
+
+  if (ZSTD_isError(decompressedLen))
+  {
+    cerr << "ZSTD_decompress failed: " << ZSTD_getErrorName(decompressedLen) << endl;
+    cerr << "InLen: " << inLen << ", outLen: " << *outLen << endl;
+    return ERR_DECOMPRESS;
+  }
+
+  *outLen = decompressedLen;
+
+#ifdef DEBUG_COMPRESSION
+  std::cout << "ZSTD::uncompress: inLen " << inLen << ", outLen " << *outLen << std::endl;
+#endif
+
+  return ERR_OK;
+#else
+  return ERR_DECOMPRESS;
+#endif
+}
+
+size_t CompressInterfaceZSTD::maxCompressedSize(size_t uncompSize) const
 {
+  return (ZSTD_COMPRESSBOUND(uncompSize) + HEADER_SIZE);
+}
+
+bool CompressInterfaceZSTD::getUncompressedSize(char* in, size_t inLen, size_t* outLen) const
+{
+#ifdef HAVE_ZSTD
+  auto contentSize = ZSTD_getFrameContentSize(in, inLen);
+
+  if (contentSize == ZSTD_CONTENTSIZE_UNKNOWN || contentSize == ZSTD_CONTENTSIZE_ERROR)
+    return false;
+
+  *outLen = contentSize;
+  return true;
+#else
+  return false;
+#endif
+}
+
+uint8_t CompressInterfaceZSTD::getChunkMagicNumber() const
+{
+  return CHUNK_MAGIC_ZSTD;
+}
+
+CompressInterface* getCompressInterfaceByType(uint32_t compressionType, uint32_t numUserPaddingBytes,
+                                              int32_t compressionLevel, bool encodeChunks)
+{
+  CompressInterface* compressor = nullptr;
+
   switch (compressionType)
   {
     case 1:
-    case 2: return new CompressInterfaceSnappy(numUserPaddingBytes);
-    case 3: return new CompressInterfaceLZ4(numUserPaddingBytes);
+    case 2: compressor = new CompressInterfaceSnappy(numUserPaddingBytes); break;
+    case 3: compressor = new CompressInterfaceLZ4(numUserPaddingBytes); break;
+    case 4: compressor = new CompressInterfaceZSTD(numUserPaddingBytes, compressionLevel); break;
   }
 
-  return nullptr;
+  if (compressor)
+    compressor->encodeChunks(encodeChunks);
+
+  return compressor;
 }
 
 CompressInterface* getCompressInterfaceByName(const std::string& compressionName,
@@ -633,16 +818,34 @@ CompressInterface* getCompressInterfaceByName(const std::string& compressionName
     return new CompressInterfaceSnappy(numUserPaddingBytes);
   else if (compressionName == "LZ4")
     return new CompressInterfaceLZ4(numUserPaddingBytes);
+  else if (compressionName == "ZSTD")
+    return new CompressInterfaceZSTD(numUserPaddingBytes);
   return nullptr;
 }
 
+int getCompressionTypeByName(const std::string& compressionName)
+{
+  if (compressionName == "SNAPPY")
+    return 2;
+  else if (compressionName == "LZ4")
+    return 3;
+  else if (compressionName == "ZSTD")
+    return 4;
+  return -1;
+}
+
 void initializeCompressorPool(
     std::unordered_map<uint32_t, std::shared_ptr<CompressInterface>>& compressorPool,
-    uint32_t numUserPaddingBytes)
+    uint32_t numUserPaddingBytes, int32_t compressionLevel, bool encodeChunks)
 {
   compressorPool = {
       make_pair(2, std::shared_ptr<CompressInterface>(new CompressInterfaceSnappy(numUserPaddingBytes))),
-      make_pair(3, std::shared_ptr<CompressInterface>(new CompressInterfaceLZ4(numUserPaddingBytes)))};
+      make_pair(3, std::shared_ptr<CompressInterface>(new CompressInterfaceLZ4(numUserPaddingBytes))),
+      make_pair(4, std::shared_ptr<CompressInterface>(
+                       new CompressInterfaceZSTD(numUserPaddingBytes, compressionLevel)))};
+
+  for (auto& compressor : compressorPool)
+    compressor.second->encodeChunks(encodeChunks);
 }
 
 std::shared_ptr<CompressInterface> getCompressorByType(
@@ -664,6 +867,12 @@ std::shared_ptr<CompressInterface> getCompressorByType(
         return nullptr;
       }
       return compressorPool[3];
+    case 4:
+      if (!compressorPool.count(4))
+      {
+        return nullptr;
+      }
+      return compressorPool[4];
   }
 
   return nullptr;
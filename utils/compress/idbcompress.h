@@ -34,12 +34,31 @@ namespace compress
 typedef std::pair<uint64_t, uint64_t> CompChunkPtr;
 typedef std::vector<CompChunkPtr> CompChunkPtrList;
 
+/** @brief Min/max and null count of the values of a chunk.
+ *
+ * Kept in the file header for the first MAX_CHUNK_ZONE_MAPS chunks of integer-like columns,
+ * the values are in the domain the column is filtered in, zero-extended for unsigned types
+ * and sign-extended for the rest. The empty values are not counted. A zeroed entry is a
+ * chunk without a zone map, which is what the headers written before them hold.
+ */
+struct ChunkZoneMap
+{
+  static const uint32_t VALID = 0x1;
+  static const uint32_t HAS_VALUES = 0x2;
+
+  int64_t min;
+  int64_t max;
+  uint32_t nullCount;
+  uint32_t flags;
+};
+
 class CompressInterface
 {
  public:
   static const unsigned int HDR_BUF_LEN = 4096;
   static const unsigned int UNCOMPRESSED_INBUF_LEN = 512 * 1024 * 8;
   static const uint32_t COMPRESSED_CHUNK_INCREMENT_SIZE = 8192;
+  static const uint32_t MAX_CHUNK_ZONE_MAPS = 128;
 
   // error codes from uncompressBlock()
   static const int ERR_OK = 0;
@@ -75,10 +94,16 @@ class CompressInterface
    * Compresses specified "in" buffer of length "inLen" bytes.
    * Compressed data and size are returned in "out" and "outLen".
    * "out" should be sized using maxCompressedSize() to allow for incompressible data.
+   * With encodeChunks() set, the values of a column of width "colWidth" and type
+   * "colDataType" are also encoded by ChunkEncoding and compressed, and the encoded
+   * chunk is kept if it is smaller; 0 compresses the bytes as they are.
    * Returns 0 if success.
    */
 
-  EXPORT int compressBlock(const char* in, const size_t inLen, unsigned char* out, size_t& outLen) const;
+  EXPORT int compressBlock(const char* in, const size_t inLen, unsigned char* out, size_t& outLen,
+                           uint32_t colWidth = 0,
+                           execplan::CalpontSystemCatalog::ColDataType colDataType =
+                               execplan::CalpontSystemCatalog::UNDEFINED) const;
 
   /**
    * outLen must be initialized with the size of the out buffer before calling uncompressBlock.
@@ -240,6 +265,21 @@ class CompressInterface
    */
   EXPORT static uint64_t getLBIDCount(void* hdrBuf);
 
+  /**
+   * setChunkZoneMap, chunks past MAX_CHUNK_ZONE_MAPS are ignored
+   */
+  EXPORT static void setChunkZoneMap(void* hdrBuf, uint64_t chunkIndex, const ChunkZoneMap& zoneMap);
+
+  /**
+   * getChunkZoneMap, returns false if the chunk has no zone map
+   */
+  EXPORT static bool getChunkZoneMap(const void* hdrBuf, uint64_t chunkIndex, ChunkZoneMap& zoneMap);
+
+  /**
+   * clearChunkZoneMaps of the chunks from firstChunkIndex on
+   */
+  EXPORT static void clearChunkZoneMaps(void* hdrBuf, uint64_t firstChunkIndex = 0);
+
   /**
    * Mutator methods for the user padding bytes
    */
@@ -259,6 +299,23 @@ class CompressInterface
     return fNumUserPaddingBytes;
   }
 
+  /**
+   * set whether compressBlock() tries ChunkEncoding. Versions before it can't
+   * read the encoded chunks.
+   */
+  EXPORT void encodeChunks(bool encode)
+  {
+    fEncodeChunks = encode;
+  }
+
+  /**
+   * get whether compressBlock() tries ChunkEncoding
+   */
+  EXPORT bool encodeChunks() const
+  {
+    return fEncodeChunks;
+  }
+
   /**
    * Given an input, uncompressed block, what's the maximum possible output,
    * compressed size?
@@ -274,12 +331,21 @@ class CompressInterface
  protected:
   virtual uint8_t getChunkMagicNumber() const = 0;
 
+  // Magic number of the chunks encoded by ChunkEncoding
+  uint8_t getEncodedChunkMagicNumber() const
+  {
+    return getChunkMagicNumber() ^ CHUNK_MAGIC_ENCODED;
+  }
+
+  static const uint8_t CHUNK_MAGIC_ENCODED = 0x10;
+
  private:
   // defaults okay
   // CompressInterface(const CompressInterface& rhs);
   // CompressInterface& operator=(const CompressInterface& rhs);
 
   unsigned int fNumUserPaddingBytes;  // Num bytes to pad compressed chunks
+  bool fEncodeChunks;                 // Try ChunkEncoding in compressBlock()
 };
 
 class CompressInterfaceSnappy : public CompressInterface
@@ -348,15 +414,60 @@ class CompressInterfaceLZ4 : public CompressInterface
   const uint8_t CHUNK_MAGIC_LZ4 = 0xfc;
 };
 
+/**
+ * Zstandard compression, compression type 4. The compression level only
+ * matters to compress, the chunks of any level are uncompressed alike.
+ */
+class CompressInterfaceZSTD : public CompressInterface
+{
+ public:
+  /**
+   * `compressionLevel` 0 is the default level of the Zstandard library.
+   */
+  EXPORT CompressInterfaceZSTD(uint32_t numUserPaddingBytes = 0, int32_t compressionLevel = 0);
+  EXPORT ~CompressInterfaceZSTD() = default;
+  /**
+   * Compress the given block using Zstandard compression API.
+   */
+  EXPORT int32_t compress(const char* in, size_t inLen, char* out, size_t* outLen) const override;
+  /**
+   * Uncompress the given block using Zstandard compression API.
+   */
+  EXPORT int32_t uncompress(const char* in, size_t inLen, char* out, size_t* outLen) const override;
+  /**
+   * Get max compressed size for the given `uncompSize` value using Zstandard
+   * compression API.
+   */
+  EXPORT size_t maxCompressedSize(size_t uncompSize) const override;
+
+  /**
+   * Get uncompressed size for the given block using Zstandard
+   * compression API.
+   */
+  EXPORT
+  bool getUncompressedSize(char* in, size_t inLen, size_t* outLen) const override;
+
+ protected:
+  uint8_t getChunkMagicNumber() const override;
+
+ private:
+  const uint8_t CHUNK_MAGIC_ZSTD = 0xfb;
+  int32_t fCompressionLevel;
+};
+
 using CompressorPool = std::unordered_map<uint32_t, std::shared_ptr<CompressInterface>>;
 
 /**
  *  Returns a pointer to the appropriate compression interface based on
  * `compressionType`. `compressionType` must be greater than 0.
+ *  `compressionLevel` is used by the compression types that have levels,
+ *  0 for their default level. `encodeChunks` sets encodeChunks().
  *  Note: caller is responsible for memory deallocation.
  */
 EXPORT CompressInterface* getCompressInterfaceByType(uint32_t compressionType,
-                                                     uint32_t numUserPaddingBytes = 0);
+                                                     uint32_t numUserPaddingBytes = 0,
+                                                     int32_t compressionLevel = 0,
+                                                     bool encodeChunks = false);
 
 /**
  *  Returns a pointer to the appropriate compression interface based on
@@ -366,11 +477,18 @@ EXPORT CompressInterface* getCompressInterfaceByType(uint32_t compressionType,
 EXPORT CompressInterface* getCompressInterfaceByName(const std::string& compressionName,
                                                      uint32_t numUserPaddingBytes = 0);
 
+/**
+ *  Returns the compression type of a compression name (SNAPPY, LZ4 or ZSTD),
+ *  -1 if there is no such compression.
+ */
+EXPORT int getCompressionTypeByName(const std::string& compressionName);
+
 /**
  *  Initializes a given `unordered_map` with all available compression
  *  interfaces.
  */
-EXPORT void initializeCompressorPool(CompressorPool& compressorPool, uint32_t numUserPaddingBytes = 0);
+EXPORT void initializeCompressorPool(CompressorPool& compressorPool, uint32_t numUserPaddingBytes = 0,
+                                     int32_t compressionLevel = 0, bool encodeChunks = false);
 
 /**
  *  Returns a `shared_ptr` to the appropriate compression interface.
@@ -503,6 +621,16 @@ void IDBCompressInterface::setLBIDByIndex(void* hdrBuf, uint64_t lbid, uint32_t
 void IDBCompressInterface::getLBIDCount(void* hdrBuf) const
 {
 }
+inline void CompressInterface::setChunkZoneMap(void*, uint64_t, const ChunkZoneMap&)
+{
+}
+inline bool CompressInterface::getChunkZoneMap(const void*, uint64_t, ChunkZoneMap&)
+{
+  return false;
+}
+inline void CompressInterface::clearChunkZoneMaps(void*, uint64_t)
+{
+}
 inline bool IDBCompressInterface::getUncompressedSize(char* in, size_t inLen, size_t* outLen)
 {
   return false;
@@ -448,7 +448,11 @@ class ByteStream : public Serializeable
   EXPORT static const BSSizeType ISSOverhead =
       3 * sizeof(uint32_t);  // space for the BS magic & length & number of long strings.
 
-  // Methods to get and set `long strings`.
+  // Methods to get and set `long strings`. These are the only segments of a
+  // ByteStream kept apart from the body: the socket sends them by reference
+  // after the body and reads them into MemChunks of their exact size. The
+  // body itself stays one contiguous buffer, readers access it in place
+  // through buf() and the extraction operators.
   EXPORT std::vector<rowgroup::StringStoreBufSPType>& getLongStrings();
   EXPORT const std::vector<rowgroup::StringStoreBufSPType>& getLongStrings() const;
   EXPORT void setLongStrings(const std::vector<rowgroup::StringStoreBufSPType>& other);
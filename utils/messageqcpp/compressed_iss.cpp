@@ -112,6 +112,8 @@ const SBS CompressedInetStreamSocket::read(const struct timespec* timeout, bool*
                   (char*)ret->getInputPtr(), &uncompressedSize);
 
   ret->advanceInputPtr(uncompressedSize);
+  // `long strings` are sent uncompressed right after the body.
+  ret->setLongStrings(readBS->getLongStrings());
 
   return ret;
 }
@@ -132,6 +134,8 @@ void CompressedInetStreamSocket::write(const ByteStream& msg, Stats* stats)
     // !!!
     *(uint32_t*)smsg.getInputPtr() = len;
     smsg.advanceInputPtr(outLen + HEADER_SIZE);
+    // Only the body is compressed, `long strings` are sent as is by reference.
+    smsg.setLongStrings(msg.getLongStrings());
 
     if (outLen < len)
       do_write(smsg, COMPRESSED_BYTESTREAM_MAGIC, stats);
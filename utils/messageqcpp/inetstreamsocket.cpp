@@ -63,6 +63,9 @@ either expressed or implied, of the FreeBSD Project.
 #include <sys/ioctl.h>
 #include <sys/types.h>
 #include <sys/time.h>
+#include <sys/uio.h>
+#include <algorithm>
+#include <climits>
 #include <cstring>
 
 #include <stdexcept>
@@ -490,17 +493,14 @@ const SBS InetStreamSocket::read(const struct ::timespec* timeout, bool* isTimeO
     return SBS(new ByteStream(0U));
   }
 
-  // we need to read the 4-byte message length first.
-  uint32_t msglen;
-  if (!readFixedSizeData(pfd, reinterpret_cast<uint8_t*>(&msglen), sizeof(msglen), timeout, isTimeOut, stats,
-                         msecs))
+  // we need to read the 4-byte message length and the number of the `long strings` first.
+  uint32_t msgHeader[2];
+  if (!readFixedSizeData(pfd, reinterpret_cast<uint8_t*>(msgHeader), sizeof(msgHeader), timeout, isTimeOut,
+                         stats, msecs))
     return SBS(new ByteStream(0U));
 
-  // Read the number of the `long strings`.
-  uint32_t longStringSize;
-  if (!readFixedSizeData(pfd, reinterpret_cast<uint8_t*>(&longStringSize), sizeof(longStringSize), timeout,
-                         isTimeOut, stats, msecs))
-    return SBS(new ByteStream(0U));
+  const uint32_t msglen = msgHeader[0];
+  const uint32_t longStringSize = msgHeader[1];
 
   // Read the actual data of the `ByteStream`.
   SBS res(new ByteStream(msglen));
@@ -588,19 +588,27 @@ void InetStreamSocket::do_write(const ByteStream& msg, uint32_t whichMagic, Stat
 
   try
   {
+    // The header with the ByteStream body and all `long strings` are sent with
+    // a single writev() call straight from their buffers, so the `long strings`
+    // are neither copied into the ByteStream nor sent with separate syscalls.
+    std::vector<struct iovec> iov;
+    iov.reserve(longStrings.size() + 1);
+
     auto bytesToWrite = sizeof(msglen) + sizeof(magic) + sizeof(uint32_t) + msglen;
-    written(fSocketParms.sd(), (const uint8_t*)realBuf, bytesToWrite);
+    iov.push_back({realBuf, bytesToWrite});
 
     for (const auto& longString : longStrings)
     {
       const rowgroup::StringStore::MemChunk* memChunk =
           reinterpret_cast<rowgroup::StringStore::MemChunk*>(longString.get());
       const auto writeSize = memChunk->currentSize + sizeof(rowgroup::StringStore::MemChunk);
-      written(fSocketParms.sd(), (const uint8_t*)longString.get(), writeSize);
+      iov.push_back({longString.get(), writeSize});
       // For stats.
       bytesToWrite += writeSize;
     }
 
+    writtenv(fSocketParms.sd(), iov.data(), iov.size());
+
     if (stats)
       stats->dataSent(bytesToWrite);
   }
@@ -905,6 +913,29 @@ void InetStreamSocket::logIoError(const char* errMsg, int errNum) const
   logger.logMessage(logging::LOG_TYPE_WARNING, logging::M0071, args, li);
 }
 
+namespace
+{
+void throwWriteError(int e)
+{
+  string errorMsg = "InetStreamSocket::write error: ";
+  scoped_array<char> buf(new char[80]);
+#if STRERROR_R_CHAR_P
+  const char* p;
+
+  if ((p = strerror_r(e, buf.get(), 80)) != 0)
+    errorMsg += p;
+
+#else
+  int p;
+
+  if ((p = strerror_r(e, buf.get(), 80)) == 0)
+    errorMsg += buf.get();
+
+#endif
+  throw runtime_error(errorMsg);
+}
+}  // namespace
+
 ssize_t InetStreamSocket::written(int fd, const uint8_t* ptr, size_t nbytes) const
 {
   size_t nleft;
@@ -922,33 +953,51 @@ ssize_t InetStreamSocket::written(int fd, const uint8_t* ptr, size_t nbytes) con
       if (errno == EINTR)
         nwritten = 0;
       else
-      {
-        // save the error no first
-        int e = errno;
-        string errorMsg = "InetStreamSocket::write error: ";
-        scoped_array<char> buf(new char[80]);
-#if STRERROR_R_CHAR_P
-        const char* p;
+        throwWriteError(errno);
+    }
 
-        if ((p = strerror_r(e, buf.get(), 80)) != 0)
-          errorMsg += p;
+    nleft -= nwritten;
+    bufp += nwritten;
+  }
 
-#else
-        int p;
+  return nbytes;
+}
 
-        if ((p = strerror_r(e, buf.get(), 80)) == 0)
-          errorMsg += buf.get();
+ssize_t InetStreamSocket::writtenv(int fd, struct iovec* iov, size_t iovcnt) const
+{
+  ssize_t total = 0;
 
-#endif
-        throw runtime_error(errorMsg);
-      }
+  while (iovcnt > 0)
+  {
+    // the O_NONBLOCK flag is not set, this is a blocking I/O.
+    ssize_t nwritten = ::writev(fd, iov, std::min<size_t>(iovcnt, IOV_MAX));
+
+    if (nwritten < 0)
+    {
+      if (errno == EINTR)
+        continue;
+
+      throwWriteError(errno);
     }
 
-    nleft -= nwritten;
-    bufp += nwritten;
+    total += nwritten;
+
+    // Skip the fully written buffers and adjust the partially written one.
+    while (iovcnt > 0 && static_cast<size_t>(nwritten) >= iov->iov_len)
+    {
+      nwritten -= iov->iov_len;
+      ++iov;
+      --iovcnt;
+    }
+
+    if (iovcnt > 0)
+    {
+      iov->iov_base = static_cast<uint8_t*>(iov->iov_base) + nwritten;
+      iov->iov_len -= nwritten;
+    }
   }
 
-  return nbytes;
+  return total;
 }
 
 const string InetStreamSocket::addr2String() const
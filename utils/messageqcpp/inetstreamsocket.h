@@ -26,6 +26,7 @@
 #include <ctime>
 #include <unistd.h>
 #include <netinet/in.h>
+#include <sys/uio.h>
 #include <cstring>
 
 #include "socket.h"
@@ -233,6 +234,9 @@ class InetStreamSocket : public Socket
 
   void do_write(const ByteStream& msg, uint32_t magic, Stats* stats = nullptr) const;
   ssize_t written(int fd, const uint8_t* ptr, size_t nbytes) const;
+  // Writes all the given buffers, handles partial writes and IOV_MAX limit.
+  // Note: modifies `iov` entries.
+  ssize_t writtenv(int fd, struct iovec* iov, size_t iovcnt) const;
   bool readFixedSizeData(struct pollfd* pfd, uint8_t* buffer, size_t numberOfBytes,
                          const struct ::timespec* timeout, bool* isTimeOut, Stats* stats, int64_t msec) const;
 
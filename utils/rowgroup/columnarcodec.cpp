@@ -0,0 +1,411 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+#include "columnarcodec.h"
+#include "exceptclasses.h"
+
+using namespace messageqcpp;
+
+namespace
+{
+inline uint64_t loadValue(const uint8_t* src, uint32_t width)
+{
+  uint64_t ret = 0;
+  memcpy(&ret, src, width);
+  return ret;
+}
+
+inline void storeValue(uint8_t* dst, uint64_t value, uint32_t width)
+{
+  memcpy(dst, &value, width);
+}
+
+inline uint8_t bitWidth(uint64_t value)
+{
+  return value ? 64 - __builtin_clzll(value) : 0;
+}
+
+inline uint64_t packedSize(uint64_t count, uint8_t bits)
+{
+  return (count * bits + 7) / 8;
+}
+
+// Packs the low `bits` bits of every value, little endian.
+void packBits(ByteStream& bs, const std::vector<uint64_t>& values, uint8_t bits)
+{
+  const uint64_t bytes = packedSize(values.size(), bits);
+  if (bytes == 0)
+    return;
+
+  bs.needAtLeast(bytes);
+  uint8_t* out = bs.getInputPtr();
+  uint64_t acc = 0;
+  uint32_t accBits = 0;
+
+  for (uint64_t value : values)
+  {
+    acc |= value << accBits;
+
+    if (accBits + bits >= 64)
+    {
+      memcpy(out, &acc, sizeof(acc));
+      out += sizeof(acc);
+      const uint32_t spill = accBits + bits - 64;
+      acc = spill ? value >> (bits - spill) : 0;
+      accBits = spill;
+    }
+    else
+    {
+      accBits += bits;
+    }
+  }
+
+  if (accBits)
+  {
+    memcpy(out, &acc, (accBits + 7) / 8);
+    out += (accBits + 7) / 8;
+  }
+
+  bs.advanceInputPtr(bytes);
+}
+
+class BitReader
+{
+ public:
+  BitReader(const uint8_t* src, uint64_t size, uint8_t bits)
+   : src(src), end(src + size), bits(bits), mask(bits == 64 ? ~0ULL : (1ULL << bits) - 1)
+  {
+  }
+
+  inline uint64_t next()
+  {
+    while (accBits < bits)
+    {
+      if (end - src >= 8 && accBits <= 64)
+      {
+        uint64_t word;
+        memcpy(&word, src, sizeof(word));
+        acc |= static_cast<unsigned __int128>(word) << accBits;
+        src += sizeof(word);
+        accBits += 64;
+      }
+      else
+      {
+        acc |= static_cast<unsigned __int128>(*src++) << accBits;
+        accBits += 8;
+      }
+    }
+
+    const uint64_t ret = static_cast<uint64_t>(acc) & mask;
+    acc >>= bits;
+    accBits -= bits;
+    return ret;
+  }
+
+ private:
+  const uint8_t* src;
+  const uint8_t* end;
+  const uint8_t bits;
+  const uint64_t mask;
+  unsigned __int128 acc = 0;
+  uint32_t accBits = 0;
+};
+
+}  // namespace
+
+namespace rowgroup
+{
+void ColumnarCodec::encode(ByteStream& bs, const uint8_t* rows, uint32_t rowCount, uint32_t rowSize,
+                           const std::vector<uint32_t>& laneWidths)
+{
+  bs << static_cast<uint32_t>(laneWidths.size());
+
+  for (uint32_t width : laneWidths)
+    bs << width;
+
+  uint32_t laneOffset = 0;
+
+  for (uint32_t width : laneWidths)
+  {
+    encodeLane(bs, rows, rowCount, rowSize, laneOffset, width);
+    laneOffset += width;
+  }
+
+  idbassert(laneOffset == rowSize);
+}
+
+void ColumnarCodec::decode(ByteStream& bs, uint8_t* rows, uint32_t rowCount, uint32_t rowSize)
+{
+  uint32_t laneCount;
+  bs >> laneCount;
+
+  std::vector<uint32_t> laneWidths(laneCount);
+
+  for (auto& width : laneWidths)
+    bs >> width;
+
+  uint32_t laneOffset = 0;
+
+  for (uint32_t width : laneWidths)
+  {
+    if (laneOffset + width > rowSize)
+      throw std::runtime_error("ColumnarCodec::decode(): lanes do not match the row size");
+
+    decodeLane(bs, rows, rowCount, rowSize, laneOffset, width);
+    laneOffset += width;
+  }
+}
+
+void ColumnarCodec::encodeLane(ByteStream& bs, const uint8_t* rows, uint32_t rowCount, uint32_t rowSize,
+                               uint32_t laneOffset, uint32_t laneWidth)
+{
+  const uint8_t* lane = rows + laneOffset;
+  const uint64_t rawSize = static_cast<uint64_t>(rowCount) * laneWidth;
+  uint64_t bestSize = rawSize;
+  LaneEncoding best = LaneEncoding::RAW;
+
+  // Frame-of-reference candidate, both for the unsigned and for the sign-flipped values.
+  uint64_t forBase = 0;
+  uint8_t forBits = 0;
+
+  if (laneWidth <= sizeof(uint64_t) && rowCount > 0)
+  {
+    const uint64_t signBit = 1ULL << (laneWidth * 8 - 1);
+    uint64_t umin = std::numeric_limits<uint64_t>::max(), umax = 0;
+    uint64_t bmin = std::numeric_limits<uint64_t>::max(), bmax = 0;
+
+    for (uint32_t i = 0; i < rowCount; ++i)
+    {
+      const uint64_t value = loadValue(lane + static_cast<uint64_t>(i) * rowSize, laneWidth);
+      const uint64_t biased = value ^ signBit;
+      umin = std::min(umin, value);
+      umax = std::max(umax, value);
+      bmin = std::min(bmin, biased);
+      bmax = std::max(bmax, biased);
+    }
+
+    if (umin == umax)
+    {
+      bs << static_cast<uint8_t>(LaneEncoding::CONST);
+      bs.append(lane, laneWidth);
+      return;
+    }
+
+    const uint8_t ubits = bitWidth(umax - umin);
+    const uint8_t bbits = bitWidth(bmax - bmin);
+    const bool biased = bbits < ubits;
+    forBits = biased ? bbits : ubits;
+    forBase = biased ? bmin : umin;
+    const uint64_t forSize = laneWidth + 1 + packedSize(rowCount, forBits);
+
+    if (forSize < bestSize)
+    {
+      bestSize = forSize;
+      best = biased ? LaneEncoding::FOR_BIASED : LaneEncoding::FOR;
+    }
+  }
+
+  // Dictionary candidate. Stop collecting as soon as it gets too large. The indexes take at
+  // least a byte for a full dictionary, so narrow FOR-packed lanes do not need to try it.
+  std::unordered_map<std::string_view, uint32_t> dict;
+  std::vector<std::string_view> dictValues;
+  bool dictFits = rowCount > 0 && (laneWidth > sizeof(uint64_t) || forBits > 8);
+
+  for (uint32_t i = 0; dictFits && i < rowCount; ++i)
+  {
+    std::string_view value(reinterpret_cast<const char*>(lane + static_cast<uint64_t>(i) * rowSize),
+                           laneWidth);
+
+    if (dict.emplace(value, dictValues.size()).second)
+    {
+      dictValues.push_back(value);
+      dictFits = dictValues.size() <= MaxDictSize;
+    }
+  }
+
+  uint8_t dictBits = 0;
+
+  if (dictFits)
+  {
+    if (dictValues.size() == 1)
+    {
+      bs << static_cast<uint8_t>(LaneEncoding::CONST);
+      bs.append(lane, laneWidth);
+      return;
+    }
+
+    dictBits = bitWidth(dictValues.size() - 1);
+    const uint64_t dictSize = sizeof(uint16_t) + dictValues.size() * laneWidth + 1 +
+                              packedSize(rowCount, dictBits);
+
+    if (dictSize < bestSize)
+    {
+      bestSize = dictSize;
+      best = LaneEncoding::DICT;
+    }
+  }
+
+  bs << static_cast<uint8_t>(best);
+
+  switch (best)
+  {
+    case LaneEncoding::RAW:
+    {
+      bs.needAtLeast(rawSize);
+      uint8_t* out = bs.getInputPtr();
+
+      for (uint32_t i = 0; i < rowCount; ++i, out += laneWidth)
+        memcpy(out, lane + static_cast<uint64_t>(i) * rowSize, laneWidth);
+
+      bs.advanceInputPtr(rawSize);
+      break;
+    }
+
+    case LaneEncoding::FOR:
+    case LaneEncoding::FOR_BIASED:
+    {
+      const uint64_t signBit = (best == LaneEncoding::FOR_BIASED) ? 1ULL << (laneWidth * 8 - 1) : 0;
+      std::vector<uint64_t> deltas(rowCount);
+
+      for (uint32_t i = 0; i < rowCount; ++i)
+        deltas[i] = (loadValue(lane + static_cast<uint64_t>(i) * rowSize, laneWidth) ^ signBit) - forBase;
+
+      bs.append(reinterpret_cast<const uint8_t*>(&forBase), laneWidth);
+      bs << forBits;
+      packBits(bs, deltas, forBits);
+      break;
+    }
+
+    case LaneEncoding::DICT:
+    {
+      std::vector<uint64_t> indexes(rowCount);
+
+      for (uint32_t i = 0; i < rowCount; ++i)
+      {
+        std::string_view value(reinterpret_cast<const char*>(lane + static_cast<uint64_t>(i) * rowSize),
+                               laneWidth);
+        indexes[i] = dict[value];
+      }
+
+      bs << static_cast<uint16_t>(dictValues.size());
+
+      for (const auto& value : dictValues)
+        bs.append(reinterpret_cast<const uint8_t*>(value.data()), laneWidth);
+
+      bs << dictBits;
+      packBits(bs, indexes, dictBits);
+      break;
+    }
+
+    default: idbassert(false);
+  }
+}
+
+void ColumnarCodec::decodeLane(ByteStream& bs, uint8_t* rows, uint32_t rowCount, uint32_t rowSize,
+                               uint32_t laneOffset, uint32_t laneWidth)
+{
+  uint8_t* lane = rows + laneOffset;
+  uint8_t tmp8;
+  bs >> tmp8;
+
+  switch (static_cast<LaneEncoding>(tmp8))
+  {
+    case LaneEncoding::RAW:
+    {
+      const uint64_t rawSize = static_cast<uint64_t>(rowCount) * laneWidth;
+      const uint8_t* in = bs.buf();
+      bs.advance(rawSize);
+
+      for (uint32_t i = 0; i < rowCount; ++i, in += laneWidth)
+        memcpy(lane + static_cast<uint64_t>(i) * rowSize, in, laneWidth);
+
+      break;
+    }
+
+    case LaneEncoding::CONST:
+    {
+      const uint8_t* in = bs.buf();
+      bs.advance(laneWidth);
+
+      for (uint32_t i = 0; i < rowCount; ++i)
+        memcpy(lane + static_cast<uint64_t>(i) * rowSize, in, laneWidth);
+
+      break;
+    }
+
+    case LaneEncoding::FOR:
+    case LaneEncoding::FOR_BIASED:
+    {
+      if (laneWidth > sizeof(uint64_t))
+        throw std::runtime_error("ColumnarCodec::decode(): FOR encoding of a wide lane");
+
+      const uint64_t signBit =
+          (static_cast<LaneEncoding>(tmp8) == LaneEncoding::FOR_BIASED) ? 1ULL << (laneWidth * 8 - 1) : 0;
+      const uint8_t* in = bs.buf();
+      bs.advance(laneWidth);
+      const uint64_t base = loadValue(in, laneWidth);
+      uint8_t bits;
+      bs >> bits;
+
+      const uint64_t size = packedSize(rowCount, bits);
+      BitReader reader(bs.buf(), size, bits);
+      bs.advance(size);
+
+      for (uint32_t i = 0; i < rowCount; ++i)
+        storeValue(lane + static_cast<uint64_t>(i) * rowSize, (base + reader.next()) ^ signBit, laneWidth);
+
+      break;
+    }
+
+    case LaneEncoding::DICT:
+    {
+      uint16_t dictSize;
+      bs >> dictSize;
+      const uint8_t* dict = bs.buf();
+      bs.advance(static_cast<uint64_t>(dictSize) * laneWidth);
+      uint8_t bits;
+      bs >> bits;
+
+      const uint64_t size = packedSize(rowCount, bits);
+      BitReader reader(bs.buf(), size, bits);
+      bs.advance(size);
+
+      for (uint32_t i = 0; i < rowCount; ++i)
+      {
+        const uint64_t index = reader.next();
+
+        if (index >= dictSize)
+          throw std::runtime_error("ColumnarCodec::decode(): dictionary index is out of range");
+
+        memcpy(lane + static_cast<uint64_t>(i) * rowSize, dict + index * laneWidth, laneWidth);
+      }
+
+      break;
+    }
+
+    default: throw std::runtime_error("ColumnarCodec::decode(): unknown lane encoding");
+  }
+}
+
+}  // namespace rowgroup
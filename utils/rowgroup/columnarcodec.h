@@ -0,0 +1,68 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "bytestream.h"
+
+namespace rowgroup
+{
+/** @brief Column-wise encoder for row-major RGData buffers.
+ *
+ * A row is split into lanes (the rid, every column and every NULL flag). Each lane is
+ * transposed over all the rows and encoded with the cheapest of:
+ *   - CONST: all the values are the same, only one value is sent;
+ *   - FOR: frame-of-reference + bit-packing for 1, 2, 4 and 8 byte lanes. NULL flag lanes
+ *     pack down to a 1-bit NULL bitmap this way;
+ *   - DICT: up to MaxDictSize distinct values plus bit-packed indexes, works for any width,
+ *     so repeated short strings stored inline are sent only once;
+ *   - RAW: the transposed values as is.
+ * Decoding writes the values straight into the row-major buffer of the receiving RGData.
+ */
+class ColumnarCodec
+{
+ public:
+  enum class LaneEncoding : uint8_t
+  {
+    RAW = 0,
+    CONST = 1,
+    FOR = 2,
+    FOR_BIASED = 3,  // FOR over values with the sign bit flipped, for small negative numbers
+    DICT = 4,
+  };
+
+  static constexpr uint32_t MaxDictSize = 256;
+
+  // Encodes `rowCount` rows of `rowSize` bytes starting at `rows`. The sum of `laneWidths`
+  // must be equal to `rowSize`.
+  static void encode(messageqcpp::ByteStream& bs, const uint8_t* rows, uint32_t rowCount, uint32_t rowSize,
+                     const std::vector<uint32_t>& laneWidths);
+
+  // Decodes the output of encode() into `rows`, which must have room for `rowCount` rows.
+  static void decode(messageqcpp::ByteStream& bs, uint8_t* rows, uint32_t rowCount, uint32_t rowSize);
+
+ private:
+  static void encodeLane(messageqcpp::ByteStream& bs, const uint8_t* rows, uint32_t rowCount,
+                         uint32_t rowSize, uint32_t laneOffset, uint32_t laneWidth);
+  static void decodeLane(messageqcpp::ByteStream& bs, uint8_t* rows, uint32_t rowCount, uint32_t rowSize,
+                         uint32_t laneOffset, uint32_t laneWidth);
+};
+
+}  // namespace rowgroup
@@ -41,6 +41,7 @@ using namespace execplan;
 
 #include "nullvaluemanip.h"
 #include "rowgroup.h"
+#include "columnarcodec.h"
 #include "dataconvert.h"
 #include "columnwidth.h"
 
@@ -396,7 +397,38 @@ void RGData::serialize(ByteStream& bs, RGDataSizeType amount) const
   bs << columnCount;
   bs << rowSize;
   bs.append(rowData.get(), amount);
+  serializeStores(bs);
+}
+
+void RGData::serializeColumnar(ByteStream& bs, const RowGroup& rg) const
+{
+  const RGDataSizeType amount = rg.getDataSize();
+  const uint32_t rgRowSize = rg.getRowSize();
+  const uint32_t rgColumnCount = rg.getColumnCount();
+  const uint32_t* offsets = rg.getDataOffsets();
+
+  // The rid, every column and every NULL flag is a lane of its own.
+  std::vector<uint32_t> laneWidths;
+  laneWidths.reserve(2 * rgColumnCount + 1);
+  laneWidths.push_back(offsets[0]);
+
+  for (uint32_t i = 0; i < rgColumnCount; ++i)
+    laneWidths.push_back(offsets[i + 1] - offsets[i]);
+
+  laneWidths.insert(laneWidths.end(), rgColumnCount, 1);
+
+  bs << (uint32_t)RGDATA_COLUMNAR_SIG;
+  bs << amount;
+  bs << rgColumnCount;
+  bs << rgRowSize;
+  bs.append(rowData.get(), RowGroup::getHeaderSize());
+  ColumnarCodec::encode(bs, rowData.get() + RowGroup::getHeaderSize(), rg.getRowCount(), rgRowSize,
+                        laneWidths);
+  serializeStores(bs);
+}
 
+void RGData::serializeStores(ByteStream& bs) const
+{
   if (strings)
   {
     bs << (uint8_t)1;
@@ -419,10 +451,9 @@ void RGData::deserialize(ByteStream& bs, RGDataSizeType defAmount)
   uint32_t sig;
   RGDataSizeType amount;
   uint8_t* buf;
-  uint8_t tmp8;
 
   bs.peek(sig);
-  if (sig == RGDATA_SIG)
+  if (sig == RGDATA_SIG || sig == RGDATA_COLUMNAR_SIG)
   {
     bs >> sig;
     bs >> amount;
@@ -443,34 +474,56 @@ void RGData::deserialize(ByteStream& bs, RGDataSizeType defAmount)
       rowSize = rowSizeTemp;
     }
     rowData.reset(new uint8_t[std::max(amount, defAmount)]);
-    buf = bs.buf();
-    memcpy(rowData.get(), buf, amount);
-    bs.advance(amount);
-    bs >> tmp8;
 
-    if (tmp8)
+    if (sig == RGDATA_SIG)
     {
-      strings.reset(new StringStore());
-      strings->deserialize(bs);
+      buf = bs.buf();
+      memcpy(rowData.get(), buf, amount);
+      bs.advance(amount);
     }
     else
-      strings.reset();
-
-    // UDAF user data
-    bs >> tmp8;
-
-    if (tmp8)
     {
-      userDataStore.reset(new UserDataStore());
-      userDataStore->deserialize(bs);
+      // Decode the columns straight into the row-major buffer.
+      const RGDataSizeType headerSize = RowGroup::getHeaderSize();
+      idbassert(amount >= headerSize && rowSizeTemp > 0);
+      buf = bs.buf();
+      memcpy(rowData.get(), buf, headerSize);
+      bs.advance(headerSize);
+      ColumnarCodec::decode(bs, rowData.get() + headerSize, (amount - headerSize) / rowSizeTemp,
+                            rowSizeTemp);
     }
-    else
-      userDataStore.reset();
+
+    deserializeStores(bs);
   }
 
   return;
 }
 
+void RGData::deserializeStores(ByteStream& bs)
+{
+  uint8_t tmp8;
+  bs >> tmp8;
+
+  if (tmp8)
+  {
+    strings.reset(new StringStore());
+    strings->deserialize(bs);
+  }
+  else
+    strings.reset();
+
+  // UDAF user data
+  bs >> tmp8;
+
+  if (tmp8)
+  {
+    userDataStore.reset(new UserDataStore());
+    userDataStore->deserialize(bs);
+  }
+  else
+    userDataStore.reset();
+}
+
 void RGData::clear()
 {
   rowData.reset();
@@ -1254,6 +1307,11 @@ void RowGroup::serializeRGData(ByteStream& bs) const
   rgData->serialize(bs, getDataSize());
 }
 
+void RowGroup::serializeRGDataColumnar(ByteStream& bs) const
+{
+  rgData->serializeColumnar(bs, *this);
+}
+
 RGDataSizeType RowGroup::getDataSize() const
 {
   return getDataSize(getRowCount());
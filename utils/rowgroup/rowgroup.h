@@ -275,6 +275,10 @@ class RGData
   // amount should be the # returned by RowGroup::getDataSize()
   void serialize(messageqcpp::ByteStream&, RGDataSizeType amount) const;
 
+  // Same as serialize() but the rows are sent column by column with lightweight
+  // per-column encodings, see ColumnarCodec. deserialize() handles both forms.
+  void serializeColumnar(messageqcpp::ByteStream&, const RowGroup& rg) const;
+
   // the 'hasLengthField' is there b/c PM aggregation (and possibly others) currently sends
   // inline data with a length field.  Once that's converted to string table format, that
   // option can go away.
@@ -330,8 +334,12 @@ class RGData
   std::shared_ptr<UserDataStore> userDataStore;
   std::optional<allocators::CountingAllocator<RGDataBufType>> alloc = {};
 
+  void serializeStores(messageqcpp::ByteStream&) const;
+  void deserializeStores(messageqcpp::ByteStream&);
+
   // Need sig to support backward compat.  RGData can deserialize both forms.
-  static const uint32_t RGDATA_SIG = 0xffffffff;  // won't happen for 'old' Rowgroup data
+  static const uint32_t RGDATA_SIG = 0xffffffff;           // won't happen for 'old' Rowgroup data
+  static const uint32_t RGDATA_COLUMNAR_SIG = 0xfffffffe;  // see serializeColumnar()
 
   friend class RowGroup;
   friend class RowGroupStorage;
@@ -1525,6 +1533,7 @@ class RowGroup : public messageqcpp::Serializeable
   uint32_t getColumnWidth(uint32_t col) const;
   uint32_t getColumnCount() const;
   inline const std::vector<uint32_t>& getOffsets() const;
+  inline const uint32_t* getDataOffsets() const;
   inline const std::vector<uint32_t>& getOIDs() const;
   inline const std::vector<uint32_t>& getKeys() const;
   inline const std::vector<uint32_t>& getColWidths() const;
@@ -1562,6 +1571,7 @@ class RowGroup : public messageqcpp::Serializeable
   }
 
   void serializeRGData(messageqcpp::ByteStream&) const;
+  void serializeRGDataColumnar(messageqcpp::ByteStream&) const;
   inline uint32_t getStringTableThreshold() const;
 
   void append(RGData&);
@@ -1830,6 +1840,12 @@ inline const std::vector<uint32_t>& RowGroup::getOffsets() const
   return oldOffsets;
 }
 
+// The offsets of the columns in the row data, the string table ones when it is in use
+inline const uint32_t* RowGroup::getDataOffsets() const
+{
+  return offsets;
+}
+
 inline const std::vector<uint32_t>& RowGroup::getOIDs() const
 {
   return oids;
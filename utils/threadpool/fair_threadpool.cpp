@@ -148,7 +148,7 @@ void FairThreadPool::threadFcn(const PriorityThreadPool::Priority preferredQueue
   RunListT runList(1);  // This is a vector to allow to grab multiple jobs
   RescheduleVecType reschedule;
   bool running = false;
-  bool rescheduleJob = false;
+  int rescheduleJob = 0;
 
   try
   {
@@ -228,7 +228,8 @@ void FairThreadPool::threadFcn(const PriorityThreadPool::Priority preferredQueue
       {
         // to avoid excessive CPU usage waiting for data from storage
         usleep(500);
-        runList[0].weight_ += (runList[0].weight_) ? runList[0].weight_ : RescheduleWeightIncrement;
+
+        runList[0].weight_ = rescheduledJobWeight(runList[0].weight_, rescheduleJob);
         addJob(runList[0]);
       }
     }
@@ -33,6 +33,7 @@
 #include <unordered_map>
 #include <list>
 #include <functional>
+#include <algorithm>
 
 #include "primitives/primproc/umsocketselector.h"
 #include "prioritythreadpool.h"
@@ -45,6 +46,27 @@ namespace threadpool
 // except these meta jobs.
 constexpr const uint32_t RescheduleWeightIncrement = 10000;
 constexpr const uint32_t MetaJobsInitialWeight = 1;
+// A functor returns this instead of a plain reschedule code when it has started the reads it waits for.
+// The job is put back into the queue after the usual delay, which gives the reads time to finish.
+constexpr const int RescheduleOnIO = -2;
+// A job put back with RescheduleOnIO waits for its reads, it isn't expensive. Its weight grows by
+// RescheduleWeightIncrement per suspension up to this cap instead of doubling, so I/O bound queries are
+// not pushed behind everything else and the weight never wraps.
+constexpr const uint32_t MaxRescheduleOnIOWeight = 16 * RescheduleWeightIncrement;
+
+// The weight a job is put back into the queue with after its functor returned rescheduleJob.
+inline uint32_t rescheduledJobWeight(uint32_t weight, int rescheduleJob)
+{
+  if (rescheduleJob == RescheduleOnIO)
+  {
+    if (weight >= MaxRescheduleOnIOWeight - RescheduleWeightIncrement)
+      return std::max(weight, MaxRescheduleOnIOWeight);
+
+    return weight + RescheduleWeightIncrement;
+  }
+
+  return weight + ((weight) ? weight : RescheduleWeightIncrement);
+}
 
 // The idea of this thread pool is to run morsel jobs(primitive job) is to equaly distribute CPU time
 // b/w multiple parallel queries(thread maps morsel to query using txnId). Query(txnId) has its weight
@@ -98,15 +120,15 @@ class FairThreadPool
   FairThreadPool(uint targetWeightPerRun, uint highThreads, uint midThreads, uint lowThreads, uint id = 0);
   virtual ~FairThreadPool();
 
-  void removeJobs(uint32_t id);
-  void addJob(const Job& job);
-  void stop();
+  virtual void removeJobs(uint32_t id);
+  virtual void addJob(const Job& job);
+  virtual void stop();
 
   /** @brief for use in debugging
    */
   void dump();
 
-  size_t queueSize() const
+  virtual size_t queueSize() const
   {
     return weightedTxnsQueue_.size();
   }
@@ -134,6 +156,14 @@ class FairThreadPool
   }
 
  protected:
+  // For the derived pools that manage their own threads and queues.
+  FairThreadPool() : defaultThreadCounts(0), weightPerRun(1), id(0), stopExtra_(false)
+  {
+  }
+
+  std::atomic<size_t> jobsRunning_{0};
+  std::atomic<uint32_t> blockedThreads_{0};
+
  private:
   struct ThreadHelper
   {
@@ -148,7 +178,6 @@ class FairThreadPool
     PriorityThreadPool::Priority preferredQueue;
   };
 
-  explicit FairThreadPool();
   explicit FairThreadPool(const FairThreadPool&);
   FairThreadPool& operator=(const FairThreadPool&);
 
@@ -181,11 +210,9 @@ class FairThreadPool
   using Txn2ThreadPoolJobsListMap = std::unordered_map<TransactionIdxT, ThreadPoolJobsList*>;
   Txn2ThreadPoolJobsListMap txn2JobsListMap_;
   WeightedTxnPrioQueue weightedTxnsQueue_;
-  std::atomic<size_t> jobsRunning_{0};
   std::atomic<size_t> threadCounts_{0};
   std::atomic<bool> stop_{false};
 
-  std::atomic<uint32_t> blockedThreads_{0};
   std::atomic<uint32_t> extraThreads_{0};
   bool stopExtra_;
 };
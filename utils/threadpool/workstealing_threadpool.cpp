@@ -0,0 +1,389 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <exception>
+#include <unistd.h>
+using namespace std;
+
+#include "messageobj.h"
+#include "messagelog.h"
+#include "threadnaming.h"
+using namespace logging;
+
+#include "workstealing_threadpool.h"
+
+#include "dbcon/joblist/primitivemsg.h"
+
+namespace
+{
+// The pool and the queue the current thread works for, so a rescheduled job goes back
+// to the queue of the worker that ran it.
+thread_local const void* tlsPool = nullptr;
+thread_local uint32_t tlsQueueIdx = 0;
+}  // namespace
+
+namespace threadpool
+{
+WorkStealingThreadPool::WorkStealingThreadPool(uint /*targetWeightPerRun*/, uint highThreads,
+                                               uint midThreads, uint lowThreads, uint /*id*/)
+{
+  uint32_t numberOfThreads = std::max(highThreads + midThreads + lowThreads, 1U);
+
+  for (uint32_t i = 0; i < numberOfThreads; ++i)
+    queues_.emplace_back(new WorkerQueue);
+
+  workerAlive_.reset(new std::atomic<bool>[numberOfThreads]);
+
+  for (uint32_t i = 0; i < numberOfThreads; ++i)
+  {
+    workerAlive_[i].store(true, std::memory_order_relaxed);
+    startWorker(i);
+  }
+
+  cout << "WorkStealingThreadPool started " << numberOfThreads << " thread/-s.\n";
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+  stop();
+  threads_.join_all();
+}
+
+void WorkStealingThreadPool::startWorker(uint32_t queueIdx)
+{
+  threads_.create_thread([this, queueIdx]() { threadFcn(queueIdx); });
+  threadCounts_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void WorkStealingThreadPool::addJob(const Job& job)
+{
+  // Replace the workers that died on an exception
+  if (threadCounts_.load(std::memory_order_relaxed) < queues_.size())
+  {
+    for (uint32_t i = 0; i < queues_.size(); ++i)
+    {
+      if (!workerAlive_[i].exchange(true))
+        startWorker(i);
+    }
+  }
+
+  // Only the submits that start or release extra threads take the pool-wide lock
+  const uint32_t blocked = blockedThreads_.load(std::memory_order_relaxed);
+  const uint32_t extra = extraThreads_.load(std::memory_order_relaxed);
+
+  if (blocked > extra || (blocked == 0 && extra > 0 && !stopExtra_.load(std::memory_order_relaxed)))
+    adjustExtraThreads();
+
+  uint32_t queueIdx = (tlsPool == this && tlsQueueIdx != NoQueue)
+                          ? tlsQueueIdx
+                          : nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+  WorkerQueue& queue = *queues_[queueIdx];
+
+  {
+    std::lock_guard<std::mutex> lk(queue.mutex);
+    auto [txnJobs, inserted] = queue.txnJobs.try_emplace(job.txnIdx_);
+
+    if (inserted)
+      queue.weightedTxns.push({job.weight_, job.txnIdx_});
+
+    txnJobs->second.push_back(job);
+    // Counted under the queue lock so the job can't be popped before it is counted.
+    queuedJobs_.fetch_add(1);
+  }
+
+  // Pairs with the sleeping_ increment in waitForJob(): either the sleeper sees the new job
+  // or this thread sees the sleeper.
+  if (sleeping_.load() > 0)
+  {
+    std::lock_guard<std::mutex> lk(sleepMutex_);
+    newJob_.notify_one();
+  }
+}
+
+void WorkStealingThreadPool::adjustExtraThreads()
+{
+  std::lock_guard<std::mutex> lk(extraMutex_);
+  // If some threads have blocked (because of output queue full)
+  // Temporarily add some extra worker threads to make up for the blocked threads.
+  if (blockedThreads_ > extraThreads_)
+  {
+    stopExtra_ = false;
+    threads_.create_thread([this]() { threadFcn(NoQueue); });
+    ++extraThreads_;
+  }
+  else if (blockedThreads_ == 0 && extraThreads_ > 0 && !stopExtra_)
+  {
+    // Release the temporary threads -- some threads have become unblocked.
+    stopExtra_ = true;
+    std::lock_guard<std::mutex> sleepLk(sleepMutex_);
+    newJob_.notify_all();
+  }
+}
+
+void WorkStealingThreadPool::removeJobs(uint32_t id)
+{
+  for (auto& queue : queues_)
+  {
+    std::lock_guard<std::mutex> lk(queue->mutex);
+
+    for (auto& [txnIdx, jobs] : queue->txnJobs)
+    {
+      for (auto job = jobs.begin(); job != jobs.end();)
+      {
+        if (job->id_ == id)
+        {
+          job = jobs.erase(job);
+          queuedJobs_.fetch_sub(1);
+          continue;
+        }
+        ++job;
+      }
+    }
+  }
+}
+
+bool WorkStealingThreadPool::popJob(WorkerQueue& queue, Job& job)
+{
+  while (!queue.weightedTxns.empty())
+  {
+    WeightedTxnT weightedTxn = queue.weightedTxns.top();
+    queue.weightedTxns.pop();
+    auto txnJobs = queue.txnJobs.find(weightedTxn.second);
+    auto& jobs = txnJobs->second;
+
+    if (jobs.empty())
+    {
+      queue.txnJobs.erase(txnJobs);
+      continue;
+    }
+
+    job = std::move(jobs.front());
+    jobs.pop_front();
+    queuedJobs_.fetch_sub(1);
+
+    // Add the txn back into the PQ adding some weight to it
+    if (jobs.empty())
+      queue.txnJobs.erase(txnJobs);
+    else
+      queue.weightedTxns.push({weightedTxn.first + job.weight_, weightedTxn.second});
+
+    return true;
+  }
+
+  return false;
+}
+
+bool WorkStealingThreadPool::tryPopJob(WorkerQueue& queue, Job& job)
+{
+  std::unique_lock<std::mutex> lk(queue.mutex, std::try_to_lock);
+  return lk.owns_lock() && popJob(queue, job);
+}
+
+bool WorkStealingThreadPool::findJob(uint32_t queueIdx, Job& job)
+{
+  const uint32_t queueCount = queues_.size();
+
+  if (queueIdx != NoQueue)
+  {
+    std::lock_guard<std::mutex> lk(queues_[queueIdx]->mutex);
+
+    if (popJob(*queues_[queueIdx], job))
+      return true;
+  }
+
+  // Steal. The first pass skips the queues other threads are busy with, the second one waits
+  // for them so a queued job is always found.
+  const uint32_t first =
+      (queueIdx != NoQueue) ? queueIdx + 1 : nextQueue_.load(std::memory_order_relaxed) % queueCount;
+
+  for (uint32_t i = 0; i < queueCount; ++i)
+  {
+    uint32_t victim = (first + i) % queueCount;
+
+    if (victim != queueIdx && tryPopJob(*queues_[victim], job))
+      return true;
+  }
+
+  for (uint32_t i = 0; i < queueCount && queuedJobs_.load(std::memory_order_relaxed) > 0; ++i)
+  {
+    uint32_t victim = (first + i) % queueCount;
+
+    if (victim == queueIdx)
+      continue;
+
+    std::lock_guard<std::mutex> lk(queues_[victim]->mutex);
+
+    if (popJob(*queues_[victim], job))
+      return true;
+  }
+
+  return false;
+}
+
+void WorkStealingThreadPool::waitForJob(bool extraThread)
+{
+  std::unique_lock<std::mutex> lk(sleepMutex_);
+  sleeping_.fetch_add(1);
+  newJob_.wait(lk,
+               [&]()
+               {
+                 return queuedJobs_.load() > 0 || stop_.load(std::memory_order_relaxed) ||
+                        (extraThread && stopExtra_.load(std::memory_order_relaxed));
+               });
+  sleeping_.fetch_sub(1);
+}
+
+void WorkStealingThreadPool::runJob(Job& job)
+{
+  jobsRunning_.fetch_add(1, std::memory_order_relaxed);
+  int rescheduleJob;
+
+  try
+  {
+    rescheduleJob = (*job.functor_)();  // run the functor
+  }
+  catch (...)
+  {
+    jobsRunning_.fetch_sub(1, std::memory_order_relaxed);
+    throw;
+  }
+
+  jobsRunning_.fetch_sub(1, std::memory_order_relaxed);
+  utils::setThreadName("Idle");
+
+  if (rescheduleJob)
+  {
+    // to avoid excessive CPU usage waiting for data from storage
+    usleep(500);
+
+    job.weight_ = rescheduledJobWeight(job.weight_, rescheduleJob);
+    addJob(job);
+  }
+}
+
+void WorkStealingThreadPool::threadFcn(uint32_t queueIdx)
+{
+  utils::setThreadName("Idle");
+  tlsPool = this;
+  tlsQueueIdx = queueIdx;
+  const bool extraThread = queueIdx == NoQueue;
+  Job job;
+  bool running = false;
+
+  try
+  {
+    while (!stop_.load(std::memory_order_relaxed))
+    {
+      if (!findJob(queueIdx, job))
+      {
+        // If this is an EXTRA thread due to other threads blocking, and all blockers are unblocked,
+        // we don't want this one any more.
+        if (extraThread && stopExtra_.load(std::memory_order_relaxed))
+        {
+          std::lock_guard<std::mutex> lk(extraMutex_);
+          --extraThreads_;
+          return;
+        }
+
+        waitForJob(extraThread);
+        continue;
+      }
+
+      running = true;
+      runJob(job);
+      running = false;
+      job = Job();
+    }
+  }
+  catch (std::exception& ex)
+  {
+    // Log the exception and exit this thread
+    try
+    {
+#ifndef NOLOGGING
+      logging::Message::Args args;
+      logging::Message message(5);
+      args.add("threadFcn: Caught exception: ");
+      args.add(ex.what());
+
+      message.format(args);
+
+      logging::LoggingID lid(22);
+      logging::MessageLog ml(lid);
+
+      ml.logErrorMessage(message);
+#endif
+
+      if (running)
+        error_handling::sendErrorMsg(logging::primitiveServerErr, job.uniqueID_, job.stepID_, job.sock_);
+    }
+    catch (...)
+    {
+      std::cout << "WorkStealingThreadPool::threadFcn(): std::exception - double exception: failed to send "
+                   "an error"
+                << std::endl;
+    }
+  }
+  catch (...)
+  {
+    try
+    {
+#ifndef NOLOGGING
+      logging::Message::Args args;
+      logging::Message message(6);
+      args.add("threadFcn: Caught unknown exception!");
+
+      message.format(args);
+
+      logging::LoggingID lid(22);
+      logging::MessageLog ml(lid);
+
+      ml.logErrorMessage(message);
+#endif
+
+      if (running)
+        error_handling::sendErrorMsg(logging::primitiveServerErr, job.uniqueID_, job.stepID_, job.sock_);
+    }
+    catch (...)
+    {
+      std::cout << "WorkStealingThreadPool::threadFcn(): ... exception - double exception: failed to send "
+                   "an error"
+                << std::endl;
+    }
+  }
+
+  // The queue of a dead worker is still served by the stealers, addJob() starts a new worker.
+  if (extraThread)
+  {
+    std::lock_guard<std::mutex> lk(extraMutex_);
+    --extraThreads_;
+  }
+  else if (!stop_.load(std::memory_order_relaxed))
+  {
+    workerAlive_[queueIdx].store(false);
+    threadCounts_.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+void WorkStealingThreadPool::stop()
+{
+  stop_.store(true, std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lk(sleepMutex_);
+  newJob_.notify_all();
+}
+
+}  // namespace threadpool
@@ -0,0 +1,110 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+#include <boost/thread/thread.hpp>
+
+#include "fair_threadpool.h"
+
+namespace threadpool
+{
+// A drop-in replacement for FairThreadPool that doesn't funnel every job through one mutex.
+// Every worker owns a queue that looks like the FairThreadPool one: jobs are grouped by txnIdx
+// and the txn with the smallest weight runs first, its weight growing with every job it runs.
+// External jobs are spread round-robin over the worker queues so every queue sees a share of
+// every query and the per-queue weights keep the queries fair overall. A job a worker
+// reschedules goes back to the queue of that worker. A worker with an empty queue steals the
+// next job from the other queues, taking it the same way the owner would, before it sleeps.
+class WorkStealingThreadPool : public FairThreadPool
+{
+ public:
+  WorkStealingThreadPool(uint targetWeightPerRun, uint highThreads, uint midThreads, uint lowThreads,
+                         uint id = 0);
+  ~WorkStealingThreadPool() override;
+
+  void removeJobs(uint32_t id) override;
+  void addJob(const Job& job) override;
+  void stop() override;
+
+  // The number of jobs waiting to run.
+  size_t queueSize() const override
+  {
+    return queuedJobs_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  using WeightT = uint32_t;
+  using WeightedTxnT = std::pair<WeightT, TransactionIdxT>;
+  struct PrioQueueCmp
+  {
+    bool operator()(WeightedTxnT lhs, WeightedTxnT rhs)
+    {
+      if (lhs.first == rhs.first)
+        return lhs.second > rhs.second;
+      return lhs.first > rhs.first;
+    }
+  };
+  using WeightedTxnPrioQueue = std::priority_queue<WeightedTxnT, std::vector<WeightedTxnT>, PrioQueueCmp>;
+
+  // A txn is in the map if and only if it is in the PQ. Its job list may be empty after
+  // removeJobs(), the txn is then dropped when it reaches the top of the PQ.
+  struct alignas(64) WorkerQueue
+  {
+    std::mutex mutex;
+    std::unordered_map<TransactionIdxT, std::deque<Job>> txnJobs;
+    WeightedTxnPrioQueue weightedTxns;
+  };
+
+  static constexpr uint32_t NoQueue = UINT32_MAX;
+
+  void startWorker(uint32_t queueIdx);
+  void adjustExtraThreads();
+  void threadFcn(uint32_t queueIdx);
+  bool popJob(WorkerQueue& queue, Job& job);
+  bool tryPopJob(WorkerQueue& queue, Job& job);
+  bool findJob(uint32_t queueIdx, Job& job);
+  void waitForJob(bool extraThread);
+  void runJob(Job& job);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  std::unique_ptr<std::atomic<bool>[]> workerAlive_;
+  std::atomic<uint32_t> nextQueue_{0};
+  std::atomic<size_t> queuedJobs_{0};
+  std::atomic<size_t> threadCounts_{0};
+  std::atomic<bool> stop_{false};
+
+  std::mutex sleepMutex_;
+  std::condition_variable newJob_;
+  std::atomic<uint32_t> sleeping_{0};
+
+  std::mutex extraMutex_;  // taken to start or release the extra threads
+  std::atomic<uint32_t> extraThreads_{0};
+  std::atomic<bool> stopExtra_{false};
+
+  boost::thread_group threads_;
+};
+
+}  // namespace threadpool
@@ -0,0 +1,108 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+#include <algorithm>
+
+#include "topnrows.h"
+
+using namespace rowgroup;
+
+namespace ordering
+{
+TopNRows::TopNRows(const RowGroup& rg, const std::vector<IdbSortSpec>& spec, uint32_t limit)
+ : fSpec(spec), fLimit(limit), fCompare(spec, rg), fRowGroup(rg), fReplaced(0)
+{
+  fHeap.reserve(fLimit);
+  fRowGroup.initRow(&fRow);
+  reset();
+}
+
+void TopNRows::reset()
+{
+  fData.reinit(fRowGroup, fLimit);
+  fRowGroup.setData(&fData);
+  fRowGroup.resetRowGroup(0);
+  fHeap.clear();
+  fReplaced = 0;
+}
+
+void TopNRows::addRows(const RowGroup& in)
+{
+  if (fLimit == 0)
+    return;
+
+  auto sortsBefore = [this](const Row::Pointer& lhs, const Row::Pointer& rhs)
+  { return fCompare(lhs, rhs); };
+  in.initRow(&fInRow);
+  in.getRow(0, &fInRow);
+
+  for (uint32_t i = 0; i < in.getRowCount(); ++i, fInRow.nextRow())
+  {
+    if (fHeap.size() < fLimit)
+    {
+      fRowGroup.getRow(fHeap.size(), &fRow);
+      copyRow(fInRow, &fRow);
+      fRowGroup.incRowCount();
+      fHeap.push_back(fRow.getPointer());
+      std::push_heap(fHeap.begin(), fHeap.end(), sortsBefore);
+    }
+    else if (sortsBefore(fInRow.getPointer(), fHeap.front()))
+    {
+      // The last row gives its place to this one
+      std::pop_heap(fHeap.begin(), fHeap.end(), sortsBefore);
+      fRow.setPointer(fHeap.back());
+      copyRow(fInRow, &fRow);
+      std::push_heap(fHeap.begin(), fHeap.end(), sortsBefore);
+
+      // A replaced row leaves its long strings in the string store
+      if (fRowGroup.usesStringTable() && ++fReplaced > 4 * fLimit)
+        compact();
+    }
+  }
+}
+
+void TopNRows::compact()
+{
+  RGData data(fRowGroup, fLimit);
+  RowGroup rowGroup(fRowGroup);
+  Row row;
+  rowGroup.setData(&data);
+  rowGroup.resetRowGroup(0);
+  rowGroup.initRow(&row);
+
+  // Row i takes heap position i, so the heap stays a heap
+  for (uint32_t i = 0; i < fHeap.size(); ++i)
+  {
+    fRow.setPointer(fHeap[i]);
+    rowGroup.getRow(i, &row);
+    copyRow(fRow, &row);
+    rowGroup.incRowCount();
+  }
+
+  fData = data;
+  fRowGroup.setData(&fData);
+
+  for (uint32_t i = 0; i < fHeap.size(); ++i)
+  {
+    fRowGroup.getRow(i, &fRow);
+    fHeap[i] = fRow.getPointer();
+  }
+
+  fReplaced = 0;
+}
+
+}  // namespace ordering
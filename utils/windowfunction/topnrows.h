@@ -0,0 +1,72 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+/** @file */
+
+#pragma once
+
+#include <vector>
+
+#include "idborderby.h"
+#include "rowgroup.h"
+
+namespace ordering
+{
+// The Top-N of ORDER BY ... LIMIT N pushed down into the PrimProc BPP.
+// Keeps the first N rows of a stream of RowGroups in the sort order, the other rows can't
+// be in the result. The rows stay in one RowGroup and a heap of their pointers keeps the last
+// of them on top, so a row that sorts before it takes its place.
+class TopNRows
+{
+ public:
+  // limit must not exceed rowgroup::rgCommonSize
+  TopNRows(const rowgroup::RowGroup& rg, const std::vector<IdbSortSpec>& spec, uint32_t limit);
+
+  void addRows(const rowgroup::RowGroup& in);
+
+  // The rows kept since the last reset(), not sorted
+  rowgroup::RowGroup& result()
+  {
+    return fRowGroup;
+  }
+  void reset();
+
+  uint32_t limit() const
+  {
+    return fLimit;
+  }
+  const std::vector<IdbSortSpec>& spec() const
+  {
+    return fSpec;
+  }
+
+ private:
+  // Copies the kept rows to a new RGData dropping the strings of the replaced ones
+  void compact();
+
+  std::vector<IdbSortSpec> fSpec;
+  const uint32_t fLimit;
+  OrderByData fCompare;
+  rowgroup::RowGroup fRowGroup;
+  rowgroup::RGData fData;
+  rowgroup::Row fRow;
+  rowgroup::Row fInRow;
+  std::vector<rowgroup::Row::Pointer> fHeap;
+  uint32_t fReplaced;
+};
+
+}  // namespace ordering
@@ -39,6 +39,7 @@
 #include "we_simplesyslog.h"
 #include "we_bulkload.h"
 #include "we_bulkstatus.h"
+#include "we_parquetreader.h"
 #include "we_config.h"
 #include "we_xmljob.h"
 #include "we_xmlgenproc.h"
@@ -163,6 +164,8 @@ void printUsage()
        << "           or as part of NULL escape sequence ('\\N'); default is '\\'" << endl
        << "        -I Binary import; binaryOpt 1-import NULL values" << endl
        << "                                    2-saturate NULL values" << endl
+       << "                                    3-import Parquet files" << endl
+       << "                                    4-import an Arrow IPC stream" << endl
        << "        -S Treat string truncations as errors" << endl
        << "        -D Disable timeout when waiting for table lock" << endl
        << "        -N Disable console output" << endl
@@ -620,13 +623,20 @@ void parseCmdLineArgs(int argc, char** argv, BulkLoad& curJob, std::string& sJob
       {
         ImportDataMode importMode = (ImportDataMode)atoi(optarg);
 
-        if ((importMode != IMPORT_DATA_BIN_ACCEPT_NULL) && (importMode != IMPORT_DATA_BIN_SAT_NULL))
+        if ((importMode != IMPORT_DATA_BIN_ACCEPT_NULL) && (importMode != IMPORT_DATA_BIN_SAT_NULL) &&
+            (importMode != IMPORT_DATA_PARQUET) && (importMode != IMPORT_DATA_ARROW))
         {
           startupError(std::string("Invalid binary import option; value can be 1"
-                                   "(accept NULL values) or 2(saturate NULL values)"),
+                                   "(accept NULL values), 2(saturate NULL values), 3(Parquet) or 4(Arrow)"),
                        true);
         }
 
+        if (((importMode == IMPORT_DATA_PARQUET) || (importMode == IMPORT_DATA_ARROW)) &&
+            !ParquetReader::supported())
+        {
+          startupError(std::string("Parquet and Arrow import are not supported by this build"), false);
+        }
+
         curJob.setImportDataMode(importMode);
         break;
       }
@@ -421,8 +421,8 @@ int BulkLoad::loadJobInfo(const string& fullName, bool bUseTempJobFile, int argc
     }
   }
 
-  // If binary import, do not allow <IgnoreField> tags in the Job file
-  if ((fImportDataMode == IMPORT_DATA_BIN_ACCEPT_NULL) || (fImportDataMode == IMPORT_DATA_BIN_SAT_NULL))
+  // If binary or Parquet import, do not allow <IgnoreField> tags in the Job file
+  if (fImportDataMode != IMPORT_DATA_TEXT)
   {
     for (unsigned kT = 0; kT < curJob.jobTableList.size(); kT++)
     {
@@ -471,6 +471,13 @@ void BulkLoad::spawnWorkers()
     cancelThread = boost::thread(cancelationThread);
   }
 
+  // With more than one read thread, the read threads left without a table
+  // to read tokenize the buffers of the tables still being read
+  for (unsigned i = 0; i < fTableInfo.size(); ++i)
+  {
+    fTableInfo[i]->setReadAhead(fNoOfReadThreads > 1);
+  }
+
   // Spawn read threads
   for (int i = 0; i < fNoOfReadThreads; ++i)
   {
@@ -752,8 +759,9 @@ int BulkLoad::preProcess(Job& job, int tableNo, std::shared_ptr<TableInfo>& tabl
       }
     }
 
-    // For binary input mode, sum up the columns widths to get fixed rec len
-    if ((fImportDataMode == IMPORT_DATA_BIN_ACCEPT_NULL) || (fImportDataMode == IMPORT_DATA_BIN_SAT_NULL))
+    // For binary input mode, sum up the columns widths to get fixed rec len.
+    // Parquet and Arrow input is converted to the same fixed length records.
+    if (fImportDataMode != IMPORT_DATA_TEXT)
     {
       if (job.jobTableList[tableNo].fFldRefs[i].fFldColType == BULK_FLDCOL_COLUMN_FIELD)
       {
@@ -834,6 +842,14 @@ int BulkLoad::preProcess(Job& job, int tableNo, std::shared_ptr<TableInfo>& tabl
 
     fLog.logMsg(oss12.str(), MSGLVL_INFO2);
   }
+  else if ((fImportDataMode == IMPORT_DATA_PARQUET) || (fImportDataMode == IMPORT_DATA_ARROW))
+  {
+    ostringstream oss12;
+    oss12 << "Table " << job.jobTableList[tableNo].tblName << " will be imported from "
+          << ((fImportDataMode == IMPORT_DATA_PARQUET) ? "Parquet files" : "an Arrow stream")
+          << " converted to records of length: " << fixedBinaryRecLen << " bytes";
+    fLog.logMsg(oss12.str(), MSGLVL_INFO2);
+  }
 
   // Initialize BulkLoadBuffers after we have added all the columns
   rc = tableInfo->initializeBuffers(fNoOfBuffers, job.jobTableList[tableNo].fFldRefs, fixedBinaryRecLen);
@@ -250,6 +250,10 @@ class BulkLoad : public FileOp
   // Lock the table for read. Called by the read thread.
   int lockTableForRead(int id);
 
+  // Tokenize the buffers read ahead for the tables still being read.
+  // Called by the read thread left without a table to read.
+  void tokenizeReadAhead();
+
   // Get column for parsing. Called by the parse thread.
   // @bug 2099 - Temporary hack to diagnose deadlock. Added report parm below.
   bool lockColumnForParse(int id,              // thread id
@@ -33,6 +33,7 @@
 
 #include "we_bulkload.h"
 #include "we_bulkloadbuffer.h"
+#include "we_fieldscan.h"
 #include "we_brm.h"
 #include "we_convertor.h"
 #include "we_log.h"
@@ -55,6 +56,7 @@ const std::string INPUT_ERROR_TOO_LONG = "Data in wrong format; exceeds max fiel
 const std::string INPUT_ERROR_NULL_CONSTRAINT = "Data violates NOT NULL constraint with no default";
 const std::string INPUT_ERROR_ODD_VARBINARY_LENGTH = "VarBinary column is incomplete; odd number of bytes; ";
 const std::string INPUT_ERROR_STRING_TOO_LONG = "Character data exceeds max field length; ";
+const std::string INPUT_ERROR_INCOMPLETE_ROW = "Incomplete row at end of input file";
 const char NULL_CHAR = 'N';
 const char* NULL_VALUE_STRING = "NULL";
 const char NULL_AUTO_INC_0 = '0';
@@ -83,6 +85,24 @@ inline void resizeRowDataArray(char** pRowData, unsigned int dataLength, unsigne
   *pRowData = tmpRaw;
 }
 
+//------------------------------------------------------------------------------
+// Append "length" bytes to pRowData, expanding it as needed
+//------------------------------------------------------------------------------
+inline void appendRowData(char** pRowData, unsigned int& dataLength, unsigned int& arrayCapacity,
+                          const char* data, unsigned int length)
+{
+  if (dataLength + length > arrayCapacity)
+  {
+    while (dataLength + length > arrayCapacity)
+      arrayCapacity = arrayCapacity * 2;
+
+    resizeRowDataArray(pRowData, dataLength, arrayCapacity);
+  }
+
+  memcpy(*pRowData + dataLength, data, length);
+  dataLength += length;
+}
+
 }  // namespace
 
 //#define DEBUG_TOKEN_PARSING 1
@@ -2243,6 +2263,120 @@ int BulkLoadBuffer::fillFromFile(const BulkLoadBuffer& overFlowBufIn, FILE* hand
   return NO_ERROR;
 }
 
+//------------------------------------------------------------------------------
+// Read the next set of rows from the input import file into "this"
+// BulkLoadBuffer, to be tokenized by tokenizeRows() while the read thread goes
+// on reading.  The data read ends with the last row that is complete in it, so
+// the tokenizing of a buffer does not depend on the buffers read before it.
+// overflow (input/output) - bytes after the last complete row read before,
+//   to start the buffer with; replaced by the bytes left now
+// bEndOfData (output) - the end of the input was reached
+//------------------------------------------------------------------------------
+int BulkLoadBuffer::readRowsFromFile(std::vector<char>& overflow, FILE* handle, bool& bEndOfData)
+{
+  boost::mutex::scoped_lock lock(fSyncUpdatesBLB);
+  reset();
+  fStartRowForLogging = 0;
+
+  if (fOverflowBuf != NULL)
+  {
+    delete[] fOverflowBuf;
+    fOverflowBuf = NULL;
+  }
+
+  fOverflowSize = 0;
+
+  size_t dataSize = overflow.size();
+
+  if (dataSize != 0)
+    memcpy(fData, overflow.data(), dataSize);
+
+  dataSize += fread(fData + dataSize, 1, fBufferSize - dataSize, handle);
+
+  if (ferror(handle))
+  {
+    return ERR_FILE_READ_IMPORT;
+  }
+
+  bEndOfData = feof(handle);
+
+  // @bug 3516: Add '\n' if missing from last record
+  if (bEndOfData && (dataSize > 0) && (fData[dataSize - 1] != NEWLINE_CHAR))
+  {
+    fData[dataSize] = NEWLINE_CHAR;
+    dataSize++;
+  }
+
+  fReadSize = findLastRowEnd(fData, fData + dataSize, fColDelim, fEnclosedByChar, fEscapeChar) - fData;
+  overflow.assign(fData + fReadSize, fData + dataSize);
+
+  // No more data completes the row, it is rejected instead of being carried
+  // over into the next input file.
+  if (bEndOfData)
+  {
+    fTrailingRow.assign(overflow.begin(), overflow.end());
+    overflow.clear();
+  }
+  else
+    fTrailingRow.clear();
+
+  // Lazy allocation of fToken memory as needed
+  if (fTokens == 0)
+  {
+    resizeTokenArray();
+  }
+
+  // If we read a full buffer without finding the end of a row, then
+  // terminate import because row size is greater than read buffer size.
+  if ((fReadSize == 0) && (dataSize == fBufferSize))
+  {
+    return ERR_BULK_ROW_FILL_BUFFER;
+  }
+
+  return NO_ERROR;
+}
+
+//------------------------------------------------------------------------------
+// Tokenize the rows read into "this" BulkLoadBuffer by readRowsFromFile().
+// Called by any read thread; the buffers read ahead are tokenized concurrently.
+//------------------------------------------------------------------------------
+void BulkLoadBuffer::tokenizeRows(const boost::ptr_vector<ColumnInfo>& columnsInfo,
+                                  unsigned int allowedErrCntThisCall)
+{
+  boost::mutex::scoped_lock lock(fSyncUpdatesBLB);
+
+  if (fReadSize > 0)
+    tokenize(columnsInfo, allowedErrCntThisCall);
+
+  if (!fTrailingRow.empty())
+  {
+    fTotalReadRowsForLog++;
+    fErrRows.push_back(fTrailingRow);
+    fRowStatus.push_back(std::pair<RID, std::string>(fTotalReadRowsForLog, INPUT_ERROR_INCOMPLETE_ROW));
+    fTrailingRow.clear();
+  }
+}
+
+//------------------------------------------------------------------------------
+// Assign the starting row ids of the rows tokenized by tokenizeRows(), which
+// did not know how many rows the buffers before this one hold.
+// totalReadRows (input/output) - total row count from tokenize() (per file)
+// correctTotalRows (input/output) - total valid row count from tokenize()
+//   (cumulative)
+//------------------------------------------------------------------------------
+void BulkLoadBuffer::setStartRows(RID& totalReadRows, RID& correctTotalRows)
+{
+  boost::mutex::scoped_lock lock(fSyncUpdatesBLB);
+  fStartRow = correctTotalRows;
+  fStartRowForLogging = totalReadRows;
+
+  for (auto& rowStatus : fRowStatus)
+    rowStatus.first += fStartRowForLogging;
+
+  totalReadRows += fTotalReadRowsForLog;
+  correctTotalRows += fTotalReadRows;
+}
+
 //------------------------------------------------------------------------------
 // Parse the rows of data in "fData", saving the meta information that describes
 // the parsed data, in fTokens.  If the number of read parsing errors for a
@@ -2371,8 +2505,14 @@ void BulkLoadBuffer::tokenize(const boost::ptr_vector<ColumnInfo>& columnsInfo,
         }
         else
         {
-          offset++;
-          p++;
+          // Step over the rest of the plain bytes of the field at once
+          char* pNext = findEitherChar(p + 1, pEndOfData, FIELD_DELIM_CHAR, NEWLINE_CHAR);
+
+          if (rawDataRowLength > 0)
+            appendRowData(&pRawDataRow, rawDataRowLength, rawDataRowCapacity, p + 1, pNext - p - 1);
+
+          offset += pNext - p;
+          p = pNext;
           continue;  // process next byte
         }
 
@@ -2475,12 +2615,22 @@ void BulkLoadBuffer::tokenize(const boost::ptr_vector<ColumnInfo>& columnsInfo,
 
         else
         {
+          // Move the plain bytes up to the next enclosing or escape character at once
+          char* pNext = findEitherChar(p + 1, pEndOfData, STRING_ENCLOSED_CHAR, ESCAPE_CHAR);
+          unsigned length = pNext - p;
+
+          // The raw bytes are saved before the move may write over them
+          if (rawDataRowLength > 0)
+            appendRowData(&pRawDataRow, rawDataRowLength, rawDataRowCapacity, p + 1, length - 1);
+
           if (idxTo != idxFrom)
-            fData[idxTo] = fData[idxFrom];
+            memmove(fData + idxTo, fData + idxFrom, length);
 
-          idxFrom++;
-          idxTo++;
-          offset++;
+          idxFrom += length;
+          idxTo += length;
+          offset += length;
+          p = pNext;
+          continue;  // process next byte
         }
 
         p++;
@@ -2995,9 +3145,11 @@ int BulkLoadBuffer::tokenizeBinary(const boost::ptr_vector<ColumnInfo>& columnsI
 
             default:
             {
-              // In BinaryAcceptNULL mode, check for NULL value
+              // In BinaryAcceptNULL mode, check for NULL value; Parquet
+              // and Arrow NULLs are converted to the same NULL values.
               if ((fTokens[curRowNum1][curCol].offset != COLPOSPAIR_NULL_TOKEN_OFFSET) &&
-                  (fImportDataMode == IMPORT_DATA_BIN_ACCEPT_NULL))
+                  ((fImportDataMode == IMPORT_DATA_BIN_ACCEPT_NULL) ||
+                   (fImportDataMode == IMPORT_DATA_PARQUET) || (fImportDataMode == IMPORT_DATA_ARROW)))
               {
                 if (isBinaryFieldNull(p, jobCol.weType, jobCol.dataType))
                 {
@@ -3149,6 +3301,14 @@ bool BulkLoadBuffer::isBinaryFieldNull(void* val, WriteEngine::ColType ct,
       break;
     }
 
+    case WriteEngine::WR_MEDINT:
+    {
+      if ((*(uint32_t*)val) == joblist::INTNULL)
+        isNullFlag = true;
+
+      break;
+    }
+
     case WriteEngine::WR_INT:
     {
       if (dt == execplan::CalpontSystemCatalog::DATE)
@@ -3237,6 +3397,7 @@ bool BulkLoadBuffer::isBinaryFieldNull(void* val, WriteEngine::ColType ct,
       break;
     }
 
+    case WriteEngine::WR_UMEDINT:
     case WriteEngine::WR_UINT:
     {
       if ((*(uint32_t*)val) == joblist::UINTNULL)
@@ -104,6 +104,8 @@ class BulkLoadBuffer
   //   size of fTokens array
   std::vector<std::pair<RID, std::string> > fRowStatus;  // Status of bad rows
   std::vector<std::string> fErrRows;                     // Rejected rows to write to .bad file
+  std::string fTrailingRow;  // Bytes at the end of the input that are not a complete row,
+  //   read by readRowsFromFile() and rejected by tokenizeRows()
 
   uint32_t fTotalReadRows;  // Total valid rows read into buffer;
   //   this count excludes rejected rows
@@ -278,6 +280,23 @@ class BulkLoadBuffer
   int fillFromFile(const BulkLoadBuffer& overFlowBufIn, FILE* handle, RID& totalRows, RID& correctTotalRows,
                    const boost::ptr_vector<ColumnInfo>& columnsInfo, unsigned int allowedErrCntThisCall);
 
+  /** @brief Read the complete rows of the next part of the table data into
+   *  the buffer, without tokenizing them.
+   *  @param overflow (in/out) Bytes after the last complete row read before,
+   *         replaced by the bytes after the last complete row read now
+   *  @param bEndOfData (out) The end of the input was reached
+   */
+  int readRowsFromFile(std::vector<char>& overflow, FILE* handle, bool& bEndOfData);
+
+  /** @brief Tokenize the rows read by readRowsFromFile().
+   */
+  void tokenizeRows(const boost::ptr_vector<ColumnInfo>& columnsInfo, unsigned int allowedErrCntThisCall);
+
+  /** @brief Number the rows tokenized by tokenizeRows() after the rows read
+   *  before them, the counts are updated as by fillFromFile().
+   */
+  void setStartRows(RID& totalReadRows, RID& correctTotalRows);
+
   /** @brief Get the overflow size
    */
   int getOverFlowSize() const
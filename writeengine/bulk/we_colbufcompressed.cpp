@@ -28,6 +28,7 @@
 #include "we_colbufcompressed.h"
 
 #include <cassert>
+#include <chrono>
 #include <cstdio>
 #include <cstring>
 #include <iostream>
@@ -48,8 +49,50 @@ using namespace idbdatafile;
 #include "idbcompress.h"
 using namespace compress;
 
+#include "threadpool.h"
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Thread pool compressing the chunks of all the compressed columns; null if
+// the chunks are compressed by the threads writing them.
+//------------------------------------------------------------------------------
+threadpool::ThreadPool* compressionThreadPool()
+{
+  static threadpool::ThreadPool* pool = []() -> threadpool::ThreadPool*
+  {
+    unsigned numThreads = WriteEngine::Config::getNumCompressionThreads();
+
+    if (numThreads == 0)
+      return nullptr;
+
+    threadpool::ThreadPool* newPool = new threadpool::ThreadPool(numThreads, numThreads * 2);
+    newPool->setName("BulkCompressPool");
+    return newPool;
+  }();
+
+  return pool;
+}
+}  // namespace
+
 namespace WriteEngine
 {
+//------------------------------------------------------------------------------
+// A full to-be-compressed buffer and its compressed chunk.
+//------------------------------------------------------------------------------
+struct ColumnBufferCompressed::Chunk
+{
+  std::shared_ptr<compress::CompressInterface> compressor;
+  const unsigned char* data;  // to-be-compressed buffer, owned by the column
+  size_t dataLen;
+  boost::scoped_array<unsigned char> outBuf;  // compressed chunk
+  size_t outLen;
+  compress::ChunkZoneMap zoneMap;
+  int rc;
+  bool queued;  // compressed by the thread pool
+  uint64_t job;  // thread pool handle if queued
+};
+
 //------------------------------------------------------------------------------
 // Constructor
 //------------------------------------------------------------------------------
@@ -60,9 +103,11 @@ ColumnBufferCompressed::ColumnBufferCompressed(ColumnInfo* pColInfo, Log* logger
  , fNumBytes(0)
  , fPreLoadHWMChunk(true)
  , fFlushedStartHwmChunk(false)
+ , fSpareBuffer(0)
 {
   fUserPaddingBytes = Config::getNumCompressedPadBlks() * BYTE_PER_BLOCK;
-  compress::initializeCompressorPool(fCompressorPool, fUserPaddingBytes);
+  compress::initializeCompressorPool(fCompressorPool, fUserPaddingBytes, Config::getCompressionLevel(),
+                                     Config::getChunkEncoding());
 }
 
 //------------------------------------------------------------------------------
@@ -70,10 +115,17 @@ ColumnBufferCompressed::ColumnBufferCompressed(ColumnInfo* pColInfo, Log* logger
 //------------------------------------------------------------------------------
 ColumnBufferCompressed::~ColumnBufferCompressed()
 {
+  // A chunk left by an error may still be compressed from fSpareBuffer
+  if (fPendingChunk && fPendingChunk->queued)
+    compressionThreadPool()->join(fPendingChunk->job);
+
   if (fToBeCompressedBuffer)
     delete[] fToBeCompressedBuffer;
 
+  delete[] fSpareBuffer;
+
   fToBeCompressedBuffer = 0;
+  fSpareBuffer = 0;
   fToBeCompressedCapacity = 0;
   fNumBytes = 0;
 }
@@ -110,6 +162,11 @@ int ColumnBufferCompressed::setDbFile(IDBDataFile* f, HWM startHwm, const char*
     fChunkPtrs.resize(chunkIndex + 1);
   }
 
+  fChunkZoneMaps.assign(fChunkPtrs.size(), compress::ChunkZoneMap());
+
+  for (unsigned int i = 0; i < fChunkZoneMaps.size(); i++)
+    compress::CompressInterface::getChunkZoneMap(hdrs, i, fChunkZoneMaps[i]);
+
   return NO_ERROR;
 }
 
@@ -334,6 +391,11 @@ int ColumnBufferCompressed::writeToFile(int startOffset, int writeSize, bool fil
 // Compress and write out the data in the to-be-compressed buffer.
 // Also may write out the compression header.
 //
+// Unless bFinishingFile is true, the buffer is handed to the compression
+// thread pool and swapped with a spare buffer, for the caller to go on with
+// the next chunk while it is compressed. The chunk is written out by the next
+// call, after the chunk before it, so the chunks stay in the file order.
+//
 // bFinishingFile indicates whether we are finished working with this file,
 // either because we are completing an extent or because we have reached the
 // end of the input data.  In either case, if bFinishingFile is true, then
@@ -358,22 +420,74 @@ int ColumnBufferCompressed::compressAndFlush(bool bFinishingFile)
     return ERR_COMP_WRONG_COMP_TYPE;
   }
 
-  const size_t OUTPUT_BUFFER_SIZE = compressor->maxCompressedSize(fToBeCompressedCapacity) +
-                                    fUserPaddingBytes +
-                                    // Padded len = len + COMPRESSED_SIZE_INCREMENT_CHUNK - (len %
-                                    // COMPRESSED_SIZE_INCREMENT_CHUNK) + usePadding
-                                    compress::CompressInterface::COMPRESSED_CHUNK_INCREMENT_SIZE;
+  // Write out the chunk compressed while this one was buffered
+  RETURN_ON_ERROR(flushPendingChunk(false));
+
+  boost::shared_ptr<Chunk> chunk(new Chunk());
+  chunk->compressor = compressor;
+  chunk->data = fToBeCompressedBuffer;
+  chunk->dataLen = fToBeCompressedCapacity;
+  chunk->outLen = 0;
+  chunk->rc = NO_ERROR;
+  chunk->queued = false;
+  chunk->job = 0;
+  fPendingChunk = chunk;
 
-  unsigned char* compressedOutBuf = new unsigned char[OUTPUT_BUFFER_SIZE];
-  boost::scoped_array<unsigned char> compressedOutBufPtr(compressedOutBuf);
-  size_t outputLen = OUTPUT_BUFFER_SIZE;
+  threadpool::ThreadPool* pool = compressionThreadPool();
 
+  if (bFinishingFile || !pool)
+  {
 #ifdef PROFILE
-  Stats::startParseEvent(WE_STATS_COMPRESS_COL_COMPRESS);
+    Stats::startParseEvent(WE_STATS_COMPRESS_COL_COMPRESS);
 #endif
+    chunk->rc = compressChunk(*chunk);
+#ifdef PROFILE
+    Stats::stopParseEvent(WE_STATS_COMPRESS_COL_COMPRESS);
+#endif
+    return flushPendingChunk(bFinishingFile);
+  }
 
-  int rc = compressor->compressBlock(reinterpret_cast<char*>(fToBeCompressedBuffer), fToBeCompressedCapacity,
-                                     compressedOutBuf, outputLen);
+  if (!fSpareBuffer)
+    fSpareBuffer = new unsigned char[CompressInterface::UNCOMPRESSED_INBUF_LEN];
+
+  std::swap(fToBeCompressedBuffer, fSpareBuffer);
+  chunk->queued = true;
+  chunk->job = pool->invoke(
+      [this, chunk]()
+      {
+        try
+        {
+          chunk->rc = compressChunk(*chunk);
+        }
+        catch (std::exception&)
+        {
+          chunk->rc = ERR_COMP_COMPRESS;
+        }
+      });
+
+  return NO_ERROR;
+}
+
+//------------------------------------------------------------------------------
+// Compress a to-be-compressed buffer into its padded chunk and compute the
+// zone map of the chunk. Called by a thread of the compression thread pool,
+// so this only reads the column.
+//------------------------------------------------------------------------------
+int ColumnBufferCompressed::compressChunk(Chunk& chunk) const
+{
+  auto startTime = std::chrono::steady_clock::now();
+
+  const size_t OUTPUT_BUFFER_SIZE = chunk.compressor->maxCompressedSize(chunk.dataLen) + fUserPaddingBytes +
+                                    // Padded len = len + COMPRESSED_SIZE_INCREMENT_CHUNK - (len %
+                                    // COMPRESSED_SIZE_INCREMENT_CHUNK) + usePadding
+                                    compress::CompressInterface::COMPRESSED_CHUNK_INCREMENT_SIZE;
+
+  chunk.outBuf.reset(new unsigned char[OUTPUT_BUFFER_SIZE]);
+  chunk.outLen = OUTPUT_BUFFER_SIZE;
+
+  int rc = chunk.compressor->compressBlock(reinterpret_cast<const char*>(chunk.data), chunk.dataLen,
+                                           chunk.outBuf.get(), chunk.outLen, fColInfo->column.width,
+                                           fColInfo->column.dataType);
 
   if (rc != 0)
   {
@@ -381,40 +495,80 @@ int ColumnBufferCompressed::compressAndFlush(bool bFinishingFile)
   }
 
   // Round up the compressed chunk size
-  rc = compressor->padCompressedChunks(compressedOutBuf, outputLen, OUTPUT_BUFFER_SIZE);
+  rc = chunk.compressor->padCompressedChunks(chunk.outBuf.get(), chunk.outLen, OUTPUT_BUFFER_SIZE);
 
   if (rc != 0)
   {
     return ERR_COMP_PAD_DATA;
   }
 
+  // PrimProc skips the chunks whose zone map can't match the scan filter
+  FileOp::computeChunkZoneMap(chunk.data, chunk.dataLen, fColInfo->column.dataType, fColInfo->column.width,
+                              fColInfo->column.emptyVal, chunk.zoneMap);
+
+  auto usecs =
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+  fColInfo->incCompressStats(usecs.count(), chunk.dataLen, chunk.outLen);
+
+  return NO_ERROR;
+}
+
+//------------------------------------------------------------------------------
+// Wait for the pending chunk to be compressed and write it out after the
+// chunks before it. Writes out the compression headers if bFinishingFile is
+// true or if this is the starting HWM chunk (see compressAndFlush()).
+//------------------------------------------------------------------------------
+int ColumnBufferCompressed::flushPendingChunk(bool bFinishingFile)
+{
+  if (!fPendingChunk)
+    return NO_ERROR;
+
+  boost::shared_ptr<Chunk> chunk;
+  chunk.swap(fPendingChunk);
+
+  if (chunk->queued)
+  {
+#ifdef PROFILE
+    Stats::startParseEvent(WE_STATS_COMPRESS_COL_COMPRESS);
+#endif
+    compressionThreadPool()->join(chunk->job);
+#ifdef PROFILE
+    Stats::stopParseEvent(WE_STATS_COMPRESS_COL_COMPRESS);
+#endif
+  }
+
+  if (chunk->rc != NO_ERROR)
+    return chunk->rc;
+
 #ifdef PROFILE
-  Stats::stopParseEvent(WE_STATS_COMPRESS_COL_COMPRESS);
   Stats::startParseEvent(WE_STATS_WRITE_COL);
 #endif
 
   off64_t fileOffset = fFile->tell();
-  size_t nitems = fFile->write(compressedOutBuf, outputLen) / outputLen;
+  size_t nitems = fFile->write(chunk->outBuf.get(), chunk->outLen) / chunk->outLen;
 
   if (nitems != 1)
     return ERR_FILE_WRITE;
 
-  CompChunkPtr compChunk((uint64_t)fileOffset, (uint64_t)outputLen);
+  CompChunkPtr compChunk((uint64_t)fileOffset, (uint64_t)chunk->outLen);
   fChunkPtrs.push_back(compChunk);
+  fChunkZoneMaps.resize(fChunkPtrs.size());
+  fChunkZoneMaps.back() = chunk->zoneMap;
 
   if (fLog->isDebug(DEBUG_2))
   {
     std::ostringstream oss;
     oss << "Writing compressed data for: OID-" << fColInfo->curCol.dataFile.fid << "; DBRoot-"
         << fColInfo->curCol.dataFile.fDbRoot << "; part-" << fColInfo->curCol.dataFile.fPartition << "; seg-"
-        << fColInfo->curCol.dataFile.fSegment << "; bytes-" << outputLen << "; fileOffset-" << fileOffset;
+        << fColInfo->curCol.dataFile.fSegment << "; bytes-" << chunk->outLen << "; fileOffset-"
+        << fileOffset;
     fLog->logMsg(oss.str(), MSGLVL_INFO2);
   }
 
   // We write out the compression headers if we are finished with this file
   // (either because we are through with the extent or the data), or because
   // this is the first HWM chunk that we may be modifying.
-  // See the description that precedes this function for more details.
+  // See the description that precedes compressAndFlush() for more details.
   if (bFinishingFile || !fFlushedStartHwmChunk)
   {
     fileOffset = fFile->tell();
@@ -424,14 +578,9 @@ int ColumnBufferCompressed::compressAndFlush(bool bFinishingFile)
     // then we flush our output, to synchronize with compressed chunks,
     if (!fFlushedStartHwmChunk)
     {
-      // char resp;
-      // std::cout << "dbg: before fflush of hdrs" << std::endl;
-      // std::cin  >> resp;
       if (fFile->flush() != 0)
         return ERR_FILE_FLUSH;
 
-      // std::cout << "dbg: after fflush of hdrs" << std::endl;
-      // std::cin  >> resp;
       fFlushedStartHwmChunk = true;
     }
 
@@ -538,6 +687,7 @@ int ColumnBufferCompressed::finishFile(bool bTruncFile)
   fToBeCompressedCapacity = 0;
   fNumBytes = 0;
   fChunkPtrs.clear();
+  fChunkZoneMaps.clear();
 
 #ifdef PROFILE
   Stats::stopParseEvent(WE_STATS_COMPRESS_COL_FINISH_EXTENT);
@@ -582,6 +732,9 @@ int ColumnBufferCompressed::saveCompressionHeaders()
   ptrs.push_back(fChunkPtrs[lastIdx].first + fChunkPtrs[lastIdx].second);
   compress::CompressInterface::storePtrs(ptrs, hdrBuf);
 
+  for (unsigned i = 0; i < fChunkZoneMaps.size(); i++)
+    compress::CompressInterface::setChunkZoneMap(hdrBuf, i, fChunkZoneMaps[i]);
+
   // Write out the header records
   // char resp;
   // std::cout << "dbg: before writeHeaders" << std::endl;
@@ -708,6 +861,7 @@ int ColumnBufferCompressed::initToBeCompressedBuffer(long long& startFileOffset)
     // We are going to add data to, and thus re-add, the last chunk; so we
     // drop it from our list.
     fChunkPtrs.resize(fChunkPtrs.size() - 1);
+    fChunkZoneMaps.resize(fChunkPtrs.size());
   }
   else  // We have left the HWM chunk; just position file offset,
         // without reading anything
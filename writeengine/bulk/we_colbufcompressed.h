@@ -31,6 +31,8 @@
 #include <cstdio>
 #include <vector>
 
+#include <boost/shared_ptr.hpp>
+
 #include "idbcompress.h"
 
 namespace WriteEngine
@@ -44,6 +46,11 @@ class ColumnInfo;
  * compressed column data before writing it out to the intended destination
  * (currently a file stream). The file stream should be initialized by
  * the client of this class
+ *
+ * A full chunk is compressed by a thread of a pool shared by all the columns,
+ * while the next chunk of the column is buffered. The compressed chunk is
+ * written out before the next one is handed to the pool, so the chunks are
+ * written in order by the thread writing the column.
  */
 class ColumnBufferCompressed : public ColumnBuffer
 {
@@ -91,8 +98,15 @@ class ColumnBufferCompressed : public ColumnBuffer
   ColumnBufferCompressed(const ColumnBufferCompressed&);
   ColumnBufferCompressed& operator=(const ColumnBufferCompressed&);
 
+  // A chunk handed to the compression thread pool
+  struct Chunk;
+
   // Compress and flush the to-be-compressed buffer; updates header if needed
   int compressAndFlush(bool bFinishFile);
+  // Compress a chunk; called by a compression thread
+  int compressChunk(Chunk& chunk) const;
+  // Wait for the pending chunk to be compressed and write it out
+  int flushPendingChunk(bool bFinishFile);
   int initToBeCompressedBuffer(long long& startFileOffset);
   // Initialize the to-be-compressed buffer
   int saveCompressionHeaders();  // Saves compression headers to the db file
@@ -104,10 +118,14 @@ class ColumnBufferCompressed : public ColumnBuffer
   size_t fNumBytes;                          // num Bytes in comp buffer
   compress::CompressorPool fCompressorPool;  // data compression object pool
   compress::CompChunkPtrList fChunkPtrs;     // col file header information
+  std::vector<compress::ChunkZoneMap> fChunkZoneMaps;  // zone maps of fChunkPtrs
   bool fPreLoadHWMChunk;                     // preload 1st HWM chunk only
   unsigned int fUserPaddingBytes;            // compressed chunk padding
   bool fFlushedStartHwmChunk;                // have we rewritten the hdr
                                              //   for the starting HWM chunk
+  boost::shared_ptr<Chunk> fPendingChunk;    // chunk being compressed
+  unsigned char* fSpareBuffer;               // to-be-compressed buffer to
+                                             //   swap with a full one
 };
 
 }  // namespace WriteEngine
@@ -153,6 +153,10 @@ ColumnInfo::ColumnInfo(Log* logger, int idIn, const JobColumn& columnIn, DBRootE
  , fStore(0)
  , fAutoIncLastValue(0)
  , fSaturatedRowCnt(0)
+ , fCompressChunks(0)
+ , fCompressUsecs(0)
+ , fCompressInBytes(0)
+ , fCompressOutBytes(0)
  , fpTableInfo(pTableInfo)
  , fAutoIncMgr(0)
  , fDbRootExtTrk(pDBRootExtTrk)
@@ -368,6 +368,17 @@ class ColumnInfo : public WeUIDGID
    */
   long long saturatedCnt();
 
+  /** @brief Add a compressed chunk to the compression totals of this column
+   * @param usecs Time taken to compress the chunk, in microseconds.
+   * @param inBytes Uncompressed size of the chunk.
+   * @param outBytes Compressed size of the chunk, with its padding.
+   */
+  void incCompressStats(int64_t usecs, int64_t inBytes, int64_t outBytes);
+
+  /** @brief Get the compression totals of this column.
+   */
+  void compressStats(int64_t& chunks, int64_t& usecs, int64_t& inBytes, int64_t& outBytes) const;
+
   /** @brief When parsing is complete for a column, this function is called
    * to finish flushing and closing the current segment file.
    */
@@ -474,6 +485,12 @@ class ColumnInfo : public WeUIDGID
 
   volatile int64_t fSaturatedRowCnt;  // No. of rows with saturated values
 
+  // Compression totals, added to by the compression threads
+  volatile int64_t fCompressChunks;    // No. of chunks compressed
+  volatile int64_t fCompressUsecs;     // Time taken to compress them
+  volatile int64_t fCompressInBytes;   // Their uncompressed size
+  volatile int64_t fCompressOutBytes;  // Their compressed size
+
   // List of segment files updated during an import; used to track infor-
   // mation necessary to update the ExtentMap at the "end" of the import.
   std::vector<File> fSegFileUpdateList;
@@ -520,6 +537,23 @@ inline void ColumnInfo::incSaturatedCnt(int64_t satIncCnt)
   (void)atomicops::atomicAdd(&fSaturatedRowCnt, satIncCnt);
 }
 
+inline void ColumnInfo::incCompressStats(int64_t usecs, int64_t inBytes, int64_t outBytes)
+{
+  (void)atomicops::atomicAdd(&fCompressChunks, int64_t(1));
+  (void)atomicops::atomicAdd(&fCompressUsecs, usecs);
+  (void)atomicops::atomicAdd(&fCompressInBytes, inBytes);
+  (void)atomicops::atomicAdd(&fCompressOutBytes, outBytes);
+}
+
+inline void ColumnInfo::compressStats(int64_t& chunks, int64_t& usecs, int64_t& inBytes,
+                                      int64_t& outBytes) const
+{
+  chunks = fCompressChunks;
+  usecs = fCompressUsecs;
+  inBytes = fCompressInBytes;
+  outBytes = fCompressOutBytes;
+}
+
 inline bool ColumnInfo::isAbbrevExtent()
 {
   return fLoadingAbbreviatedExtent;
@@ -0,0 +1,145 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+/*******************************************************************************
+ * $Id$
+ *
+ *******************************************************************************/
+/** @file
+ * Vectorized search for the bytes that end the run of plain bytes of a field,
+ * used by BulkLoadBuffer::tokenize(), and for the end of the last complete row
+ * of the input read into a buffer.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace WriteEngine
+{
+/** @brief Find the first byte in [p, end) that is c1 or c2.
+ *
+ * tokenize() walks the input a byte at a time, most of the bytes being the
+ * plain content of a field. The bytes the parsing state can change on are
+ * looked up 16 at a time instead: the field delimiter and the line end of a
+ * field, or the enclosing and escape characters inside an enclosed field.
+ * @return the byte found, end if there is none
+ */
+inline char* findEitherChar(char* p, const char* end, char c1, char c2)
+{
+#if defined(__x86_64__)
+  const __m128i v1 = _mm_set1_epi8(c1);
+  const __m128i v2 = _mm_set1_epi8(c2);
+
+  for (; p + 16 <= end; p += 16)
+  {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(bytes, v1), _mm_cmpeq_epi8(bytes, v2)));
+
+    if (mask != 0)
+      return p + __builtin_ctz(mask);
+  }
+#elif defined(__aarch64__)
+  const uint8x16_t v1 = vdupq_n_u8(c1);
+  const uint8x16_t v2 = vdupq_n_u8(c2);
+
+  for (; p + 16 <= end; p += 16)
+  {
+    uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    uint8x16_t eq = vorrq_u8(vceqq_u8(bytes, v1), vceqq_u8(bytes, v2));
+    // 4 bits per byte, there is no movemask on NEON
+    uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+
+    if (mask != 0)
+      return p + (__builtin_ctzll(mask) >> 2);
+  }
+#endif
+
+  for (; p < end; p++)
+  {
+    if (*p == c1 || *p == c2)
+      return p;
+  }
+
+  return p;
+}
+
+/** @brief Find the end of the last complete row in [p, end).
+ *
+ * Follows the row and field ends of tokenize() without tokenizing: a newline
+ * ends a row unless it is inside an enclosed field, and a field is enclosed
+ * if it starts with the enclosing character. p must be the start of a row.
+ * @param enclosed the enclosing character, '\0' if fields are not enclosed
+ * @return the byte after the newline ending the last complete row, the
+ * starting p if there is none
+ */
+inline char* findLastRowEnd(char* p, const char* end, char delim, char enclosed, char escape)
+{
+  char* rowEnd = p;
+
+  if (enclosed == '\0')
+  {
+    void* newline = memrchr(p, '\n', end - p);
+    return newline ? static_cast<char*>(newline) + 1 : p;
+  }
+
+  while (p < end)
+  {
+    if (*p == enclosed)
+    {
+      // Up to the enclosing character that is not escaped or doubled
+      for (p++;; p++)
+      {
+        p = findEitherChar(p, end, enclosed, escape);
+
+        if (p == end)
+          return rowEnd;
+
+        if (p + 1 < end && ((*p == escape && (p[1] == enclosed || p[1] == escape || p[1] == 0x0D ||
+                                              p[1] == 0x0A)) ||
+                            (*p == enclosed && p[1] == enclosed)))
+          p++;
+        else if (*p == enclosed)
+          break;
+      }
+
+      p++;
+    }
+
+    // What is left of the field is plain or ignored trailing bytes
+    p = findEitherChar(p, end, delim, '\n');
+
+    if (p == end)
+      break;
+
+    if (*p == '\n')
+      rowEnd = p + 1;
+
+    p++;
+  }
+
+  return rowEnd;
+}
+
+}  // namespace WriteEngine
@@ -153,6 +153,10 @@ TableInfo::TableInfo(Log* logger, const BRM::TxnID txnID, const string& processN
  , fRejectErrCnt(0)
  , fExtentStrAlloc(tableOID, logger)
  , fOamCachePtr(oam::OamCache::makeOamCache())
+ , fReadAhead(false)
+ , fReadAheadEnd(false)
+ , fReadDone(false)
+ , fParquetParseLength(0)
 {
   fBuffers.clear();
   fColumns.clear();
@@ -259,9 +263,31 @@ bool TableInfo::lockForRead(const int& locker)
 }
 
 //------------------------------------------------------------------------------
-// Loop thru reading the import file(s) assigned to this TableInfo object.
+// Read the import file(s) assigned to this TableInfo object.  However reading
+// ends, the other read threads stop tokenizing the buffers read ahead.
 //------------------------------------------------------------------------------
 int TableInfo::readTableData()
+{
+  int rc;
+
+  try
+  {
+    rc = readTableFiles();
+  }
+  catch (...)
+  {
+    stopReadAhead();
+    throw;
+  }
+
+  stopReadAhead();
+  return rc;
+}
+
+//------------------------------------------------------------------------------
+// Loop thru reading the import file(s) assigned to this TableInfo object.
+//------------------------------------------------------------------------------
+int TableInfo::readTableFiles()
 {
   RID validTotalRows = 0;
   RID totalRowsPerInputFile = 0;
@@ -344,7 +370,8 @@ int TableInfo::readTableData()
     //
     // LOOP to wait for, and read, the next avail BulkLoadBuffer object
     //
-    while (!isBufferAvailable(report))
+    // (a buffer read ahead was grabbed when it was read)
+    while (fReadAheadBuffers.empty() && !isBufferAvailable(fCurrentReadBuffer, report))
     {
       // See if JobStatus has been set to terminate by another thread
       if (BulkStatus::getJobStatus() == EXIT_FAILURE)
@@ -424,6 +451,24 @@ int TableInfo::readTableData()
                                                   &fS3ParseLength, totalRowsPerInputFile, validTotalRows,
                                                   fColumns, allowedErrCntThisCall);
     }
+    else if ((fImportDataMode == IMPORT_DATA_PARQUET) || (fImportDataMode == IMPORT_DATA_ARROW))
+    {
+      readRc = fBuffers[readBufNo].fillFromMemory(fBuffers[prevReadBuf], fParquetRecords.data(),
+                                                  fParquetRecords.size(), &fParquetParseLength,
+                                                  totalRowsPerInputFile, validTotalRows, fColumns,
+                                                  allowedErrCntThisCall);
+
+      // Convert the next rows now, so the end of the file is seen with the last ones
+      if ((readRc == NO_ERROR) && (fParquetParseLength == fParquetRecords.size()))
+        readRc = readParquetBatch();
+    }
+    else if (fReadAhead)
+    {
+      readRc = readAhead(readBufNo, allowedErrCntThisCall);
+
+      if (readRc == NO_ERROR)
+        fBuffers[readBufNo].setStartRows(totalRowsPerInputFile, validTotalRows);
+    }
     else
     {
       readRc = fBuffers[readBufNo].fillFromFile(fBuffers[prevReadBuf], fHandle, totalRowsPerInputFile,
@@ -529,7 +574,10 @@ int TableInfo::readTableData()
       fCurrentReadBuffer = (fCurrentReadBuffer + 1) % fReadBufCount;
 
       // bufferCount++;
-      if ((fHandle && feof(fHandle)) || (fReadFromS3 && (fS3ReadLength == fS3ParseLength)))
+      if ((fHandle && feof(fHandle) && fReadAheadBuffers.empty()) ||
+          (fReadFromS3 && (fS3ReadLength == fS3ParseLength)) ||
+          (((fImportDataMode == IMPORT_DATA_PARQUET) || (fImportDataMode == IMPORT_DATA_ARROW)) &&
+           fParquetReader.eof()))
       {
         timeval readFinished;
         gettimeofday(&readFinished, NULL);
@@ -1015,6 +1063,18 @@ void TableInfo::reportTotals(double elapsedTime)
       ossSatCnt << satCount;
       fLog->logMsg(ossSatCnt.str(), MSGLVL_WARNING);
     }
+
+    int64_t compChunks, compUsecs, compInBytes, compOutBytes;
+    fColumns[i].compressStats(compChunks, compUsecs, compInBytes, compOutBytes);
+
+    if (compChunks > 0)
+    {
+      ostringstream ossComp;
+      ossComp << "Column " << fTableName << '.' << fColumns[i].column.colName << "; Compressed "
+              << compChunks << " chunks from " << compInBytes << " to " << compOutBytes << " bytes in "
+              << (compUsecs / 1000000.0) << " secs";
+      fLog->logMsg(ossComp.str(), MSGLVL_INFO2);
+    }
   }
 
   logging::Message::Args tblFinishedMsgArgs;
@@ -1210,6 +1270,24 @@ int TableInfo::initializeBuffers(int noOfBuffers, const JobFieldRefList& jobFiel
 {
 
   fReadBufCount = noOfBuffers;
+  fReadAheadRc.assign(fReadBufCount, NO_ERROR);
+  fTokenized.assign(fReadBufCount, 0);
+
+  // The columns the fields of the records converted from Parquet or Arrow are
+  // parsed into, as tokenizeBinary() assigns them
+  if ((fImportDataMode == IMPORT_DATA_PARQUET) || (fImportDataMode == IMPORT_DATA_ARROW))
+  {
+    fParquetColumns.clear();
+
+    for (const JobFieldRef& fieldRef : jobFieldRefList)
+    {
+      if (fieldRef.fFldColType == BULK_FLDCOL_COLUMN_FIELD)
+      {
+        const JobColumn& column = fColumns[fParquetColumns.size()].column;
+        fParquetColumns.push_back({column.dataType, column.definedWidth, column.scale});
+      }
+    }
+  }
 
   // initialize and populate the buffer vector.
   for (int i = 0; i < fReadBufCount; ++i)
@@ -1261,6 +1339,68 @@ int TableInfo::openTableFile()
   if (fHandle != NULL)
     return NO_ERROR;
 
+  // A partial row read ahead belongs to the previous file
+  fReadAheadOverflow.clear();
+
+  if (fImportDataMode == IMPORT_DATA_PARQUET)
+  {
+    // Parquet metadata is at the end of the file, it is read from a file
+    if (fReadFromStdin || fReadFromS3)
+    {
+      fLog->logMsg("Parquet import of table " + fTableName + " requires a local import file",
+                   ERR_FILE_OPEN, MSGLVL_ERROR);
+      return ERR_FILE_OPEN;
+    }
+
+    string errMsg;
+    int rc = fParquetReader.open(fFileName, fParquetColumns, errMsg);
+
+    if (rc != NO_ERROR)
+    {
+      ostringstream oss;
+      oss << "Error opening Parquet import file " << fFileName << ". " << errMsg;
+      fLog->logMsg(oss.str(), rc, MSGLVL_ERROR);
+      return rc;
+    }
+
+    ostringstream oss;
+    oss << "Opening " << fFileName << " (" << fParquetReader.rowCount() << " rows) to import into table "
+        << fTableName;
+    fLog->logMsg(oss.str(), MSGLVL_INFO2);
+
+    return readParquetBatch();
+  }
+
+  if (fImportDataMode == IMPORT_DATA_ARROW)
+  {
+    // An Arrow IPC stream is read as it comes, from stdin as well
+    if (fReadFromS3)
+    {
+      fLog->logMsg("Arrow import of table " + fTableName + " from S3 is not supported", ERR_FILE_OPEN,
+                   MSGLVL_ERROR);
+      return ERR_FILE_OPEN;
+    }
+
+    string errMsg;
+    int rc = fParquetReader.openStream(fReadFromStdin ? string() : fFileName, fParquetColumns, errMsg);
+
+    if (rc != NO_ERROR)
+    {
+      ostringstream oss;
+      oss << "Error opening Arrow import stream " << (fReadFromStdin ? string("STDIN") : fFileName) << ". "
+          << errMsg;
+      fLog->logMsg(oss.str(), rc, MSGLVL_ERROR);
+      return rc;
+    }
+
+    ostringstream oss;
+    oss << "Reading Arrow stream from " << (fReadFromStdin ? string("STDIN") : fFileName)
+        << " to import into table " << fTableName;
+    fLog->logMsg(oss.str(), MSGLVL_INFO2);
+
+    return readParquetBatch();
+  }
+
   if (fReadFromStdin)
   {
     fHandle = stdin;
@@ -1325,11 +1465,34 @@ int TableInfo::openTableFile()
   return NO_ERROR;
 }
 
+//------------------------------------------------------------------------------
+// Convert the next batch of rows of the Parquet or Arrow input into the binary
+// records fParquetRecords, to be copied into the read buffers.  The records
+// are empty at the end of the file.
+//------------------------------------------------------------------------------
+int TableInfo::readParquetBatch()
+{
+  string errMsg;
+  fParquetParseLength = 0;
+  int rc = fParquetReader.readRecords(fParquetRecords, errMsg);
+
+  if (rc != NO_ERROR)
+  {
+    ostringstream oss;
+    oss << "Error reading import file " << (fReadFromStdin ? string("STDIN") : fFileName) << ". " << errMsg;
+    fLog->logMsg(oss.str(), rc, MSGLVL_ERROR);
+  }
+
+  return rc;
+}
+
 //------------------------------------------------------------------------------
 // Close the current open file we have been importing.
 //------------------------------------------------------------------------------
 void TableInfo::closeTableFile()
 {
+  fReadAheadOverflow.clear();
+
   if (fHandle)
   {
     // If reading from stdin, we don't delete the buffer out from under
@@ -1345,6 +1508,12 @@ void TableInfo::closeTableFile()
 
     fHandle = 0;
   }
+  else if ((fImportDataMode == IMPORT_DATA_PARQUET) || (fImportDataMode == IMPORT_DATA_ARROW))
+  {
+    fParquetReader.close();
+    fParquetRecords.clear();
+    fParquetParseLength = 0;
+  }
   else if (ms3)
   {
     ms3_free((uint8_t*)fFileBuffer);
@@ -1352,22 +1521,23 @@ void TableInfo::closeTableFile()
 }
 
 //------------------------------------------------------------------------------
-// "Grabs" the current read buffer for TableInfo so that the read thread that
-// is calling this function, can read the next buffer's set of data.
+// "Grabs" the specified read buffer (the current read buffer, or the next one
+// to read ahead) for TableInfo so that the read thread that is calling this
+// function, can read the next buffer's set of data.
 //------------------------------------------------------------------------------
 // @bug2099. Temporary hack to diagnose deadlock.
 // Added report parm and couts below.
-bool TableInfo::isBufferAvailable(bool report)
+bool TableInfo::isBufferAvailable(int bufferId, bool report)
 {
   boost::mutex::scoped_lock lock(fSyncUpdatesTI);
-  Status bufferStatus = fBuffers[fCurrentReadBuffer].getStatusBLB();
+  Status bufferStatus = fBuffers[bufferId].getStatusBLB();
 
   if ((bufferStatus == WriteEngine::PARSE_COMPLETE) || (bufferStatus == WriteEngine::NEW))
   {
     // reset buffer status and column locks while we have
     // an fSyncUpdatesTI lock
-    fBuffers[fCurrentReadBuffer].setStatusBLB(WriteEngine::READ_PROGRESS);
-    fBuffers[fCurrentReadBuffer].resetColumnLocks();
+    fBuffers[bufferId].setStatusBLB(WriteEngine::READ_PROGRESS);
+    fBuffers[bufferId].resetColumnLocks();
     return true;
   }
 
@@ -1385,6 +1555,128 @@ bool TableInfo::isBufferAvailable(bool report)
   return false;
 }
 
+//------------------------------------------------------------------------------
+// Wait for the specified buffer (fCurrentReadBuffer) to be tokenized, reading
+// the next buffers ahead meanwhile.  A buffer read ahead ends with the last
+// row that is complete in it (see BulkLoadBuffer::readRowsFromFile()), so
+// the buffers can be tokenized in any order by the read threads left without
+// a table to read (see BulkLoad::read()).  They are still completed in order,
+// the read thread numbers the rows of a buffer once the buffer is returned.
+// The read thread itself tokenizes when it can't read ahead.
+//------------------------------------------------------------------------------
+int TableInfo::readAhead(int bufferId, unsigned allowedErrCnt)
+{
+  if (fReadAheadBuffers.empty())
+  {
+    fReadAheadEnd = false;
+    readAheadBuffer(bufferId, allowedErrCnt);
+  }
+
+  while (fReadAheadRc[bufferId] == NO_ERROR)
+  {
+    {
+      boost::mutex::scoped_lock lock(fTokenizeMutex);
+
+      if (fTokenized[bufferId])
+        break;
+    }
+
+    int nextBuffer = (fReadAheadBuffers.back() + 1) % fReadBufCount;
+
+    if (!fReadAheadEnd && (nextBuffer != bufferId) && isBufferAvailable(nextBuffer, false))
+    {
+      readAheadBuffer(nextBuffer, allowedErrCnt);
+    }
+    else if (!tokenizeReadAhead())
+    {
+      // See if JobStatus has been set to terminate by another thread
+      if (BulkStatus::getJobStatus() == EXIT_FAILURE)
+      {
+        boost::mutex::scoped_lock lock(fSyncUpdatesTI);
+        fStatusTI = WriteEngine::ERR;
+        throw SecondaryShutdownException(
+            "TableInfo::"
+            "readAhead() responding to job termination");
+      }
+
+      sleepMS(1);
+    }
+  }
+
+  fReadAheadBuffers.pop_front();
+  return fReadAheadRc[bufferId];
+}
+
+//------------------------------------------------------------------------------
+// Read the rows for the specified buffer from the current import file, and
+// queue the buffer to be tokenized.  allowedErrCnt is the number of errors
+// still allowed before any of the buffers read ahead is completed.
+//------------------------------------------------------------------------------
+void TableInfo::readAheadBuffer(int bufferId, unsigned allowedErrCnt)
+{
+  bool bEndOfData = false;
+  int rc = fBuffers[bufferId].readRowsFromFile(fReadAheadOverflow, fHandle, bEndOfData);
+
+  fReadAheadRc[bufferId] = rc;
+  fReadAheadBuffers.push_back(bufferId);
+
+  if ((rc != NO_ERROR) || bEndOfData)
+    fReadAheadEnd = true;
+
+  if (rc == NO_ERROR)
+  {
+    boost::mutex::scoped_lock lock(fTokenizeMutex);
+    fTokenized[bufferId] = 0;
+    fTokenizeQueue.push_back(std::make_pair(bufferId, allowedErrCnt));
+  }
+}
+
+//------------------------------------------------------------------------------
+// Tokenize the oldest buffer queued by the read thread of this table, if any.
+// Called by the read thread of this table, and by the read threads left
+// without a table to read.
+//------------------------------------------------------------------------------
+bool TableInfo::tokenizeReadAhead()
+{
+  std::pair<int, unsigned> next;
+
+  {
+    boost::mutex::scoped_lock lock(fTokenizeMutex);
+
+    if (fTokenizeQueue.empty())
+      return false;
+
+    next = fTokenizeQueue.front();
+    fTokenizeQueue.pop_front();
+  }
+
+  fBuffers[next.first].tokenizeRows(fColumns, next.second);
+
+  boost::mutex::scoped_lock lock(fTokenizeMutex);
+  fTokenized[next.first] = 1;
+  return true;
+}
+
+//------------------------------------------------------------------------------
+// Is the read thread of this table still reading buffers ahead.
+//------------------------------------------------------------------------------
+bool TableInfo::isReadingAhead()
+{
+  boost::mutex::scoped_lock lock(fTokenizeMutex);
+  return fReadAhead && !fReadDone;
+}
+
+//------------------------------------------------------------------------------
+// Stop the tokenizing of the buffers read ahead, the read thread is done with
+// this table.
+//------------------------------------------------------------------------------
+void TableInfo::stopReadAhead()
+{
+  boost::mutex::scoped_lock lock(fTokenizeMutex);
+  fTokenizeQueue.clear();
+  fReadDone = true;
+}
+
 //------------------------------------------------------------------------------
 // Report whether rows were rejected, and if so, then list them out into the
 // reject file.
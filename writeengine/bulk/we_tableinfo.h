@@ -22,6 +22,7 @@
 #pragma once
 
 #include <sys/time.h>
+#include <deque>
 #include <fstream>
 #include <utility>
 #include <vector>
@@ -44,6 +45,7 @@
 #include "we_log.h"
 #include "we_brmreporter.h"
 #include "we_extentstripealloc.h"
+#include "we_parquetreader.h"
 #include "messagelog.h"
 #include "brmtypes.h"
 #include "querytele.h"
@@ -171,6 +173,24 @@ class TableInfo : public WeUIDGID
   boost::uuids::uuid fJobUUID;              // Job UUID
   std::vector<BRM::LBID_t> fDictFlushBlks;  // dict blks to be flushed from cache
 
+  // Reading ahead of the tokenizing of the read buffers (see readAhead())
+  bool fReadAhead;                        // Read ahead, tokenize in any read thread
+  std::vector<char> fReadAheadOverflow;   // Bytes after the last complete row
+  std::deque<int> fReadAheadBuffers;      // Buffers read ahead, oldest first
+  std::vector<int> fReadAheadRc;          // Return code of reading each buffer
+  bool fReadAheadEnd;                     // No more buffers to read ahead
+  boost::mutex fTokenizeMutex;            // Synchronizes the tokenizing state
+  std::deque<std::pair<int, unsigned> > fTokenizeQueue;  // Buffers to tokenize
+  //   and their allowed error counts
+  std::vector<char> fTokenized;  // Buffer read ahead has been tokenized
+  bool fReadDone;                // Read thread is done with this table
+
+  // Parquet or Arrow input, converted to binary records a batch of rows at a time
+  ParquetReader fParquetReader;
+  std::vector<ParquetReader::Column> fParquetColumns;  // Columns in the file
+  std::vector<char> fParquetRecords;                  // Records of the batch
+  size_t fParquetParseLength;                         // Records copied to buffers
+
   //--------------------------------------------------------------------------
   // Private Functions
   //--------------------------------------------------------------------------
@@ -182,10 +202,24 @@ class TableInfo : public WeUIDGID
   void deleteTempDBFileChanges();        // Delete DB temp swap files (on HDFS)
   int finishBRM();                       // Finish reporting updates for BRM
   void freeProcessingBuffers();          // Free up Processing Buffers
-  bool isBufferAvailable(bool report);   // Is tbl buffer available for reading
   int openTableFile();                   // Open data file and set the buffer
+  int readParquetBatch();                // Convert next Parquet rows to records
+  int readTableFiles();                  // Read the import file(s) of this table
   void reportTotals(double elapsedSec);  // Report summary totals
   void sleepMS(long int ms);             // Sleep method
+
+  // Is tbl buffer available for reading
+  bool isBufferAvailable(int bufferId, bool report);
+
+  // Wait for the buffer to be tokenized, reading the next buffers meanwhile
+  int readAhead(int bufferId, unsigned allowedErrCnt);
+
+  // Read the next buffer ahead and queue it for tokenizing
+  void readAheadBuffer(int bufferId, unsigned allowedErrCnt);
+
+  // Stop the tokenizing of the buffers read ahead
+  void stopReadAhead();
+
   // Compare column HWM with the examplar HWM.
   int compareHWMs(const int smallestColumnId, const int widerColumnId, const uint32_t smallerColumnWidth,
                   const uint32_t widerColumnWidth, const std::vector<DBRootExtentInfo>& segFileInfo,
@@ -373,6 +407,21 @@ class TableInfo : public WeUIDGID
    */
   int readTableData();
 
+  /** @brief Tokenize the next buffer read ahead by the read thread of this
+   *  table, if any.
+   *  @returns TRUE if a buffer was tokenized
+   */
+  bool tokenizeReadAhead();
+
+  /** @brief Are there buffers yet to be read ahead for this table
+   */
+  bool isReadingAhead();
+
+  /** @brief Read ahead of the tokenizing when the other read threads can
+   *  tokenize the buffers (text files only).
+   */
+  void setReadAhead(bool bReadAhead);
+
   /** @brief parse method
    */
   int parseColumn(const int& columnId, const int& bufferId, double& processingTime);
@@ -626,6 +675,11 @@ inline void TableInfo::setNullStringMode(bool bMode)
   fNullStringMode = bMode;
 }
 
+inline void TableInfo::setReadAhead(bool bReadAhead)
+{
+  fReadAhead = bReadAhead && (fImportDataMode == IMPORT_DATA_TEXT) && !fReadFromS3;
+}
+
 inline void TableInfo::setTableId(const int& id)
 {
   fTableId = id;
@@ -81,14 +81,15 @@ void BulkLoad::read(int id)
 
       if ((tableId = lockTableForRead(id)) == -1)
       {
+#ifdef PROFILE
+        Stats::stopReadEvent(WE_STATS_WAIT_TO_SELECT_TBL);
+#endif
+        tokenizeReadAhead();
         fLog.logMsg(
             "BulkLoad::ReadOperation No more tables "
             "available for processing. Read thread " +
                 Convertor::int2Str(id) + " exiting...",
             MSGLVL_INFO2);
-#ifdef PROFILE
-        Stats::stopReadEvent(WE_STATS_WAIT_TO_SELECT_TBL);
-#endif
         return;
       }
 
@@ -177,6 +178,45 @@ int BulkLoad::lockTableForRead(int id)
   return -1;
 }
 
+//------------------------------------------------------------------------------
+// Tokenize the buffers read ahead by the read threads of the tables still
+// being read (see TableInfo::readAhead()), until all the tables are read.
+// A single large import file is tokenized by all the read threads this way.
+//------------------------------------------------------------------------------
+void BulkLoad::tokenizeReadAhead()
+{
+  while (true)
+  {
+    // See if JobStatus has been set to terminate by another thread
+    if (BulkStatus::getJobStatus() == EXIT_FAILURE)
+    {
+      throw SecondaryShutdownException(
+          "BulkLoad::"
+          "tokenizeReadAhead() responding to job termination");
+    }
+
+    bool bReading = false;
+    bool bTokenized = false;
+
+    for (unsigned i = 0; i < fTableInfo.size(); ++i)
+    {
+      if (fTableInfo[i]->isReadingAhead())
+      {
+        bReading = true;
+
+        if (fTableInfo[i]->tokenizeReadAhead())
+          bTokenized = true;
+      }
+    }
+
+    if (!bReading)
+      return;
+
+    if (!bTokenized)
+      sleepMS(1);
+  }
+}
+
 //------------------------------------------------------------------------------
 // This is the main entry point method for each parsing thread.
 // id is the one-up number (starting at 0) associated with each parsing thread.
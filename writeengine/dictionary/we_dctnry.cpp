@@ -25,6 +25,9 @@
  *  can be deleted.
  *  The whole file contains only one class Dctnry
  */
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -50,6 +53,8 @@ using namespace BRM;
 using namespace idbdatafile;
 #include "checks.h"
 #include "utils_utf8.h" // for utf8_truncate_point()
+#include "dictbloomfilter.h"
+#include "dictngramindex.h"
 
 namespace
 {
@@ -64,6 +69,8 @@ const int START_HDR1 =  // start loc of 2nd offset (HDR1)
     HDR_UNIT_SIZE + NEXT_PTR_BYTES + HDR_UNIT_SIZE;
 const int PSEUDO_COL_WIDTH = DICT_COL_WIDTH;  // used to convert row count to block count
 const int MAX_BLOB_SIZE = 16777215;           // MCOL-4758 limit TEXT and BLOB to 16MB
+const size_t MAX_BLOOM_HASHES = 65536;        // hashes kept before building the Bloom filter in memory
+const size_t MAX_NGRAM_BLOCKS = 4096;         // block signatures kept before writing them out
 }  // namespace
 
 namespace WriteEngine
@@ -90,6 +97,15 @@ Dctnry::Dctnry()
  , m_curOp(0)
  , m_colWidth(0)
  , m_importDataMode(IMPORT_DATA_TEXT)
+ , m_charset(NULL)
+ , m_bloomState(INDEX_NONE)
+ , m_bloomCharsetNumber(0)
+ , m_bloomFilterBytes(0)
+ , m_bloomInvalid(false)
+ , m_ngramState(INDEX_NONE)
+ , m_ngramCharsetNumber(0)
+ , m_ngramInvalid(false)
+ , m_ngramCreated(false)
 {
   memset(m_dctnryHeader, 0, sizeof(m_dctnryHeader));
   memset(m_curBlock.data, 0, sizeof(m_curBlock.data));
@@ -382,6 +398,22 @@ int Dctnry::closeDctnry(bool realClose)
     // m_curBlock.state== BLK_INIT;
   }
 
+  rc = flushBloomFilter();
+
+  if (rc == NO_ERROR)
+    rc = flushNgramIndex(true);
+
+  if (rc == NO_ERROR)
+    rc = flushOrderIndex();
+
+  if (rc != NO_ERROR)
+  {
+    closeDctnryFile(false, oids);
+    return rc;
+  }
+
+  m_charset = NULL;
+
   //@Bug 5572. always close file for uncompressed file.
   if (FileOp::compressionType() == 0)
     realClose = true;
@@ -444,6 +476,15 @@ int Dctnry::closeDctnryOnly()
   std::map<FID, FID> oids;
   closeDctnryFile(false, oids);
 
+  // The strings aren't kept, neither are their hashes
+  m_bloomHashes.clear();
+  m_bloomBits.clear();
+  m_bloomState = INDEX_NONE;
+  m_ngramBlocks.clear();
+  m_ngramState = INDEX_NONE;
+  m_orderIndex.clear();
+  m_charset = NULL;
+
   freeStringCache();
 
   return NO_ERROR;
@@ -588,6 +629,10 @@ int Dctnry::openDctnry(const OID& dctnryOID, const uint16_t dbRoot, const uint32
   getBlockOpCount(m_curBlock, opCnt);
   m_curOp = opCnt;
 
+  openBloomFilter();
+  openNgramIndex();
+  openOrderIndex();
+
   // "If" this store file contains no more than 1 block, then we preload
   // the string cache used to recognize duplicates during row insertion.
   if (m_hwm == 0)
@@ -670,6 +715,7 @@ int Dctnry::insertDctnry2(Signature& sig)
 
     insertDctnryHdr(m_curBlock.data, write_size);
     insertSgnture(m_curBlock.data, write_size, (unsigned char*)sig.signature);
+    RETURN_ON_ERROR(addToNgramIndex(m_lastFbo, sig.signature, write_size));
 
     sig.size -= write_size;
     sig.signature += write_size;
@@ -742,7 +788,7 @@ int Dctnry::insertDctnry2(Signature& sig)
 
   sig.size = origSigSize;
   sig.signature = origSig;
-  return NO_ERROR;
+  return addToOrderIndex(sig.token, origSig, origSigSize);
 }
 
 /*******************************************************************************
@@ -783,6 +829,7 @@ int Dctnry::insertDctnry(const char* buf, ColPosPair** pos, const int totalRow,
   cb.file.oid = m_dctnryOID;
   cb.file.pFile = m_dFile;
   WriteEngine::Token nullToken;
+  m_charset = cs;
 
   //...Loop through all the rows for the specified column
   while (startPos < totalRow)
@@ -896,6 +943,9 @@ int Dctnry::insertDctnry(const char* buf, ColPosPair** pos, const int totalRow,
       // Stats::stopParseEvent("getTokenFromArray");
     }
 
+    // The strings found in the cache are in the store file already
+    addToBloomFilter(curSig.signature, curSig.size);
+
     totalUseSize = m_totalHdrBytes + curSig.size;
 
     //...String not found in cache, so proceed.
@@ -1100,6 +1150,7 @@ int Dctnry::insertDctnry(const int& sgnature_size, const unsigned char* sgnature
   size = sgnature_size;
   value = (unsigned char*)sgnature_value;
   token.bc = 0;
+  addToBloomFilter(sgnature_value, sgnature_size);
 
   for (i = m_lastFbo; i < m_numBlocks; i++)
   {
@@ -1119,6 +1170,7 @@ int Dctnry::insertDctnry(const int& sgnature_size, const unsigned char* sgnature
 
       insertDctnryHdr(m_curBlock.data, write_size);
       insertSgnture(m_curBlock.data, write_size, value);
+      RETURN_ON_ERROR(addToNgramIndex(m_lastFbo, value, write_size));
       size -= write_size;
       value += write_size;
       m_curBlock.state = BLK_WRITE;
@@ -1138,7 +1190,7 @@ int Dctnry::insertDctnry(const int& sgnature_size, const unsigned char* sgnature
       m_curFbo = m_lastFbo;
 
       if ((m_curOp < (MAX_OP_COUNT - 1)) && (size <= 0))
-        return NO_ERROR;
+        return addToOrderIndex(token, sgnature_value, sgnature_size);
     }  // end Found
 
     //@bug 3832. check error code
@@ -1485,4 +1537,529 @@ void Dctnry::copyDctnryHeader(void* buf)
   memcpy(buf, m_dctnryHeader2, m_totalHdrBytes);
 }
 
+/*******************************************************************************
+ * Set the collation of the strings to be inserted into the store file
+ ******************************************************************************/
+void Dctnry::setCharsetNumber(uint32_t charsetNumber)
+{
+  m_charset = charsetNumber ? &datatypes::Charset(charsetNumber).getCharset() : NULL;
+}
+
+/*******************************************************************************
+ * Find out if the strings of the opened store file are in a Bloom filter.
+ * A store file without strings starts a new filter, otherwise the filter file
+ * must be valid.
+ ******************************************************************************/
+void Dctnry::openBloomFilter()
+{
+  m_bloomHashes.clear();
+  m_bloomBits.clear();
+  m_bloomInvalid = false;
+  m_bloomCharsetNumber = 0;
+  m_bloomFilterBytes = 0;
+
+  if (m_hwm == 0 && m_curOp == 0)
+  {
+    m_bloomState = INDEX_NEW;
+    return;
+  }
+
+  m_bloomState = INDEX_NONE;
+  const std::string fileName = utils::DictBloomFilter::fileName(m_segFileName);
+
+  if (!IDBPolicy::exists(fileName.c_str()))
+    return;
+
+  IDBDataFile* pFile = openFile(fileName.c_str(), "rb", 0, false);
+
+  if (pFile == NULL)
+    return;
+
+  utils::DictBloomFilter::Header header;
+
+  if (pFile->pread(&header, 0, sizeof(header)) == (ssize_t)sizeof(header) &&
+      utils::DictBloomFilter::isValid(header))
+  {
+    m_bloomState = INDEX_VALID;
+    m_bloomCharsetNumber = header.charsetNumber;
+    m_bloomFilterBytes = header.filterBytes;
+  }
+
+  closeFile(pFile);
+}
+
+/*******************************************************************************
+ * Add a string inserted into the store file to its Bloom filter
+ ******************************************************************************/
+void Dctnry::addToBloomFilter(const unsigned char* str, int len)
+{
+  if (m_bloomState == INDEX_NONE || m_bloomInvalid)
+    return;
+
+  if (m_bloomState == INDEX_NEW && m_bloomCharsetNumber == 0 && m_charset)
+    m_bloomCharsetNumber = m_charset->number;
+
+  // Hashes of another collation would miss the strings equal to the ones looked for
+  if (!m_charset || m_charset->number != m_bloomCharsetNumber)
+  {
+    m_bloomInvalid = true;
+    m_bloomHashes.clear();
+    m_bloomBits.clear();
+    return;
+  }
+
+  datatypes::Charset cs(const_cast<CHARSET_INFO*>(m_charset));
+  uint32_t hash = utils::DictBloomFilter::hash(cs, reinterpret_cast<const char*>(str), len);
+
+  if (m_bloomBits.empty())
+  {
+    m_bloomHashes.push_back(hash);
+
+    // Past a bulk load worth of strings the whole filter is cheaper to keep
+    if (m_bloomHashes.size() >= MAX_BLOOM_HASHES)
+      buildBloomBits();
+
+    return;
+  }
+
+  uint32_t bits[utils::DictBloomFilter::HASH_COUNT];
+  utils::DictBloomFilter::bits(hash, m_bloomFilterBytes, bits);
+
+  for (auto bit : bits)
+    utils::DictBloomFilter::set(m_bloomBits.data(), bit);
+}
+
+/*******************************************************************************
+ * Move the kept hashes into the filter in memory. A new filter is sized for the
+ * strings the store file holds once its extents are full, assuming the strings
+ * to come take as much room as the ones inserted so far.
+ ******************************************************************************/
+void Dctnry::buildBloomBits()
+{
+  if (m_bloomFilterBytes == 0)
+  {
+    const uint64_t fileBlocks = (uint64_t)(BRMWrapper::getInstance()->getExtentRows() / BYTE_PER_BLOCK) *
+                                PSEUDO_COL_WIDTH * Config::getExtentsPerSegmentFile();
+    const uint64_t usedBlocks = m_curFbo + 1;
+    const uint64_t expectedStrings = m_bloomHashes.size() * std::max(fileBlocks, usedBlocks) / usedBlocks;
+    m_bloomFilterBytes = utils::DictBloomFilter::filterBytes(expectedStrings);
+  }
+
+  m_bloomBits.resize(m_bloomFilterBytes, 0);
+
+  for (auto hash : m_bloomHashes)
+  {
+    uint32_t bits[utils::DictBloomFilter::HASH_COUNT];
+    utils::DictBloomFilter::bits(hash, m_bloomFilterBytes, bits);
+
+    for (auto bit : bits)
+      utils::DictBloomFilter::set(m_bloomBits.data(), bit);
+  }
+
+  m_bloomHashes.clear();
+}
+
+/*******************************************************************************
+ * Write the hashes of the inserted strings to the Bloom filter file. If that
+ * fails the filter file is removed, a filter without some of the strings can't
+ * be used.
+ ******************************************************************************/
+int Dctnry::flushBloomFilter()
+{
+  if (m_bloomState == INDEX_NONE ||
+      (!m_bloomInvalid && m_bloomHashes.empty() && m_bloomBits.empty()))
+    return NO_ERROR;
+
+  const std::string fileName = utils::DictBloomFilter::fileName(m_segFileName);
+  int rc = writeBloomFilter();
+
+  if (rc != NO_ERROR)
+  {
+    if (IDBPolicy::remove(fileName.c_str()) != 0 && errno != ENOENT)
+      return rc;
+
+    m_bloomInvalid = true;
+  }
+
+  m_bloomState = m_bloomInvalid ? INDEX_NONE : INDEX_VALID;
+  m_bloomHashes.clear();
+  m_bloomBits.clear();
+  return NO_ERROR;
+}
+
+int Dctnry::writeBloomFilter()
+{
+  const std::string fileName = utils::DictBloomFilter::fileName(m_segFileName);
+  utils::DictBloomFilter::Header header;
+  IDBDataFile* pFile;
+  int rc = NO_ERROR;
+
+  if (m_bloomInvalid)
+  {
+    if (!IDBPolicy::exists(fileName.c_str()))
+      return NO_ERROR;
+
+    RETURN_ON_NULL((pFile = openFile(fileName.c_str(), "r+b", 0, false)), ERR_FILE_OPEN);
+    utils::DictBloomFilter::initHeader(header, m_bloomCharsetNumber, m_bloomFilterBytes, false);
+    rc = writeFile(pFile, (unsigned char*)&header, sizeof(header));
+  }
+  else if (m_bloomState == INDEX_NEW)
+  {
+    // Also writes over the filter of a store file that was dropped
+    if (m_bloomBits.empty())
+      buildBloomBits();
+
+    // The header turns valid after the bits are on disk, PrimProc may read the file meanwhile
+    RETURN_ON_NULL((pFile = openFile(fileName.c_str(), "w+b", 0, false)), ERR_FILE_CREATE);
+    std::vector<unsigned char> headerBlock(utils::DictBloomFilter::HEADER_LEN, 0);
+    utils::DictBloomFilter::initHeader(header, m_bloomCharsetNumber, m_bloomFilterBytes, false);
+    memcpy(headerBlock.data(), &header, sizeof(header));
+    rc = writeFile(pFile, headerBlock.data(), headerBlock.size());
+
+    if (rc == NO_ERROR)
+      rc = writeFile(pFile, m_bloomBits.data(), m_bloomBits.size());
+
+    if (rc == NO_ERROR && pFile->flush() != 0)
+      rc = ERR_FILE_WRITE;
+
+    if (rc == NO_ERROR && (rc = setFileOffset(pFile, 0)) == NO_ERROR)
+    {
+      utils::DictBloomFilter::initHeader(header, m_bloomCharsetNumber, m_bloomFilterBytes, true);
+      rc = writeFile(pFile, (unsigned char*)&header, sizeof(header));
+    }
+  }
+  else
+  {
+    RETURN_ON_NULL((pFile = openFile(fileName.c_str(), "r+b", 0, false)), ERR_FILE_OPEN);
+
+    if (m_bloomBits.empty())
+    {
+      // A few DML strings, only their bytes of the filter are updated
+      for (auto hash : m_bloomHashes)
+      {
+        uint32_t bits[utils::DictBloomFilter::HASH_COUNT];
+        utils::DictBloomFilter::bits(hash, m_bloomFilterBytes, bits);
+
+        for (uint32_t i = 0; rc == NO_ERROR && i < utils::DictBloomFilter::HASH_COUNT; i++)
+        {
+          uint8_t byte = 0;
+          const uint64_t offset = utils::DictBloomFilter::offset(bits[i]);
+
+          if (pFile->pread(&byte, offset, 1) != 1)
+            rc = ERR_FILE_READ;
+          else if (!utils::DictBloomFilter::test(byte, bits[i]))
+          {
+            byte |= 1 << (bits[i] & 7);
+
+            if ((rc = setFileOffset(pFile, offset)) == NO_ERROR)
+              rc = writeFile(pFile, &byte, 1);
+          }
+        }
+      }
+    }
+    else
+    {
+      std::vector<uint8_t> filter(m_bloomFilterBytes);
+
+      if (pFile->pread(filter.data(), utils::DictBloomFilter::HEADER_LEN, filter.size()) !=
+          (ssize_t)filter.size())
+        rc = ERR_FILE_READ;
+      else
+      {
+        for (size_t i = 0; i < filter.size(); i++)
+          filter[i] |= m_bloomBits[i];
+
+        if ((rc = setFileOffset(pFile, utils::DictBloomFilter::HEADER_LEN)) == NO_ERROR)
+          rc = writeFile(pFile, filter.data(), filter.size());
+      }
+    }
+  }
+
+  if (rc == NO_ERROR && pFile->flush() != 0)
+    rc = ERR_FILE_WRITE;
+
+  closeFile(pFile);
+  return rc;
+}
+
+/*******************************************************************************
+ * Find out if the blocks of the opened store file are in an n-gram index, as
+ * for the Bloom filter.
+ ******************************************************************************/
+void Dctnry::openNgramIndex()
+{
+  m_ngramBlocks.clear();
+  m_ngramInvalid = false;
+  m_ngramCreated = false;
+  m_ngramCharsetNumber = 0;
+
+  if (m_hwm == 0 && m_curOp == 0)
+  {
+    m_ngramState = INDEX_NEW;
+    return;
+  }
+
+  m_ngramState = INDEX_NONE;
+  const std::string fileName = utils::DictNgramIndex::fileName(m_segFileName);
+
+  if (!IDBPolicy::exists(fileName.c_str()))
+    return;
+
+  IDBDataFile* pFile = openFile(fileName.c_str(), "rb", 0, false);
+
+  if (pFile == NULL)
+    return;
+
+  utils::DictNgramIndex::Header header;
+
+  if (pFile->pread(&header, 0, sizeof(header)) == (ssize_t)sizeof(header) &&
+      utils::DictNgramIndex::isValid(header))
+  {
+    m_ngramState = INDEX_VALID;
+    m_ngramCharsetNumber = header.charsetNumber;
+  }
+
+  closeFile(pFile);
+}
+
+/*******************************************************************************
+ * Add the bytes of a string stored in block fbo of the store file to the
+ * signature of the block
+ ******************************************************************************/
+int Dctnry::addToNgramIndex(uint32_t fbo, const unsigned char* str, int len)
+{
+  if (m_ngramState == INDEX_NONE || m_ngramInvalid)
+    return NO_ERROR;
+
+  if (m_ngramState == INDEX_NEW && m_ngramCharsetNumber == 0 && m_charset &&
+      utils::DictNgramIndex::supported(*m_charset))
+    m_ngramCharsetNumber = m_charset->number;
+
+  if (!m_charset || m_charset->number != m_ngramCharsetNumber)
+  {
+    m_ngramInvalid = true;
+    m_ngramBlocks.clear();
+    return NO_ERROR;
+  }
+
+  std::vector<uint8_t>& signature = m_ngramBlocks[fbo];
+
+  if (signature.empty())
+    signature.resize(utils::DictNgramIndex::SIGNATURE_BYTES, 0);
+
+  utils::DictNgramIndex::add(signature.data(), str, len, utils::DictNgramIndex::exact(*m_charset));
+
+  // A bulk load fills blocks all the time, their signatures go out as they pile up
+  if (m_ngramBlocks.size() >= MAX_NGRAM_BLOCKS)
+    return flushNgramIndex(false);
+
+  return NO_ERROR;
+}
+
+/*******************************************************************************
+ * Write the block signatures to the n-gram index file, the index of a new
+ * store file turns valid when the file is closed. If writing fails the index
+ * file is removed.
+ ******************************************************************************/
+int Dctnry::flushNgramIndex(bool closing)
+{
+  if (m_ngramState == INDEX_NONE)
+    return NO_ERROR;
+
+  // Nothing to write unless the new index file turns valid
+  const bool finishing = closing && m_ngramState == INDEX_NEW && m_ngramCreated;
+
+  if (!m_ngramInvalid && m_ngramBlocks.empty() && !finishing)
+    return NO_ERROR;
+
+  const std::string fileName = utils::DictNgramIndex::fileName(m_segFileName);
+  int rc = writeNgramIndex(closing);
+
+  if (rc != NO_ERROR)
+  {
+    if (IDBPolicy::remove(fileName.c_str()) != 0 && errno != ENOENT)
+      return rc;
+
+    m_ngramInvalid = true;
+  }
+
+  if (m_ngramInvalid)
+    m_ngramState = INDEX_NONE;
+  else if (closing)
+    m_ngramState = INDEX_VALID;
+
+  m_ngramBlocks.clear();
+  return NO_ERROR;
+}
+
+int Dctnry::writeNgramIndex(bool closing)
+{
+  const std::string fileName = utils::DictNgramIndex::fileName(m_segFileName);
+  const uint32_t sigBytes = utils::DictNgramIndex::SIGNATURE_BYTES;
+  utils::DictNgramIndex::Header header;
+  IDBDataFile* pFile;
+  int rc = NO_ERROR;
+
+  if (m_ngramInvalid)
+  {
+    if (!IDBPolicy::exists(fileName.c_str()))
+      return NO_ERROR;
+
+    RETURN_ON_NULL((pFile = openFile(fileName.c_str(), "r+b", 0, false)), ERR_FILE_OPEN);
+    utils::DictNgramIndex::initHeader(header, m_ngramCharsetNumber, false);
+    rc = writeFile(pFile, (unsigned char*)&header, sizeof(header));
+  }
+  else
+  {
+    if (m_ngramState == INDEX_NEW && !m_ngramCreated)
+    {
+      // Also writes over the index of a store file that was dropped
+      RETURN_ON_NULL((pFile = openFile(fileName.c_str(), "w+b", 0, false)), ERR_FILE_CREATE);
+      std::vector<unsigned char> headerBlock(utils::DictNgramIndex::HEADER_LEN, 0);
+      utils::DictNgramIndex::initHeader(header, m_ngramCharsetNumber, false);
+      memcpy(headerBlock.data(), &header, sizeof(header));
+      rc = writeFile(pFile, headerBlock.data(), headerBlock.size());
+      m_ngramCreated = true;
+    }
+    else
+    {
+      RETURN_ON_NULL((pFile = openFile(fileName.c_str(), "r+b", 0, false)), ERR_FILE_OPEN);
+    }
+
+    // The signatures of each run of consecutive blocks are merged in one read and write
+    auto it = m_ngramBlocks.begin();
+
+    while (rc == NO_ERROR && it != m_ngramBlocks.end())
+    {
+      auto end = it;
+      uint32_t count = 0;
+
+      while (end != m_ngramBlocks.end() && end->first == it->first + count)
+      {
+        ++end;
+        ++count;
+      }
+
+      std::vector<uint8_t> run(count * sigBytes, 0);
+      const uint64_t offset = utils::DictNgramIndex::offset(it->first);
+
+      // Past the end of the file there is nothing to merge with
+      if (pFile->pread(run.data(), offset, run.size()) < 0)
+        rc = ERR_FILE_READ;
+
+      for (uint8_t* dest = run.data(); rc == NO_ERROR && it != end; ++it, dest += sigBytes)
+      {
+        for (uint32_t i = 0; i < sigBytes; i++)
+          dest[i] |= it->second[i];
+      }
+
+      if (rc == NO_ERROR && (rc = setFileOffset(pFile, offset)) == NO_ERROR)
+        rc = writeFile(pFile, run.data(), run.size());
+    }
+
+    // The header turns valid after the signatures are on disk, PrimProc may read the file meanwhile
+    if (rc == NO_ERROR && closing && m_ngramState == INDEX_NEW)
+    {
+      if (pFile->flush() != 0)
+        rc = ERR_FILE_WRITE;
+
+      if (rc == NO_ERROR && (rc = setFileOffset(pFile, 0)) == NO_ERROR)
+      {
+        utils::DictNgramIndex::initHeader(header, m_ngramCharsetNumber, true);
+        rc = writeFile(pFile, (unsigned char*)&header, sizeof(header));
+      }
+    }
+  }
+
+  if (rc == NO_ERROR && pFile->flush() != 0)
+    rc = ERR_FILE_WRITE;
+
+  closeFile(pFile);
+  return rc;
+}
+
+/*******************************************************************************
+ * Start the order index of the opened store file. Only a store file without
+ * strings gets a new index, the index of another one is dropped when a string
+ * is added.
+ ******************************************************************************/
+void Dctnry::openOrderIndex()
+{
+  m_orderIndex.open(m_hwm == 0 && m_curOp == 0);
+}
+
+/*******************************************************************************
+ * Keep the string of a token inserted into the store file. The first string
+ * added removes the index file, PrimProc can't use it until the tokens of the
+ * store file are in there.
+ ******************************************************************************/
+int Dctnry::addToOrderIndex(const Token& token, const unsigned char* str, int len)
+{
+  uint64_t tokenValue;
+  memcpy(&tokenValue, &token, sizeof(tokenValue));
+
+  // PrimProc reads the strings that span blocks from the store file
+  if (m_orderIndex.add(tokenValue, m_charset ? m_charset->number : 0,
+                       token.bc != 0 ? NULL : (const char*)str, len))
+  {
+    // Also the index of a store file that was dropped
+    const std::string fileName = utils::DictOrderIndex::fileName(m_segFileName);
+
+    if (IDBPolicy::remove(fileName.c_str()) != 0 && errno != ENOENT)
+      return ERR_FILE_DELETE;
+  }
+
+  return NO_ERROR;
+}
+
+/*******************************************************************************
+ * Write the index file of the strings added, without it PrimProc reads the
+ * strings from the store file.
+ ******************************************************************************/
+int Dctnry::flushOrderIndex()
+{
+  if (!m_orderIndex.changed())
+    return NO_ERROR;
+
+  if (writeOrderIndex() == NO_ERROR)
+    m_orderIndex.written();
+  else
+    m_orderIndex.drop();
+
+  return NO_ERROR;
+}
+
+int Dctnry::writeOrderIndex()
+{
+  const std::string fileName = utils::DictOrderIndex::fileName(m_segFileName);
+  const std::string tmpFileName = fileName + ".tmp";
+  utils::DictOrderIndex index;
+  std::string file;
+
+  // The generation tells PrimProc the file is not the one it read before
+  const uint64_t generation = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::system_clock::now().time_since_epoch())
+                                  .count();
+  m_orderIndex.build(index);
+  index.serialize(m_orderIndex.collation(), generation, file);
+
+  IDBDataFile* pFile;
+  RETURN_ON_NULL((pFile = openFile(tmpFileName.c_str(), "w+b", 0, false)), ERR_FILE_CREATE);
+  int rc = writeFile(pFile, (const unsigned char*)file.data(), file.size());
+
+  if (rc == NO_ERROR && pFile->flush() != 0)
+    rc = ERR_FILE_WRITE;
+
+  closeFile(pFile);
+
+  // PrimProc reads the whole file or none of it
+  if (rc == NO_ERROR && IDBPolicy::rename(tmpFileName.c_str(), fileName.c_str()) != 0)
+    rc = ERR_FILE_WRITE;
+
+  if (rc != NO_ERROR)
+    IDBPolicy::remove(tmpFileName.c_str());
+
+  return rc;
+}
+
 }  // namespace WriteEngine
@@ -29,13 +29,16 @@
 #include <cstdlib>
 #include <cstddef>
 #include <iostream>
+#include <map>
 #include <string>
+#include <vector>
 
 #include "we_dbfileop.h"
 #include "we_type.h"
 #include "we_brm.h"
 #include "bytestream.h"
 #include "nullstring.h"
+#include "dictorderindex.h"
 
 #define EXPORT
 
@@ -226,6 +229,12 @@ class Dctnry : public DbFileOp
     m_importDataMode = importMode;
   }
 
+  /**
+   * @brief Set the collation of the strings inserted until the file is closed,
+   * the Bloom filter of the store file hashes them with it
+   */
+  EXPORT void setCharsetNumber(uint32_t charsetNumber);
+
   virtual int checkFixLastDictChunk()
   {
     return NO_ERROR;
@@ -298,6 +307,38 @@ class Dctnry : public DbFileOp
   virtual void closeDctnryFile(bool doFlush, std::map<FID, FID>& oids);
   virtual int numOfBlocksInFile();
 
+  //
+  // Bloom filter of the strings of the store file, see utils::DictBloomFilter.
+  // The hashes of the inserted strings are added to the filter file when the
+  // store file is closed.
+  //
+  void openBloomFilter();
+  void addToBloomFilter(const unsigned char* str, int len);
+  void buildBloomBits();
+  int flushBloomFilter();
+  int writeBloomFilter();
+
+  //
+  // Trigram signatures of the blocks of the store file, see utils::DictNgramIndex.
+  // The signatures of the blocks strings are stored in are written to the index
+  // file when there are many of them and when the store file is closed.
+  //
+  void openNgramIndex();
+  int addToNgramIndex(uint32_t fbo, const unsigned char* str, int len);
+  int flushNgramIndex(bool closing);
+  int writeNgramIndex(bool closing);
+
+  //
+  // Order preserving codes of the strings of the store file, see utils::DictOrderIndex.
+  // The strings and their tokens are kept while a store file started empty is open,
+  // the index file is removed when a string is added and written anew when the file
+  // is closed. The index of another store file is dropped when strings are added.
+  //
+  void openOrderIndex();
+  int addToOrderIndex(const Token& token, const unsigned char* str, int len);
+  int flushOrderIndex();
+  int writeOrderIndex();
+
   std::set<Signature, sig_compare> m_sigArray;
   int m_arraySize;  // num strings in m_sigArray
 
@@ -330,6 +371,26 @@ class Dctnry : public DbFileOp
   utils::NullString m_defVal;             // optional default string value
   ImportDataMode m_importDataMode;  // Import data in text or binary mode
 
+  enum IndexState  // of the Bloom filter and the n-gram index
+  {
+    INDEX_NONE,  // the store file has no valid index
+    INDEX_NEW,   // the store file was empty, a new index is started
+    INDEX_VALID  // the strings are added to the existing index
+  };
+  const CHARSET_INFO* m_charset;        // collation of the inserted strings
+  IndexState m_bloomState;
+  uint32_t m_bloomCharsetNumber;        // collation of the filter hashes
+  uint32_t m_bloomFilterBytes;          // size of the filter, 0 until a new one is sized
+  bool m_bloomInvalid;                  // strings were added the filter can't hash
+  std::vector<uint32_t> m_bloomHashes;  // hashes not in the filter file yet
+  std::vector<uint8_t> m_bloomBits;     // the filter, once there are many hashes
+  IndexState m_ngramState;
+  uint32_t m_ngramCharsetNumber;        // collation the trigrams are folded with
+  bool m_ngramInvalid;                  // strings were added the index can't fold
+  bool m_ngramCreated;                  // the new index file is written, not valid yet
+  std::map<uint32_t, std::vector<uint8_t>> m_ngramBlocks;  // signatures by fbo not in the file yet
+  utils::DictOrderIndexWriter m_orderIndex;
+
 };  // end of class
 
 }  // namespace WriteEngine
@@ -152,6 +152,7 @@ void BulkRollbackFileCompressed::truncateSegmentFile(OID columnOID, uint32_t dbR
 
     ptrs.push_back(chunkPtrs[chunkIndex].first + chunkPtrs[chunkIndex].second);
     compress::CompressInterface::storePtrs(ptrs, hdrs);
+    compress::CompressInterface::clearChunkZoneMaps(hdrs, chunkIndex + 1);
 
     rc = fDbFile.writeHeaders(pFile, hdrs);
 
@@ -385,6 +386,8 @@ void BulkRollbackFileCompressed::reInitTruncColumnExtent(OID columnOID, uint32_t
 
     newPtrs.push_back(chunkPtrs[chunkIndex].first + restoredChunkLen);
     compress::CompressInterface::storePtrs(newPtrs, hdrs);
+    // The restored chunk holds the values it had before the import
+    compress::CompressInterface::clearChunkZoneMaps(hdrs, chunkIndex);
 
     rc = fDbFile.writeHeaders(pFile, hdrs);
 
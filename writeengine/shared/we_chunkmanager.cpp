@@ -103,7 +103,8 @@ ChunkManager::ChunkManager()
                                : IDBFileSystem::getFs(IDBDataFile::BUFFERED))
 {
   fUserPaddings = Config::getNumCompressedPadBlks() * BYTE_PER_BLOCK;
-  compress::initializeCompressorPool(fCompressorPool, fUserPaddings);
+  compress::initializeCompressorPool(fCompressorPool, fUserPaddings, Config::getCompressionLevel(),
+                                     Config::getChunkEncoding());
 
   COMPRESSED_CHUNK_SIZE =
       compress::CompressInterface::getMaxCompressedSizeGeneric(UNCOMPRESSED_CHUNK_SIZE) + 64 + 3 + 8 * 1024;
@@ -869,6 +870,24 @@ void ChunkManager::initializeDctnryChunk(char* buf, int size)
   }
 }
 
+//------------------------------------------------------------------------------
+// Update the zone map of a column chunk in the header, PrimProc uses it to
+// skip the chunks that can't match a scan filter.
+//------------------------------------------------------------------------------
+void ChunkManager::updateChunkZoneMap(CompFileData* fileData, ChunkData* chunkData)
+{
+  if (fileData->fDctnryCol)
+    return;
+
+  compress::ChunkZoneMap zoneMap;
+  const uint8_t* emptyVal = fFileOp->getEmptyRowValue(fileData->fColDataType, fileData->fColWidth);
+  FileOp::computeChunkZoneMap(reinterpret_cast<unsigned char*>(chunkData->fBufUnCompressed),
+                              chunkData->fLenUnCompressed, fileData->fColDataType, fileData->fColWidth,
+                              emptyVal, zoneMap);
+  compress::CompressInterface::setChunkZoneMap(fileData->fFileHeader.fControlData, chunkData->fChunkId,
+                                               zoneMap);
+}
+
 //------------------------------------------------------------------------------
 // Compress and write the requested chunk (id) for fileData, to disk.
 // id is: (fbo*BYTE_PER_BLOCK)/UNCOMPRESSED_CHUNK_SIZE
@@ -916,12 +935,15 @@ int ChunkManager::writeChunkToFile(CompFileData* fileData, ChunkData* chunkData)
     }
 
     if (fCompressor->compressBlock((char*)chunkData->fBufUnCompressed, chunkData->fLenUnCompressed,
-                                   (unsigned char*)fBufCompressed, fLenCompressed) != 0)
+                                   (unsigned char*)fBufCompressed, fLenCompressed, encodingWidth(fileData),
+                                   fileData->fColDataType) != 0)
     {
       logMessage(ERR_COMP_COMPRESS, logging::LOG_TYPE_ERROR, __LINE__);
       return ERR_COMP_COMPRESS;
     }
 
+    updateChunkZoneMap(fileData, chunkData);
+
     WE_COMP_DBG(cout << "Chunk compressed from " << chunkData->fLenUnCompressed << " to " << fLenCompressed;)
 
     // Removed padding code here, will add padding for the last chunk.
@@ -1865,7 +1887,8 @@ int ChunkManager::reallocateChunks(CompFileData* fileData)
       }
 
       if ((rc = fCompressor->compressBlock((char*)chunkData->fBufUnCompressed, chunkData->fLenUnCompressed,
-                                           (unsigned char*)fBufCompressed, fLenCompressed)) != 0)
+                                           (unsigned char*)fBufCompressed, fLenCompressed,
+                                           encodingWidth(fileData), fileData->fColDataType)) != 0)
       {
         ostringstream oss;
         oss << "Compress data failed @line:" << __LINE__ << "with retCode:" << rc
@@ -1879,6 +1902,8 @@ int ChunkManager::reallocateChunks(CompFileData* fileData)
       WE_COMP_DBG(cout << "Chunk compressed from " << chunkData->fLenUnCompressed << " to "
                        << fLenCompressed;)
 
+      updateChunkZoneMap(fileData, chunkData);
+
       // shifting chunk, add padding space
       if ((rc = fCompressor->padCompressedChunks((unsigned char*)fBufCompressed, fLenCompressed,
                                                  fMaxCompressedBufSize)) != 0)
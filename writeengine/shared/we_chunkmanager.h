@@ -314,6 +314,15 @@ class ChunkManager
   void initializeColumnChunk(char* buf, CompFileData* fileData);
   void initializeDctnryChunk(char* buf, int size);
 
+  // @brief Update the header zone map of a column chunk about to be written.
+  void updateChunkZoneMap(CompFileData* fileData, ChunkData* chunkData);
+
+  // @brief Width the values of the chunks of a file are encoded in, 0 for none.
+  uint32_t encodingWidth(const CompFileData* fileData) const
+  {
+    return fileData->fDctnryCol ? 0 : fileData->fColWidth;
+  }
+
   // @brief Calculate the header size based on column width.
   int calculateHeaderSize(int width);
 
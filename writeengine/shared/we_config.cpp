@@ -71,6 +71,9 @@ string Config::m_BulkRollbackDir;
 bool Config::m_FastDelete;
 unsigned Config::m_MaxFileSystemDiskUsage = DEFAULT_MAX_FILESYSTEM_DISK_USAGE;
 unsigned Config::m_NumCompressedPadBlks = DEFAULT_COMPRESSED_PADDING_BLKS;
+unsigned Config::m_NumCompressionThreads = 0;
+int Config::m_CompressionLevel = 0;
+bool Config::m_ChunkEncoding = false;
 bool Config::m_ParentOAMModuleFlag = DEFAULT_PARENT_OAM;
 string Config::m_LocalModuleType;
 int Config::m_LocalModuleID = DEFAULT_LOCAL_MODULE_ID;
@@ -217,6 +220,31 @@ void Config::checkReload()
   if (ncpb.length() != 0)
     m_NumCompressedPadBlks = cf->uFromText(ncpb);
 
+  //--------------------------------------------------------------------------
+  // Number of threads compressing column chunks, one per core by default
+  //--------------------------------------------------------------------------
+  m_NumCompressionThreads = boost::thread::hardware_concurrency();
+  string nct = cf->getConfig("WriteEngine", "CompressionThreads");
+
+  if (nct.length() != 0)
+    m_NumCompressionThreads = cf->uFromText(nct);
+
+  //--------------------------------------------------------------------------
+  // Compression level of the compression types that have levels (ZSTD)
+  //--------------------------------------------------------------------------
+  m_CompressionLevel = 0;
+  string cl = cf->getConfig("WriteEngine", "CompressionLevel");
+
+  if (cl.length() != 0)
+    m_CompressionLevel = cf->fromText(cl);
+
+  //--------------------------------------------------------------------------
+  // Chunk encoding option, off by default: versions without ChunkEncoding
+  // can't read the encoded chunks
+  //--------------------------------------------------------------------------
+  const std::string chunkEncodingTemp = cf->getConfig("WriteEngine", "ChunkEncoding");
+  m_ChunkEncoding = (chunkEncodingTemp == "y" || chunkEncodingTemp == "Y");
+
   IDBPolicy::configIDBPolicy();
 
   //--------------------------------------------------------------------------
@@ -570,6 +598,51 @@ unsigned Config::getNumCompressedPadBlks()
   return m_NumCompressedPadBlks;
 }
 
+/*******************************************************************************
+ * DESCRIPTION:
+ *    Get number of threads compressing the chunks of the compressed columns
+ *    of a bulk load; 0 if each chunk is compressed by the thread writing it.
+ * PARAMETERS:
+ *    none
+ ******************************************************************************/
+unsigned Config::getNumCompressionThreads()
+{
+  boost::mutex::scoped_lock lk(fCacheLock);
+  checkReload();
+
+  return m_NumCompressionThreads;
+}
+
+/*******************************************************************************
+ * DESCRIPTION:
+ *    Get level to compress chunks with, for the compression types that have
+ *    levels; 0 for their default level.
+ * PARAMETERS:
+ *    none
+ ******************************************************************************/
+int Config::getCompressionLevel()
+{
+  boost::mutex::scoped_lock lk(fCacheLock);
+  checkReload();
+
+  return m_CompressionLevel;
+}
+
+/*******************************************************************************
+ * DESCRIPTION:
+ *    Get whether the chunks of column files are also compressed encoded by
+ *    ChunkEncoding, keeping the smaller of the two.
+ * PARAMETERS:
+ *    none
+ ******************************************************************************/
+bool Config::getChunkEncoding()
+{
+  boost::mutex::scoped_lock lk(fCacheLock);
+  checkReload();
+
+  return m_ChunkEncoding;
+}
+
 /*******************************************************************************
  * DESCRIPTION:
  *    Get Parent OAM Module flag; are we running on active parent OAM node.
@@ -132,6 +132,22 @@ class Config
    */
   EXPORT static unsigned getNumCompressedPadBlks();
 
+  /**
+   * @brief Number of threads compressing column chunks in a bulk load.
+   */
+  EXPORT static unsigned getNumCompressionThreads();
+
+  /**
+   * @brief Level of the compression types that have levels, 0 for default.
+   */
+  EXPORT static int getCompressionLevel();
+
+  /**
+   * @brief Whether the compressed chunks of column files are tried with
+   * ChunkEncoding.
+   */
+  EXPORT static bool getChunkEncoding();
+
   /**
    * @brief Parent OAM Module flag (is this the parent OAM node, ex: pm1)
    */
@@ -190,6 +206,9 @@ class Config
   static bool m_FastDelete;                   // fast delete option
   static unsigned m_MaxFileSystemDiskUsage;   // max file system % disk usage
   static unsigned m_NumCompressedPadBlks;     // num blks to pad comp chunks
+  static unsigned m_NumCompressionThreads;    // num threads compressing
+  static int m_CompressionLevel;              // level of ZSTD compression
+  static bool m_ChunkEncoding;                // try ChunkEncoding on chunks
   static bool m_ParentOAMModuleFlag;          // are we running on parent PM
   static std::string m_LocalModuleType;       // local node type (ex: "pm")
   static int m_LocalModuleID;                 // local node id   (ex: 1   )
@@ -160,6 +160,8 @@ WErrorCodes::WErrorCodes() : fErrorCodes()
   fErrorCodes[ERR_BULK_ROLLBACK_SEG_LIST] = " Error building segment file list in a directory.";
   fErrorCodes[ERR_BULK_BINARY_PARTIAL_REC] = " Binary import did not end on fixed length record boundary.";
   fErrorCodes[ERR_BULK_BINARY_IGNORE_FLD] = " <IgnoreField> tag not supported for binary imports.";
+  fErrorCodes[ERR_BULK_PARQUET_READ] = " Error reading Parquet or Arrow import data.";
+  fErrorCodes[ERR_BULK_PARQUET_SCHEMA] = " Parquet or Arrow columns do not match the table columns.";
 
   // BRM error
   fErrorCodes[ERR_BRM_LOOKUP_LBID] = " a BRM Lookup LBID error.";
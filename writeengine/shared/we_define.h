@@ -263,6 +263,9 @@ const int ERR_BULK_BINARY_PARTIAL_REC =
     ERR_BULKBASE + 10;  // Binary input did not end on fixed length record boundary
 const int ERR_BULK_BINARY_IGNORE_FLD =
     ERR_BULKBASE + 11;  // <IgnoreField> tag not supported for binary import
+const int ERR_BULK_PARQUET_READ = ERR_BULKBASE + 12;  // Error reading Parquet or Arrow input
+const int ERR_BULK_PARQUET_SCHEMA =
+    ERR_BULKBASE + 13;  // Parquet or Arrow columns do not match the table columns
 
 //--------------------------------------------------------------------------
 // BRM error
@@ -51,11 +51,65 @@ using namespace compress;
 #include "messagelog.h"
 using namespace logging;
 
+#include "mcs_datatype.h"
+#include "nullvaluemanip.h"
+#include "dictbloomfilter.h"
+#include "dictngramindex.h"
+#include "dictorderindex.h"
+
 #include "IDBDataFile.h"
 #include "IDBFileSystem.h"
 #include "IDBPolicy.h"
 using namespace idbdatafile;
 
+namespace
+{
+// Min and max of the values of a chunk in the domain T is compared in
+template <typename T>
+void fillChunkZoneMap(const unsigned char* buf, size_t len, const uint8_t* emptyVal, uint64_t nullVal,
+                      compress::ChunkZoneMap& zoneMap)
+{
+  T empty;
+  memcpy(&empty, emptyVal, sizeof(T));
+  const T null = static_cast<T>(nullVal);
+  T min = 0;
+  T max = 0;
+  bool found = false;
+
+  for (const unsigned char *pos = buf, *end = buf + len - len % sizeof(T); pos < end; pos += sizeof(T))
+  {
+    T value;
+    memcpy(&value, pos, sizeof(T));
+
+    if (value == empty)
+      continue;
+
+    if (value == null)
+    {
+      zoneMap.nullCount++;
+      continue;
+    }
+
+    if (!found)
+    {
+      min = max = value;
+      found = true;
+    }
+    else if (value < min)
+      min = value;
+    else if (value > max)
+      max = value;
+  }
+
+  if (found)
+  {
+    zoneMap.min = static_cast<int64_t>(min);
+    zoneMap.max = static_cast<int64_t>(max);
+    zoneMap.flags |= compress::ChunkZoneMap::HAS_VALUES;
+  }
+}
+}  // namespace
+
 namespace WriteEngine
 {
 /*static*/ boost::mutex FileOp::m_createDbRootMutexes;
@@ -443,6 +497,13 @@ int FileOp::deleteFile(FID fid, uint16_t dbRoot, uint32_t partition, uint16_t se
 
   RETURN_ON_ERROR(getFileName(fid, fileName, dbRoot, partition, segment));
 
+  // The Bloom filter, the n-gram index and the order index of a dictionary store file go along with it.
+  // Most files have none of them, removing a missing one is cheaper than asking for it first on S3.
+  for (const std::string& indexFileName :
+       {utils::DictBloomFilter::fileName(fileName), utils::DictNgramIndex::fileName(fileName),
+        utils::DictOrderIndex::fileName(fileName)})
+    (void)IDBPolicy::remove(indexFileName.c_str());
+
   return (deleteFile(fileName));
 }
 
@@ -1148,8 +1209,8 @@ int FileOp::writeInitialCompColumnChunk(IDBDataFile* pFile, int nBlocksAllocated
   // Compress an initialized abbreviated extent
   // Initially m_compressionType == 0, but this function is used under
   // condtion where m_compressionType > 0.
-  std::unique_ptr<CompressInterface> compressor(
-      compress::getCompressInterfaceByType(m_compressionType, userPaddingBytes));
+  std::unique_ptr<CompressInterface> compressor(compress::getCompressInterfaceByType(
+      m_compressionType, userPaddingBytes, Config::getCompressionLevel(), Config::getChunkEncoding()));
   const size_t OUTPUT_BUFFER_SIZE = compressor->maxCompressedSize(INPUT_BUFFER_SIZE) + userPaddingBytes +
                                     compress::CompressInterface::COMPRESSED_CHUNK_INCREMENT_SIZE;
 
@@ -1160,7 +1221,8 @@ int FileOp::writeInitialCompColumnChunk(IDBDataFile* pFile, int nBlocksAllocated
 
   setEmptyBuf((unsigned char*)toBeCompressedInput, INPUT_BUFFER_SIZE, emptyVal, width);
 
-  int rc = compressor->compressBlock(toBeCompressedInput, INPUT_BUFFER_SIZE, compressedOutput, outputLen);
+  int rc = compressor->compressBlock(toBeCompressedInput, INPUT_BUFFER_SIZE, compressedOutput, outputLen,
+                                     width, colDataType);
 
   if (rc != 0)
   {
@@ -1258,7 +1320,8 @@ int FileOp::fillCompColumnExtentEmptyChunks(OID oid, int colWidth, const uint8_t
   int userPadBytes = Config::getNumCompressedPadBlks() * BYTE_PER_BLOCK;
 
   std::unique_ptr<CompressInterface> compressor(compress::getCompressInterfaceByType(
-      compress::CompressInterface::getCompressionType(hdrs), userPadBytes));
+      compress::CompressInterface::getCompressionType(hdrs), userPadBytes, Config::getCompressionLevel(),
+      Config::getChunkEncoding()));
 
   CompChunkPtrList chunkPtrs;
   int rcComp = compress::CompressInterface::getPtrList(hdrs, chunkPtrs);
@@ -1382,7 +1445,8 @@ int FileOp::fillCompColumnExtentEmptyChunks(OID oid, int colWidth, const uint8_t
       // Compress and then pad the compressed chunk
       setEmptyBuf((unsigned char*)toBeCompressedBuf, IN_BUF_LEN, emptyVal, colWidth);
       size_t outputLen = OUT_BUF_LEN;
-      rcComp = compressor->compressBlock(toBeCompressedBuf, IN_BUF_LEN, compressedBuf, outputLen);
+      rcComp = compressor->compressBlock(toBeCompressedBuf, IN_BUF_LEN, compressedBuf, outputLen, colWidth,
+                                         colDataType);
 
       if (rcComp != 0)
       {
@@ -1450,6 +1514,9 @@ int FileOp::fillCompColumnExtentEmptyChunks(OID oid, int colWidth, const uint8_t
     ptrs.push_back(chunkPtrs[chunkPtrs.size() - 1].first + chunkPtrs[chunkPtrs.size() - 1].second);
     compress::CompressInterface::storePtrs(ptrs, hdrs);
 
+    // The empty chunks may take the place of chunks dropped by a rollback
+    compress::CompressInterface::clearChunkZoneMaps(hdrs, chunkPtrs.size() - numChunksToFill);
+
     rc = writeHeaders(pFile, hdrs);
 
     if (rc != NO_ERROR)
@@ -1506,12 +1573,14 @@ int FileOp::expandAbbrevColumnChunk(IDBDataFile* pFile, const uint8_t* emptyVal,
 {
   int userPadBytes = Config::getNumCompressedPadBlks() * BYTE_PER_BLOCK;
   auto realCompressionType = m_compressionType;
+  auto colDataType = execplan::CalpontSystemCatalog::UNDEFINED;
   if (hdrs)
   {
     realCompressionType = compress::CompressInterface::getCompressionType(hdrs);
+    colDataType = compress::CompressInterface::getColDataType(hdrs);
   }
-  std::unique_ptr<CompressInterface> compressor(
-      compress::getCompressInterfaceByType(realCompressionType, userPadBytes));
+  std::unique_ptr<CompressInterface> compressor(compress::getCompressInterfaceByType(
+      realCompressionType, userPadBytes, Config::getCompressionLevel(), Config::getChunkEncoding()));
 
   const int IN_BUF_LEN = CompressInterface::UNCOMPRESSED_INBUF_LEN;
   const int OUT_BUF_LEN = compressor->maxCompressedSize(IN_BUF_LEN) + userPadBytes +
@@ -1548,7 +1617,7 @@ int FileOp::expandAbbrevColumnChunk(IDBDataFile* pFile, const uint8_t* emptyVal,
   // Compress the data we just read, as a "full" 4MB chunk
   outputLen = OUT_BUF_LEN;
   rc = compressor->compressBlock(reinterpret_cast<char*>(toBeCompressedBuf), IN_BUF_LEN, compressedOutBuf,
-                                 outputLen);
+                                 outputLen, colWidth, colDataType);
 
   if (rc != 0)
   {
@@ -2652,4 +2721,80 @@ bool FileOp::chownDataPath(const std::string& fileName) const
   return false;
 }
 
+/***********************************************************
+ * DESCRIPTION:
+ *    Compute the min/max and the null count of the values in an
+ *    uncompressed chunk, the empty values are skipped.
+ * PARAMETERS:
+ *    buf - chunk data
+ *    len - chunk length in bytes
+ *    colDataType - column data type
+ *    width - column width
+ *    emptyVal - empty value of the column
+ *    zoneMap - (out) zone map of the chunk
+ * RETURN:
+ *    false if the column type doesn't keep zone maps
+ ***********************************************************/
+/* static */
+bool FileOp::computeChunkZoneMap(const unsigned char* buf, size_t len,
+                                 execplan::CalpontSystemCatalog::ColDataType colDataType, int width,
+                                 const uint8_t* emptyVal, compress::ChunkZoneMap& zoneMap)
+{
+  zoneMap = compress::ChunkZoneMap();
+
+  switch (colDataType)
+  {
+    case execplan::CalpontSystemCatalog::TINYINT:
+    case execplan::CalpontSystemCatalog::SMALLINT:
+    case execplan::CalpontSystemCatalog::MEDINT:
+    case execplan::CalpontSystemCatalog::INT:
+    case execplan::CalpontSystemCatalog::BIGINT:
+    case execplan::CalpontSystemCatalog::DECIMAL:
+    case execplan::CalpontSystemCatalog::DATE:
+    case execplan::CalpontSystemCatalog::DATETIME:
+    case execplan::CalpontSystemCatalog::TIMESTAMP:
+    case execplan::CalpontSystemCatalog::TIME:
+    case execplan::CalpontSystemCatalog::UTINYINT:
+    case execplan::CalpontSystemCatalog::USMALLINT:
+    case execplan::CalpontSystemCatalog::UDECIMAL:
+    case execplan::CalpontSystemCatalog::UMEDINT:
+    case execplan::CalpontSystemCatalog::UINT:
+    case execplan::CalpontSystemCatalog::UBIGINT: break;
+
+    default: return false;
+  }
+
+  // The scan compares the values of these types as unsigned, the rest as signed
+  const bool isUnsigned = datatypes::isUnsigned(colDataType);
+  const uint64_t nullVal = utils::getNullValue(colDataType, width);
+
+  switch (width)
+  {
+    case 1:
+      isUnsigned ? fillChunkZoneMap<uint8_t>(buf, len, emptyVal, nullVal, zoneMap)
+                 : fillChunkZoneMap<int8_t>(buf, len, emptyVal, nullVal, zoneMap);
+      break;
+
+    case 2:
+      isUnsigned ? fillChunkZoneMap<uint16_t>(buf, len, emptyVal, nullVal, zoneMap)
+                 : fillChunkZoneMap<int16_t>(buf, len, emptyVal, nullVal, zoneMap);
+      break;
+
+    case 4:
+      isUnsigned ? fillChunkZoneMap<uint32_t>(buf, len, emptyVal, nullVal, zoneMap)
+                 : fillChunkZoneMap<int32_t>(buf, len, emptyVal, nullVal, zoneMap);
+      break;
+
+    case 8:
+      isUnsigned ? fillChunkZoneMap<uint64_t>(buf, len, emptyVal, nullVal, zoneMap)
+                 : fillChunkZoneMap<int64_t>(buf, len, emptyVal, nullVal, zoneMap);
+      break;
+
+    default: return false;
+  }
+
+  zoneMap.flags |= compress::ChunkZoneMap::VALID;
+  return true;
+}
+
 }  // namespace WriteEngine
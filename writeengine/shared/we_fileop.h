@@ -117,6 +117,14 @@ class FileOp : public BlockOp, public WeUIDGID
    */
   EXPORT bool exists(const char* fileName) const;
 
+  /**
+   * @brief Compute the zone map of an uncompressed chunk of a column.
+   * Returns false for the column types without zone maps.
+   */
+  EXPORT static bool computeChunkZoneMap(const unsigned char* buf, size_t len,
+                                         execplan::CalpontSystemCatalog::ColDataType colDataType,
+                                         int width, const uint8_t* emptyVal, compress::ChunkZoneMap& zoneMap);
+
   /**
    * @brief @brief Check whether file exists or not by using file id, DBRoot,
    * partition, and segment number.
@@ -0,0 +1,960 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+/*******************************************************************************
+ * $Id$
+ *
+ *******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <sstream>
+#include <string_view>
+#include <type_traits>
+
+#include "mcsconfig.h"
+
+#ifdef HAVE_PARQUET
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <arrow/io/stdio.h>
+#include <arrow/ipc/reader.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/properties.h>
+#endif
+
+#include "we_parquetreader.h"
+#include "we_define.h"
+#include "dataconvert.h"
+#include "joblisttypes.h"
+#include "mcs_decimal.h"
+
+using namespace execplan;
+
+namespace WriteEngine
+{
+#ifdef HAVE_PARQUET
+namespace
+{
+const int64_t BATCH_ROWS = 64 * 1024;
+const int64_t MICROS_PER_SECOND = 1000000;
+const int64_t MICROS_PER_DAY = MICROS_PER_SECOND * SECS_PER_DAY;
+const int128_t MAX_INT128 = ~datatypes::Decimal128Null;
+
+// How a table column is stored in a binary import record
+enum class ColumnKind
+{
+  SIGNED,
+  UNSIGNED,
+  DECIMAL,
+  FLOAT,
+  DOUBLE,
+  DATE,
+  DATETIME,
+  TIMESTAMP,
+  TIME,
+  STRING,
+  UNSUPPORTED
+};
+
+// The Parquet or Arrow values a column kind is converted from
+enum class SourceKind
+{
+  NUMBER,
+  DATETIME,
+  TIME,
+  BYTES,
+  UNSUPPORTED
+};
+
+ColumnKind columnKind(CalpontSystemCatalog::ColDataType dataType)
+{
+  switch (dataType)
+  {
+    case CalpontSystemCatalog::TINYINT:
+    case CalpontSystemCatalog::SMALLINT:
+    case CalpontSystemCatalog::MEDINT:
+    case CalpontSystemCatalog::INT:
+    case CalpontSystemCatalog::BIGINT: return ColumnKind::SIGNED;
+
+    case CalpontSystemCatalog::UTINYINT:
+    case CalpontSystemCatalog::USMALLINT:
+    case CalpontSystemCatalog::UMEDINT:
+    case CalpontSystemCatalog::UINT:
+    case CalpontSystemCatalog::UBIGINT: return ColumnKind::UNSIGNED;
+
+    case CalpontSystemCatalog::DECIMAL:
+    case CalpontSystemCatalog::UDECIMAL: return ColumnKind::DECIMAL;
+
+    case CalpontSystemCatalog::FLOAT:
+    case CalpontSystemCatalog::UFLOAT: return ColumnKind::FLOAT;
+
+    case CalpontSystemCatalog::DOUBLE:
+    case CalpontSystemCatalog::UDOUBLE: return ColumnKind::DOUBLE;
+
+    case CalpontSystemCatalog::DATE: return ColumnKind::DATE;
+    case CalpontSystemCatalog::DATETIME: return ColumnKind::DATETIME;
+    case CalpontSystemCatalog::TIMESTAMP: return ColumnKind::TIMESTAMP;
+    case CalpontSystemCatalog::TIME: return ColumnKind::TIME;
+
+    case CalpontSystemCatalog::CHAR:
+    case CalpontSystemCatalog::VARCHAR:
+    case CalpontSystemCatalog::VARBINARY:
+    case CalpontSystemCatalog::BLOB:
+    case CalpontSystemCatalog::TEXT:
+    case CalpontSystemCatalog::CLOB: return ColumnKind::STRING;
+
+    default: return ColumnKind::UNSUPPORTED;
+  }
+}
+
+SourceKind sourceKind(const arrow::DataType& type)
+{
+  switch (type.id())
+  {
+    case arrow::Type::BOOL:
+    case arrow::Type::INT8:
+    case arrow::Type::INT16:
+    case arrow::Type::INT32:
+    case arrow::Type::INT64:
+    case arrow::Type::UINT8:
+    case arrow::Type::UINT16:
+    case arrow::Type::UINT32:
+    case arrow::Type::UINT64:
+    case arrow::Type::FLOAT:
+    case arrow::Type::DOUBLE:
+    case arrow::Type::DECIMAL128: return SourceKind::NUMBER;
+
+    case arrow::Type::DATE32:
+    case arrow::Type::DATE64:
+    case arrow::Type::TIMESTAMP: return SourceKind::DATETIME;
+
+    case arrow::Type::TIME32:
+    case arrow::Type::TIME64: return SourceKind::TIME;
+
+    case arrow::Type::STRING:
+    case arrow::Type::BINARY:
+    case arrow::Type::LARGE_STRING:
+    case arrow::Type::LARGE_BINARY:
+    case arrow::Type::FIXED_SIZE_BINARY: return SourceKind::BYTES;
+
+    case arrow::Type::DICTIONARY:
+      return sourceKind(*static_cast<const arrow::DictionaryType&>(type).value_type());
+
+    default: return SourceKind::UNSUPPORTED;
+  }
+}
+
+bool convertible(ColumnKind column, int width, SourceKind source)
+{
+  switch (column)
+  {
+    case ColumnKind::SIGNED:
+    case ColumnKind::UNSIGNED:
+    case ColumnKind::DECIMAL:
+      return source == SourceKind::NUMBER && (width == 1 || width == 2 || width == 4 || width == 8 ||
+                                              (width == 16 && column == ColumnKind::DECIMAL));
+
+    case ColumnKind::FLOAT:
+    case ColumnKind::DOUBLE: return source == SourceKind::NUMBER;
+
+    case ColumnKind::DATE:
+    case ColumnKind::DATETIME:
+    case ColumnKind::TIMESTAMP: return source == SourceKind::DATETIME;
+
+    case ColumnKind::TIME: return source == SourceKind::TIME;
+
+    case ColumnKind::STRING: return source == SourceKind::BYTES;
+
+    default: return false;
+  }
+}
+
+int64_t floorDiv(int64_t value, int64_t divisor)
+{
+  int64_t quotient = value / divisor;
+  return (value % divisor < 0) ? quotient - 1 : quotient;
+}
+
+int64_t toMicros(int64_t value, arrow::TimeUnit::type unit)
+{
+  switch (unit)
+  {
+    case arrow::TimeUnit::SECOND: return value * MICROS_PER_SECOND;
+    case arrow::TimeUnit::MILLI: return value * 1000;
+    case arrow::TimeUnit::MICRO: return value;
+    default: return floorDiv(value, 1000);
+  }
+}
+
+// Proleptic Gregorian date of a count of days from 1970-01-01
+void civilFromDays(int64_t days, int64_t& year, unsigned& month, unsigned& day)
+{
+  days += 719468;
+  const int64_t era = floorDiv(days, 146097);
+  const unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+  const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+  const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  const unsigned monthFromMarch = (5 * dayOfYear + 2) / 153;
+  day = dayOfYear - (153 * monthFromMarch + 2) / 5 + 1;
+  month = monthFromMarch < 10 ? monthFromMarch + 3 : monthFromMarch - 9;
+  year = yearOfEra + era * 400 + (month <= 2);
+}
+
+template <typename T>
+void store(char* field, T value)
+{
+  memcpy(field, &value, sizeof(value));
+}
+
+// The two lowest signed and the two highest unsigned values are the NULL and
+// empty row values, a value in range is saturated later by convert()
+template <typename T>
+void storeInt(char* field, int128_t value, bool isUnsigned)
+{
+  const int128_t lo = isUnsigned ? 0 : -(int128_t(1) << (sizeof(T) * 8 - 1)) + 2;
+  const int128_t hi =
+      isUnsigned ? (int128_t(1) << (sizeof(T) * 8)) - 3 : (int128_t(1) << (sizeof(T) * 8 - 1)) - 1;
+  store<T>(field, static_cast<T>(std::min(std::max(value, lo), hi)));
+}
+
+void storeInt(char* field, int width, int128_t value, bool isUnsigned)
+{
+  switch (width)
+  {
+    case 1: storeInt<uint8_t>(field, value, isUnsigned); break;
+    case 2: storeInt<uint16_t>(field, value, isUnsigned); break;
+    case 4: storeInt<uint32_t>(field, value, isUnsigned); break;
+    case 8: storeInt<uint64_t>(field, value, isUnsigned); break;
+    default: store<int128_t>(field, std::max(value, datatypes::Decimal128Empty + 1)); break;
+  }
+}
+
+void storeNull(char* field, ColumnKind kind, int width)
+{
+  switch (kind)
+  {
+    case ColumnKind::SIGNED:
+    case ColumnKind::DECIMAL:
+    {
+      switch (width)
+      {
+        case 1: store(field, joblist::TINYINTNULL); break;
+        case 2: store(field, joblist::SMALLINTNULL); break;
+        case 4: store(field, joblist::INTNULL); break;
+        case 8: store(field, joblist::BIGINTNULL); break;
+        default: store(field, datatypes::Decimal128Null); break;
+      }
+
+      break;
+    }
+
+    case ColumnKind::UNSIGNED:
+    {
+      switch (width)
+      {
+        case 1: store(field, joblist::UTINYINTNULL); break;
+        case 2: store(field, joblist::USMALLINTNULL); break;
+        case 4: store(field, joblist::UINTNULL); break;
+        default: store(field, joblist::UBIGINTNULL); break;
+      }
+
+      break;
+    }
+
+    case ColumnKind::FLOAT: store(field, joblist::FLOATNULL); break;
+    case ColumnKind::DOUBLE: store(field, joblist::DOUBLENULL); break;
+    case ColumnKind::DATE: store(field, joblist::DATENULL); break;
+    case ColumnKind::DATETIME: store(field, joblist::DATETIMENULL); break;
+    case ColumnKind::TIMESTAMP: store(field, joblist::TIMESTAMPNULL); break;
+    case ColumnKind::TIME: store(field, joblist::TIMENULL); break;
+
+    // An empty string is NULL in a binary import
+    default: memset(field, 0, width); break;
+  }
+}
+
+// A number with scale digits after the decimal point; false for NaN
+bool scaledValue(const arrow::Array& array, int64_t row, int sourceScale, int scale, int128_t& value)
+{
+  double real;
+
+  switch (array.type_id())
+  {
+    case arrow::Type::BOOL: value = static_cast<const arrow::BooleanArray&>(array).Value(row); break;
+    case arrow::Type::INT8: value = static_cast<const arrow::Int8Array&>(array).Value(row); break;
+    case arrow::Type::INT16: value = static_cast<const arrow::Int16Array&>(array).Value(row); break;
+    case arrow::Type::INT32: value = static_cast<const arrow::Int32Array&>(array).Value(row); break;
+    case arrow::Type::INT64: value = static_cast<const arrow::Int64Array&>(array).Value(row); break;
+    case arrow::Type::UINT8: value = static_cast<const arrow::UInt8Array&>(array).Value(row); break;
+    case arrow::Type::UINT16: value = static_cast<const arrow::UInt16Array&>(array).Value(row); break;
+    case arrow::Type::UINT32: value = static_cast<const arrow::UInt32Array&>(array).Value(row); break;
+    case arrow::Type::UINT64: value = static_cast<const arrow::UInt64Array&>(array).Value(row); break;
+
+    case arrow::Type::DECIMAL128:
+    {
+      arrow::Decimal128 decimal(static_cast<const arrow::Decimal128Array&>(array).GetValue(row));
+      value = (int128_t(decimal.high_bits()) << 64) | decimal.low_bits();
+      break;
+    }
+
+    default:
+    {
+      real = (array.type_id() == arrow::Type::FLOAT)
+                 ? static_cast<const arrow::FloatArray&>(array).Value(row)
+                 : static_cast<const arrow::DoubleArray&>(array).Value(row);
+
+      if (std::isnan(real))
+        return false;
+
+      real = std::round(real * std::pow(10.0, scale));
+
+      if (std::fabs(real) < 1e38)
+        value = static_cast<int128_t>(real);
+      else
+        value = real < 0 ? -MAX_INT128 : MAX_INT128;
+
+      return true;
+    }
+  }
+
+  for (; sourceScale < scale; sourceScale++)
+  {
+    if (value > MAX_INT128 / 10 || value < -MAX_INT128 / 10)
+    {
+      value = value < 0 ? -MAX_INT128 : MAX_INT128;
+      return true;
+    }
+
+    value *= 10;
+  }
+
+  if (sourceScale > scale)
+  {
+    int128_t divisor = 1;
+
+    for (; sourceScale > scale; sourceScale--)
+      divisor *= 10;
+
+    // Round half away from zero
+    int128_t remainder = value % divisor;
+    value /= divisor;
+
+    if (remainder < 0 && -remainder >= divisor + remainder)
+      value--;
+    else if (remainder > 0 && remainder >= divisor - remainder)
+      value++;
+  }
+
+  return true;
+}
+
+double realValue(const arrow::Array& array, int64_t row, int sourceScale)
+{
+  switch (array.type_id())
+  {
+    case arrow::Type::FLOAT: return static_cast<const arrow::FloatArray&>(array).Value(row);
+    case arrow::Type::DOUBLE: return static_cast<const arrow::DoubleArray&>(array).Value(row);
+
+    default:
+    {
+      int128_t value;
+      scaledValue(array, row, sourceScale, sourceScale, value);
+      return static_cast<double>(value) / std::pow(10.0, sourceScale);
+    }
+  }
+}
+
+// Microseconds from 1970-01-01 00:00:00 UTC, or from midnight for a time
+int64_t microsValue(const arrow::Array& array, int64_t row)
+{
+  switch (array.type_id())
+  {
+    case arrow::Type::DATE32:
+      return static_cast<const arrow::Date32Array&>(array).Value(row) * MICROS_PER_DAY;
+
+    case arrow::Type::DATE64:
+      return static_cast<const arrow::Date64Array&>(array).Value(row) * 1000;
+
+    case arrow::Type::TIMESTAMP:
+      return toMicros(static_cast<const arrow::TimestampArray&>(array).Value(row),
+                      static_cast<const arrow::TimestampType&>(*array.type()).unit());
+
+    case arrow::Type::TIME32:
+      return toMicros(static_cast<const arrow::Time32Array&>(array).Value(row),
+                      static_cast<const arrow::TimeType&>(*array.type()).unit());
+
+    default:
+      return toMicros(static_cast<const arrow::Time64Array&>(array).Value(row),
+                      static_cast<const arrow::TimeType&>(*array.type()).unit());
+  }
+}
+
+std::string_view bytesValue(const arrow::Array& array, int64_t row)
+{
+  switch (array.type_id())
+  {
+    case arrow::Type::LARGE_STRING:
+    case arrow::Type::LARGE_BINARY:
+    {
+      auto value = static_cast<const arrow::LargeBinaryArray&>(array).GetView(row);
+      return std::string_view(value.data(), value.size());
+    }
+
+    case arrow::Type::FIXED_SIZE_BINARY:
+    {
+      auto value = static_cast<const arrow::FixedSizeBinaryArray&>(array).GetView(row);
+      return std::string_view(value.data(), value.size());
+    }
+
+    default:
+    {
+      auto value = static_cast<const arrow::BinaryArray&>(array).GetView(row);
+      return std::string_view(value.data(), value.size());
+    }
+  }
+}
+
+void storeTemporal(char* field, ColumnKind kind, int64_t micros)
+{
+  const int64_t days = floorDiv(micros, MICROS_PER_DAY);
+  int64_t ofDay = micros - days * MICROS_PER_DAY;
+  const unsigned usec = ofDay % MICROS_PER_SECOND;
+  ofDay /= MICROS_PER_SECOND;
+  const unsigned second = ofDay % 60;
+  const unsigned minute = (ofDay / 60) % 60;
+  const unsigned hour = ofDay / 3600;
+
+  if (kind == ColumnKind::TIMESTAMP)
+  {
+    // The timestamps before 1970 are left to convert() as the zero timestamp
+    int64_t seconds = floorDiv(micros, MICROS_PER_SECOND);
+    store(field, seconds < 0 ? dataconvert::TimeStamp(0, 0) : dataconvert::TimeStamp(usec, seconds));
+    return;
+  }
+
+  if (kind == ColumnKind::TIME)
+  {
+    // With the day of a time parsed from text by convertColumnTime()
+    dataconvert::Time atime;
+    atime.hour = hour;
+    atime.minute = minute;
+    atime.second = second;
+    atime.msecond = usec;
+    atime.is_neg = false;
+    store(field, atime);
+    return;
+  }
+
+  // Out of range dates are stored invalid for convert() to reject
+  int64_t year;
+  unsigned month, day;
+  civilFromDays(days, year, month, day);
+
+  if (year < 0 || year > 9999)
+    year = month = day = 0;
+
+  if (kind == ColumnKind::DATE)
+    store(field, dataconvert::Date(year, month, day));
+  else
+    store(field, dataconvert::DateTime(year, month, day, hour, minute, second, usec));
+}
+
+int sourceScale(const arrow::Array& array)
+{
+  return (array.type_id() == arrow::Type::DECIMAL128)
+             ? static_cast<const arrow::Decimal128Type&>(*array.type()).scale()
+             : 0;
+}
+
+// Converts a value that is not NULL
+void convertValue(const arrow::Array& array, int64_t row, ColumnKind kind,
+                  const ParquetReader::Column& column, int sourceScale, char* field)
+{
+  switch (kind)
+  {
+    case ColumnKind::SIGNED:
+    case ColumnKind::UNSIGNED:
+    case ColumnKind::DECIMAL:
+    {
+      int128_t value;
+
+      if (scaledValue(array, row, sourceScale, (kind == ColumnKind::DECIMAL) ? column.scale : 0, value))
+        storeInt(field, column.width, value, kind == ColumnKind::UNSIGNED);
+      else
+        storeNull(field, kind, column.width);
+
+      break;
+    }
+
+    case ColumnKind::FLOAT: store(field, static_cast<float>(realValue(array, row, sourceScale))); break;
+    case ColumnKind::DOUBLE: store(field, realValue(array, row, sourceScale)); break;
+
+    case ColumnKind::STRING:
+    {
+      std::string_view value = bytesValue(array, row);
+      size_t length = std::min(value.size(), static_cast<size_t>(column.width));
+      memcpy(field, value.data(), length);
+      memset(field + length, 0, column.width - length);
+      break;
+    }
+
+    default: storeTemporal(field, kind, microsValue(array, row)); break;
+  }
+}
+
+// Copies values stored in the column type as they are, T being the unsigned
+// type of the column width for an integer column
+template <typename ArrayType, typename T>
+void copyValues(const arrow::Array& array, ColumnKind kind, int width, char* field, unsigned recordLength)
+{
+  const auto* values = static_cast<const ArrayType&>(array).raw_values();
+
+  for (int64_t row = 0; row < array.length(); row++, field += recordLength)
+  {
+    if (array.IsNull(row))
+      storeNull(field, kind, width);
+    else if constexpr (std::is_floating_point_v<T>)
+      store<T>(field, values[row]);
+    else
+      storeInt<T>(field, values[row], kind == ColumnKind::UNSIGNED);
+  }
+}
+
+// The integers of the column width and the floats of the column type don't
+// need the conversion of each value by its type
+bool copyFixedWidth(const arrow::Array& array, ColumnKind kind, int width, char* field,
+                    unsigned recordLength)
+{
+  switch (kind)
+  {
+    case ColumnKind::SIGNED:
+    case ColumnKind::UNSIGNED:
+    {
+      const bool isUnsigned = (kind == ColumnKind::UNSIGNED);
+
+      switch (array.type_id())
+      {
+        case arrow::Type::INT8:
+        case arrow::Type::UINT8:
+          if (width != 1 || isUnsigned != (array.type_id() == arrow::Type::UINT8))
+            return false;
+
+          if (isUnsigned)
+            copyValues<arrow::UInt8Array, uint8_t>(array, kind, width, field, recordLength);
+          else
+            copyValues<arrow::Int8Array, uint8_t>(array, kind, width, field, recordLength);
+
+          return true;
+
+        case arrow::Type::INT16:
+        case arrow::Type::UINT16:
+          if (width != 2 || isUnsigned != (array.type_id() == arrow::Type::UINT16))
+            return false;
+
+          if (isUnsigned)
+            copyValues<arrow::UInt16Array, uint16_t>(array, kind, width, field, recordLength);
+          else
+            copyValues<arrow::Int16Array, uint16_t>(array, kind, width, field, recordLength);
+
+          return true;
+
+        case arrow::Type::INT32:
+        case arrow::Type::UINT32:
+          if (width != 4 || isUnsigned != (array.type_id() == arrow::Type::UINT32))
+            return false;
+
+          if (isUnsigned)
+            copyValues<arrow::UInt32Array, uint32_t>(array, kind, width, field, recordLength);
+          else
+            copyValues<arrow::Int32Array, uint32_t>(array, kind, width, field, recordLength);
+
+          return true;
+
+        case arrow::Type::INT64:
+        case arrow::Type::UINT64:
+          if (width != 8 || isUnsigned != (array.type_id() == arrow::Type::UINT64))
+            return false;
+
+          if (isUnsigned)
+            copyValues<arrow::UInt64Array, uint64_t>(array, kind, width, field, recordLength);
+          else
+            copyValues<arrow::Int64Array, uint64_t>(array, kind, width, field, recordLength);
+
+          return true;
+
+        default: return false;
+      }
+    }
+
+    case ColumnKind::FLOAT:
+      if (array.type_id() != arrow::Type::FLOAT)
+        return false;
+
+      copyValues<arrow::FloatArray, float>(array, kind, width, field, recordLength);
+      return true;
+
+    case ColumnKind::DOUBLE:
+      if (array.type_id() != arrow::Type::DOUBLE)
+        return false;
+
+      copyValues<arrow::DoubleArray, double>(array, kind, width, field, recordLength);
+      return true;
+
+    default: return false;
+  }
+}
+
+// The fields of the values of the dictionary of a column, kept while the
+// slices of a batch sharing the dictionary are converted
+struct ConvertedDictionary
+{
+  std::shared_ptr<arrow::ArrayData> dictionary;  // Shared by the slices of a batch
+  std::vector<char> fields;
+};
+
+void convertColumn(const arrow::Array& array, const ParquetReader::Column& column, char* field,
+                   unsigned recordLength, ConvertedDictionary& converted)
+{
+  const ColumnKind kind = columnKind(column.dataType);
+
+  if (array.type_id() == arrow::Type::DICTIONARY)
+  {
+    // The dictionary values are converted once, each row copies the field of
+    // its index
+    const arrow::DictionaryArray& dictArray = static_cast<const arrow::DictionaryArray&>(array);
+
+    if (converted.dictionary != dictArray.data()->dictionary)
+    {
+      const arrow::Array& dictionary = *dictArray.dictionary();
+      ConvertedDictionary unused;
+      converted.fields.resize(dictionary.length() * column.width);
+      convertColumn(dictionary, column, converted.fields.data(), column.width, unused);
+      converted.dictionary = dictArray.data()->dictionary;
+    }
+
+    for (int64_t row = 0; row < array.length(); row++, field += recordLength)
+    {
+      if (array.IsNull(row))
+        storeNull(field, kind, column.width);
+      else
+        memcpy(field, &converted.fields[dictArray.GetValueIndex(row) * column.width], column.width);
+    }
+
+    return;
+  }
+
+  if (copyFixedWidth(array, kind, column.width, field, recordLength))
+    return;
+
+  const int scale = sourceScale(array);
+
+  for (int64_t row = 0; row < array.length(); row++, field += recordLength)
+  {
+    if (array.IsNull(row))
+      storeNull(field, kind, column.width);
+    else
+      convertValue(array, row, kind, column, scale, field);
+  }
+}
+
+// Checks the columns of the file can be imported into the table columns
+int checkSchema(const arrow::Schema& schema, const std::vector<ParquetReader::Column>& columns,
+                std::string& errMsg)
+{
+  if (schema.num_fields() != static_cast<int>(columns.size()))
+  {
+    std::ostringstream oss;
+    oss << "The input has " << schema.num_fields() << " columns, " << columns.size()
+        << " columns are imported";
+    errMsg = oss.str();
+    return ERR_BULK_PARQUET_SCHEMA;
+  }
+
+  for (unsigned i = 0; i < columns.size(); i++)
+  {
+    const arrow::Field& field = *schema.field(i);
+
+    if (!convertible(columnKind(columns[i].dataType), columns[i].width, sourceKind(*field.type())))
+    {
+      std::ostringstream oss;
+      oss << "Column " << (i + 1) << " (" << field.name() << ") of type " << field.type()->ToString()
+          << " can not be imported into a " << colDataTypeToString(columns[i].dataType) << " column";
+      errMsg = oss.str();
+      return ERR_BULK_PARQUET_SCHEMA;
+    }
+  }
+
+  return NO_ERROR;
+}
+
+}  // namespace
+
+struct ParquetReader::Impl
+{
+  std::unique_ptr<parquet::arrow::FileReader> fileReader;
+  std::shared_ptr<arrow::RecordBatchReader> batchReader;
+  std::shared_ptr<arrow::RecordBatch> batch;      // Rows being converted
+  int64_t batchOffset = 0;                        // Rows of batch converted
+  std::vector<ConvertedDictionary> dictionaries;  // By column
+};
+
+bool ParquetReader::supported()
+{
+  return true;
+}
+
+int ParquetReader::open(const std::string& fileName, const std::vector<Column>& columns, std::string& errMsg)
+{
+  close();
+  fColumns = columns;
+  fRecordLength = 0;
+
+  for (const Column& column : fColumns)
+    fRecordLength += column.width;
+
+  fImpl.reset(new Impl);
+  fImpl->dictionaries.resize(fColumns.size());
+
+  try
+  {
+    auto file = arrow::io::ReadableFile::Open(fileName);
+
+    if (!file.ok())
+    {
+      errMsg = file.status().ToString();
+      return ERR_FILE_OPEN;
+    }
+
+    parquet::ArrowReaderProperties properties;
+    properties.set_batch_size(BATCH_ROWS);
+
+    // Dictionary encoded strings are read as Arrow dictionaries, converted once
+    for (unsigned i = 0; i < fColumns.size(); i++)
+    {
+      if (columnKind(fColumns[i].dataType) == ColumnKind::STRING)
+        properties.set_read_dictionary(i, true);
+    }
+
+    parquet::arrow::FileReaderBuilder builder;
+    arrow::Status status = builder.Open(*file);
+
+    if (status.ok())
+      status = builder.properties(properties)->Build(&fImpl->fileReader);
+
+    std::shared_ptr<arrow::Schema> schema;
+
+    if (status.ok())
+      status = fImpl->fileReader->GetSchema(&schema);
+
+    if (!status.ok())
+    {
+      errMsg = status.ToString();
+      return ERR_BULK_PARQUET_READ;
+    }
+
+    int rc = checkSchema(*schema, fColumns, errMsg);
+
+    if (rc != NO_ERROR)
+      return rc;
+
+    fRowCount = fImpl->fileReader->parquet_reader()->metadata()->num_rows();
+
+    std::vector<int> rowGroups(fImpl->fileReader->num_row_groups());
+    std::iota(rowGroups.begin(), rowGroups.end(), 0);
+    auto batchReader = fImpl->fileReader->GetRecordBatchReader(rowGroups);
+
+    if (!batchReader.ok())
+    {
+      errMsg = batchReader.status().ToString();
+      return ERR_BULK_PARQUET_READ;
+    }
+
+    fImpl->batchReader = std::move(*batchReader);
+  }
+  catch (const std::exception& ex)
+  {
+    errMsg = ex.what();
+    return ERR_BULK_PARQUET_READ;
+  }
+
+  fEof = false;
+  return NO_ERROR;
+}
+
+int ParquetReader::openStream(const std::string& fileName, const std::vector<Column>& columns,
+                              std::string& errMsg)
+{
+  close();
+  fColumns = columns;
+  fRecordLength = 0;
+
+  for (const Column& column : fColumns)
+    fRecordLength += column.width;
+
+  fImpl.reset(new Impl);
+  fImpl->dictionaries.resize(fColumns.size());
+
+  try
+  {
+    std::shared_ptr<arrow::io::InputStream> input;
+
+    if (fileName.empty())
+    {
+      input = std::make_shared<arrow::io::StdinStream>();
+    }
+    else
+    {
+      auto file = arrow::io::ReadableFile::Open(fileName);
+
+      if (!file.ok())
+      {
+        errMsg = file.status().ToString();
+        return ERR_FILE_OPEN;
+      }
+
+      input = *file;
+    }
+
+    // Reads the schema message that starts the stream
+    auto batchReader = arrow::ipc::RecordBatchStreamReader::Open(input);
+
+    if (!batchReader.ok())
+    {
+      errMsg = batchReader.status().ToString();
+      return ERR_BULK_PARQUET_READ;
+    }
+
+    fImpl->batchReader = *batchReader;
+
+    int rc = checkSchema(*fImpl->batchReader->schema(), fColumns, errMsg);
+
+    if (rc != NO_ERROR)
+      return rc;
+  }
+  catch (const std::exception& ex)
+  {
+    errMsg = ex.what();
+    return ERR_BULK_PARQUET_READ;
+  }
+
+  fEof = false;
+  return NO_ERROR;
+}
+
+int ParquetReader::readRecords(std::vector<char>& records, std::string& errMsg)
+{
+  records.clear();
+
+  if (fEof)
+    return NO_ERROR;
+
+  // A stream writer chooses the size of its batches, they are converted
+  // BATCH_ROWS rows at a time
+  while (!fImpl->batch || fImpl->batchOffset == fImpl->batch->num_rows())
+  {
+    try
+    {
+      fImpl->batchOffset = 0;
+      arrow::Status status = fImpl->batchReader->ReadNext(&fImpl->batch);
+
+      if (!status.ok())
+      {
+        errMsg = status.ToString();
+        return ERR_BULK_PARQUET_READ;
+      }
+    }
+    catch (const std::exception& ex)
+    {
+      errMsg = ex.what();
+      return ERR_BULK_PARQUET_READ;
+    }
+
+    if (!fImpl->batch)
+    {
+      fEof = true;
+      return NO_ERROR;
+    }
+  }
+
+  std::shared_ptr<arrow::RecordBatch> batch = fImpl->batch->Slice(fImpl->batchOffset, BATCH_ROWS);
+  fImpl->batchOffset += batch->num_rows();
+
+  records.resize(batch->num_rows() * fRecordLength);
+  unsigned offset = 0;
+
+  for (unsigned i = 0; i < fColumns.size(); i++)
+  {
+    convertColumn(*batch->column(i), fColumns[i], records.data() + offset, fRecordLength,
+                  fImpl->dictionaries[i]);
+    offset += fColumns[i].width;
+  }
+
+  return NO_ERROR;
+}
+
+#else
+
+struct ParquetReader::Impl
+{
+};
+
+bool ParquetReader::supported()
+{
+  return false;
+}
+
+int ParquetReader::open(const std::string& fileName, const std::vector<Column>& columns, std::string& errMsg)
+{
+  errMsg = "Parquet import is not supported by this build";
+  return ERR_BULK_PARQUET_READ;
+}
+
+int ParquetReader::openStream(const std::string& fileName, const std::vector<Column>& columns,
+                              std::string& errMsg)
+{
+  errMsg = "Arrow import is not supported by this build";
+  return ERR_BULK_PARQUET_READ;
+}
+
+int ParquetReader::readRecords(std::vector<char>& records, std::string& errMsg)
+{
+  records.clear();
+  errMsg = "Parquet and Arrow import are not supported by this build";
+  return ERR_BULK_PARQUET_READ;
+}
+
+#endif
+
+ParquetReader::ParquetReader() : fRecordLength(0), fRowCount(0), fEof(true)
+{
+}
+
+ParquetReader::~ParquetReader()
+{
+}
+
+void ParquetReader::close()
+{
+  fImpl.reset();
+  fEof = true;
+  fRowCount = 0;
+}
+
+}  // namespace WriteEngine
@@ -0,0 +1,120 @@
+/* Copyright (C) 2024 MariaDB Corporation
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; version 2 of
+   the License.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program; if not, write to the Free Software
+   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+   MA 02110-1301, USA. */
+
+/*******************************************************************************
+ * $Id$
+ *
+ *******************************************************************************/
+/** @file
+ * Reads a Parquet import file or an Arrow IPC stream as the fixed length
+ * records of a binary import.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "calpontsystemcatalog.h"
+
+namespace WriteEngine
+{
+/** @brief Converts the rows of a Parquet file or an Arrow IPC stream to binary
+ * import records.
+ *
+ * The columns of the file are imported into the table columns in the same
+ * position. Each value is converted from its Parquet type to the binary
+ * import form of the column type: integers and decimals scaled to the column
+ * scale in the column width, floats, packed dates and times, strings padded
+ * with '\0' to the column width. A Parquet NULL becomes the NULL value of the
+ * column type, as in a binary import that accepts NULL values, so the records
+ * are parsed by tokenizeBinary() and convert() without a text round trip.
+ * The values of a dictionary encoded column are converted once per batch.
+ *
+ * Without Arrow and Parquet libraries at build time supported() is false and
+ * open() and openStream() fail.
+ */
+class ParquetReader
+{
+ public:
+  // A table column the file is imported into
+  struct Column
+  {
+    execplan::CalpontSystemCatalog::ColDataType dataType;
+    int width;  // width of the column in a binary import record
+    int scale;
+  };
+
+  ParquetReader();
+  ~ParquetReader();
+
+  static bool supported();
+
+  /** @brief Opens the file and checks its columns can be imported.
+   *
+   * @param columns the table columns in the order of the file columns
+   * @param errMsg the reason when open fails
+   * @return NO_ERROR, ERR_FILE_OPEN, ERR_BULK_PARQUET_READ or ERR_BULK_PARQUET_SCHEMA
+   */
+  int open(const std::string& fileName, const std::vector<Column>& columns, std::string& errMsg);
+
+  /** @brief Opens an Arrow IPC stream and checks its columns can be imported.
+   *
+   * The stream is read as it comes, from a pipe as well as from a file.
+   * @param fileName the file of the stream, stdin if empty
+   * @return NO_ERROR, ERR_FILE_OPEN, ERR_BULK_PARQUET_READ or ERR_BULK_PARQUET_SCHEMA
+   */
+  int openStream(const std::string& fileName, const std::vector<Column>& columns, std::string& errMsg);
+
+  /** @brief Converts the next batch of rows to records.
+   *
+   * @param records replaced by the records, empty at the end of the file
+   * @return NO_ERROR or ERR_BULK_PARQUET_READ
+   */
+  int readRecords(std::vector<char>& records, std::string& errMsg);
+
+  void close();
+
+  // All the rows were read
+  bool eof() const
+  {
+    return fEof;
+  }
+
+  unsigned recordLength() const
+  {
+    return fRecordLength;
+  }
+
+  // Rows of a Parquet file, 0 for a stream
+  uint64_t rowCount() const
+  {
+    return fRowCount;
+  }
+
+ private:
+  struct Impl;  // Arrow readers, kept out of the callers' includes
+
+  std::unique_ptr<Impl> fImpl;
+  std::vector<Column> fColumns;
+  unsigned fRecordLength;
+  uint64_t fRowCount;
+  bool fEof;
+};
+
+}  // namespace WriteEngine
@@ -137,11 +137,15 @@ enum BulkModeType
 // Import Mode 0-text Import (default)
 //             1-Binary Import with NULL values
 //             2-Binary Import with saturated NULL values
+//             3-Parquet Import, converted to binary records with NULL values
+//             4-Arrow IPC stream Import, converted as Parquet
 enum ImportDataMode
 {
   IMPORT_DATA_TEXT = 0,
   IMPORT_DATA_BIN_ACCEPT_NULL = 1,
-  IMPORT_DATA_BIN_SAT_NULL = 2
+  IMPORT_DATA_BIN_SAT_NULL = 2,
+  IMPORT_DATA_PARQUET = 3,
+  IMPORT_DATA_ARROW = 4
 };
 
 /**
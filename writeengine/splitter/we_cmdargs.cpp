@@ -41,6 +41,7 @@ using namespace std;
 using namespace oam;
 
 #include "we_cmdargs.h"
+#include "we_parquetreader.h"
 
 #include "installdir.h"
 #include "mcsconfig.h"
@@ -188,7 +189,10 @@ std::string WECmdArgs::getCpImportCmdLine()
   if (fNullStrMode)
     aSS << " -n " << '1';
 
-  if (fImportDataMode != IMPORT_DATA_TEXT)
+  // In mode 1 Parquet and Arrow input is sent to the PMs as binary records
+  if (((fImportDataMode == IMPORT_DATA_PARQUET) || (fImportDataMode == IMPORT_DATA_ARROW)) && (fMode == 1))
+    aSS << " -I " << IMPORT_DATA_BIN_ACCEPT_NULL;
+  else if (fImportDataMode != IMPORT_DATA_TEXT)
     aSS << " -I " << fImportDataMode;
 
   // if(fConfig.length()>0)
@@ -552,6 +556,8 @@ void WECmdArgs::usage()
        << "\t-I\tImport binary data; how to treat NULL values:\n"
        << "\t\t\t1 - import NULL values\n"
        << "\t\t\t2 - saturate NULL values\n"
+       << "\t\t\t3 - import Parquet files\n"
+       << "\t\t\t4 - import an Arrow IPC stream\n"
        << "\t-P\tList of PMs ex: -P 1,2,3. Default is all PMs.\n"
        << "\t-S\tTreat string truncations as errors.\n"
        << "\t-m\tmode\n"
@@ -854,9 +860,23 @@ void WECmdArgs::parseCmdLineArgs(int argc, char** argv)
         {
           fImportDataMode = IMPORT_DATA_BIN_SAT_NULL;
         }
+        else if (binaryMode == 3)
+        {
+          if (!ParquetReader::supported())
+            throw(runtime_error("Parquet import is not supported by this build"));
+
+          fImportDataMode = IMPORT_DATA_PARQUET;
+        }
+        else if (binaryMode == 4)
+        {
+          if (!ParquetReader::supported())
+            throw(runtime_error("Arrow import is not supported by this build"));
+
+          fImportDataMode = IMPORT_DATA_ARROW;
+        }
         else
         {
-          throw(runtime_error("Invalid Binary mode; value can be 1 or 2"));
+          throw(runtime_error("Invalid Binary mode; value can be 1, 2, 3 or 4"));
         }
 
         break;
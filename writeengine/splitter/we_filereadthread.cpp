@@ -79,6 +79,7 @@ WEFileReadThread::WEFileReadThread(WESDHandler& aSdh)
  , fEncl('\0')
  , fEsc('\\')
  , fDelim('|')
+ , fParquetOffset(0)
 {
   // TODO batch qty to get from config
   fBatchQty = 10000;
@@ -310,7 +311,10 @@ void WEFileReadThread::feedData()
       TgtPmId = getTgtPmId();
     }
 
-    if ((TgtPmId > 0) && (fInFile.good()))
+    bool aParquet = ((fSdh.getImportDataMode() == IMPORT_DATA_PARQUET) ||
+                     (fSdh.getImportDataMode() == IMPORT_DATA_ARROW));
+
+    if ((TgtPmId > 0) && (aParquet || fInFile.good()))
     {
       try
       {
@@ -318,6 +322,8 @@ void WEFileReadThread::feedData()
 
         if (fSdh.getImportDataMode() == IMPORT_DATA_TEXT)
           aRowCnt = readDataFile(aSbs);
+        else if (aParquet)
+          aRowCnt = readParquetDataFile(aSbs);
         else
           aRowCnt = readBinaryDataFile(aSbs, fSdh.getTableRecLen());
 
@@ -340,7 +346,7 @@ void WEFileReadThread::feedData()
     }
 
     // Finish reading file and thread can go away once data sent
-    if (fInFile.eof())
+    if (aParquet ? fParquetReader.eof() : fInFile.eof())
     {
       if (fInfileList.size() != 0)
       {
@@ -468,6 +474,49 @@ unsigned int WEFileReadThread::readBinaryDataFile(messageqcpp::SBS& Sbs, unsigne
   return 0;
 }
 
+//------------------------------------------------------------------------------
+// Read Parquet or Arrow input data, converted to the fixed length records of a
+// binary import that accepts NULL values
+//------------------------------------------------------------------------------
+unsigned int WEFileReadThread::readParquetDataFile(messageqcpp::SBS& Sbs)
+{
+  boost::mutex::scoped_lock aLock(fFileMutex);
+
+  if (fParquetReader.eof())
+    return 0;
+
+  unsigned int aIdx = 0;
+  const unsigned int aRecLen = fParquetReader.recordLength();
+  *Sbs << (ByteStream::byte)(WE_CLT_SRV_DATA);
+
+  while (aIdx < getBatchQty())
+  {
+    if (fParquetOffset == fParquetRecords.size())
+    {
+      std::string aErrMsg;
+
+      if (fParquetReader.readRecords(fParquetRecords, aErrMsg) != NO_ERROR)
+        throw runtime_error("Error reading input file " + fInFileName + ": " + aErrMsg);
+
+      fParquetOffset = 0;
+
+      if (fParquetReader.eof())
+        break;
+    }
+
+    unsigned int aRows = std::min<size_t>(getBatchQty() - aIdx,
+                                          (fParquetRecords.size() - fParquetOffset) / aRecLen);
+    (*Sbs).append(reinterpret_cast<ByteStream::byte*>(&fParquetRecords[fParquetOffset]), aRows * aRecLen);
+    fParquetOffset += aRows * aRecLen;
+    aIdx += aRows;
+  }
+
+  if (fSdh.getDebugLvl() > 2)
+    cout << "Converted input data rows = " << aIdx << endl;
+
+  return aIdx;
+}
+
 //------------------------------------------------------------------------------
 
 void WEFileReadThread::openInFile()
@@ -492,7 +541,36 @@ void WEFileReadThread::openInFile()
     if (fSdh.getDebugLvl())
       cout << "Input Filename: " << fInFileName << endl;
 
-    if (doS3Import)
+    if (fSdh.getImportDataMode() == IMPORT_DATA_PARQUET)
+    {
+      // Parquet metadata is at the end of the file, it is read from a file
+      if (doS3Import || (fInFileName == "/dev/stdin"))
+        throw runtime_error("Parquet import requires an input file");
+
+      std::string aErrMsg;
+
+      if (fParquetReader.open(fInFileName, fSdh.getRecordColumns(), aErrMsg) != NO_ERROR)
+        throw runtime_error("Could not open Parquet input file " + fInFileName + ": " + aErrMsg);
+
+      fParquetRecords.clear();
+      fParquetOffset = 0;
+    }
+    else if (fSdh.getImportDataMode() == IMPORT_DATA_ARROW)
+    {
+      // An Arrow IPC stream is read as it comes, from stdin as well
+      if (doS3Import)
+        throw runtime_error("Arrow import from S3 is not supported");
+
+      std::string aErrMsg;
+      std::string aFileName = (fInFileName == "/dev/stdin") ? std::string() : fInFileName;
+
+      if (fParquetReader.openStream(aFileName, fSdh.getRecordColumns(), aErrMsg) != NO_ERROR)
+        throw runtime_error("Could not open Arrow input stream " + fInFileName + ": " + aErrMsg);
+
+      fParquetRecords.clear();
+      fParquetOffset = 0;
+    }
+    else if (doS3Import)
     {
       size_t bufLen = 0;
       if (buf)
@@ -30,6 +30,7 @@
 #pragma once
 
 #include "we_cmdargs.h"
+#include "we_parquetreader.h"
 #include "libmarias3/marias3.h"
 #include <boost/iostreams/device/array.hpp>
 #include <boost/iostreams/stream.hpp>
@@ -70,6 +71,7 @@ class WEFileReadThread
   void feedData();
   unsigned int readDataFile(messageqcpp::SBS& Sbs);
   unsigned int readBinaryDataFile(messageqcpp::SBS& Sbs, unsigned int recLen);
+  unsigned int readParquetDataFile(messageqcpp::SBS& Sbs);
   void openInFile();
 
   int getNextRow(std::istream& ifs, char* pBuf, int MaxLen);
@@ -155,6 +157,11 @@ class WEFileReadThread
   char* fBuff;    // main data buffer
   int fBuffSize;
 
+  // Parquet or Arrow input, sent as the binary records it is converted to
+  ParquetReader fParquetReader;
+  std::vector<char> fParquetRecords;  // records of the current batch of rows
+  size_t fParquetOffset;              // records of the batch already sent
+
   /* To support mode 1 imports from objects on S3 */
   void initS3Connection(const WECmdArgs&);
   bool doS3Import;
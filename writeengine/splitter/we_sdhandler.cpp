@@ -2326,10 +2326,13 @@ int WESDHandler::getTableOID(std::string Schema, std::string Table)
 
 //------------------------------------------------------------------------------
 // Get the expected import binary fixed record length for the specified table.
+// The columns of the records are saved in fRecordColumns, Parquet and Arrow
+// input is converted into these records.
 //------------------------------------------------------------------------------
 unsigned int WESDHandler::calcTableRecLen(const std::string& schema, const std::string table)
 {
   unsigned int recLen = 0;
+  fRecordColumns.clear();
 
   CalpontSystemCatalog::TableName tableName(schema, table);
   boost::shared_ptr<CalpontSystemCatalog> systemCatalogPtr = CalpontSystemCatalog::makeCalpontSystemCatalog();
@@ -2361,11 +2364,13 @@ unsigned int WESDHandler::calcTableRecLen(const std::string& schema, const std::
       if (setIter != colListInJobFile.end())
       {
         recLen += colType.colWidth;
+        fRecordColumns.push_back({colType.colDataType, colType.colWidth, colType.scale});
       }
     }
     else
     {
       recLen += colType.colWidth;
+      fRecordColumns.push_back({colType.colDataType, colType.colWidth, colType.scale});
     }
 
     ++rid_iterator;
@@ -208,6 +208,10 @@ class WESDHandler
   {
     return fFixedBinaryRecLen;
   }
+  const std::vector<ParquetReader::Column>& getRecordColumns() const
+  {
+    return fRecordColumns;
+  }
   void updateRowTx(unsigned int RowCnt, int CIdx)
   {
     fWeSplClients[CIdx]->updateRowTx(RowCnt);
@@ -261,6 +265,7 @@ class WESDHandler
   int64_t fTableLock;
   int32_t fTableOId;
   uint32_t fFixedBinaryRecLen;
+  std::vector<ParquetReader::Column> fRecordColumns;  // Columns of a binary record
 
   boost::mutex fRespMutex;
   boost::condition fRespCond;
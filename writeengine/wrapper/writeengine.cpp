@@ -1722,6 +1722,7 @@ int WriteEngineWrapper::insertColumnRecs(
       dctStr_iter = dictStrList[i].begin();
       col_iter = colValueList[i].begin();
       Dctnry* dctnry = m_dctnry[op(dctnryStructList[i].fCompressionType)];
+      dctnry->setCharsetNumber(dctnryStructList[i].fCharsetNumber);
       rc = dctnry->openDctnry(dctnryStructList[i].dctnryOid, dctnryStructList[i].fColDbRoot,
                               dctnryStructList[i].fColPartition, dctnryStructList[i].fColSegment,
                               useTmpSuffix);  // @bug 5572 HDFS tmp file
@@ -1793,6 +1794,7 @@ int WriteEngineWrapper::insertColumnRecs(
               newDctnryStructList[i].dctnryOid, newDctnryStructList[i].fColDbRoot,
               newDctnryStructList[i].fColPartition, newDctnryStructList[i].fColSegment);
 
+        dctnry->setCharsetNumber(newDctnryStructList[i].fCharsetNumber);
         rc = dctnry->openDctnry(newDctnryStructList[i].dctnryOid, newDctnryStructList[i].fColDbRoot,
                                 newDctnryStructList[i].fColPartition, newDctnryStructList[i].fColSegment,
                                 false);  // @bug 5572 HDFS tmp file
@@ -2542,6 +2544,7 @@ int WriteEngineWrapper::insertColumnRecsBinary(
     {
       dctStr_iter = dictStrList[i].begin();
       Dctnry* dctnry = m_dctnry[op(dctnryStructList[i].fCompressionType)];
+      dctnry->setCharsetNumber(dctnryStructList[i].fCharsetNumber);
       rc = dctnry->openDctnry(dctnryStructList[i].dctnryOid, dctnryStructList[i].fColDbRoot,
                               dctnryStructList[i].fColPartition, dctnryStructList[i].fColSegment,
                               useTmpSuffix);  // @bug 5572 HDFS tmp file
@@ -2601,6 +2604,7 @@ int WriteEngineWrapper::insertColumnRecsBinary(
               newDctnryStructList[i].dctnryOid, newDctnryStructList[i].fColDbRoot,
               newDctnryStructList[i].fColPartition, newDctnryStructList[i].fColSegment);
 
+        dctnry->setCharsetNumber(newDctnryStructList[i].fCharsetNumber);
         rc = dctnry->openDctnry(newDctnryStructList[i].dctnryOid, newDctnryStructList[i].fColDbRoot,
                                 newDctnryStructList[i].fColPartition, newDctnryStructList[i].fColSegment,
                                 false);  // @bug 5572 HDFS tmp file
@@ -3096,6 +3100,7 @@ int WriteEngineWrapper::insertColumnRec_SYS(const TxnID& txnid, const CSCTypesLi
       dctnryStructList[i].fColPartition = partitionNum;
       dctnryStructList[i].fColSegment = segmentNum;
       dctnryStructList[i].fColDbRoot = dbRoot;
+      dctnry->setCharsetNumber(dctnryStructList[i].fCharsetNumber);
       rc = dctnry->openDctnry(dctnryStructList[i].dctnryOid, dctnryStructList[i].fColDbRoot,
                               dctnryStructList[i].fColPartition, dctnryStructList[i].fColSegment,
                               false);  // @bug 5572 HDFS tmp file
@@ -3170,6 +3175,7 @@ int WriteEngineWrapper::insertColumnRec_SYS(const TxnID& txnid, const CSCTypesLi
 
       if (newExtent)
       {
+        dctnry->setCharsetNumber(newDctnryStructList[i].fCharsetNumber);
         rc = dctnry->openDctnry(newDctnryStructList[i].dctnryOid, newDctnryStructList[i].fColDbRoot,
                                 newDctnryStructList[i].fColPartition, newDctnryStructList[i].fColSegment,
                                 false);  // @bug 5572 HDFS tmp file
@@ -3761,6 +3767,7 @@ int WriteEngineWrapper::insertColumnRec_Single(const TxnID& txnid, const CSCType
 
       if (bUseStartExtent)
       {
+        dctnry->setCharsetNumber(dctnryStructList[i].fCharsetNumber);
         rc = dctnry->openDctnry(dctnryStructList[i].dctnryOid, dctnryStructList[i].fColDbRoot,
                                 dctnryStructList[i].fColPartition, dctnryStructList[i].fColSegment,
                                 true);  // @bug 5572 HDFS tmp file
@@ -3833,6 +3840,7 @@ int WriteEngineWrapper::insertColumnRec_Single(const TxnID& txnid, const CSCType
 
       if (newExtent)
       {
+        dctnry->setCharsetNumber(newDctnryStructList[i].fCharsetNumber);
         rc = dctnry->openDctnry(newDctnryStructList[i].dctnryOid, newDctnryStructList[i].fColDbRoot,
                                 newDctnryStructList[i].fColPartition, newDctnryStructList[i].fColSegment,
                                 false);  // @bug 5572 HDFS tmp file
@@ -6075,6 +6083,7 @@ int WriteEngineWrapper::tokenize(const TxnID& txnid, DctnryStruct& dctnryStruct,
   // find the corresponding column segment file the token is going to be inserted.
 
   Dctnry* dctnry = m_dctnry[op(dctnryStruct.fCompressionType)];
+  dctnry->setCharsetNumber(dctnryStruct.fCharsetNumber);
   int rc = dctnry->openDctnry(dctnryStruct.dctnryOid, dctnryStruct.fColDbRoot, dctnryStruct.fColPartition,
                               dctnryStruct.fColSegment,
                               useTmpSuffix);  // @bug 5572 TBD
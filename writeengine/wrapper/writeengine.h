@@ -383,6 +383,7 @@ class WriteEngineWrapper : public WEObj
   {
     int compress_op = op(dctnryStruct.fCompressionType);
     m_dctnry[compress_op]->setTransId(txnid);
+    m_dctnry[compress_op]->setCharsetNumber(dctnryStruct.fCharsetNumber);
     return m_dctnry[compress_op]->openDctnry(dctnryStruct.dctnryOid, dctnryStruct.fColDbRoot,
                                              dctnryStruct.fColPartition, dctnryStruct.fColSegment,
                                              useTmpSuffix);